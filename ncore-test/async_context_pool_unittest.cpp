@@ -0,0 +1,143 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/async_context_pool.h>
+#include <ncore/sys/file_stream.h>
+#include <ncore/sys/proactor.h>
+#include <ncore/sys/file_stream_async_event_args.h>
+
+namespace
+{
+
+using namespace ncore;
+
+typedef AsyncContextPool<FileStreamAsyncContext> FileStreamContextPool;
+
+// 用池中的上下文写文件，完成回调中归还
+class PooledWriter
+{
+public:
+    static const size_t kMaxRequests = 8;
+    static const size_t kBlockSize = 512;
+
+public:
+    PooledWriter();
+
+    bool init();
+    void fini();
+
+    bool StartWrite();
+
+    void OnWriteCompleted(FileStreamAsyncContext & arg);
+
+    Proactor proactor;
+    FileStream fs;
+    FileStreamContextPool pool;
+    FileStreamAsyncResultAdapter<PooledWriter> adapter;
+    char buffer[kBlockSize];
+    size_t completed;
+};
+
+PooledWriter::PooledWriter()
+    : completed(0)
+{
+    adapter.Register(this, &PooledWriter::OnWriteCompleted);
+    memset(buffer, 'p', sizeof(buffer));
+}
+
+bool PooledWriter::init()
+{
+    if (!proactor.init()) return false;
+
+    if (!fs.init("async_context_pool",
+                 FileAccess::kReadWrite,
+                 FileShare::kExclusive,
+                 FileMode::kCreateAlways,
+                 FileAttribute::kNormal,
+                 FileOption::kDeleteOnClose))
+        return false;
+
+    return fs.Associate(proactor);
+}
+
+void PooledWriter::fini()
+{
+    fs.fini();
+    proactor.fini();
+}
+
+bool PooledWriter::StartWrite()
+{
+    for (size_t index = 0; index < kMaxRequests; ++index)
+    {
+        FileStreamContextPool::Handle args = pool.Acquire();
+        if (args.empty()) return false;
+
+        args->SetBuffer(buffer, kBlockSize);
+        args->set_offset(static_cast<uint64_t>(index * kBlockSize));
+        args->set_completion_delegate(&adapter);
+        if (!fs.WriteAsync(*args)) return false;
+
+        // 请求在途，所有权交给完成回调
+        args.Detach();
+    }
+    return true;
+}
+
+void PooledWriter::OnWriteCompleted(FileStreamAsyncContext & arg)
+{
+    FileStreamContextPool::Handle args(&arg);
+    if (arg.error() == 0 && arg.transfered() == kBlockSize) ++completed;
+}
+
+}
+
+TEST(AsyncContextPoolTest, AcquireAndRelease)
+{
+    FileStreamContextPool pool;
+    EXPECT_EQ(0, pool.capacity());
+
+    // 预留按块向上取整
+    ASSERT_TRUE(pool.Reserve(10));
+    const size_t slab = FileStreamContextPool::kSlabSize;
+    EXPECT_EQ(slab, pool.capacity());
+    EXPECT_EQ(slab, pool.available());
+
+    {
+        FileStreamContextPool::Handle first = pool.Acquire();
+        ASSERT_FALSE(first.empty());
+        EXPECT_EQ(0, first->count());
+        EXPECT_EQ(slab - 1, pool.available());
+
+        // 移动不改变归属
+        FileStreamContextPool::Handle second(std::move(first));
+        EXPECT_TRUE(first.empty());
+        EXPECT_EQ(slab - 1, pool.available());
+
+        second.Reset();
+        EXPECT_EQ(slab, pool.available());
+
+        FileStreamAsyncContext * detached = pool.Acquire().Detach();
+        EXPECT_EQ(slab - 1, pool.available());
+        FileStreamContextPool::Release(*detached);
+    }
+
+    // 稳定运行时不再扩充
+    EXPECT_EQ(slab, pool.available());
+    EXPECT_EQ(slab, pool.capacity());
+}
+
+TEST(AsyncContextPoolTest, ReleaseFromCompletion)
+{
+    PooledWriter writer;
+    ASSERT_TRUE(writer.init());
+    ASSERT_TRUE(writer.pool.Reserve(PooledWriter::kMaxRequests));
+    ASSERT_TRUE(writer.StartWrite());
+
+    const size_t expected = PooledWriter::kMaxRequests;
+    for (int loop = 0; loop < 100 && writer.completed < expected; ++loop)
+        writer.proactor.RunBatch(100, 16);
+
+    EXPECT_EQ(expected, writer.completed);
+    EXPECT_EQ(writer.pool.capacity(), writer.pool.available());
+
+    writer.fini();
+}
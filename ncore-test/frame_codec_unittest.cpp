@@ -0,0 +1,253 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/frame_codec.h>
+#include <ncore/sys/socket.h>
+#include <ncore/sys/proactor.h>
+#include "proactor_engine_test.h"
+
+using namespace ncore;
+
+class FrameCodecTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+#if defined NCORE_WINDOWS
+        WORD wsaver = MAKEWORD(2, 2);
+        WSADATA wsadata = {0};
+        WSAStartup(wsaver, &wsadata);
+#endif
+    }
+
+    static void TearDownTestCase()
+    {
+#if defined NCORE_WINDOWS
+        WSACleanup();
+#endif
+    }
+};
+
+// 把数据写入解码器，模拟一次接收
+static void Feed(FrameDecoder & decoder, const std::string & data)
+{
+    size_t offset = 0;
+    while (offset < data.size())
+    {
+        size_t size = 0;
+        char * buffer = decoder.Prepare(size);
+        ASSERT_TRUE(buffer != 0);
+        size = std::min(size, data.size() - offset);
+        memcpy(buffer, data.data() + offset, size);
+        decoder.Commit(size);
+        offset += size;
+    }
+}
+
+static std::string Encode(FrameFormat::Value format, const std::string & body)
+{
+    char header[FrameDecoder::kMaxHeaderSize];
+    size_t size = FrameDecoder::EncodeHeader(format, body.size(), header);
+    return std::string(header, size) + body;
+}
+
+TEST_F(FrameCodecTest, EncodeHeader)
+{
+    char header[FrameDecoder::kMaxHeaderSize];
+    EXPECT_EQ(2, FrameDecoder::EncodeHeader(FrameFormat::kFrameFixed16, 0x1234, header));
+    EXPECT_EQ(0x12, static_cast<uint8_t>(header[0]));
+    EXPECT_EQ(0x34, static_cast<uint8_t>(header[1]));
+    EXPECT_EQ(0, FrameDecoder::EncodeHeader(FrameFormat::kFrameFixed16, 0x10000, header));
+    EXPECT_EQ(4, FrameDecoder::EncodeHeader(FrameFormat::kFrameFixed32, 0x10000, header));
+    EXPECT_EQ(1, FrameDecoder::EncodeHeader(FrameFormat::kFrameVarint, 127, header));
+    EXPECT_EQ(2, FrameDecoder::EncodeHeader(FrameFormat::kFrameVarint, 300, header));
+    EXPECT_EQ(0xAC, static_cast<uint8_t>(header[0]));
+    EXPECT_EQ(0x02, static_cast<uint8_t>(header[1]));
+    EXPECT_EQ(5, FrameDecoder::EncodeHeader(FrameFormat::kFrameVarint, 0xFFFFFFFF, header));
+}
+
+TEST_F(FrameCodecTest, SplitAndBatched)
+{
+    const FrameFormat::Value formats[] = {FrameFormat::kFrameFixed16,
+                                          FrameFormat::kFrameFixed32,
+                                          FrameFormat::kFrameVarint};
+    for (size_t index = 0; index < 3; ++index)
+    {
+        FrameDecoder decoder;
+        ASSERT_TRUE(decoder.init(formats[index], 1024, 64));
+
+        // 一次接收多个帧，包括空帧
+        std::string data = Encode(formats[index], "first") +
+                           Encode(formats[index], "") +
+                           Encode(formats[index], "second");
+        Feed(decoder, data);
+        FrameView frame;
+        ASSERT_EQ(FrameStatus::kFrameReady, decoder.Next(frame));
+        EXPECT_EQ("first", std::string(frame.data, frame.size));
+        ASSERT_EQ(FrameStatus::kFrameReady, decoder.Next(frame));
+        EXPECT_EQ(0, frame.size);
+        ASSERT_EQ(FrameStatus::kFrameReady, decoder.Next(frame));
+        EXPECT_EQ("second", std::string(frame.data, frame.size));
+        EXPECT_EQ(FrameStatus::kFrameIncomplete, decoder.Next(frame));
+        EXPECT_EQ(0, decoder.buffered());
+
+        // 帧头和帧体都可以被拆开
+        std::string body(300, 'x');
+        data = Encode(formats[index], body);
+        for (size_t offset = 0; offset < data.size(); ++offset)
+        {
+            EXPECT_EQ(FrameStatus::kFrameIncomplete, decoder.Next(frame));
+            Feed(decoder, data.substr(offset, 1));
+        }
+        ASSERT_EQ(FrameStatus::kFrameReady, decoder.Next(frame));
+        EXPECT_EQ(body, std::string(frame.data, frame.size));
+    }
+}
+
+TEST_F(FrameCodecTest, Growth)
+{
+    FrameDecoder decoder;
+    ASSERT_TRUE(decoder.init(FrameFormat::kFrameFixed32, 4096, 64));
+    EXPECT_EQ(64, decoder.capacity());
+
+    // 知道帧的长度之后一次留出整个帧的空间
+    std::string body(1000, 'y');
+    std::string data = Encode(FrameFormat::kFrameFixed32, body);
+    Feed(decoder, data.substr(0, 10));
+    FrameView frame;
+    EXPECT_EQ(FrameStatus::kFrameIncomplete, decoder.Next(frame));
+    size_t size = 0;
+    ASSERT_TRUE(decoder.Prepare(size) != 0);
+    EXPECT_LE(data.size() - 10, size);
+    Feed(decoder, data.substr(10));
+    ASSERT_EQ(FrameStatus::kFrameReady, decoder.Next(frame));
+    EXPECT_EQ(body, std::string(frame.data, frame.size));
+    EXPECT_LE(data.size(), decoder.capacity());
+
+    // 取完之后从头开始使用
+    size_t capacity = decoder.capacity();
+    Feed(decoder, Encode(FrameFormat::kFrameFixed32, "z"));
+    ASSERT_EQ(FrameStatus::kFrameReady, decoder.Next(frame));
+    EXPECT_EQ(capacity, decoder.capacity());
+}
+
+TEST_F(FrameCodecTest, Guards)
+{
+    FrameDecoder decoder;
+    ASSERT_TRUE(decoder.init(FrameFormat::kFrameVarint, 100, 64));
+    Feed(decoder, Encode(FrameFormat::kFrameVarint, std::string(101, 'a')));
+    FrameView frame;
+    EXPECT_EQ(FrameStatus::kFrameTooLarge, decoder.Next(frame));
+    decoder.fini();
+
+    ASSERT_TRUE(decoder.init(FrameFormat::kFrameVarint, 100, 64));
+    Feed(decoder, std::string(5, '\xFF'));
+    EXPECT_EQ(FrameStatus::kFrameMalformed, decoder.Next(frame));
+    decoder.fini();
+
+    // 第5个字节超出32位
+    ASSERT_TRUE(decoder.init(FrameFormat::kFrameVarint, 100, 64));
+    Feed(decoder, std::string("\xFF\xFF\xFF\xFF\x1F", 5));
+    EXPECT_EQ(FrameStatus::kFrameMalformed, decoder.Next(frame));
+}
+
+// 收集接收到的帧
+class FrameCollector
+{
+public:
+    FrameCollector() : closed(false), error(0)
+    {
+        adapter.Register(this, &FrameCollector::OnFrame);
+    }
+
+    void OnFrame(FrameReader & reader)
+    {
+        if (reader.closed())
+        {
+            closed = true;
+            error = reader.error();
+            return;
+        }
+        frames.push_back(std::string(reader.frame(), reader.frame_size()));
+    }
+
+    FrameReaderAdapter<FrameCollector> adapter;
+    std::vector<std::string> frames;
+    bool closed;
+    uint32_t error;
+};
+
+class FrameCodecAsyncTest : public ProactorEngineTest
+{
+};
+
+TEST_P(FrameCodecAsyncTest, SocketReader)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket listener;
+    ASSERT_TRUE(listener.init(AddressFamily::kInterNetwork,
+                              SocketType::kStream,
+                              ProtocolType::kTCP));
+    IPEndPoint iep;
+    ASSERT_TRUE(BindAnyPort(listener, IPAddress::kIPLoopback, iep));
+    ASSERT_TRUE(listener.Listen(1));
+
+    Socket client;
+    ASSERT_TRUE(client.init(AddressFamily::kInterNetwork,
+                            SocketType::kStream,
+                            ProtocolType::kTCP));
+    ASSERT_TRUE(client.Connect(iep));
+    Socket server = listener.Accept();
+    ASSERT_TRUE(server.IsValid());
+    ASSERT_TRUE(server.Associate(proactor));
+
+    FrameCollector collector;
+    FrameReader reader;
+    EXPECT_FALSE(reader.Start());
+    ASSERT_TRUE(reader.init(server, FrameFormat::kFrameVarint, 64 * 1024, 256));
+    reader.set_completion_delegate(&collector.adapter);
+    ASSERT_TRUE(reader.Start());
+
+    // 许多小帧一次发送，再加一个需要扩大缓冲区的大帧
+    const size_t kFrames = 100;
+    std::string data;
+    for (size_t index = 0; index < kFrames; ++index)
+        data += Encode(FrameFormat::kFrameVarint, std::string(index % 7, 'a' + index % 26));
+    std::string large(20000, 'L');
+    data += Encode(FrameFormat::kFrameVarint, large);
+
+    uint32_t transfered = 0;
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+        ASSERT_TRUE(client.Send(data.data() + sent, data.size() - sent, transfered));
+        sent += transfered;
+    }
+
+    for (int loop = 0; loop < 200 && collector.frames.size() < kFrames + 1; ++loop)
+        proactor.Run(10);
+    ASSERT_EQ(kFrames + 1, collector.frames.size());
+    for (size_t index = 0; index < kFrames; ++index)
+        EXPECT_EQ(std::string(index % 7, 'a' + index % 26), collector.frames[index]);
+    EXPECT_EQ(large, collector.frames[kFrames]);
+    EXPECT_EQ(kFrames + 1, reader.frame_count());
+    EXPECT_GT(reader.frame_count(), reader.receive_count());
+    EXPECT_FALSE(collector.closed);
+
+    // 对端在帧的边界上关闭
+    client.fini();
+    for (int loop = 0; loop < 100 && !collector.closed; ++loop)
+        proactor.Run(10);
+    EXPECT_TRUE(collector.closed);
+    EXPECT_EQ(0, collector.error);
+
+    reader.fini();
+    server.fini();
+    listener.fini();
+    proactor.fini();
+}
+
+INSTANTIATE_PROACTOR_ENGINE_TEST(FrameCodecAsyncTest);
@@ -0,0 +1,106 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/io_stats.h>
+#include <ncore/sys/file_stream.h>
+#include <ncore/sys/proactor.h>
+#include <ncore/sys/file_stream_async_event_args.h>
+
+namespace
+{
+
+using namespace ncore;
+
+// 统计完成的写请求
+class WriteCounter
+{
+public:
+    WriteCounter() : completed(0)
+    {
+        adapter.Register(this, &WriteCounter::OnWriteCompleted);
+    }
+
+    void OnWriteCompleted(FileStreamAsyncContext & arg)
+    {
+        ++completed;
+    }
+
+    FileStreamAsyncResultAdapter<WriteCounter> adapter;
+    size_t completed;
+};
+
+}
+
+TEST(IOStatsTest, HistogramBuckets)
+{
+    IOHistogram histogram;
+    EXPECT_EQ(0, histogram.Percentile(99));
+
+    // 0、1、[2,4)、[4,8)各一个，[512,1024)一个
+    const uint64_t values[] = {0, 1, 3, 5, 1000};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+        histogram.Add(values[i]);
+
+    EXPECT_EQ(5, histogram.count);
+    EXPECT_EQ(1009, histogram.sum);
+    EXPECT_EQ(1000, histogram.max);
+    EXPECT_EQ(1, histogram.buckets[2]);
+    EXPECT_EQ(1, histogram.buckets[10]);
+
+    EXPECT_EQ(0, histogram.Percentile(0));
+    EXPECT_EQ(3, histogram.Percentile(50));
+    // 最高的桶以最大值为上界
+    EXPECT_EQ(1000, histogram.Percentile(100));
+}
+
+TEST(IOStatsTest, RecordsFileWrites)
+{
+    static const size_t kMaxRequests = 4;
+    static const size_t kBlockSize = 1024;
+
+    Proactor io;
+    ASSERT_TRUE(io.init());
+
+    FileStream fs;
+    ASSERT_TRUE(fs.init("io_stats",
+                        FileAccess::kReadWrite,
+                        FileShare::kExclusive,
+                        FileMode::kCreateAlways,
+                        FileAttribute::kNormal,
+                        FileOption::kDeleteOnClose));
+    ASSERT_TRUE(fs.Associate(io));
+
+    IOStats stats;
+    fs.set_stats(&stats);
+
+    WriteCounter counter;
+    char buffer[kBlockSize] = {0};
+    FileStreamAsyncContext args[kMaxRequests];
+    for (size_t index = 0; index < kMaxRequests; ++index)
+    {
+        args[index].SetBuffer(buffer, kBlockSize);
+        args[index].set_offset(static_cast<uint64_t>(index * kBlockSize));
+        args[index].set_completion_delegate(&counter.adapter);
+        ASSERT_TRUE(fs.WriteAsync(args[index]));
+    }
+
+    for (int loop = 0; loop < 100 && counter.completed < kMaxRequests; ++loop)
+        io.RunBatch(100, 16);
+    ASSERT_EQ(kMaxRequests, counter.completed);
+
+    // 按操作类型汇总
+    IOStatsSnapshot snapshot;
+    stats.Snapshot(snapshot);
+    const IOOpStats & writes = snapshot.ops[AsyncFileStreamOp::kAsyncWrite];
+    EXPECT_EQ(kMaxRequests, writes.queue_latency.count);
+    EXPECT_EQ(kMaxRequests, writes.handler_time.count);
+    EXPECT_EQ(kMaxRequests * kBlockSize, writes.bytes.sum);
+    EXPECT_EQ(kBlockSize, writes.bytes.max);
+    EXPECT_EQ(0, writes.errors);
+    EXPECT_EQ(0, snapshot.ops[AsyncFileStreamOp::kAsyncRead].bytes.count);
+
+    stats.Reset();
+    stats.Snapshot(snapshot);
+    EXPECT_EQ(0, snapshot.ops[AsyncFileStreamOp::kAsyncWrite].bytes.count);
+
+    fs.fini();
+    io.fini();
+}
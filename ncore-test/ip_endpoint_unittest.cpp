@@ -0,0 +1,158 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/ip_endpoint.h>
+
+using namespace ncore;
+
+// 解析后再格式化
+static std::string Format(const char * text)
+{
+    IPAddress address;
+    if (!IPAddress::Parse(text, address))
+        return "invalid";
+    return address.ToString();
+}
+
+TEST(IPAddressTest, IPv4)
+{
+    EXPECT_EQ("0.0.0.0", Format("0.0.0.0"));
+    EXPECT_EQ("127.0.0.1", Format("127.0.0.1"));
+    EXPECT_EQ("255.255.255.255", Format("255.255.255.255"));
+
+    IPAddress address;
+    ASSERT_TRUE(IPAddress::Parse("192.168.1.20", address));
+    EXPECT_EQ(AddressFamily::kInterNetwork, address.AddressFamily());
+    EXPECT_EQ(0xC0A80114, address.Address());
+
+    const char * invalid[] = {"", "1.2.3", "1.2.3.4.5", "256.1.1.1", "01.2.3.4",
+                              "1..2.3", "1.2.3.4 ", "a.b.c.d", "1.2.3.-4"};
+    for (size_t index = 0; index < sizeof(invalid) / sizeof(invalid[0]); ++index)
+        EXPECT_EQ("invalid", Format(invalid[index])) << invalid[index];
+}
+
+TEST(IPAddressTest, IPv6)
+{
+    EXPECT_EQ("::", Format("::"));
+    EXPECT_EQ("::1", Format("::1"));
+    EXPECT_EQ("::1", Format("0:0:0:0:0:0:0:1"));
+    EXPECT_EQ("2001:db8::1", Format("2001:DB8:0:0:0:0:0:1"));
+    EXPECT_EQ("2001:db8::", Format("2001:db8::"));
+    EXPECT_EQ("1:2:3:4:5:6:7:8", Format("1:2:3:4:5:6:7:8"));
+    // 只有一组0时不压缩，一样长时压缩前面的
+    EXPECT_EQ("1:0:2:3:4:5:6:7", Format("1:0:2:3:4:5:6:7"));
+    EXPECT_EQ("1::4:0:0:7:8", Format("1:0:0:4:0:0:7:8"));
+    EXPECT_EQ("1:0:0:4::8", Format("1:0:0:4:0:0:0:8"));
+    // 内嵌的IPv4
+    EXPECT_EQ("::ffff:10.0.0.1", Format("::ffff:10.0.0.1"));
+    EXPECT_EQ("::ffff:10.0.0.1", Format("0:0:0:0:0:ffff:a00:1"));
+    EXPECT_EQ("64:ff9b::a00:1", Format("64:ff9b::10.0.0.1"));
+    // 范围
+    EXPECT_EQ("fe80::1%2", Format("fe80::1%2"));
+
+    IPAddress address;
+    ASSERT_TRUE(IPAddress::Parse("fe80::1%7", address));
+    EXPECT_EQ(AddressFamily::kInterNetworkV6, address.AddressFamily());
+    EXPECT_EQ(7, address.ScopeId());
+
+    const char * invalid[] = {":", ":::", "1:2:3:4:5:6:7", "1:2:3:4:5:6:7:8:9",
+                              "1::2::3", "12345::", "1:2:3:4:5:6:7::8", "1:",
+                              "::1%", "g::", "::1.2.3", "1:2:3:4:5:6:7:1.2.3.4"};
+    for (size_t index = 0; index < sizeof(invalid) / sizeof(invalid[0]); ++index)
+        EXPECT_EQ("invalid", Format(invalid[index])) << invalid[index];
+}
+
+TEST(IPAddressTest, ToStringBuffer)
+{
+    IPAddress address;
+    ASSERT_TRUE(IPAddress::Parse("10.1.2.3", address));
+    char buffer[IPAddress::kMaxStringLength];
+    EXPECT_EQ(8, address.ToString(buffer, sizeof(buffer)));
+    EXPECT_STREQ("10.1.2.3", buffer);
+    // 缓冲区需要容纳结尾的0
+    EXPECT_EQ(0, address.ToString(buffer, 8));
+    EXPECT_EQ(8, address.ToString(buffer, 9));
+
+    ASSERT_TRUE(IPAddress::Parse("ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff%4294967295",
+                                 address));
+    EXPECT_EQ(50, address.ToString(buffer, sizeof(buffer)));
+}
+
+TEST(IPAddressTest, Compare)
+{
+    IPAddress a, b, c;
+    ASSERT_TRUE(IPAddress::Parse("::1", a));
+    ASSERT_TRUE(IPAddress::Parse("0::0:1", b));
+    ASSERT_TRUE(IPAddress::Parse("::1%1", c));
+    EXPECT_TRUE(a == b);
+    EXPECT_EQ(a.Hash(), b.Hash());
+    EXPECT_TRUE(a != c);
+    EXPECT_TRUE(a < c);
+    EXPECT_TRUE(IPAddress(IPAddress::kIPLoopback) < a);
+    EXPECT_TRUE(IPAddress(IPAddress::kIPLoopback) == IPAddress(0x7F000001));
+}
+
+TEST(IPEndPointTest, Parse)
+{
+    IPEndPoint ep;
+    ASSERT_TRUE(IPEndPoint::Parse("127.0.0.1:80", ep));
+    EXPECT_EQ(AddressFamily::kInterNetwork, ep.AddressFamily());
+    EXPECT_EQ(IPAddress::kIPLoopback, ep.Host().Address());
+    EXPECT_EQ(80, ep.Port());
+    EXPECT_EQ("127.0.0.1:80", ep.ToString());
+
+    ASSERT_TRUE(IPEndPoint::Parse("[::1]:443", ep));
+    EXPECT_EQ(AddressFamily::kInterNetworkV6, ep.AddressFamily());
+    EXPECT_EQ(443, ep.Port());
+    EXPECT_EQ("[::1]:443", ep.ToString());
+
+    ASSERT_TRUE(IPEndPoint::Parse("[fe80::a%3]:65535", ep));
+    EXPECT_EQ(3, ep.Host().ScopeId());
+    EXPECT_EQ("[fe80::a%3]:65535", ep.ToString());
+
+    // 省略端口
+    ASSERT_TRUE(IPEndPoint::Parse("::1", ep));
+    EXPECT_EQ(0, ep.Port());
+    ASSERT_TRUE(IPEndPoint::Parse("10.0.0.1", ep));
+    EXPECT_EQ("10.0.0.1:0", ep.ToString());
+
+    // 不需要以0结尾
+    const char text[] = "1.2.3.4:5678 trailing";
+    ASSERT_TRUE(IPEndPoint::Parse(text, 12, ep));
+    EXPECT_EQ("1.2.3.4:5678", ep.ToString());
+
+    const char * invalid[] = {"", "1.2.3.4:", "1.2.3.4:65536", "1.2.3.4:8x",
+                              "[::1", "[::1]80", "[::1]:", "[1.2.3.4]:80x",
+                              "::1:80:"};
+    for (size_t index = 0; index < sizeof(invalid) / sizeof(invalid[0]); ++index)
+        EXPECT_FALSE(IPEndPoint::Parse(invalid[index], ep)) << invalid[index];
+    // 失败时不修改
+    EXPECT_EQ("1.2.3.4:5678", ep.ToString());
+}
+
+TEST(IPEndPointTest, Key)
+{
+    IPEndPoint v4(IPAddress::kIPLoopback, 80);
+    IPEndPoint v4_other_port(IPAddress::kIPLoopback, 81);
+    IPEndPoint v6;
+    ASSERT_TRUE(IPEndPoint::Parse("[::1]:80", v6));
+
+    EXPECT_TRUE(v4 == IPEndPoint(IPAddress(IPAddress::kIPLoopback), 80));
+    EXPECT_TRUE(v4 != v4_other_port);
+    EXPECT_TRUE(v4 != v6);
+    EXPECT_TRUE(v4 < v4_other_port);
+    EXPECT_TRUE(v4 < v6);
+
+    std::unordered_map<IPEndPoint, int> table;
+    table[v4] = 1;
+    table[v4_other_port] = 2;
+    table[v6] = 3;
+    IPEndPoint parsed;
+    ASSERT_TRUE(IPEndPoint::Parse("127.0.0.1:81", parsed));
+    EXPECT_EQ(3, table.size());
+    EXPECT_EQ(2, table[parsed]);
+
+    std::set<IPEndPoint> sorted;
+    sorted.insert(v6);
+    sorted.insert(v4_other_port);
+    sorted.insert(v4);
+    EXPECT_TRUE(*sorted.begin() == v4);
+}
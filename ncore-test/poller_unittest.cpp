@@ -0,0 +1,139 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/poller.h>
+#include <ncore/sys/socket.h>
+#include "proactor_engine_test.h"
+
+using namespace ncore;
+
+class PollerTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+#if defined NCORE_WINDOWS
+        WORD wsaver = MAKEWORD(2, 2);
+        WSADATA wsadata = {0};
+        WSAStartup(wsaver, &wsadata);
+#endif
+    }
+
+    static void TearDownTestCase()
+    {
+#if defined NCORE_WINDOWS
+        WSACleanup();
+#endif
+    }
+};
+
+TEST_F(PollerTest, Readiness)
+{
+    Socket listener;
+    ASSERT_TRUE(listener.init(AddressFamily::kInterNetwork,
+                              SocketType::kStream,
+                              ProtocolType::kTCP));
+    IPEndPoint iep;
+    ASSERT_TRUE(BindAnyPort(listener, IPAddress::kIPLoopback, iep));
+    ASSERT_TRUE(listener.Listen(1));
+
+    Socket client;
+    ASSERT_TRUE(client.init(AddressFamily::kInterNetwork,
+                            SocketType::kStream,
+                            ProtocolType::kTCP));
+    ASSERT_TRUE(client.Connect(iep));
+    Socket server = listener.Accept();
+    ASSERT_TRUE(server.IsValid());
+
+    Poller poller;
+    PollResult results[4];
+    EXPECT_EQ(-1, poller.Wait(results, 4, 0));
+    ASSERT_TRUE(poller.init());
+
+    int server_token = 1;
+    int client_token = 2;
+    ASSERT_TRUE(poller.Add(server, PollEvent::kPollReadable,
+                           PollMode::kPollLevel, &server_token));
+    EXPECT_FALSE(poller.Add(server, PollEvent::kPollReadable,
+                            PollMode::kPollLevel, &server_token));
+    ASSERT_TRUE(poller.Add(client, PollEvent::kPollWritable,
+                           PollMode::kPollLevel, &client_token));
+    EXPECT_EQ(2, poller.size());
+
+    // 刚建立的连接可写，不可读
+    ASSERT_EQ(1, poller.Wait(results, 4, 100));
+    EXPECT_EQ(&client_token, results[0].token);
+    EXPECT_TRUE((results[0].events & PollEvent::kPollWritable) != 0);
+    EXPECT_TRUE(poller.Remove(client));
+    EXPECT_FALSE(poller.Remove(client));
+    EXPECT_EQ(0, poller.Wait(results, 4, 0));
+
+    // 水平触发：数据没有取走时每次都报告
+    uint32_t transfered = 0;
+    ASSERT_TRUE(client.Send("xy", 2, transfered));
+    for (int loop = 0; loop < 2; ++loop)
+    {
+        ASSERT_EQ(1, poller.Wait(results, 4, 1000));
+        EXPECT_EQ(&server_token, results[0].token);
+        EXPECT_EQ(PollEvent::kPollReadable, results[0].events);
+    }
+
+    // 单次触发：报告后停止关注，修改后重新启用
+    ASSERT_TRUE(poller.Modify(server, PollEvent::kPollReadable,
+                              PollMode::kPollOneShot, &server_token));
+    EXPECT_EQ(1, poller.Wait(results, 4, 0));
+    EXPECT_EQ(0, poller.Wait(results, 4, 0));
+    ASSERT_TRUE(poller.Modify(server, PollEvent::kPollReadable,
+                              PollMode::kPollOneShot, &server_token));
+    EXPECT_EQ(1, poller.Wait(results, 4, 0));
+
+#if defined NCORE_LINUX
+    // 边缘触发：只在新数据到达时报告
+    ASSERT_TRUE(poller.Modify(server, PollEvent::kPollReadable,
+                              PollMode::kPollEdge, &server_token));
+    EXPECT_EQ(1, poller.Wait(results, 4, 0));
+    EXPECT_EQ(0, poller.Wait(results, 4, 0));
+    ASSERT_TRUE(client.Send("z", 1, transfered));
+    EXPECT_EQ(1, poller.Wait(results, 4, 1000));
+    EXPECT_EQ(0, poller.Wait(results, 4, 0));
+#endif
+
+    // 对端关闭
+    char data[4];
+    ASSERT_TRUE(server.Receive(data, sizeof(data), transfered));
+    ASSERT_TRUE(poller.Modify(server, PollEvent::kPollReadable,
+                              PollMode::kPollLevel, &server_token));
+    client.fini();
+    ASSERT_EQ(1, poller.Wait(results, 4, 1000));
+    EXPECT_TRUE((results[0].events & PollEvent::kPollReadable) != 0);
+    EXPECT_TRUE((results[0].events & PollEvent::kPollHangup) != 0);
+
+    EXPECT_TRUE(poller.Remove(server));
+    EXPECT_EQ(0, poller.size());
+    poller.fini();
+    server.fini();
+    listener.fini();
+}
+
+#if defined NCORE_LINUX
+TEST_F(PollerTest, EventFd)
+{
+    Poller poller;
+    ASSERT_TRUE(poller.init());
+
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    ASSERT_NE(-1, fd);
+    ASSERT_TRUE(poller.Add(fd, PollEvent::kPollReadable,
+                           PollMode::kPollLevel, &fd));
+    PollResult result = {0};
+    EXPECT_EQ(0, poller.Wait(&result, 1, 0));
+
+    uint64_t value = 1;
+    ASSERT_EQ(sizeof(value), write(fd, &value, sizeof(value)));
+    ASSERT_EQ(1, poller.Wait(&result, 1, 1000));
+    EXPECT_EQ(&fd, result.token);
+    EXPECT_EQ(PollEvent::kPollReadable, result.events);
+
+    EXPECT_TRUE(poller.Remove(fd));
+    close(fd);
+    poller.fini();
+}
+#endif
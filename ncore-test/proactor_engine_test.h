@@ -0,0 +1,82 @@
+﻿#ifndef NCORE_TEST_PROACTOR_ENGINE_TEST_H_
+#define NCORE_TEST_PROACTOR_ENGINE_TEST_H_
+
+#include <gtest/gtest.h>
+#include <ncore/sys/proactor.h>
+#include <ncore/sys/socket.h>
+
+// 以测试参数指定的后端初始化前摄器，Windows上只有完成端口
+inline bool InitProactor(ncore::Proactor & proactor, int engine)
+{
+#if defined NCORE_LINUX
+    return proactor.init(static_cast<ncore::ProactorEngine::Value>(engine));
+#else
+    return engine == 0 && proactor.init();
+#endif
+}
+
+// 绑定到address上由系统分配的端口，通过endpoint返回实际地址；
+// 固定端口可能被其他连接的临时端口或者前一遍遗留的TIME_WAIT占用
+inline bool BindAnyPort(ncore::Socket & socket, const ncore::IPAddress & address,
+                        ncore::IPEndPoint & endpoint)
+{
+    return socket.Bind(ncore::IPEndPoint(address, 0)) &&
+           socket.LocalEndPoint(endpoint);
+}
+
+// 前摄器和套接字测试的基类，Linux上以epoll和io_uring各运行一遍，Windows上运行一遍
+class ProactorEngineTest : public ::testing::TestWithParam<int>
+{
+public:
+    //参数化测试由gtest在外部调用
+    static void SetUpTestCase()
+    {
+#if defined NCORE_WINDOWS
+        WORD wsaver = MAKEWORD(2, 2);
+        WSADATA wsadata = {0};
+        WSAStartup(wsaver, &wsadata);
+#endif
+    }
+
+    static void TearDownTestCase()
+    {
+#if defined NCORE_WINDOWS
+        WSACleanup();
+#endif
+    }
+
+protected:
+    // 后端不可用时返回true，测试直接返回；内核不支持io_uring时跳过，epoll或完成端口失败时报错
+    bool EngineUnavailable() const
+    {
+        ncore::Proactor proactor;
+        if (InitProactor(proactor, GetParam()))
+        {
+            proactor.fini();
+            return false;
+        }
+
+#if defined NCORE_LINUX
+        if (GetParam() == ncore::ProactorEngine::kIORing)
+        {
+            printf("io_uring is unavailable, skipped\n");
+            return true;
+        }
+#endif
+        ADD_FAILURE() << "Proactor::init failed";
+        return true;
+    }
+
+};
+
+#if defined NCORE_LINUX
+#define INSTANTIATE_PROACTOR_ENGINE_TEST(test_case_name) \
+    INSTANTIATE_TEST_CASE_P(Engines, test_case_name, \
+        ::testing::Values(static_cast<int>(ncore::ProactorEngine::kEpoll), \
+                          static_cast<int>(ncore::ProactorEngine::kIORing)))
+#else
+#define INSTANTIATE_PROACTOR_ENGINE_TEST(test_case_name) \
+    INSTANTIATE_TEST_CASE_P(Engines, test_case_name, ::testing::Values(0))
+#endif
+
+#endif
@@ -0,0 +1,516 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/base/atomic.h>
+#include <ncore/sys/thread.h>
+#include <ncore/sys/file_stream.h>
+#include <ncore/sys/proactor.h>
+#include <ncore/sys/proactor_group.h>
+#include <ncore/sys/file_stream_async_event_args.h>
+#include "proactor_engine_test.h"
+
+namespace
+{
+
+using namespace ncore;
+
+// 批量写入文件，统计完成的请求
+class BatchWriter
+{
+public:
+    static const size_t kMaxRequests = 16;
+    static const size_t kBlockSize = 4096;
+
+public:
+    BatchWriter();
+
+    bool init(int engine);
+    void fini();
+
+    bool StartWrite();
+#if defined NCORE_LINUX
+    // 把写入的缓冲区注册为固定缓冲区
+    bool RegisterBuffer();
+#endif
+    size_t completed() const;
+    size_t failed() const;
+
+    Proactor & proactor();
+
+private:
+    void OnWriteCompleted(FileStreamAsyncContext & arg);
+
+private:
+    Proactor proactor_;
+    FileStream fs_;
+    FileStreamAsyncResultAdapter<BatchWriter> adapter_;
+    FileStreamAsyncContext args_[kMaxRequests];
+    char buffer_[kBlockSize];
+    size_t completed_;
+    size_t failed_;
+};
+
+BatchWriter::BatchWriter()
+    : completed_(0), failed_(0)
+{
+    adapter_.Register(this, &BatchWriter::OnWriteCompleted);
+    memset(buffer_, 'n', sizeof(buffer_));
+}
+
+bool BatchWriter::init(int engine)
+{
+    if (!InitProactor(proactor_, engine)) return false;
+
+    if (!fs_.init("proactor_batch",
+                  FileAccess::kReadWrite,
+                  FileShare::kExclusive,
+                  FileMode::kCreateAlways,
+                  FileAttribute::kNormal,
+                  FileOption::kDeleteOnClose))
+        return false;
+
+    return fs_.Associate(proactor_);
+}
+
+void BatchWriter::fini()
+{
+    fs_.fini();
+    proactor_.fini();
+}
+
+bool BatchWriter::StartWrite()
+{
+    for (size_t index = 0; index < kMaxRequests; ++index)
+    {
+        FileStreamAsyncContext & arg = args_[index];
+        arg.SetBuffer(buffer_, kBlockSize);
+        arg.set_offset(static_cast<uint64_t>(index * kBlockSize));
+        arg.set_completion_delegate(&adapter_);
+        if (!fs_.WriteAsync(arg)) return false;
+    }
+    return true;
+}
+
+#if defined NCORE_LINUX
+bool BatchWriter::RegisterBuffer()
+{
+    return proactor_.RegisterBuffer(buffer_, sizeof(buffer_));
+}
+#endif
+
+size_t BatchWriter::completed() const
+{
+    return completed_;
+}
+
+size_t BatchWriter::failed() const
+{
+    return failed_;
+}
+
+Proactor & BatchWriter::proactor()
+{
+    return proactor_;
+}
+
+void BatchWriter::OnWriteCompleted(FileStreamAsyncContext & arg)
+{
+    ++completed_;
+    if (arg.error() || arg.transfered() != kBlockSize) ++failed_;
+}
+
+// 在线程组上写文件，回调发生在I/O线程上
+class GroupWriter
+{
+public:
+    GroupWriter();
+
+    void OnWriteCompleted(FileStreamAsyncContext & arg);
+
+    FileStreamAsyncResultAdapter<GroupWriter> adapter;
+    Atomic completed;
+};
+
+GroupWriter::GroupWriter()
+{
+    adapter.Register(this, &GroupWriter::OnWriteCompleted);
+}
+
+void GroupWriter::OnWriteCompleted(FileStreamAsyncContext & arg)
+{
+    ++completed;
+}
+
+// 投递到前摄器的任务，可以在另一个线程上等待执行
+class PostedTasks
+{
+public:
+    static const size_t kMaxTasks = 3;
+
+public:
+    PostedTasks(Proactor & io);
+
+    void Count();
+    void Wait();
+
+    Proactor & io;
+    AsyncTaskAdapter<PostedTasks> tasks[kMaxTasks];
+    ThreadProcAdapter<PostedTasks> wait_proc;
+    Atomic count;
+    size_t waited;
+};
+
+PostedTasks::PostedTasks(Proactor & proactor)
+    : io(proactor), waited(0)
+{
+    for (size_t i = 0; i < kMaxTasks; ++i)
+        tasks[i].Register(this, &PostedTasks::Count);
+    wait_proc.Register(this, &PostedTasks::Wait);
+}
+
+void PostedTasks::Count()
+{
+    ++count;
+}
+
+void PostedTasks::Wait()
+{
+    waited = io.RunBatch(5000, 64);
+}
+
+// 投递的任务中推迟另一个任务，检查推迟的任务在分发结束时执行
+class DeferredTasks
+{
+public:
+    DeferredTasks(Proactor & io);
+
+    void OnPosted();
+    void OnDeferred();
+
+    Proactor & io;
+    AsyncTaskAdapter<DeferredTasks> posted;
+    AsyncTaskAdapter<DeferredTasks> deferred;
+    bool deferred_ok;
+    int deferred_count;
+};
+
+DeferredTasks::DeferredTasks(Proactor & proactor)
+    : io(proactor), deferred_ok(false), deferred_count(0)
+{
+    posted.Register(this, &DeferredTasks::OnPosted);
+    deferred.Register(this, &DeferredTasks::OnDeferred);
+}
+
+void DeferredTasks::OnPosted()
+{
+    deferred_ok = io.Defer(deferred);
+}
+
+void DeferredTasks::OnDeferred()
+{
+    ++deferred_count;
+}
+
+// 定时器到期后重新启动自身，直到达到次数
+class RepeatingTimer
+{
+public:
+    static const int kMaxRepeats = 3;
+
+public:
+    RepeatingTimer(Proactor & io);
+
+    void OnExpired();
+
+    Proactor & io;
+    AsyncTimerAdapter<RepeatingTimer> timer;
+    int fired;
+};
+
+RepeatingTimer::RepeatingTimer(Proactor & proactor)
+    : io(proactor), fired(0)
+{
+    timer.Register(this, &RepeatingTimer::OnExpired);
+}
+
+void RepeatingTimer::OnExpired()
+{
+    if (++fired < kMaxRepeats)
+        io.SetTimer(timer, 10);
+}
+
+}
+
+class ProactorTest : public ProactorEngineTest
+{
+};
+
+TEST_P(ProactorTest, RunBatchTimeout)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    EXPECT_EQ(0, proactor.RunBatch(1, 8));
+    EXPECT_EQ(0, proactor.RunBatch(1, 0));
+
+    proactor.fini();
+}
+
+TEST_P(ProactorTest, RunBatchDrainsCompletions)
+{
+    if (EngineUnavailable())
+        return;
+
+    BatchWriter writer;
+    ASSERT_TRUE(writer.init(GetParam()));
+    ASSERT_TRUE(writer.StartWrite());
+
+    const size_t expected = BatchWriter::kMaxRequests;
+    size_t processed = 0;
+    for (int loop = 0; loop < 100; ++loop)
+    {
+        if (processed == expected) break;
+        processed += writer.proactor().RunBatch(100, 4);
+    }
+
+    EXPECT_EQ(expected, processed);
+    EXPECT_EQ(expected, writer.completed());
+    EXPECT_EQ(0, writer.failed());
+
+    writer.fini();
+}
+
+#if defined NCORE_LINUX
+// io_uring上以WRITE_FIXED写入已注册的缓冲区，epoll不支持注册
+TEST_P(ProactorTest, RegisteredBufferWrite)
+{
+    if (EngineUnavailable())
+        return;
+
+    BatchWriter writer;
+    ASSERT_TRUE(writer.init(GetParam()));
+    EXPECT_EQ(GetParam() == ProactorEngine::kIORing, writer.RegisterBuffer());
+    ASSERT_TRUE(writer.StartWrite());
+
+    const size_t expected = BatchWriter::kMaxRequests;
+    for (int loop = 0; loop < 100 && writer.completed() != expected; ++loop)
+        writer.proactor().RunBatch(100, 16);
+
+    EXPECT_EQ(expected, writer.completed());
+    EXPECT_EQ(0, writer.failed());
+
+    writer.fini();
+}
+#endif
+
+TEST(ProactorGroupTest, LeastLoadedAssociate)
+{
+    static const size_t kMaxStreams = 4;
+
+    ProactorGroup group;
+    ASSERT_TRUE(group.init(2, false, ProactorBalance::kLeastLoaded));
+    ASSERT_EQ(2, group.size());
+
+    FileStream streams[kMaxStreams];
+    for (size_t index = 0; index < kMaxStreams; ++index)
+    {
+        char name[32];
+        sprintf(name, "proactor_group_%d", static_cast<int>(index));
+        ASSERT_TRUE(streams[index].init(name,
+                                        FileAccess::kReadWrite,
+                                        FileShare::kExclusive,
+                                        FileMode::kCreateAlways,
+                                        FileAttribute::kNormal,
+                                        FileOption::kDeleteOnClose));
+        EXPECT_TRUE(group.Associate(streams[index]) != 0);
+    }
+
+    // 最少负载策略下两个线程各分到一半
+    ProactorWorkerStats stats;
+    for (size_t index = 0; index < group.size(); ++index)
+    {
+        ASSERT_TRUE(group.GetStats(index, stats));
+        EXPECT_EQ(2, stats.portals);
+    }
+    EXPECT_FALSE(group.GetStats(group.size(), stats));
+
+    GroupWriter writer;
+    char buffer[512] = {0};
+    FileStreamAsyncContext args[kMaxStreams];
+    for (size_t index = 0; index < kMaxStreams; ++index)
+    {
+        args[index].SetBuffer(buffer, sizeof(buffer));
+        args[index].set_completion_delegate(&writer.adapter);
+        EXPECT_TRUE(streams[index].WriteAsync(args[index]));
+    }
+
+    for (int loop = 0; loop < 100 && writer.completed != kMaxStreams; ++loop)
+        Thread::Sleep(10, false);
+    EXPECT_TRUE(writer.completed == static_cast<int>(kMaxStreams));
+
+    uint64_t completions = 0;
+    for (size_t index = 0; index < group.size(); ++index)
+    {
+        group.GetStats(index, stats);
+        completions += stats.completions;
+    }
+    EXPECT_EQ(kMaxStreams, completions);
+
+    for (size_t index = 0; index < kMaxStreams; ++index)
+        streams[index].fini();
+    group.fini();
+}
+
+TEST_P(ProactorTest, PostRunsBatchedTasks)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor io;
+    ASSERT_TRUE(InitProactor(io, GetParam()));
+
+    PostedTasks posted(io);
+    for (size_t i = 0; i < PostedTasks::kMaxTasks; ++i)
+        EXPECT_TRUE(io.Post(posted.tasks[i]));
+
+    // 三次投递只产生一次唤醒，一次取出全部任务
+    size_t expected = PostedTasks::kMaxTasks;
+    EXPECT_EQ(expected, io.RunBatch(1000, 64));
+    EXPECT_TRUE(posted.count == static_cast<int>(PostedTasks::kMaxTasks));
+    EXPECT_EQ(0, io.RunBatch(0, 64));
+
+    io.fini();
+}
+
+TEST_P(ProactorTest, DeferRunsAtBatchEnd)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor io;
+    ASSERT_TRUE(InitProactor(io, GetParam()));
+
+    // 不在分发中时不能推迟
+    DeferredTasks tasks(io);
+    EXPECT_FALSE(io.Defer(tasks.deferred));
+
+    EXPECT_TRUE(io.Post(tasks.posted));
+    EXPECT_EQ(1, io.RunBatch(1000, 64));
+    EXPECT_TRUE(tasks.deferred_ok);
+    EXPECT_EQ(1, tasks.deferred_count);
+
+    io.fini();
+}
+
+TEST_P(ProactorTest, PostWakesWaitingThread)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor io;
+    ASSERT_TRUE(InitProactor(io, GetParam()));
+
+    PostedTasks posted(io);
+    Thread waiter;
+    ASSERT_TRUE(waiter.init(posted.wait_proc));
+    ASSERT_TRUE(waiter.Start());
+
+    Thread::Sleep(50, false);
+    EXPECT_TRUE(io.Post(posted.tasks[0]));
+    waiter.Join();
+
+    // 等待在超时之前被唤醒
+    EXPECT_EQ(1, posted.waited);
+    EXPECT_TRUE(posted.count == 1);
+
+    io.fini();
+}
+
+TEST_P(ProactorTest, TimerRearmsItself)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor io;
+    ASSERT_TRUE(InitProactor(io, GetParam()));
+
+    RepeatingTimer repeating(io);
+    io.SetTimer(repeating.timer, 10);
+    EXPECT_TRUE(repeating.timer.armed());
+
+    // 无限等待也会在定时器到期时返回
+    for (int loop = 0; loop < 100 && repeating.fired < RepeatingTimer::kMaxRepeats; ++loop)
+        io.RunBatch(-1, 64);
+    int expected = RepeatingTimer::kMaxRepeats;
+    EXPECT_EQ(expected, repeating.fired);
+    EXPECT_FALSE(repeating.timer.armed());
+    EXPECT_FALSE(io.CancelTimer(repeating.timer));
+
+    io.SetTimer(repeating.timer, 10000);
+    EXPECT_TRUE(io.CancelTimer(repeating.timer));
+    EXPECT_EQ(0, io.RunBatch(0, 64));
+
+    io.fini();
+}
+
+TEST_P(ProactorTest, PostWithPendingTimer)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor io;
+    ASSERT_TRUE(InitProactor(io, GetParam()));
+
+    // 定时器未到期时每轮投递一次，一批中可能取到多个唤醒，投递的任务都要执行
+    RepeatingTimer repeating(io);
+    io.SetTimer(repeating.timer, 100000);
+
+    const int kRounds = 10;
+    PostedTasks posted(io);
+    for (int round = 0; round < kRounds; ++round)
+    {
+        EXPECT_TRUE(io.Post(posted.tasks[0]));
+        io.RunBatch(10, 64);
+    }
+    EXPECT_TRUE(posted.count == kRounds);
+
+    EXPECT_TRUE(io.CancelTimer(repeating.timer));
+    io.fini();
+}
+
+TEST_P(ProactorTest, HybridSpinThenBlock)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor io;
+    ASSERT_TRUE(InitProactor(io, GetParam()));
+
+    // 已有任务时在忙轮询中取到，不进入阻塞等待
+    PostedTasks posted(io);
+    io.SetSpinPolicy(1000, false);
+    EXPECT_TRUE(io.Post(posted.tasks[0]));
+    EXPECT_EQ(1, io.RunHybrid(100, 64));
+    ProactorSpinStats stats = io.spin_stats();
+    EXPECT_EQ(1, stats.spin_hits);
+    EXPECT_EQ(0, stats.blocking_waits);
+    EXPECT_EQ(1000, stats.spin_budget);
+
+    // 预算用完后阻塞等待到超时
+    EXPECT_EQ(0, io.RunHybrid(10, 64));
+    stats = io.spin_stats();
+    EXPECT_EQ(1, stats.blocking_waits);
+    EXPECT_TRUE(stats.spin_polls > 1);
+
+    // 到达间隔远大于上限时自适应地停止忙轮询
+    io.SetSpinPolicy(1000, true);
+    for (int loop = 0; loop < 4; ++loop)
+        EXPECT_EQ(0, io.RunHybrid(20, 64));
+    stats = io.spin_stats();
+    EXPECT_EQ(0, stats.spin_budget);
+
+    io.fini();
+}
+
+INSTANTIATE_PROACTOR_ENGINE_TEST(ProactorTest);
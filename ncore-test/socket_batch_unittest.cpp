@@ -0,0 +1,140 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/socket.h>
+#include <ncore/sys/socket_async_event_args.h>
+#include <ncore/sys/proactor.h>
+#include "proactor_engine_test.h"
+
+using namespace ncore;
+
+#if defined NCORE_LINUX
+
+class SocketBatchTest : public ProactorEngineTest
+{
+};
+
+class BatchCompletion
+{
+public:
+    BatchCompletion() : completed(0), error(0)
+    {
+        adapter.Register(this, &BatchCompletion::OnCompleted);
+    }
+
+    void OnCompleted(SocketAsyncContext & args)
+    {
+        error = args.error();
+        ++completed;
+    }
+
+    SocketAsyncResultAdapter<BatchCompletion> adapter;
+    size_t completed;
+    uint32_t error;
+};
+
+static const size_t kDatagrams = 4;
+static const uint32_t kDatagramSize = 1400;
+
+// 接收kDatagrams个数据报，逐个比较内容
+static void ExpectDatagrams(Socket & receiver, const char * payload)
+{
+    char recv_buffer[kDatagrams][kDatagramSize];
+    SocketDatagram in[kDatagrams];
+    for (size_t index = 0; index < kDatagrams; ++index)
+    {
+        in[index].data = recv_buffer[index];
+        in[index].size = kDatagramSize;
+    }
+
+    size_t received = 0;
+    while (received < kDatagrams)
+    {
+        size_t count = 0;
+        ASSERT_TRUE(receiver.ReceiveFromBatch(in + received, kDatagrams - received,
+                                              1000, count));
+        ASSERT_LT(0, count);
+        received += count;
+    }
+    for (size_t index = 0; index < kDatagrams; ++index)
+    {
+        EXPECT_EQ(kDatagramSize, in[index].transfered);
+        EXPECT_EQ(0, memcmp(payload + index * kDatagramSize, recv_buffer[index],
+                            kDatagramSize));
+    }
+}
+
+// 分段超过发送端的MTU，GSO以EMSGSIZE失败，同步和异步都改用sendmmsg发送
+TEST_P(SocketBatchTest, SegmentAboveMTU)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket receiver;
+    Socket sender;
+    ASSERT_TRUE(receiver.init(AddressFamily::kInterNetworkV6,
+                              SocketType::kDgram,
+                              ProtocolType::kUDP));
+
+    // Socket不提供套接字选项，发送端的描述符是当前最小的空闲描述符，以本地地址确认
+    int sender_fd = dup(0);
+    ASSERT_LE(0, sender_fd);
+    close(sender_fd);
+    ASSERT_TRUE(sender.init(AddressFamily::kInterNetworkV6,
+                            SocketType::kDgram,
+                            ProtocolType::kUDP));
+    IPEndPoint sender_ep;
+    ASSERT_TRUE(BindAnyPort(sender, IPAddress(in6addr_loopback), sender_ep));
+    sockaddr_in6 bound;
+    socklen_t bound_size = sizeof(bound);
+    ASSERT_EQ(0, getsockname(sender_fd, reinterpret_cast<sockaddr *>(&bound),
+                             &bound_size));
+    ASSERT_EQ(sender_ep.Port(), ntohs(bound.sin6_port));
+
+    IPEndPoint iep;
+    ASSERT_TRUE(BindAnyPort(receiver, IPAddress(in6addr_loopback), iep));
+    ASSERT_TRUE(sender.Associate(proactor));
+
+    // IPv6的最小MTU，每个分段加上报头超过它
+    int mtu = 1280;
+    ASSERT_EQ(0, setsockopt(sender_fd, IPPROTO_IPV6, IPV6_MTU, &mtu, sizeof(mtu)));
+
+    char payload[kDatagrams * kDatagramSize];
+    for (size_t index = 0; index < sizeof(payload); ++index)
+        payload[index] = static_cast<char>(index * 7);
+
+    SocketDatagram out[kDatagrams];
+    for (size_t index = 0; index < kDatagrams; ++index)
+    {
+        out[index].data = payload + index * kDatagramSize;
+        out[index].size = kDatagramSize;
+        out[index].endpoint = iep;
+    }
+
+    size_t sent = 0;
+    ASSERT_TRUE(sender.SendToBatch(out, kDatagrams, sent));
+    EXPECT_EQ(kDatagrams, sent);
+    ExpectDatagrams(receiver, payload);
+
+    BatchCompletion completion;
+    SocketBatchAsyncContext send_args;
+    ASSERT_TRUE(send_args.SetDatagrams(out, kDatagrams));
+    send_args.set_completion_delegate(&completion.adapter);
+    ASSERT_TRUE(sender.SendToBatchAsync(send_args));
+    for (int loop = 0; loop < 100 && completion.completed < 1; ++loop)
+        proactor.Run(10);
+
+    ASSERT_EQ(1, completion.completed);
+    EXPECT_EQ(0, completion.error);
+    EXPECT_EQ(kDatagrams, send_args.transfered());
+    ExpectDatagrams(receiver, payload);
+
+    sender.fini();
+    receiver.fini();
+    proactor.fini();
+}
+
+INSTANTIATE_PROACTOR_ENGINE_TEST(SocketBatchTest);
+
+#endif
@@ -0,0 +1,188 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/socket.h>
+#include <ncore/sys/socket_async_event_args.h>
+#include <ncore/sys/socket_buffer_pool.h>
+#include <ncore/sys/proactor.h>
+#include "proactor_engine_test.h"
+
+using namespace ncore;
+
+class SocketBufferPoolTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+#if defined NCORE_WINDOWS
+        WORD wsaver = MAKEWORD(2, 2);
+        WSADATA wsadata = {0};
+        WSAStartup(wsaver, &wsadata);
+#endif
+    }
+
+    static void TearDownTestCase()
+    {
+#if defined NCORE_WINDOWS
+        WSACleanup();
+#endif
+    }
+};
+
+// 收到数据后复制出来并归还缓冲区，对端关闭时停止
+class PooledReceiver
+{
+public:
+    PooledReceiver(Socket & socket, SocketBufferPool & pool)
+        : socket(socket), pool(pool), received(0), closed(false),
+          error(0), unreleased(0)
+    {
+        adapter.Register(this, &PooledReceiver::OnReceived);
+        args.set_completion_delegate(&adapter);
+    }
+
+    bool Start()
+    {
+        return socket.ReceivePooledAsync(args, pool);
+    }
+
+    void OnReceived(SocketAsyncContext & args)
+    {
+        if (args.error() || args.transfered() == 0)
+        {
+            error = args.error();
+            closed = true;
+            if (args.buffer())
+                ++unreleased;
+            return;
+        }
+
+        memcpy(data + received, args.buffer(), args.transfered());
+        received += args.transfered();
+        args.buffer_pool()->Release(args.buffer());
+        if (!Start())
+            closed = true;
+    }
+
+    Socket & socket;
+    SocketBufferPool & pool;
+    SocketAsyncContext args;
+    SocketAsyncResultAdapter<PooledReceiver> adapter;
+    char data[1024];
+    size_t received;
+    bool closed;
+    uint32_t error;
+    size_t unreleased;
+};
+
+TEST_F(SocketBufferPoolTest, AcquireRelease)
+{
+    SocketBufferPool pool;
+    EXPECT_FALSE(pool.init(0, 4));
+    EXPECT_FALSE(pool.init(1024, 0));
+    ASSERT_TRUE(pool.init(1024, 4));
+    EXPECT_FALSE(pool.init(1024, 4));
+    EXPECT_EQ(1024, pool.buffer_size());
+    EXPECT_EQ(4, pool.count());
+    EXPECT_EQ(4, pool.available());
+
+    void * buffers[4];
+    for (size_t index = 0; index < 4; ++index)
+    {
+        buffers[index] = pool.Acquire();
+        ASSERT_TRUE(buffers[index] != 0);
+        for (size_t prev = 0; prev < index; ++prev)
+            EXPECT_NE(buffers[prev], buffers[index]);
+    }
+    EXPECT_TRUE(pool.Acquire() == 0);
+    EXPECT_EQ(0, pool.available());
+
+    pool.Release(buffers[2]);
+    EXPECT_EQ(1, pool.available());
+    EXPECT_EQ(buffers[2], pool.Acquire());
+
+    for (size_t index = 0; index < 4; ++index)
+        pool.Release(buffers[index]);
+    EXPECT_EQ(4, pool.available());
+    pool.fini();
+}
+
+class SocketBufferPoolAsyncTest : public ProactorEngineTest
+{
+};
+
+TEST_P(SocketBufferPoolAsyncTest, PooledReceive)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    SocketBufferPool pool;
+    ASSERT_TRUE(pool.init(64, 2));
+#if defined NCORE_LINUX
+    // io_uring引擎下由内核选取缓冲区，不支持时仍然以就绪后取缓冲区的方式工作
+    bool registered = proactor.RegisterBufferPool(pool);
+#endif
+
+    Socket listener;
+    ASSERT_TRUE(listener.init(AddressFamily::kInterNetwork,
+                              SocketType::kStream,
+                              ProtocolType::kTCP));
+    IPEndPoint iep;
+    ASSERT_TRUE(BindAnyPort(listener, IPAddress::kIPLoopback, iep));
+    ASSERT_TRUE(listener.Listen(1));
+
+    Socket client;
+    ASSERT_TRUE(client.init(AddressFamily::kInterNetwork,
+                            SocketType::kStream,
+                            ProtocolType::kTCP));
+    ASSERT_TRUE(client.Connect(iep));
+    Socket server = listener.Accept();
+    ASSERT_TRUE(server.IsValid());
+    ASSERT_TRUE(server.Associate(proactor));
+
+    // 等待中的接收不占用缓冲区
+    PooledReceiver receiver(server, pool);
+    ASSERT_TRUE(receiver.Start());
+    for (int loop = 0; loop < 5; ++loop)
+        proactor.Run(10);
+    EXPECT_EQ(2, pool.available());
+    EXPECT_EQ(0, receiver.received);
+
+    char data[200];
+    for (size_t index = 0; index < sizeof(data); ++index)
+        data[index] = static_cast<char>(index);
+
+    uint32_t transfered = 0;
+    ASSERT_TRUE(client.Send(data, sizeof(data), transfered));
+    EXPECT_EQ(sizeof(data), transfered);
+    for (int loop = 0; loop < 100 && receiver.received < sizeof(data); ++loop)
+        proactor.Run(10);
+
+    ASSERT_EQ(sizeof(data), receiver.received);
+    EXPECT_EQ(0, memcmp(data, receiver.data, sizeof(data)));
+    EXPECT_EQ(2, pool.available());
+
+    // 对端关闭时以0字节完成，不带缓冲区
+    client.fini();
+    for (int loop = 0; loop < 100 && !receiver.closed; ++loop)
+        proactor.Run(10);
+    EXPECT_TRUE(receiver.closed);
+    EXPECT_EQ(0, receiver.error);
+    EXPECT_EQ(0, receiver.unreleased);
+    EXPECT_EQ(2, pool.available());
+
+#if defined NCORE_LINUX
+    if (registered)
+    {
+        EXPECT_TRUE(proactor.UnregisterBufferPool(pool));
+    }
+#endif
+    EXPECT_EQ(2, pool.available());
+    server.fini();
+    listener.fini();
+    pool.fini();
+    proactor.fini();
+}
+
+INSTANTIATE_PROACTOR_ENGINE_TEST(SocketBufferPoolAsyncTest);
@@ -0,0 +1,200 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/socket.h>
+#include <ncore/sys/socket_listener.h>
+#include <ncore/sys/proactor_group.h>
+#include <ncore/sys/spin_lock.h>
+#include <ncore/sys/thread.h>
+#include "proactor_engine_test.h"
+#if defined NCORE_LINUX
+#include <sys/resource.h>
+#endif
+
+using namespace ncore;
+
+class SocketListenerTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+#if defined NCORE_WINDOWS
+        WORD wsaver = MAKEWORD(2, 2);
+        WSADATA wsadata = {0};
+        WSAStartup(wsaver, &wsadata);
+#endif
+    }
+
+    static void TearDownTestCase()
+    {
+#if defined NCORE_WINDOWS
+        WSACleanup();
+#endif
+    }
+
+    // SocketListener不接受端口0，先由系统分配一个空闲的端口
+    static bool ReservePort(IPEndPoint & endpoint)
+    {
+        Socket reserved;
+        if (!reserved.init(AddressFamily::kInterNetwork,
+                           SocketType::kStream,
+                           ProtocolType::kTCP))
+            return false;
+        return BindAnyPort(reserved, IPAddress::kIPLoopback, endpoint);
+    }
+};
+
+// 取走接受到的连接
+class AcceptCollector
+{
+public:
+    AcceptCollector()
+        : invalid(0), errors(0)
+    {
+        adapter.Register(this, &AcceptCollector::OnAccepted);
+        count = 0;
+    }
+
+    // 在前摄器停止之前关闭
+    void Clear()
+    {
+        for (size_t index = 0; index < sockets.size(); ++index)
+            delete sockets[index];
+        sockets.clear();
+    }
+
+    void OnAccepted(SocketAcceptContext & context)
+    {
+        if (context.error())
+        {
+            ++errors;
+            return;
+        }
+
+        Socket * socket = new Socket(std::move(context.accepted_socket()));
+        lock.Acquire();
+        if (!socket->IsValid())
+            ++invalid;
+        sockets.push_back(socket);
+        lock.Release();
+        ++count;
+    }
+
+    SocketAcceptResultAdapter<AcceptCollector> adapter;
+    SpinLock lock;
+    std::vector<Socket *> sockets;
+    Atomic count;
+    size_t invalid;
+    size_t errors;
+};
+
+TEST_F(SocketListenerTest, ShardedAccept)
+{
+    ProactorGroup group;
+    ASSERT_TRUE(group.init(2, false, ProactorBalance::kRoundRobin));
+
+    IPEndPoint iep;
+    ASSERT_TRUE(ReservePort(iep));
+    SocketListener listener;
+    EXPECT_FALSE(listener.Start());
+    ASSERT_TRUE(listener.init(group, iep, 4));
+    EXPECT_EQ(2, listener.shard_count());
+
+    AcceptCollector collector;
+    listener.set_completion_delegate(&collector.adapter);
+    ASSERT_TRUE(listener.Start());
+    EXPECT_FALSE(listener.Start());
+
+    // 连接数多于预先投递的请求数，回调后自动补充
+    const size_t kClients = 20;
+    Socket clients[kClients];
+    for (size_t index = 0; index < kClients; ++index)
+    {
+        ASSERT_TRUE(clients[index].init(AddressFamily::kInterNetwork,
+                                        SocketType::kStream,
+                                        ProtocolType::kTCP));
+        ASSERT_TRUE(clients[index].Connect(iep));
+    }
+
+    for (int loop = 0; loop < 200 && collector.count != kClients; ++loop)
+        Thread::Sleep(10, false);
+    EXPECT_EQ(kClients, static_cast<size_t>(static_cast<int>(collector.count)));
+    EXPECT_EQ(0, collector.invalid);
+    EXPECT_EQ(0, collector.errors);
+    EXPECT_EQ(kClients, listener.accepted(0) + listener.accepted(1));
+
+    // 接受到的连接可以直接收发
+    for (size_t index = 0; index < kClients; ++index)
+    {
+        uint32_t transfered = 0;
+        EXPECT_TRUE(clients[index].Send("x", 1, transfered));
+    }
+    collector.lock.Acquire();
+    for (size_t index = 0; index < collector.sockets.size(); ++index)
+    {
+        char data = 0;
+        uint32_t transfered = 0;
+        EXPECT_TRUE(collector.sockets[index]->Receive(&data, 1, transfered));
+        EXPECT_EQ('x', data);
+    }
+    collector.lock.Release();
+
+    listener.fini();
+    EXPECT_EQ(0, collector.errors);
+    collector.Clear();
+    for (size_t index = 0; index < kClients; ++index)
+        clients[index].fini();
+    group.fini();
+}
+
+#if defined NCORE_LINUX
+// 文件描述符耗尽时accept以EMFILE失败，推迟再次投递而不是在I/O线程上空转
+TEST_F(SocketListenerTest, BackoffOnExhaustion)
+{
+    ProactorGroup group;
+    ASSERT_TRUE(group.init(1, false, ProactorBalance::kRoundRobin));
+
+    IPEndPoint iep;
+    ASSERT_TRUE(ReservePort(iep));
+    SocketListener listener;
+    ASSERT_TRUE(listener.init(group, iep, 1));
+
+    AcceptCollector collector;
+    listener.set_completion_delegate(&collector.adapter);
+    ASSERT_TRUE(listener.Start());
+
+    Socket client;
+    ASSERT_TRUE(client.init(AddressFamily::kInterNetwork,
+                            SocketType::kStream,
+                            ProtocolType::kTCP));
+
+    // 把上限降到当前最小的空闲描述符，之后不能再打开新的描述符
+    rlimit saved;
+    ASSERT_EQ(0, getrlimit(RLIMIT_NOFILE, &saved));
+    int lowest = dup(0);
+    ASSERT_LE(0, lowest);
+    close(lowest);
+    rlimit limited = saved;
+    limited.rlim_cur = static_cast<rlim_t>(lowest);
+    ASSERT_EQ(0, setrlimit(RLIMIT_NOFILE, &limited));
+
+    bool connected = client.Connect(iep);
+    Thread::Sleep(200, false);
+    size_t errors = collector.errors;
+    ASSERT_EQ(0, setrlimit(RLIMIT_NOFILE, &saved));
+    ASSERT_TRUE(connected);
+
+    // 每次推迟kAcceptBackoff毫秒，200毫秒内只重试几次
+    EXPECT_LE(1, errors);
+    EXPECT_GE(200 / SocketListener::kAcceptBackoff + 2, errors);
+
+    // 恢复之后下一次投递接受到这个连接
+    for (int loop = 0; loop < 100 && collector.count != 1; ++loop)
+        Thread::Sleep(10, false);
+    EXPECT_EQ(1, static_cast<int>(collector.count));
+    EXPECT_EQ(0, collector.invalid);
+
+    listener.fini();
+    collector.Clear();
+    client.fini();
+    group.fini();
+}
+#endif
@@ -0,0 +1,336 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/proactor.h>
+#include <ncore/sys/socket.h>
+#include <ncore/sys/socket_pool.h>
+#include <ncore/sys/thread.h>
+#include "proactor_engine_test.h"
+
+using namespace ncore;
+
+class SocketPoolTest : public ProactorEngineTest
+{
+};
+
+// 记录请求的回调
+class CheckoutWaiter
+{
+public:
+    CheckoutWaiter()
+        : completed(0), connection(0), error(0)
+    {
+        adapter.Register(this, &CheckoutWaiter::OnCompleted);
+        request.set_completion_delegate(&adapter);
+    }
+
+    void OnCompleted(SocketPoolRequest & r)
+    {
+        ++completed;
+        connection = r.connection();
+        error = r.error();
+    }
+
+    bool Wait(Proactor & proactor, size_t count)
+    {
+        for (int loop = 0; loop < 200 && completed < count; ++loop)
+            proactor.Run(10);
+        return completed == count;
+    }
+
+    SocketPoolRequest request;
+    SocketPoolResultAdapter<CheckoutWaiter> adapter;
+    size_t completed;
+    PooledSocket * connection;
+    uint32_t error;
+};
+
+// 回调中立即放回取得的连接
+class ReleasingWaiter
+{
+public:
+    explicit ReleasingWaiter(SocketPool & p)
+        : pool(p), completed(0), error(0)
+    {
+        adapter.Register(this, &ReleasingWaiter::OnCompleted);
+        request.set_completion_delegate(&adapter);
+    }
+
+    void OnCompleted(SocketPoolRequest & r)
+    {
+        ++completed;
+        error = r.error();
+        if (r.connection())
+            pool.Release(r.connection(), true);
+    }
+
+    SocketPool & pool;
+    SocketPoolRequest request;
+    SocketPoolResultAdapter<ReleasingWaiter> adapter;
+    size_t completed;
+    uint32_t error;
+};
+
+TEST_P(SocketPoolTest, CheckoutAndReuse)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket listener;
+    ASSERT_TRUE(listener.init(AddressFamily::kInterNetwork,
+                              SocketType::kStream,
+                              ProtocolType::kTCP));
+    IPEndPoint iep;
+    ASSERT_TRUE(BindAnyPort(listener, IPAddress::kIPLoopback, iep));
+    ASSERT_TRUE(listener.Listen(4));
+
+    SocketPool pool;
+    CheckoutWaiter first;
+    EXPECT_FALSE(pool.CheckoutAsync(first.request, iep));
+    ASSERT_TRUE(pool.init(proactor, 1, 0));
+
+    // 没有空闲连接时新建连接
+    ASSERT_TRUE(pool.CheckoutAsync(first.request, iep));
+    ASSERT_TRUE(first.Wait(proactor, 1));
+    EXPECT_EQ(0, first.error);
+    ASSERT_TRUE(first.connection != 0);
+    EXPECT_FALSE(first.connection->reused());
+    Socket peer = listener.Accept();
+    ASSERT_TRUE(peer.IsValid());
+    EXPECT_EQ(1, pool.connection_count());
+
+    // 达到上限时排队，放回的连接直接交给等待的请求
+    CheckoutWaiter second;
+    ASSERT_TRUE(pool.CheckoutAsync(second.request, iep));
+    for (int loop = 0; loop < 5; ++loop)
+        proactor.Run(10);
+    EXPECT_EQ(0, second.completed);
+    EXPECT_EQ(1, pool.connection_count());
+
+    pool.Release(first.connection, true);
+    ASSERT_TRUE(second.Wait(proactor, 1));
+    EXPECT_EQ(0, second.error);
+    EXPECT_EQ(first.connection, second.connection);
+    EXPECT_TRUE(second.connection->reused());
+
+    // 复用的连接可以直接收发
+    uint32_t transfered = 0;
+    EXPECT_TRUE(second.connection->socket().Send("x", 1, transfered));
+    char data = 0;
+    EXPECT_TRUE(peer.Receive(&data, 1, transfered));
+    EXPECT_EQ('x', data);
+
+    pool.Release(second.connection, true);
+    EXPECT_EQ(1, pool.idle_count());
+
+    // 对端发来不属于任何请求的数据，空闲连接可读，取出时丢弃并新建连接
+    EXPECT_TRUE(peer.Send("y", 1, transfered));
+    Thread::Sleep(50, false);
+    CheckoutWaiter third;
+    ASSERT_TRUE(pool.CheckoutAsync(third.request, iep));
+    ASSERT_TRUE(third.Wait(proactor, 1));
+    EXPECT_EQ(0, third.error);
+    ASSERT_TRUE(third.connection != 0);
+    EXPECT_FALSE(third.connection->reused());
+    EXPECT_EQ(1, pool.connection_count());
+    Socket peer2 = listener.Accept();
+    EXPECT_TRUE(peer2.IsValid());
+
+    // 不能继续使用的连接被关闭
+    pool.Release(third.connection, false);
+    EXPECT_EQ(0, pool.idle_count());
+    EXPECT_EQ(0, pool.connection_count());
+
+    pool.fini();
+    EXPECT_FALSE(pool.CheckoutAsync(first.request, iep));
+    peer.fini();
+    peer2.fini();
+    listener.fini();
+    proactor.fini();
+}
+
+TEST_P(SocketPoolTest, FiniWithoutRunner)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket listener;
+    ASSERT_TRUE(listener.init(AddressFamily::kInterNetwork,
+                              SocketType::kStream,
+                              ProtocolType::kTCP));
+    IPEndPoint iep;
+    ASSERT_TRUE(BindAnyPort(listener, IPAddress::kIPLoopback, iep));
+    ASSERT_TRUE(listener.Listen(4));
+
+    // 一个正在建立的连接和一个排队的请求，之后没有任何线程执行前摄器
+    SocketPool pool;
+    ASSERT_TRUE(pool.init(proactor, 1, 0));
+    ReleasingWaiter dialing(pool);
+    CheckoutWaiter queued;
+    ASSERT_TRUE(pool.CheckoutAsync(dialing.request, iep));
+    ASSERT_TRUE(pool.CheckoutAsync(queued.request, iep));
+    EXPECT_EQ(0, dialing.completed);
+    EXPECT_EQ(0, queued.completed);
+
+    // fini自己完成这两个请求，不会一直等待
+    pool.fini();
+    EXPECT_EQ(1, dialing.completed);
+    EXPECT_EQ(0, dialing.error);
+    EXPECT_EQ(1, queued.completed);
+    EXPECT_TRUE(queued.connection == 0);
+    EXPECT_NE(0, queued.error);
+
+    listener.fini();
+    proactor.fini();
+}
+
+TEST_P(SocketPoolTest, IdleTimeout)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket listener;
+    ASSERT_TRUE(listener.init(AddressFamily::kInterNetwork,
+                              SocketType::kStream,
+                              ProtocolType::kTCP));
+    IPEndPoint iep;
+    ASSERT_TRUE(BindAnyPort(listener, IPAddress::kIPLoopback, iep));
+    ASSERT_TRUE(listener.Listen(4));
+
+    SocketPool pool;
+    ASSERT_TRUE(pool.init(proactor, 2, 50));
+
+    CheckoutWaiter waiters[2];
+    for (size_t index = 0; index < 2; ++index)
+        ASSERT_TRUE(pool.CheckoutAsync(waiters[index].request, iep));
+    for (size_t index = 0; index < 2; ++index)
+    {
+        ASSERT_TRUE(waiters[index].Wait(proactor, 1));
+        EXPECT_EQ(0, waiters[index].error);
+        ASSERT_TRUE(waiters[index].connection != 0);
+    }
+    EXPECT_NE(waiters[0].connection, waiters[1].connection);
+    EXPECT_EQ(2, pool.connection_count());
+
+    for (size_t index = 0; index < 2; ++index)
+        pool.Release(waiters[index].connection, true);
+    EXPECT_EQ(2, pool.idle_count());
+
+    // 定时器关闭空闲超时的连接
+    for (int loop = 0; loop < 100 && pool.idle_count() != 0; ++loop)
+        proactor.Run(10);
+    EXPECT_EQ(0, pool.idle_count());
+    EXPECT_EQ(0, pool.connection_count());
+
+    pool.fini();
+    listener.fini();
+    proactor.fini();
+}
+
+// 在自己的线程上反复执行Evict，直到停止
+class EvictRacer
+{
+public:
+    explicit EvictRacer(SocketPool & pool)
+        : pool_(pool)
+    {
+        proc_.Register(this, &EvictRacer::Run);
+        evicted = 0;
+        stopping = 0;
+    }
+
+    bool Start()
+    {
+        return thread_.init(proc_) && thread_.Start();
+    }
+
+    void Stop()
+    {
+        stopping = 1;
+        thread_.Join();
+        thread_.fini();
+    }
+
+    void Run()
+    {
+        while (stopping == 0)
+            evicted += static_cast<int>(pool_.Evict());
+    }
+
+    Atomic evicted;
+    Atomic stopping;
+
+private:
+    SocketPool & pool_;
+    Thread thread_;
+    ThreadProcAdapter<EvictRacer> proc_;
+};
+
+// 连接数上限为1，唯一的连接空闲超时后Evict与取连接同时进行，
+// Evict让出的名额要交给排队的请求，否则请求一直等待
+TEST_P(SocketPoolTest, EvictRacesCheckout)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket listener;
+    ASSERT_TRUE(listener.init(AddressFamily::kInterNetwork,
+                              SocketType::kStream,
+                              ProtocolType::kTCP));
+    IPEndPoint iep;
+    ASSERT_TRUE(BindAnyPort(listener, IPAddress::kIPLoopback, iep));
+    ASSERT_TRUE(listener.Listen(16));
+
+    SocketPool pool;
+    ASSERT_TRUE(pool.init(proactor, 1, 1));
+    EvictRacer racer(pool);
+    ASSERT_TRUE(racer.Start());
+
+    std::vector<Socket *> peers;
+    for (int round = 0; round < 20; ++round)
+    {
+        CheckoutWaiter waiter;
+        ASSERT_TRUE(pool.CheckoutAsync(waiter.request, iep));
+        if (!waiter.Wait(proactor, 1))
+        {
+            // 名额丢失，请求永远等待；先停止前摄器，fini中取消的请求直接回调
+            ADD_FAILURE() << "checkout is stuck in round " << round;
+            racer.Stop();
+            proactor.fini();
+            return;
+        }
+        EXPECT_EQ(0, waiter.error);
+        ASSERT_TRUE(waiter.connection != 0);
+
+        // 新建的连接由对端接受，等客户端关闭之后再关闭，避免监听的端口处于TIME_WAIT
+        if (!waiter.connection->reused())
+        {
+            peers.push_back(new Socket(listener.Accept()));
+            EXPECT_TRUE(peers.back()->IsValid());
+        }
+        pool.Release(waiter.connection, true);
+
+        // 等到空闲超时，下一轮取连接时与Evict争夺这个连接
+        Thread::Sleep(2, false);
+    }
+
+    racer.Stop();
+    EXPECT_LT(0, static_cast<int>(racer.evicted));
+    pool.fini();
+    for (size_t index = 0; index < peers.size(); ++index)
+        delete peers[index];
+    listener.fini();
+    proactor.fini();
+}
+
+INSTANTIATE_PROACTOR_ENGINE_TEST(SocketPoolTest);
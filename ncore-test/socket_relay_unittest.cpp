@@ -0,0 +1,189 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/socket.h>
+#include <ncore/sys/socket_relay.h>
+#include <ncore/sys/proactor.h>
+#include "proactor_engine_test.h"
+
+using namespace ncore;
+
+class SocketRelayTest : public ProactorEngineTest
+{
+};
+
+class RelayCounter
+{
+public:
+    RelayCounter() : completed(0)
+    {
+        adapter.Register(this, &RelayCounter::OnCompleted);
+    }
+
+    void OnCompleted(SocketRelay & relay)
+    {
+        ++completed;
+    }
+
+    SocketRelayResultAdapter<RelayCounter> adapter;
+    size_t completed;
+};
+
+// 连接到listener，返回服务端一侧的套接字，失败时无效
+static Socket MakePair(Socket & listener, const IPEndPoint & iep, Socket & client)
+{
+    if (!client.init(AddressFamily::kInterNetwork,
+                     SocketType::kStream,
+                     ProtocolType::kTCP) ||
+        !client.Connect(iep))
+        return Socket();
+
+    return listener.Accept();
+}
+
+static bool ReceiveAll(Socket & socket, char * data, uint32_t size)
+{
+    uint32_t received = 0;
+    while (received < size)
+    {
+        uint32_t transfered = 0;
+        if (!socket.Receive(data + received, size - received, transfered) ||
+            transfered == 0)
+            return false;
+        received += transfered;
+    }
+    return true;
+}
+
+// 两个方向各转发一次，缓冲区小于数据量以覆盖多轮读入和写出
+TEST_P(SocketRelayTest, TCPRelay)
+{
+    static const uint32_t kDataSize = 32768;
+
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket listener;
+    ASSERT_TRUE(listener.init(AddressFamily::kInterNetwork,
+                              SocketType::kStream,
+                              ProtocolType::kTCP));
+    IPEndPoint iep;
+    ASSERT_TRUE(BindAnyPort(listener, IPAddress::kIPLoopback, iep));
+    ASSERT_TRUE(listener.Listen(2));
+
+    Socket first_client;
+    Socket second_client;
+    Socket first = MakePair(listener, iep, first_client);
+    Socket second = MakePair(listener, iep, second_client);
+    ASSERT_TRUE(first.IsValid());
+    ASSERT_TRUE(second.IsValid());
+    ASSERT_TRUE(first.Associate(proactor));
+    ASSERT_TRUE(second.Associate(proactor));
+
+    std::vector<char> forward(kDataSize);
+    std::vector<char> backward(kDataSize);
+    for (uint32_t index = 0; index < kDataSize; ++index)
+    {
+        forward[index] = static_cast<char>(index);
+        backward[index] = static_cast<char>(index * 7);
+    }
+
+    RelayCounter counter;
+    SocketRelay relay;
+    ASSERT_TRUE(relay.init(first, second, 4096));
+    relay.set_completion_delegate(&counter.adapter);
+    ASSERT_TRUE(relay.Start());
+    EXPECT_TRUE(relay.is_running());
+    EXPECT_FALSE(relay.Start());
+
+    // first一侧写完后半关闭，second一侧仍然可以发送
+    uint32_t sent = 0;
+    ASSERT_TRUE(first_client.Send(&forward[0], kDataSize, sent));
+    ASSERT_TRUE(first_client.Shutdown(SocketShutdown::kSend));
+    for (int loop = 0; loop < 100 && relay.first_to_second() < kDataSize; ++loop)
+        proactor.Run(50);
+    EXPECT_EQ(kDataSize, relay.first_to_second());
+    EXPECT_EQ(0, counter.completed);
+
+    ASSERT_TRUE(second_client.Send(&backward[0], kDataSize, sent));
+    ASSERT_TRUE(second_client.Shutdown(SocketShutdown::kSend));
+    for (int loop = 0; loop < 100 && counter.completed == 0; ++loop)
+        proactor.Run(50);
+    ASSERT_EQ(1, counter.completed);
+    EXPECT_FALSE(relay.is_running());
+    EXPECT_EQ(0, relay.error());
+    EXPECT_EQ(kDataSize, relay.second_to_first());
+
+    // 数据原样到达，之后读到结束
+    std::vector<char> echo(kDataSize);
+    ASSERT_TRUE(ReceiveAll(second_client, &echo[0], kDataSize));
+    EXPECT_TRUE(echo == forward);
+    ASSERT_TRUE(ReceiveAll(first_client, &echo[0], kDataSize));
+    EXPECT_TRUE(echo == backward);
+
+    uint32_t transfered = 0;
+    EXPECT_TRUE(first_client.Receive(&echo[0], kDataSize, transfered));
+    EXPECT_EQ(0, transfered);
+    EXPECT_TRUE(second_client.Receive(&echo[0], kDataSize, transfered));
+    EXPECT_EQ(0, transfered);
+
+    relay.fini();
+    first_client.fini();
+    second_client.fini();
+    first.fini();
+    second.fini();
+    listener.fini();
+    proactor.fini();
+}
+
+// Stop取消两端的请求，转发以错误结束
+TEST_P(SocketRelayTest, Stop)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket listener;
+    ASSERT_TRUE(listener.init(AddressFamily::kInterNetwork,
+                              SocketType::kStream,
+                              ProtocolType::kTCP));
+    IPEndPoint iep;
+    ASSERT_TRUE(BindAnyPort(listener, IPAddress::kIPLoopback, iep));
+    ASSERT_TRUE(listener.Listen(2));
+
+    Socket first_client;
+    Socket second_client;
+    Socket first = MakePair(listener, iep, first_client);
+    Socket second = MakePair(listener, iep, second_client);
+    ASSERT_TRUE(first.IsValid());
+    ASSERT_TRUE(second.IsValid());
+    ASSERT_TRUE(first.Associate(proactor));
+    ASSERT_TRUE(second.Associate(proactor));
+
+    RelayCounter counter;
+    SocketRelay relay;
+    ASSERT_TRUE(relay.init(first, second));
+    relay.set_completion_delegate(&counter.adapter);
+    ASSERT_TRUE(relay.Start());
+
+    relay.Stop();
+    for (int loop = 0; loop < 100 && counter.completed == 0; ++loop)
+        proactor.Run(50);
+    ASSERT_EQ(1, counter.completed);
+    EXPECT_NE(0, relay.error());
+    EXPECT_EQ(0, relay.first_to_second());
+    EXPECT_EQ(0, relay.second_to_first());
+
+    relay.fini();
+    first_client.fini();
+    second_client.fini();
+    first.fini();
+    second.fini();
+    listener.fini();
+    proactor.fini();
+}
+
+INSTANTIATE_PROACTOR_ENGINE_TEST(SocketRelayTest);
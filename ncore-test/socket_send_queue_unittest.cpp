@@ -0,0 +1,439 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/socket.h>
+#include <ncore/sys/socket_send_queue.h>
+#include <ncore/sys/proactor.h>
+#include <ncore/sys/sys_info.h>
+#include <ncore/sys/thread.h>
+#include <ncore/sys/token_bucket.h>
+#include "proactor_engine_test.h"
+
+using namespace ncore;
+
+class SocketSendQueueTest : public ProactorEngineTest
+{
+};
+
+// 记录消息完成的顺序和背压状态的变化
+class SendRecorder
+{
+public:
+    SendRecorder() : full_count(0), resume_count(0), errors(0)
+    {
+        request_adapter.Register(this, &SendRecorder::OnSent);
+        queue_adapter.Register(this, &SendRecorder::OnBackpressure);
+    }
+
+    void OnSent(SocketSendRequest & request)
+    {
+        if (request.error())
+            ++errors;
+        completed.push_back(reinterpret_cast<size_t>(request.user_token()));
+    }
+
+    void OnBackpressure(SocketSendQueue & queue)
+    {
+        if (queue.is_full())
+            ++full_count;
+        else
+            ++resume_count;
+    }
+
+    SocketSendRequestAdapter<SendRecorder> request_adapter;
+    SocketSendQueueAdapter<SendRecorder> queue_adapter;
+    std::vector<size_t> completed;
+    size_t full_count;
+    size_t resume_count;
+    size_t errors;
+};
+
+// 大量小消息排队发送，到达高水位后拒绝，降到低水位后恢复
+TEST_P(SocketSendQueueTest, Pipeline)
+{
+    static const size_t kMessages = 64;
+    static const uint32_t kMessageSize = 500;
+    static const size_t kHighWaterMark = 8192;
+
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket listener;
+    ASSERT_TRUE(listener.init(AddressFamily::kInterNetwork,
+                              SocketType::kStream,
+                              ProtocolType::kTCP));
+    IPEndPoint iep;
+    ASSERT_TRUE(BindAnyPort(listener, IPAddress::kIPLoopback, iep));
+    ASSERT_TRUE(listener.Listen(1));
+
+    Socket client;
+    ASSERT_TRUE(client.init(AddressFamily::kInterNetwork,
+                            SocketType::kStream,
+                            ProtocolType::kTCP));
+    ASSERT_TRUE(client.Connect(iep));
+    Socket server = listener.Accept();
+    ASSERT_TRUE(server.IsValid());
+    ASSERT_TRUE(client.Associate(proactor));
+
+    std::vector<char> data(kMessages * kMessageSize);
+    for (size_t index = 0; index < data.size(); ++index)
+        data[index] = static_cast<char>(index * 13);
+
+    SendRecorder recorder;
+    SocketSendRequest requests[kMessages];
+    for (size_t index = 0; index < kMessages; ++index)
+    {
+        requests[index].SetBuffer(&data[index * kMessageSize], kMessageSize);
+        requests[index].set_user_token(reinterpret_cast<void *>(index));
+        requests[index].set_completion_delegate(&recorder.request_adapter);
+    }
+
+    SocketSendQueue queue;
+    ASSERT_TRUE(queue.init(client, kHighWaterMark));
+    queue.set_backpressure_delegate(&recorder.queue_adapter);
+
+    SocketSendRequest empty;
+    EXPECT_FALSE(queue.Send(empty));
+
+    size_t next = 0;
+    for (int loop = 0; loop < 200 && recorder.completed.size() < kMessages; ++loop)
+    {
+        while (next < kMessages && queue.Send(requests[next]))
+            ++next;
+        proactor.Run(10);
+    }
+
+    ASSERT_EQ(kMessages, recorder.completed.size());
+    EXPECT_EQ(0, recorder.errors);
+    EXPECT_EQ(0, queue.error());
+    EXPECT_EQ(0, queue.queued_size());
+    EXPECT_EQ(0, queue.queued_count());
+    EXPECT_FALSE(queue.is_full());
+    EXPECT_LE(1, recorder.full_count);
+    EXPECT_EQ(recorder.full_count, recorder.resume_count);
+    for (size_t index = 0; index < kMessages; ++index)
+        EXPECT_EQ(index, recorder.completed[index]);
+
+    // 消息按顺序首尾相接
+    std::vector<char> received(data.size());
+    size_t size = 0;
+    while (size < received.size())
+    {
+        uint32_t transfered = 0;
+        if (!server.Receive(&received[size], received.size() - size, transfered) ||
+            transfered == 0)
+            break;
+        size += transfered;
+    }
+    ASSERT_EQ(data.size(), size);
+    EXPECT_TRUE(received == data);
+
+    queue.fini();
+    client.fini();
+    server.fini();
+    listener.fini();
+    proactor.fini();
+}
+
+// 发送出错后，排队的消息都以错误完成，队列不再接受消息
+TEST_P(SocketSendQueueTest, Error)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket client;
+    ASSERT_TRUE(client.init(AddressFamily::kInterNetwork,
+                            SocketType::kStream,
+                            ProtocolType::kTCP));
+    ASSERT_TRUE(client.Associate(proactor));
+
+    char data[16] = {0};
+    SendRecorder recorder;
+    SocketSendRequest request;
+    request.SetBuffer(data, sizeof(data));
+    request.set_completion_delegate(&recorder.request_adapter);
+
+    // 未连接的套接字上发送失败
+    SocketSendQueue queue;
+    ASSERT_TRUE(queue.init(client));
+    EXPECT_TRUE(queue.Send(request));
+    for (int loop = 0; loop < 100 && recorder.completed.empty(); ++loop)
+        proactor.Run(10);
+
+    ASSERT_EQ(1, recorder.completed.size());
+    EXPECT_EQ(1, recorder.errors);
+    EXPECT_NE(0, request.error());
+    EXPECT_NE(0, queue.error());
+    EXPECT_FALSE(queue.Send(request));
+
+    queue.fini();
+    client.fini();
+    proactor.fini();
+}
+
+// 按令牌桶的速率发送，令牌不足时由定时器推迟提交
+TEST_P(SocketSendQueueTest, Pacing)
+{
+    static const size_t kMessages = 16;
+    static const uint32_t kMessageSize = 8192;
+    static const uint64_t kRate = 256 * 1024;
+    static const uint64_t kBurst = 16 * 1024;
+
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket listener;
+    ASSERT_TRUE(listener.init(AddressFamily::kInterNetwork,
+                              SocketType::kStream,
+                              ProtocolType::kTCP));
+    IPEndPoint iep;
+    ASSERT_TRUE(BindAnyPort(listener, IPAddress::kIPLoopback, iep));
+    ASSERT_TRUE(listener.Listen(1));
+
+    Socket client;
+    ASSERT_TRUE(client.init(AddressFamily::kInterNetwork,
+                            SocketType::kStream,
+                            ProtocolType::kTCP));
+    ASSERT_TRUE(client.Connect(iep));
+    Socket server = listener.Accept();
+    ASSERT_TRUE(server.IsValid());
+    ASSERT_TRUE(client.Associate(proactor));
+
+#if defined NCORE_WINDOWS
+    EXPECT_FALSE(client.SetPacingRate(kRate));
+#else
+    EXPECT_TRUE(client.SetPacingRate(kRate * 4));
+    EXPECT_TRUE(client.SetPacingRate(0));
+#endif
+
+    std::vector<char> data(kMessages * kMessageSize);
+    for (size_t index = 0; index < data.size(); ++index)
+        data[index] = static_cast<char>(index * 7);
+
+    SendRecorder recorder;
+    SocketSendRequest requests[kMessages];
+    for (size_t index = 0; index < kMessages; ++index)
+    {
+        requests[index].SetBuffer(&data[index * kMessageSize], kMessageSize);
+        requests[index].set_user_token(reinterpret_cast<void *>(index));
+        requests[index].set_completion_delegate(&recorder.request_adapter);
+    }
+
+    // 全局的桶不限速，只统计
+    TokenBucket global;
+    ASSERT_TRUE(global.init(0, 1));
+    TokenBucket bucket;
+    ASSERT_TRUE(bucket.init(kRate, kBurst, &global));
+
+    SocketSendQueue queue;
+    EXPECT_FALSE(queue.set_pacing(&bucket, &proactor));
+    ASSERT_TRUE(queue.init(client, data.size() * 2));
+    EXPECT_FALSE(queue.set_pacing(&bucket, 0));
+    ASSERT_TRUE(queue.set_pacing(&bucket, &proactor));
+
+    uint64_t start = SysInfo::TickCount64();
+    for (size_t index = 0; index < kMessages; ++index)
+        ASSERT_TRUE(queue.Send(requests[index]));
+    EXPECT_FALSE(queue.set_pacing(0, 0));
+
+    for (int loop = 0; loop < 300 && recorder.completed.size() < kMessages; ++loop)
+        proactor.Run(10);
+    uint64_t elapsed = SysInfo::TickCount64() - start;
+
+    ASSERT_EQ(kMessages, recorder.completed.size());
+    EXPECT_EQ(0, recorder.errors);
+    for (size_t index = 0; index < kMessages; ++index)
+        EXPECT_EQ(index, recorder.completed[index]);
+
+    // 满桶的部分立即发出，其余按速率发送
+    uint64_t expected = (data.size() - kBurst) * 1000 / kRate;
+    EXPECT_LE(expected * 9 / 10, elapsed);
+    EXPECT_LT(0, queue.throttled_count());
+    EXPECT_LT(0, queue.throttled_bytes());
+
+    IOHistogram delay = queue.queue_delay();
+    EXPECT_EQ(kMessages, delay.count);
+    EXPECT_LE(expected * 900, delay.max);
+
+    TokenBucketStats stats;
+    bucket.Snapshot(stats);
+    EXPECT_EQ(data.size(), stats.granted_bytes);
+    EXPECT_EQ(queue.throttled_count(), stats.throttled_count);
+    global.Snapshot(stats);
+    EXPECT_EQ(data.size(), stats.granted_bytes);
+    EXPECT_EQ(0, stats.throttled_count);
+
+    std::vector<char> received(data.size());
+    size_t size = 0;
+    while (size < received.size())
+    {
+        uint32_t transfered = 0;
+        if (!server.Receive(&received[size], received.size() - size, transfered) ||
+            transfered == 0)
+            break;
+        size += transfered;
+    }
+    ASSERT_EQ(data.size(), size);
+    EXPECT_TRUE(received == data);
+
+    queue.fini();
+    bucket.fini();
+    global.fini();
+    client.fini();
+    server.fini();
+    listener.fini();
+    proactor.fini();
+}
+
+// 在另一个线程上执行前摄器，直到停止
+class ProactorRunner
+{
+public:
+    explicit ProactorRunner(Proactor & proactor)
+        : proactor_(proactor)
+    {
+        proc_.Register(this, &ProactorRunner::Run);
+        stopping = 0;
+    }
+
+    bool Start()
+    {
+        return thread_.init(proc_) && thread_.Start();
+    }
+
+    void Stop()
+    {
+        stopping = 1;
+        thread_.Join();
+        thread_.fini();
+    }
+
+    void Run()
+    {
+        while (stopping == 0)
+            proactor_.Run(10);
+    }
+
+    Atomic stopping;
+
+private:
+    Proactor & proactor_;
+    Thread thread_;
+    ThreadProcAdapter<ProactorRunner> proc_;
+};
+
+// 统计完成的消息数，回调可能在任一执行前摄器的线程上
+class PacedCounter
+{
+public:
+    PacedCounter()
+    {
+        adapter.Register(this, &PacedCounter::OnSent);
+        completed = 0;
+        errors = 0;
+    }
+
+    void OnSent(SocketSendRequest & request)
+    {
+        if (request.error())
+            ++errors;
+        ++completed;
+    }
+
+    SocketSendRequestAdapter<PacedCounter> adapter;
+    Atomic completed;
+    Atomic errors;
+};
+
+// 两个线程执行前摄器，定时器发起的提交可能在另一个线程上先完成，
+// 此时需要的定时器由定时器的回调启动，所有消息照常按速率发出
+TEST_P(SocketSendQueueTest, PacingOnTwoThreads)
+{
+    static const size_t kMessages = 32;
+    static const uint32_t kMessageSize = 4096;
+    static const uint64_t kRate = 512 * 1024;
+
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket listener;
+    ASSERT_TRUE(listener.init(AddressFamily::kInterNetwork,
+                              SocketType::kStream,
+                              ProtocolType::kTCP));
+    IPEndPoint iep;
+    ASSERT_TRUE(BindAnyPort(listener, IPAddress::kIPLoopback, iep));
+    ASSERT_TRUE(listener.Listen(1));
+
+    Socket client;
+    ASSERT_TRUE(client.init(AddressFamily::kInterNetwork,
+                            SocketType::kStream,
+                            ProtocolType::kTCP));
+    ASSERT_TRUE(client.Connect(iep));
+    Socket server = listener.Accept();
+    ASSERT_TRUE(server.IsValid());
+    ASSERT_TRUE(client.Associate(proactor));
+
+    std::vector<char> data(kMessages * kMessageSize);
+    for (size_t index = 0; index < data.size(); ++index)
+        data[index] = static_cast<char>(index * 13);
+
+    PacedCounter counter;
+    SocketSendRequest requests[kMessages];
+    for (size_t index = 0; index < kMessages; ++index)
+    {
+        requests[index].SetBuffer(&data[index * kMessageSize], kMessageSize);
+        requests[index].set_completion_delegate(&counter.adapter);
+    }
+
+    // 桶只容纳一条消息，之后的每条消息都由定时器推迟
+    TokenBucket bucket;
+    ASSERT_TRUE(bucket.init(kRate, kMessageSize));
+    SocketSendQueue queue;
+    ASSERT_TRUE(queue.init(client, data.size() * 2));
+    ASSERT_TRUE(queue.set_pacing(&bucket, &proactor));
+
+    ProactorRunner runner(proactor);
+    ASSERT_TRUE(runner.Start());
+    for (size_t index = 0; index < kMessages; ++index)
+        ASSERT_TRUE(queue.Send(requests[index]));
+
+    for (int loop = 0; loop < 300 && counter.completed != kMessages; ++loop)
+        proactor.Run(10);
+    runner.Stop();
+
+    EXPECT_EQ(kMessages, static_cast<size_t>(static_cast<int>(counter.completed)));
+    EXPECT_EQ(0, static_cast<int>(counter.errors));
+    EXPECT_LT(0, queue.throttled_count());
+
+    std::vector<char> received(data.size());
+    size_t size = 0;
+    while (size < received.size())
+    {
+        uint32_t transfered = 0;
+        if (!server.Receive(&received[size], received.size() - size, transfered) ||
+            transfered == 0)
+            break;
+        size += transfered;
+    }
+    ASSERT_EQ(data.size(), size);
+    EXPECT_TRUE(received == data);
+
+    queue.fini();
+    bucket.fini();
+    client.fini();
+    server.fini();
+    listener.fini();
+    proactor.fini();
+}
+
+INSTANTIATE_PROACTOR_ENGINE_TEST(SocketSendQueueTest);
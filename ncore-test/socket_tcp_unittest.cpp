@@ -0,0 +1,435 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/socket.h>
+#include <ncore/sys/socket_async_event_args.h>
+#include <ncore/sys/file_stream.h>
+#include <ncore/sys/proactor.h>
+#include <ncore/sys/sys_info.h>
+#include <ncore/sys/thread.h>
+#include "proactor_engine_test.h"
+
+using namespace ncore;
+
+#if defined NCORE_LINUX
+
+// socket_unittest.cpp中依赖Windows的TCP测试，在Linux上以两种后端各运行一遍
+class SocketTcpTest : public ProactorEngineTest
+{
+protected:
+    // 在回环地址上建立一对连接，client发起，返回listener接受到的一端，失败时无效
+    static Socket ConnectPair(Socket & listener, Socket & client)
+    {
+        IPEndPoint iep;
+        if (!listener.init(AddressFamily::kInterNetwork,
+                           SocketType::kStream,
+                           ProtocolType::kTCP) ||
+            !BindAnyPort(listener, IPAddress::kIPLoopback, iep) ||
+            !listener.Listen(1))
+            return Socket();
+
+        if (!client.init(AddressFamily::kInterNetwork,
+                         SocketType::kStream,
+                         ProtocolType::kTCP) ||
+            !client.Connect(iep))
+            return Socket();
+
+        return listener.Accept();
+    }
+
+    // 同步接收到size字节或者对端关闭为止
+    static uint32_t ReceiveAll(Socket & socket, char * data, uint32_t size)
+    {
+        uint32_t received = 0;
+        while (received < size)
+        {
+            uint32_t transfered = 0;
+            if (!socket.Receive(data + received, size - received, transfered) ||
+                transfered == 0)
+                break;
+            received += transfered;
+        }
+        return received;
+    }
+};
+
+// 统计完成的请求
+class CompletionCounter
+{
+public:
+    CompletionCounter() : completed(0), error(0)
+    {
+        adapter.Register(this, &CompletionCounter::OnCompleted);
+    }
+
+    void OnCompleted(SocketAsyncContext & args)
+    {
+        error = args.error();
+        ++completed;
+    }
+
+    SocketAsyncResultAdapter<CompletionCounter> adapter;
+    size_t completed;
+    uint32_t error;
+};
+
+// 多段缓冲区的收发，部分完成时跳过已传输的部分继续提交
+class SegmentTransfer
+{
+public:
+    SegmentTransfer(Socket & socket, bool send)
+        : total(0), error(0), completed(false), socket_(socket), send_(send)
+    {
+        adapter_.Register(this, &SegmentTransfer::OnCompleted);
+        args.set_completion_delegate(&adapter_);
+    }
+
+    bool Start()
+    {
+        return send_ ? socket_.SendAsync(args) : socket_.ReceiveAsync(args);
+    }
+
+    void OnCompleted(SocketAsyncContext & arg)
+    {
+        total += arg.transfered();
+        error = arg.error();
+        if (error == 0 && arg.transfered() != 0 &&
+            arg.ConsumeBuffers(arg.transfered()) && Start())
+            return;
+        completed = true;
+    }
+
+    SocketAsyncContext args;
+    size_t total;
+    uint32_t error;
+    bool completed;
+
+private:
+    Socket & socket_;
+    bool send_;
+    SocketAsyncResultAdapter<SegmentTransfer> adapter_;
+};
+
+// 在另一个线程上延迟一段时间后发送
+class DelayedSender
+{
+public:
+    DelayedSender(Socket & socket, const char * data, uint32_t delay)
+        : socket_(socket), data_(data), delay_(delay), sent(false)
+    {
+        proc_.Register(this, &DelayedSender::Run);
+    }
+
+    bool Start()
+    {
+        return thread_.init(proc_) && thread_.Start();
+    }
+
+    void Join()
+    {
+        thread_.Join();
+        thread_.fini();
+    }
+
+    void Run()
+    {
+        Thread::Sleep(delay_, false);
+        uint32_t transfered = 0;
+        sent = socket_.Send(data_, static_cast<uint32_t>(strlen(data_)), transfered);
+    }
+
+private:
+    Socket & socket_;
+    const char * data_;
+    uint32_t delay_;
+    Thread thread_;
+    ThreadProcAdapter<DelayedSender> proc_;
+
+public:
+    bool sent;
+};
+
+// 报头、文件和报尾一次发送，同步发送到文件尾，异步发送指定的长度
+TEST_P(SocketTcpTest, SendFile)
+{
+    if (EngineUnavailable())
+        return;
+
+    static const uint32_t kFileSize = 32768;
+    std::vector<char> payload(kFileSize);
+    for (uint32_t index = 0; index < kFileSize; ++index)
+        payload[index] = static_cast<char>(index * 13);
+
+    FileStream file;
+    ASSERT_TRUE(file.init("socket_tcp_send_file",
+                          FileAccess::kReadWrite,
+                          FileShare::kExclusive,
+                          FileMode::kCreateAlways,
+                          FileAttribute::kNormal,
+                          FileOption::kDeleteOnClose));
+    uint32_t written = 0;
+    ASSERT_TRUE(file.Write(&payload[0], kFileSize, 0, written));
+    ASSERT_EQ(kFileSize, written);
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket listener;
+    Socket client;
+    Socket server = ConnectPair(listener, client);
+    ASSERT_TRUE(server.IsValid());
+
+    char header[8] = "header:";
+    char trailer[8] = ":tail";
+    SocketBuffer head = {header, sizeof(header)};
+    SocketBuffer tail = {trailer, sizeof(trailer)};
+    const uint32_t total = sizeof(header) + kFileSize + sizeof(trailer);
+
+    for (int round = 0; round < 2; ++round)
+    {
+        if (round == 0)
+        {
+            uint32_t sent = 0;
+            ASSERT_TRUE(client.SendFile(file, 0, 0, head, tail, sent));
+            EXPECT_EQ(total, sent);
+        }
+        else
+        {
+            ASSERT_TRUE(client.Associate(proactor));
+            CompletionCounter counter;
+            SocketFileAsyncContext args;
+            args.SetFile(file, 0, kFileSize);
+            args.SetHeader(header, sizeof(header));
+            args.SetTrailer(trailer, sizeof(trailer));
+            args.set_completion_delegate(&counter.adapter);
+            ASSERT_TRUE(client.SendFileAsync(args));
+            for (int loop = 0; loop < 100 && counter.completed == 0; ++loop)
+                proactor.Run(50);
+            ASSERT_EQ(1, counter.completed);
+            EXPECT_EQ(0, counter.error);
+            EXPECT_EQ(total, args.transfered());
+        }
+
+        std::vector<char> echo(total);
+        ASSERT_EQ(total, ReceiveAll(server, &echo[0], total));
+        EXPECT_EQ(0, memcmp(header, &echo[0], sizeof(header)));
+        EXPECT_EQ(0, memcmp(&payload[0], &echo[sizeof(header)], kFileSize));
+        EXPECT_EQ(0, memcmp(trailer, &echo[sizeof(header) + kFileSize], sizeof(trailer)));
+    }
+
+    // 从中间开始的一段，不带报头和报尾
+    const uint32_t kOffset = 1000;
+    const uint32_t kLength = 5000;
+    uint32_t sent = 0;
+    ASSERT_TRUE(client.SendFile(file, kOffset, kLength, sent));
+    EXPECT_EQ(kLength, sent);
+    std::vector<char> part(kLength);
+    ASSERT_EQ(kLength, ReceiveAll(server, &part[0], kLength));
+    EXPECT_EQ(0, memcmp(&payload[kOffset], &part[0], kLength));
+
+    client.fini();
+    server.fini();
+    listener.fini();
+    proactor.fini();
+    file.fini();
+}
+
+// 报头和数据分两段一次发送，对端分散接收到两段
+TEST_P(SocketTcpTest, AsyncScatterGatherIO)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket listener;
+    Socket client;
+    Socket server = ConnectPair(listener, client);
+    ASSERT_TRUE(server.IsValid());
+    ASSERT_TRUE(client.Associate(proactor));
+    ASSERT_TRUE(server.Associate(proactor));
+
+    char header[16] = "scatter-gather";
+    // 超过套接字缓冲区，收发都会部分完成后跳过已传输的部分
+    static const size_t kPayloadSize = 1048576;
+    std::vector<char> payload(kPayloadSize);
+    for (size_t index = 0; index < kPayloadSize; ++index)
+        payload[index] = static_cast<char>(index * 7);
+
+    SegmentTransfer sender(client, true);
+    SocketBuffer out[] = {{header, sizeof(header)},
+                          {&payload[0], kPayloadSize}};
+    ASSERT_TRUE(sender.args.SetBuffers(out, 2));
+    EXPECT_EQ(sizeof(header) + kPayloadSize, sender.args.count());
+
+    char recv_header[16] = {0};
+    std::vector<char> recv_payload(kPayloadSize);
+    SegmentTransfer receiver(server, false);
+    SocketBuffer in[] = {{recv_header, sizeof(recv_header)},
+                         {&recv_payload[0], kPayloadSize}};
+    ASSERT_TRUE(receiver.args.SetBuffers(in, 2));
+
+    ASSERT_TRUE(sender.Start());
+    ASSERT_TRUE(receiver.Start());
+    for (int loop = 0; loop < 200 && !(sender.completed && receiver.completed); ++loop)
+        proactor.Run(50);
+
+    EXPECT_EQ(0, sender.error);
+    EXPECT_EQ(0, receiver.error);
+    EXPECT_EQ(sizeof(header) + kPayloadSize, sender.total);
+    EXPECT_EQ(sizeof(header) + kPayloadSize, receiver.total);
+    EXPECT_EQ(0, memcmp(header, recv_header, sizeof(header)));
+    EXPECT_EQ(0, memcmp(&payload[0], &recv_payload[0], kPayloadSize));
+
+    client.fini();
+    server.fini();
+    listener.fini();
+    proactor.fini();
+}
+
+// 同步操作的超时以ETIMEDOUT失败，超时改变时重新设置缓存的SO_RCVTIMEO
+TEST_P(SocketTcpTest, SyncTimeout)
+{
+    if (EngineUnavailable())
+        return;
+
+    Socket listener;
+    Socket client;
+    Socket server = ConnectPair(listener, client);
+    ASSERT_TRUE(server.IsValid());
+
+    char buffer[64] = {0};
+    uint32_t transfered = 0;
+    uint64_t start = SysInfo::TickCount64();
+    errno = 0;
+    EXPECT_FALSE(client.Receive(buffer, sizeof(buffer), 100, transfered));
+    EXPECT_EQ(ETIMEDOUT, errno);
+    EXPECT_GE(SysInfo::TickCount64() - start, 80);
+    EXPECT_FALSE(client.Receive(buffer, sizeof(buffer), 0, transfered));
+
+    ASSERT_TRUE(server.Send("ping", 4, transfered));
+    ASSERT_TRUE(client.Receive(buffer, sizeof(buffer), 1000, transfered));
+    EXPECT_EQ(4, transfered);
+    EXPECT_EQ(0, memcmp(buffer, "ping", 4));
+
+    // 先以100毫秒超时失败一次，不超时的调用要等到晚于它到达的数据
+    EXPECT_FALSE(client.Receive(buffer, sizeof(buffer), 100, transfered));
+    DelayedSender sender(server, "pong", 300);
+    ASSERT_TRUE(sender.Start());
+    ASSERT_TRUE(client.Receive(buffer, sizeof(buffer), transfered));
+    sender.Join();
+    EXPECT_TRUE(sender.sent);
+    EXPECT_EQ(4, transfered);
+    EXPECT_EQ(0, memcmp(buffer, "pong", 4));
+
+    // 关联到前摄器后是非阻塞的套接字，由poll计时
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+    ASSERT_TRUE(client.Associate(proactor));
+    start = SysInfo::TickCount64();
+    errno = 0;
+    EXPECT_FALSE(client.Receive(buffer, sizeof(buffer), 100, transfered));
+    EXPECT_EQ(ETIMEDOUT, errno);
+    EXPECT_GE(SysInfo::TickCount64() - start, 80);
+
+    // 没有连接到达时接受超时
+    start = SysInfo::TickCount64();
+    errno = 0;
+    Socket accepted = listener.Accept(100);
+    EXPECT_FALSE(accepted.IsValid());
+    EXPECT_EQ(ETIMEDOUT, errno);
+    EXPECT_GE(SysInfo::TickCount64() - start, 80);
+
+    client.fini();
+    server.fini();
+    listener.fini();
+    proactor.fini();
+}
+
+// 异步接收超过期限时以ETIMEDOUT完成，而不是取消请求得到的ECANCELED
+TEST_P(SocketTcpTest, AsyncReceiveTimeout)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket listener;
+    Socket client;
+    Socket server = ConnectPair(listener, client);
+    ASSERT_TRUE(server.IsValid());
+    ASSERT_TRUE(client.Associate(proactor));
+
+    CompletionCounter counter;
+    char buffer[64] = {0};
+    SocketAsyncContext args;
+    args.SetBuffer(buffer, sizeof(buffer));
+    args.set_completion_delegate(&counter.adapter);
+    args.set_timeout(100);
+    uint64_t start = SysInfo::TickCount64();
+    ASSERT_TRUE(client.ReceiveAsync(args));
+    for (int loop = 0; loop < 100 && counter.completed == 0; ++loop)
+        proactor.Run(50);
+
+    ASSERT_EQ(1, counter.completed);
+    EXPECT_EQ(ETIMEDOUT, counter.error);
+    EXPECT_EQ(0, args.transfered());
+    EXPECT_GE(SysInfo::TickCount64() - start, 80);
+
+    // 期限之前完成的请求不受定时器影响
+    args.set_timeout(1000);
+    ASSERT_TRUE(client.ReceiveAsync(args));
+    uint32_t transfered = 0;
+    ASSERT_TRUE(server.Send("ping", 4, transfered));
+    for (int loop = 0; loop < 100 && counter.completed == 1; ++loop)
+        proactor.Run(50);
+
+    ASSERT_EQ(2, counter.completed);
+    EXPECT_EQ(0, counter.error);
+    EXPECT_EQ(4, args.transfered());
+    EXPECT_EQ(0, memcmp(buffer, "ping", 4));
+
+    client.fini();
+    server.fini();
+    listener.fini();
+    proactor.fini();
+}
+
+INSTANTIATE_PROACTOR_ENGINE_TEST(SocketTcpTest);
+
+TEST(SocketAsyncContextTest, ConsumeBuffers)
+{
+    char first[4];
+    char second[8];
+    SocketBuffer buffers[] = {{first, sizeof(first)}, {second, sizeof(second)}};
+
+    SocketAsyncContext args;
+    EXPECT_FALSE(args.SetBuffers(buffers, 0));
+    ASSERT_TRUE(args.SetBuffers(buffers, 2));
+    EXPECT_EQ(12, args.count());
+    EXPECT_EQ(2, args.buffer_count());
+
+    // 跨过第一段，第二段从第3个字节开始
+    EXPECT_TRUE(args.ConsumeBuffers(6));
+    EXPECT_EQ(1, args.buffer_count());
+    EXPECT_EQ(second + 2, args.buffers()[0].data);
+    EXPECT_EQ(6, args.buffers()[0].size);
+    EXPECT_EQ(6, args.count());
+
+    // 正好在段的边界上
+    ASSERT_TRUE(args.SetBuffers(buffers, 2));
+    EXPECT_TRUE(args.ConsumeBuffers(4));
+    EXPECT_EQ(1, args.buffer_count());
+    EXPECT_EQ(second, args.buffers()[0].data);
+    EXPECT_EQ(8, args.count());
+
+    EXPECT_FALSE(args.ConsumeBuffers(8));
+    EXPECT_EQ(0, args.count());
+
+    // SetBuffer恢复为单块缓冲区
+    args.SetBuffer(first, sizeof(first));
+    EXPECT_EQ(0, args.buffer_count());
+    EXPECT_TRUE(args.buffers() == 0);
+}
+
+#endif
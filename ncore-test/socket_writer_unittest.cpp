@@ -0,0 +1,132 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/socket.h>
+#include <ncore/sys/socket_writer.h>
+#include <ncore/sys/proactor.h>
+#include "proactor_engine_test.h"
+
+using namespace ncore;
+
+class SocketWriterTest : public ProactorEngineTest
+{
+};
+
+// 在前摄器的任务中多次小块写入，模拟一个回调中产生的响应
+class BatchWriter
+{
+public:
+    static const size_t kWrites = 10;
+    static const size_t kWriteSize = 10;
+
+public:
+    BatchWriter(SocketWriter & writer, const char * data)
+        : writer(writer), data(data), failed(0)
+    {
+        task.Register(this, &BatchWriter::Run);
+    }
+
+    void Run()
+    {
+        for (size_t index = 0; index < kWrites; ++index)
+        {
+            if (!writer.Write(data + index * kWriteSize, kWriteSize))
+                ++failed;
+        }
+    }
+
+    SocketWriter & writer;
+    const char * data;
+    AsyncTaskAdapter<BatchWriter> task;
+    size_t failed;
+};
+
+static bool ReceiveAll(Socket & socket, char * data, size_t size)
+{
+    size_t received = 0;
+    while (received < size)
+    {
+        uint32_t transfered = 0;
+        if (!socket.Receive(data + received,
+                            static_cast<uint32_t>(size - received),
+                            transfered) ||
+            transfered == 0)
+            return false;
+        received += transfered;
+    }
+    return true;
+}
+
+TEST_P(SocketWriterTest, Coalesce)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    Socket listener;
+    ASSERT_TRUE(listener.init(AddressFamily::kInterNetwork,
+                              SocketType::kStream,
+                              ProtocolType::kTCP));
+    IPEndPoint iep;
+    ASSERT_TRUE(BindAnyPort(listener, IPAddress::kIPLoopback, iep));
+    ASSERT_TRUE(listener.Listen(1));
+
+    Socket client;
+    ASSERT_TRUE(client.init(AddressFamily::kInterNetwork,
+                            SocketType::kStream,
+                            ProtocolType::kTCP));
+    ASSERT_TRUE(client.Connect(iep));
+    Socket server = listener.Accept();
+    ASSERT_TRUE(server.IsValid());
+    ASSERT_TRUE(client.Associate(proactor));
+
+    char data[256];
+    for (size_t index = 0; index < sizeof(data); ++index)
+        data[index] = static_cast<char>(index);
+
+    SocketWriter writer;
+    ASSERT_TRUE(writer.init(client, proactor, 64));
+
+    // 分发中的写入：达到阈值时发送一次，分发结束时发送剩余的部分
+    BatchWriter batch(writer, data);
+    ASSERT_TRUE(proactor.Post(batch.task));
+    for (int loop = 0; loop < 100 && writer.stats().bytes < 100; ++loop)
+        proactor.Run(10);
+    EXPECT_EQ(0, batch.failed);
+    EXPECT_EQ(0, writer.buffered());
+
+    SocketWriterStats stats = writer.stats();
+    EXPECT_EQ(10, stats.writes);
+    EXPECT_EQ(2, stats.sends);
+    EXPECT_EQ(100, stats.bytes);
+
+    char received[256];
+    ASSERT_TRUE(ReceiveAll(server, received, 100));
+    EXPECT_EQ(0, memcmp(data, received, 100));
+
+    // 分发之外的写入留在缓冲区，直到Flush
+    EXPECT_TRUE(writer.Write(data + 100, 20));
+    EXPECT_TRUE(writer.Write(data + 120, 20));
+    EXPECT_EQ(40, writer.buffered());
+    EXPECT_TRUE(writer.Flush());
+    EXPECT_EQ(0, writer.buffered());
+    for (int loop = 0; loop < 100 && writer.stats().bytes < 140; ++loop)
+        proactor.Run(10);
+
+    stats = writer.stats();
+    EXPECT_EQ(12, stats.writes);
+    EXPECT_EQ(3, stats.sends);
+    EXPECT_EQ(140, stats.bytes);
+    EXPECT_EQ(0, writer.error());
+
+    ASSERT_TRUE(ReceiveAll(server, received, 40));
+    EXPECT_EQ(0, memcmp(data + 100, received, 40));
+
+    writer.fini();
+    client.fini();
+    server.fini();
+    listener.fini();
+    proactor.fini();
+}
+
+INSTANTIATE_PROACTOR_ENGINE_TEST(SocketWriterTest);
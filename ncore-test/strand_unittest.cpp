@@ -0,0 +1,128 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/base/atomic.h>
+#include <ncore/sys/thread.h>
+#include <ncore/sys/strand.h>
+
+namespace
+{
+
+using namespace ncore;
+
+// 记录执行顺序，第一个任务在执行中再投递第二个
+class ChainedTasks
+{
+public:
+    ChainedTasks(Strand & strand);
+
+    void First();
+    void Second();
+
+    Strand & strand;
+    AsyncTaskAdapter<ChainedTasks> first;
+    AsyncTaskAdapter<ChainedTasks> second;
+    std::vector<int> order;
+};
+
+ChainedTasks::ChainedTasks(Strand & s)
+    : strand(s)
+{
+    first.Register(this, &ChainedTasks::First);
+    second.Register(this, &ChainedTasks::Second);
+}
+
+void ChainedTasks::First()
+{
+    order.push_back(1);
+    EXPECT_TRUE(strand.RunningInThisThread());
+    strand.Post(second);
+    // 不重入，第二个任务在本任务返回后执行
+    order.push_back(2);
+}
+
+void ChainedTasks::Second()
+{
+    order.push_back(3);
+}
+
+// 多个线程同时向同一个Strand投递，检查任务没有并发执行
+class ConcurrentPoster
+{
+public:
+    static const size_t kMaxThreads = 4;
+    static const size_t kMaxTasks = 2000;
+
+public:
+    ConcurrentPoster(Strand & strand);
+
+    void Post();
+    void Count();
+
+    Strand & strand;
+    size_t count;
+    bool overlapped;
+
+private:
+    Atomic inside_;
+    Atomic next_thread_;
+    AsyncTaskAdapter<ConcurrentPoster> tasks_[kMaxThreads][kMaxTasks];
+};
+
+ConcurrentPoster::ConcurrentPoster(Strand & s)
+    : strand(s), count(0), overlapped(false)
+{
+    for (size_t i = 0; i < kMaxThreads; ++i)
+        for (size_t j = 0; j < kMaxTasks; ++j)
+            tasks_[i][j].Register(this, &ConcurrentPoster::Count);
+}
+
+void ConcurrentPoster::Post()
+{
+    size_t index = static_cast<size_t>(++next_thread_) - 1;
+    for (size_t j = 0; j < kMaxTasks; ++j)
+        strand.Post(tasks_[index][j]);
+}
+
+void ConcurrentPoster::Count()
+{
+    if (++inside_ != 1) overlapped = true;
+    ++count;
+    --inside_;
+}
+
+}
+
+TEST(StrandTest, PostInsideTaskIsQueued)
+{
+    Strand strand;
+    ChainedTasks tasks(strand);
+    EXPECT_FALSE(strand.RunningInThisThread());
+
+    strand.Post(tasks.first);
+    ASSERT_EQ(3, tasks.order.size());
+    EXPECT_EQ(1, tasks.order[0]);
+    EXPECT_EQ(2, tasks.order[1]);
+    EXPECT_EQ(3, tasks.order[2]);
+    EXPECT_FALSE(strand.RunningInThisThread());
+}
+
+TEST(StrandTest, ConcurrentPostIsSerialized)
+{
+    Strand strand;
+    ConcurrentPoster poster(strand);
+
+    ThreadProcAdapter<ConcurrentPoster> proc;
+    proc.Register(&poster, &ConcurrentPoster::Post);
+
+    Thread threads[ConcurrentPoster::kMaxThreads];
+    for (size_t i = 0; i < ConcurrentPoster::kMaxThreads; ++i)
+    {
+        ASSERT_TRUE(threads[i].init(proc));
+        ASSERT_TRUE(threads[i].Start());
+    }
+    for (size_t i = 0; i < ConcurrentPoster::kMaxThreads; ++i)
+        threads[i].Join();
+
+    size_t expected = ConcurrentPoster::kMaxThreads * ConcurrentPoster::kMaxTasks;
+    EXPECT_EQ(expected, poster.count);
+    EXPECT_FALSE(poster.overlapped);
+}
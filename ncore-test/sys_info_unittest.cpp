@@ -1,9 +1,9 @@
-#include <gtest/gtest.h>
-#include <ncore/sys/sys_info.h>
-
-using namespace ncore;
-
-TEST(SysInfo, CommonAppDataPath)
-{
-    auto path = SysInfo::CommonAppDataPath();
+#include <gtest/gtest.h>
+#include <ncore/sys/sys_info.h>
+
+using namespace ncore;
+
+TEST(SysInfo, CommonAppDataPath)
+{
+    auto path = SysInfo::CommonAppDataPath();
 }
\ No newline at end of file
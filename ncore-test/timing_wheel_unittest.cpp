@@ -0,0 +1,97 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/timing_wheel.h>
+
+namespace
+{
+
+using namespace ncore;
+
+// 记录定时器到期的次数
+class ExpireCounter
+{
+public:
+    ExpireCounter() : count(0) {}
+
+    void OnExpired()
+    {
+        ++count;
+    }
+
+    int count;
+};
+
+// 推进时间轮并执行到期的定时器
+size_t AdvanceAndRun(TimingWheel & wheel, uint64_t now)
+{
+    AsyncTaskQueue expired;
+    size_t count = wheel.Advance(now, expired);
+    AsyncTaskQueue::Run(expired.TakeAll());
+    return count;
+}
+
+}
+
+TEST(TimingWheelTest, ExpireAcrossLevels)
+{
+    static const uint64_t kStart = 1000;
+    // 分别落在第0、1、2、3层
+    const uint64_t delays[] = {0, 5, 255, 256, 69000, 19999000};
+    const size_t kMaxTimers = sizeof(delays) / sizeof(delays[0]);
+
+    TimingWheel wheel;
+    wheel.Reset(kStart);
+
+    ExpireCounter counters[kMaxTimers];
+    AsyncTimerAdapter<ExpireCounter> timers[kMaxTimers];
+    for (size_t i = 0; i < kMaxTimers; ++i)
+    {
+        timers[i].Register(&counters[i], &ExpireCounter::OnExpired);
+        wheel.Add(timers[i], kStart + delays[i]);
+        EXPECT_TRUE(timers[i].armed());
+    }
+    EXPECT_EQ(kMaxTimers, wheel.size());
+
+    // 每个定时器恰好在到期的刻度被取出
+    for (size_t i = 0; i < kMaxTimers; ++i)
+    {
+        uint64_t expire = kStart + delays[i];
+        if (expire > kStart)
+            AdvanceAndRun(wheel, expire - 1);
+        EXPECT_EQ(0, counters[i].count);
+        AdvanceAndRun(wheel, expire);
+        EXPECT_EQ(1, counters[i].count);
+        EXPECT_TRUE(timers[i].firing());
+    }
+    EXPECT_EQ(0, wheel.size());
+}
+
+TEST(TimingWheelTest, RemoveAndNextExpire)
+{
+    TimingWheel wheel;
+    wheel.Reset(1);
+    EXPECT_EQ(static_cast<uint64_t>(-1), wheel.NextExpire());
+
+    ExpireCounter counter;
+    AsyncTimerAdapter<ExpireCounter> near_timer;
+    AsyncTimerAdapter<ExpireCounter> far_timer;
+    near_timer.Register(&counter, &ExpireCounter::OnExpired);
+    far_timer.Register(&counter, &ExpireCounter::OnExpired);
+
+    wheel.Add(near_timer, 10);
+    EXPECT_EQ(10, wheel.NextExpire());
+
+    // 不在最底层的定时器需要在边界处下移
+    wheel.Add(far_timer, 1000);
+    EXPECT_TRUE(wheel.Remove(near_timer));
+    EXPECT_FALSE(wheel.Remove(near_timer));
+    EXPECT_FALSE(near_timer.armed());
+    EXPECT_EQ(256, wheel.NextExpire());
+
+    // 重新加入即重新定时
+    wheel.Add(far_timer, 20);
+    EXPECT_EQ(1, wheel.size());
+    EXPECT_EQ(0, AdvanceAndRun(wheel, 19));
+    EXPECT_EQ(1, AdvanceAndRun(wheel, 20));
+    EXPECT_EQ(1, counter.count);
+    EXPECT_FALSE(wheel.Remove(far_timer));
+}
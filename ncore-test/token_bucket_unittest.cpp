@@ -0,0 +1,112 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/token_bucket.h>
+#include <ncore/sys/thread.h>
+
+using namespace ncore;
+
+// 桶初始是满的，取完之后按速率等待
+TEST(TokenBucketTest, Basic)
+{
+    TokenBucket bucket;
+    EXPECT_FALSE(bucket.init(1000, 0));
+    ASSERT_TRUE(bucket.init(1000, 500));
+    EXPECT_FALSE(bucket.init(1000, 500));
+    EXPECT_EQ(500, bucket.tokens());
+
+    uint64_t delay = 0;
+    EXPECT_EQ(0, bucket.Acquire(0, delay));
+
+    // 一次放行不超过burst
+    EXPECT_EQ(500, bucket.Acquire(2000, delay));
+    EXPECT_EQ(0, delay);
+    EXPECT_GE(0, bucket.tokens());
+
+    // 至少积累到min(size, burst)才放行，1000字节每秒攒100字节约100毫秒
+    EXPECT_EQ(0, bucket.Acquire(100, delay));
+    EXPECT_LT(90000, delay);
+    EXPECT_GE(100000, delay);
+
+    Thread::Sleep(static_cast<uint32_t>(delay / 1000) + 20, false);
+    EXPECT_EQ(100, bucket.Acquire(100, delay));
+
+    TokenBucketStats stats;
+    bucket.Snapshot(stats);
+    EXPECT_EQ(600, stats.granted_bytes);
+    EXPECT_EQ(100, stats.throttled_bytes);
+    EXPECT_EQ(1, stats.throttled_count);
+    EXPECT_EQ(1, stats.delay.count);
+
+    bucket.fini();
+}
+
+// 不限速的桶只统计；长时间空闲后不超过burst
+TEST(TokenBucketTest, Unlimited)
+{
+    TokenBucket bucket;
+    ASSERT_TRUE(bucket.init(0, 1));
+
+    uint64_t delay = 0;
+    EXPECT_EQ(1 << 20, bucket.Acquire(1 << 20, delay));
+    EXPECT_EQ(1 << 20, bucket.Acquire(1 << 20, delay));
+
+    TokenBucketStats stats;
+    bucket.Snapshot(stats);
+    EXPECT_EQ(2 << 20, stats.granted_bytes);
+    EXPECT_EQ(0, stats.throttled_count);
+
+    // 改为限速后按新的速率补充，不超过新的burst
+    bucket.SetRate(1000000, 4096);
+    Thread::Sleep(20, false);
+    EXPECT_EQ(4096, bucket.Acquire(1 << 20, delay));
+    EXPECT_EQ(0, bucket.Acquire(1 << 20, delay));
+    EXPECT_LT(0, delay);
+
+    bucket.fini();
+}
+
+// 分组和全局的父桶由所有子桶分享
+TEST(TokenBucketTest, Hierarchy)
+{
+    TokenBucket global;
+    ASSERT_TRUE(global.init(1000, 1000));
+
+    TokenBucket group;
+    ASSERT_TRUE(group.init(0, 1, &global));
+
+    TokenBucket first;
+    TokenBucket second;
+    ASSERT_TRUE(first.init(1000000, 800, &group));
+    ASSERT_TRUE(second.init(1000000, 800, &group));
+    EXPECT_EQ(&group, first.parent());
+
+    // 第一个连接取走800，全局只剩200，第二个连接需要等待
+    uint64_t delay = 0;
+    EXPECT_EQ(800, first.Acquire(800, delay));
+    EXPECT_EQ(0, second.Acquire(800, delay));
+    EXPECT_LT(500000, delay);
+    EXPECT_LE(200, global.tokens());
+    EXPECT_GT(250, global.tokens());
+
+    // 少量的数据可以用剩余的令牌发送
+    EXPECT_EQ(200, second.Acquire(200, delay));
+    EXPECT_GT(50, global.tokens());
+
+    TokenBucketStats stats;
+    global.Snapshot(stats);
+    EXPECT_EQ(1000, stats.granted_bytes);
+    EXPECT_EQ(800, stats.throttled_bytes);
+    EXPECT_EQ(1, stats.throttled_count);
+
+    group.Snapshot(stats);
+    EXPECT_EQ(1000, stats.granted_bytes);
+    EXPECT_EQ(0, stats.throttled_count);
+
+    second.Snapshot(stats);
+    EXPECT_EQ(200, stats.granted_bytes);
+    EXPECT_EQ(0, stats.throttled_count);
+
+    second.fini();
+    first.fini();
+    group.fini();
+    global.fini();
+}
@@ -0,0 +1,252 @@
+﻿#include <gtest/gtest.h>
+#include <ncore/sys/socket.h>
+#include <ncore/sys/socket_async_event_args.h>
+#include <ncore/sys/unix_endpoint.h>
+#include <ncore/sys/proactor.h>
+#include "proactor_engine_test.h"
+
+using namespace ncore;
+
+#if defined NCORE_AF_UNIX
+
+class UnixEndPointTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+#if defined NCORE_WINDOWS
+        WORD wsaver = MAKEWORD(2, 2);
+        WSADATA wsadata = {0};
+        WSAStartup(wsaver, &wsadata);
+#endif
+    }
+
+    static void TearDownTestCase()
+    {
+#if defined NCORE_WINDOWS
+        WSACleanup();
+#endif
+    }
+};
+
+static const char * kSocketPath = "ncore_unix_endpoint_test.sock";
+
+TEST_F(UnixEndPointTest, Address)
+{
+    UnixEndPoint unnamed;
+    EXPECT_EQ(AddressFamily::kUnix, unnamed.AddressFamily());
+    EXPECT_TRUE(unnamed.IsUnnamed());
+    EXPECT_FALSE(unnamed.IsAbstract());
+    EXPECT_EQ("", unnamed.Path());
+
+    UnixEndPoint path(kSocketPath);
+    EXPECT_EQ(AddressFamily::kUnix, path.AddressFamily());
+    EXPECT_FALSE(path.IsUnnamed());
+    EXPECT_FALSE(path.IsAbstract());
+    EXPECT_EQ(kSocketPath, path.Path());
+
+    // 路径过长时地址无效
+    std::string long_path(UnixEndPoint::kMaxPathLength + 1, 'x');
+    EXPECT_FALSE(path.SetPath(long_path.c_str()));
+    EXPECT_TRUE(path.IsUnnamed());
+    long_path.resize(UnixEndPoint::kMaxPathLength);
+    EXPECT_TRUE(path.SetPath(long_path.c_str()));
+    EXPECT_EQ(long_path, path.Path());
+
+    // 从IPEndPoint取回，不是AF_UNIX时得到未命名的地址
+    IPEndPoint ep = UnixEndPoint(kSocketPath);
+    EXPECT_EQ(kSocketPath, UnixEndPoint(ep).Path());
+    IPEndPoint iep(IPAddress::kIPLoopback, 80);
+    EXPECT_TRUE(UnixEndPoint(iep).IsUnnamed());
+
+#if defined NCORE_LINUX
+    UnixEndPoint abstract = UnixEndPoint::Abstract("ncore.test");
+    EXPECT_TRUE(abstract.IsAbstract());
+    EXPECT_EQ("ncore.test", abstract.Path());
+#endif
+}
+
+TEST_F(UnixEndPointTest, Stream)
+{
+    remove(kSocketPath);
+    UnixEndPoint uep(kSocketPath);
+
+    Socket listener;
+    ASSERT_TRUE(listener.init(AddressFamily::kUnix,
+                              SocketType::kStream,
+                              ProtocolType::kUnspecificProtocol));
+    ASSERT_TRUE(listener.Bind(uep));
+    ASSERT_TRUE(listener.Listen(1));
+
+    Socket client;
+    ASSERT_TRUE(client.init(AddressFamily::kUnix,
+                            SocketType::kStream,
+                            ProtocolType::kUnspecificProtocol));
+    ASSERT_TRUE(client.Connect(uep));
+    Socket server = listener.Accept(1000);
+    ASSERT_TRUE(server.IsValid());
+
+    char data[8] = {0};
+    uint32_t transfered = 0;
+    ASSERT_TRUE(client.Send("unix", 4, transfered));
+    EXPECT_EQ(4, transfered);
+    ASSERT_TRUE(server.Receive(data, sizeof(data), 1000, transfered));
+    EXPECT_EQ(4, transfered);
+    EXPECT_EQ(0, memcmp(data, "unix", 4));
+
+    // 文件在关闭之后仍然存在，不删除就不能再次绑定
+    client.fini();
+    server.fini();
+    listener.fini();
+    ASSERT_TRUE(listener.init(AddressFamily::kUnix,
+                              SocketType::kStream,
+                              ProtocolType::kUnspecificProtocol));
+    EXPECT_FALSE(listener.Bind(uep));
+    listener.fini();
+    EXPECT_EQ(0, remove(kSocketPath));
+}
+
+#if defined NCORE_LINUX
+// 记录异步操作的完成
+class UnixCompletion
+{
+public:
+    UnixCompletion() : completed(0), errors(0)
+    {
+        adapter.Register(this, &UnixCompletion::OnCompleted);
+    }
+
+    void OnCompleted(SocketAsyncContext & args)
+    {
+        ++completed;
+        if (args.error())
+            ++errors;
+    }
+
+    SocketAsyncResultAdapter<UnixCompletion> adapter;
+    int completed;
+    int errors;
+};
+
+class UnixEndPointAsyncTest : public ProactorEngineTest
+{
+};
+
+TEST_P(UnixEndPointAsyncTest, AbstractAsync)
+{
+    if (EngineUnavailable())
+        return;
+
+    Proactor proactor;
+    ASSERT_TRUE(InitProactor(proactor, GetParam()));
+
+    UnixEndPoint uep = UnixEndPoint::Abstract("ncore.unix_endpoint_test");
+    Socket listener;
+    ASSERT_TRUE(listener.init(AddressFamily::kUnix,
+                              SocketType::kSeqPacket,
+                              ProtocolType::kUnspecificProtocol));
+    ASSERT_TRUE(listener.Bind(uep));
+    ASSERT_TRUE(listener.Listen(1));
+    ASSERT_TRUE(listener.Associate(proactor));
+
+    // 抽象命名空间的地址同时只能绑定一次
+    Socket other;
+    ASSERT_TRUE(other.init(AddressFamily::kUnix,
+                           SocketType::kSeqPacket,
+                           ProtocolType::kUnspecificProtocol));
+    EXPECT_FALSE(other.Bind(uep));
+    other.fini();
+
+    Socket client;
+    ASSERT_TRUE(client.init(AddressFamily::kUnix,
+                            SocketType::kSeqPacket,
+                            ProtocolType::kUnspecificProtocol));
+    ASSERT_TRUE(client.Associate(proactor));
+
+    UnixCompletion completion;
+    Socket server;
+    SocketAsyncContext accept_args;
+    accept_args.set_accept_socket(server);
+    accept_args.set_completion_delegate(&completion.adapter);
+    ASSERT_TRUE(listener.AcceptAsync(accept_args));
+
+    SocketAsyncContext connect_args;
+    connect_args.set_remote_endpoint(uep);
+    connect_args.set_completion_delegate(&completion.adapter);
+    ASSERT_TRUE(client.ConnectAsync(connect_args));
+
+    for (int loop = 0; loop < 100 && completion.completed < 2; ++loop)
+        proactor.Run(10);
+    ASSERT_EQ(2, completion.completed);
+    EXPECT_EQ(0, completion.errors);
+    ASSERT_TRUE(server.IsValid());
+
+    // 没有绑定的客户端是未命名的地址
+    EXPECT_TRUE(UnixEndPoint(accept_args.remote_endpoint()).IsUnnamed());
+
+    // kSeqPacket保留消息边界
+    uint32_t transfered = 0;
+    ASSERT_TRUE(client.Send("first", 5, transfered));
+    ASSERT_TRUE(client.Send("second", 6, transfered));
+    char data[16] = {0};
+    ASSERT_TRUE(server.Receive(data, sizeof(data), 1000, transfered));
+    EXPECT_EQ(5, transfered);
+    ASSERT_TRUE(server.Receive(data, sizeof(data), 1000, transfered));
+    EXPECT_EQ(6, transfered);
+
+    client.fini();
+    server.fini();
+    listener.fini();
+    proactor.fini();
+}
+
+TEST_F(UnixEndPointTest, PassSocket)
+{
+    Socket front, worker;
+    ASSERT_TRUE(Socket::CreatePair(SocketType::kSeqPacket, front, worker));
+    EXPECT_FALSE(Socket::CreatePair(SocketType::kSeqPacket, front, worker));
+
+    // 要交给工作进程的连接
+    Socket local, remote;
+    ASSERT_TRUE(Socket::CreatePair(SocketType::kStream, local, remote));
+
+    uint32_t transfered = 0;
+    EXPECT_FALSE(front.SendSocket(local, 0, 0, transfered));
+    ASSERT_TRUE(front.SendSocket(local, "conn", 4, transfered));
+    EXPECT_EQ(4, transfered);
+    local.fini();
+
+    Socket received;
+    char data[8] = {0};
+    ASSERT_TRUE(worker.ReceiveSocket(received, data, sizeof(data), transfered));
+    EXPECT_EQ(4, transfered);
+    EXPECT_EQ(0, memcmp(data, "conn", 4));
+    ASSERT_TRUE(received.IsValid());
+
+    // 传递过来的套接字与原来的是同一个连接
+    ASSERT_TRUE(received.Send("hi", 2, transfered));
+    ASSERT_TRUE(remote.Receive(data, sizeof(data), 1000, transfered));
+    EXPECT_EQ(2, transfered);
+    EXPECT_EQ(0, memcmp(data, "hi", 2));
+
+    // 不带套接字的消息
+    Socket none;
+    ASSERT_TRUE(front.Send("x", 1, transfered));
+    ASSERT_TRUE(worker.ReceiveSocket(none, data, sizeof(data), transfered));
+    EXPECT_EQ(1, transfered);
+    EXPECT_FALSE(none.IsValid());
+
+    // 对端关闭
+    front.fini();
+    ASSERT_TRUE(worker.ReceiveSocket(none, data, sizeof(data), transfered));
+    EXPECT_EQ(0, transfered);
+
+    received.fini();
+    remote.fini();
+    worker.fini();
+}
+#endif
+
+INSTANTIATE_PROACTOR_ENGINE_TEST(UnixEndPointAsyncTest);
+
+#endif
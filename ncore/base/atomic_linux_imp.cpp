@@ -0,0 +1,74 @@
+﻿#include "atomic.h"
+
+namespace ncore
+{
+
+
+Atomic::~Atomic()
+{
+
+}
+
+Atomic::Atomic() 
+{
+    Exchange(0);
+}
+
+Atomic::Atomic( int value)
+{
+    Exchange(value);
+}
+
+
+int Atomic::operator=( int value)
+{
+    return Exchange(value);
+}
+
+int Atomic::operator+=( int addend)
+{
+    return __sync_add_and_fetch(&value_, addend);
+}
+
+int Atomic::operator-=( int addend)
+{
+    return operator+=(-addend);
+}
+
+int Atomic::operator++()
+{
+    return __sync_add_and_fetch(&value_, 1);
+}
+
+int Atomic::operator--()
+{
+    return __sync_sub_and_fetch(&value_, 1);
+}
+
+int Atomic::CompareExchange(int exchange, int comparand)
+{
+    return __sync_val_compare_and_swap(&value_, comparand, exchange);
+}
+
+int Atomic::Exchange(int exchange)
+{
+    return __atomic_exchange_n(&value_, exchange, __ATOMIC_SEQ_CST);
+}
+
+Atomic::operator int () const
+{
+    return value_;
+}
+
+bool operator==(int left, const Atomic & right)
+{
+    return left == (int)right;
+}
+
+bool operator==(const Atomic & left, int right)
+{
+    return (int)left == right;
+}
+
+
+}
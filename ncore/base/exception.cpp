@@ -1,34 +1,40 @@
-﻿#include "exception.h"
-
-
-namespace ncore
-{
-
-Exception::Exception()
-    : tail_(0)
-{
-    memset(message_, 0, sizeof(message_));
-}
-
-Exception::Exception(const char * message)
-    : tail_(0)
-{
-    set_message(message);
-}
-
-Exception::~Exception()
-{
-}
-
-const char * Exception::message() const
-{
-    return message_;
-}
-
-void Exception::set_message(const char * message)
-{
-    if(message)
-        strncpy_s(message_, message, sizeof(message_));
-}
-
+﻿#include "exception.h"
+
+
+namespace ncore
+{
+
+Exception::Exception()
+    : tail_(0)
+{
+    memset(message_, 0, sizeof(message_));
+}
+
+Exception::Exception(const char * message)
+    : tail_(0)
+{
+    set_message(message);
+}
+
+Exception::~Exception()
+{
+}
+
+const char * Exception::message() const
+{
+    return message_;
+}
+
+void Exception::set_message(const char * message)
+{
+    if(message == 0)
+        return;
+#if defined NCORE_WINDOWS
+    strncpy_s(message_, message, sizeof(message_));
+#else
+    strncpy(message_, message, sizeof(message_) - 1);
+    message_[sizeof(message_) - 1] = 0;
+#endif
+}
+
 }
\ No newline at end of file
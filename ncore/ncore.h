@@ -1,94 +1,145 @@
-﻿#ifndef NSBASE_PLATFORM_H_
-#define NSBASE_PLATFORM_H_
-
-//Toolchain Detection
-#if defined(_MSC_VER)
-  #pragma execution_character_set("utf-8")
-  //MSVC toolchain already imply the target OS
-  #define NCORE_WINDOWS
-  //Platform Detection
-  #if defined(_M_IX86)
-    #define NCORE_X86
-  #elif defined(_M_X64)
-    #define NCORE_X64
-  #endif
-  //Configuration Detection
-  #if defined(NDEBUG)
-    #define NCORE_RELEASE
-  #elif defined(_DEBUG)
-    #define NCORE_DEBUG
-  #endif
-#endif
-
-#if defined NCORE_WINDOWS
-  #define NOMINMAX
-  #include <winsock2.h>
-  //avoiding conflicit with winsock.h
-  #ifndef WIN32_LEAN_AND_MEAN
-    #define WIN32_LEAN_AND_MEAN
-  #endif
-  #include <windows.h>
-  #include <dwmapi.h>
-  #include <windowsx.h>
-  #include <ws2tcpip.h>
-  #include <mswsock.h>
-  #include <shlobj.h>
-  #include <aclapi.h>
-  #include <accctrl.h>
-  #include <sddl.h>
-#else
-  #error Unspported OS
-#endif
-
-#if !defined(NCORE_X86) && !defined(NCORE_X64)
-  #error Unspported Architecture
-#endif
-
-#if !defined(NCORE_DEBUG) && !defined(NCORE_RELEASE)
-  #error Unsupported Configuration
-#endif
-
-
-#include <assert.h>
-#include <ctype.h>
-#include <memory.h>
-#include <process.h>
-#include <stdlib.h>
-#include <stdio.h>
-#include <stdint.h>
-#include <stdarg.h>
-#include <time.h>
-
-#include <algorithm>
-#include <cstdlib>
-#include <list>
-#include <map>
-#include <memory>
-#include <queue>
-#include <set>
-#include <stack>
-#include <sstream>
-#include <string>
-#include <typeinfo>
-#include <utility>
-#include <unordered_map>
-#include <unordered_set>
-#include <vector>
-
-
-namespace ncore
-{
-#ifdef NCORE_WINDOWS
-
-static const size_t kMaxPath16 = 264;
-static const size_t kMaxPath8 = 1048;
-static const size_t kMaxPath = kMaxPath8;
-
-typedef HKEY RegKey;
-
-#endif
-
-
-}
-
+﻿#ifndef NSBASE_PLATFORM_H_
+#define NSBASE_PLATFORM_H_
+
+//Toolchain Detection
+#if defined(_MSC_VER)
+  #pragma execution_character_set("utf-8")
+  //MSVC toolchain already imply the target OS
+  #define NCORE_WINDOWS
+  //Platform Detection
+  #if defined(_M_IX86)
+    #define NCORE_X86
+  #elif defined(_M_X64)
+    #define NCORE_X64
+  #endif
+  //Configuration Detection
+  #if defined(NDEBUG)
+    #define NCORE_RELEASE
+  #elif defined(_DEBUG)
+    #define NCORE_DEBUG
+  #endif
+#elif defined(__GNUC__) && defined(__linux__)
+  #define NCORE_LINUX
+  //Platform Detection
+  #if defined(__i386__)
+    #define NCORE_X86
+  #elif defined(__x86_64__)
+    #define NCORE_X64
+  #endif
+  //Configuration Detection
+  #if defined(NDEBUG)
+    #define NCORE_RELEASE
+  #else
+    #define NCORE_DEBUG
+  #endif
+#endif
+
+#if defined NCORE_WINDOWS
+  #define NOMINMAX
+  #include <winsock2.h>
+  //avoiding conflicit with winsock.h
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #include <windows.h>
+  #include <dwmapi.h>
+  #include <windowsx.h>
+  #include <ws2tcpip.h>
+  #include <mswsock.h>
+  //afunix.h始于Windows 10 1803（RS4）的SDK，v120工具集的8.1 SDK没有，此时不提供UnixEndPoint
+  #if defined NTDDI_WIN10_RS4
+    #include <afunix.h>
+    #define NCORE_AF_UNIX
+  #endif
+  #include <shlobj.h>
+  #include <aclapi.h>
+  #include <accctrl.h>
+  #include <sddl.h>
+  #include <process.h>
+#elif defined NCORE_LINUX
+  #include <arpa/inet.h>
+  #include <errno.h>
+  #include <fcntl.h>
+  #include <limits.h>
+  #include <linux/io_uring.h>
+  #include <netinet/in.h>
+  #include <netinet/tcp.h>
+  #include <netinet/udp.h>
+  #include <poll.h>
+  #include <pthread.h>
+  #include <sched.h>
+  #include <string.h>
+  #include <sys/epoll.h>
+  #include <sys/eventfd.h>
+  #include <sys/mman.h>
+  #include <sys/resource.h>
+  #include <sys/sendfile.h>
+  #include <sys/socket.h>
+  #include <sys/stat.h>
+  #include <sys/statvfs.h>
+  #include <sys/syscall.h>
+  #include <sys/types.h>
+  #include <sys/uio.h>
+  #include <sys/un.h>
+  #define NCORE_AF_UNIX
+  #include <unistd.h>
+#else
+  #error Unspported OS
+#endif
+
+#if !defined(NCORE_X86) && !defined(NCORE_X64)
+  #error Unspported Architecture
+#endif
+
+#if !defined(NCORE_DEBUG) && !defined(NCORE_RELEASE)
+  #error Unsupported Configuration
+#endif
+
+
+#include <assert.h>
+#include <ctype.h>
+#include <memory.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <time.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <map>
+#include <memory>
+#include <queue>
+#include <set>
+#include <stack>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+namespace ncore
+{
+#ifdef NCORE_WINDOWS
+
+static const size_t kMaxPath16 = 264;
+static const size_t kMaxPath8 = 1048;
+static const size_t kMaxPath = kMaxPath8;
+
+typedef HKEY RegKey;
+
+#elif defined NCORE_LINUX
+
+static const size_t kMaxPath = PATH_MAX;
+
+#endif
+
+
+}
+
 #endif
\ No newline at end of file
@@ -1,48 +1,93 @@
-#include "named_event.h"
-#include "async_context.h"
-
-namespace ncore
-{
-
-
-AsyncContext::AsyncContext()
-    : user_token_(0)
-{
-    overlapped_.Internal = 0;
-    overlapped_.InternalHigh = 0;
-    overlapped_.Offset = 0;
-    overlapped_.OffsetHigh = 0;
-    overlapped_.hEvent = 0;
-}
-
-AsyncContext::AsyncContext(const NamedEvent & e)
-    : user_token_(0)
-{
-    overlapped_.Internal = 0;
-    overlapped_.InternalHigh = 0;
-    overlapped_.Offset = 0;
-    overlapped_.OffsetHigh = 0;
-    overlapped_.hEvent = e.WaitableHandle();
-}
-
-void * AsyncContext::user_token() const
-{
-    return user_token_;
-}
-
-void AsyncContext::set_user_token(void * token)
-{
-    user_token_ = token;
-}
-
-void AsyncContext::SuppressIOCP()
-{
-    DWORD value = reinterpret_cast<DWORD>(overlapped_.hEvent);
-    if(value)
-    {
-        value |= 0x1;
-        overlapped_.hEvent = reinterpret_cast<HANDLE>(value);
-    }
-}
-
-}
+#include "async_context.h"
+#if defined NCORE_WINDOWS
+#include "named_event.h"
+#endif
+
+namespace ncore
+{
+
+
+#if defined NCORE_WINDOWS
+
+AsyncContext::AsyncContext()
+    : user_token_(0), submit_time_(0)
+{
+    overlapped_.Internal = 0;
+    overlapped_.InternalHigh = 0;
+    overlapped_.Offset = 0;
+    overlapped_.OffsetHigh = 0;
+    overlapped_.hEvent = 0;
+}
+
+AsyncContext::AsyncContext(const NamedEvent & e)
+    : user_token_(0), submit_time_(0)
+{
+    overlapped_.Internal = 0;
+    overlapped_.InternalHigh = 0;
+    overlapped_.Offset = 0;
+    overlapped_.OffsetHigh = 0;
+    overlapped_.hEvent = e.WaitableHandle();
+}
+
+#elif defined NCORE_LINUX
+
+AsyncContext::AsyncContext()
+    : user_token_(0), submit_time_(0)
+{
+    memset(&request_, 0, sizeof(request_));
+    request_.fd = -1;
+    request_.accepted = -1;
+    request_.buffer_group = -1;
+}
+
+void AsyncContext::PrepareRequest(AsyncRequestOp::Value op, int fd)
+{
+    //offset由上层设置，保持不变
+    int64_t offset = request_.offset;
+    memset(&request_, 0, sizeof(request_));
+    request_.op = op;
+    request_.fd = fd;
+    request_.offset = offset;
+    request_.accepted = -1;
+    request_.buffer_group = -1;
+    request_.msg.msg_iov = &request_.iov;
+    request_.msg.msg_iovlen = 1;
+}
+
+#endif
+
+void * AsyncContext::user_token() const
+{
+    return user_token_;
+}
+
+void AsyncContext::set_user_token(void * token)
+{
+    user_token_ = token;
+}
+
+void AsyncContext::set_timeout(uint32_t ms)
+{
+    deadline_.timeout_ = ms;
+}
+
+uint32_t AsyncContext::timeout() const
+{
+    return deadline_.timeout_;
+}
+
+#if defined NCORE_WINDOWS
+
+void AsyncContext::SuppressIOCP()
+{
+    DWORD value = reinterpret_cast<DWORD>(overlapped_.hEvent);
+    if(value)
+    {
+        value |= 0x1;
+        overlapped_.hEvent = reinterpret_cast<HANDLE>(value);
+    }
+}
+
+#endif
+
+}
@@ -1,31 +1,136 @@
-﻿#ifndef NCORE_SYS_ASYNC_CONTEXT_H_
-#define NCORE_SYS_ASYNC_CONTEXT_H_
-
-#include <ncore/ncore.h>
-
-namespace ncore
-{
-
-
-class NamedEvent;
-
-class AsyncContext
-{
-protected:
-    AsyncContext();
-    AsyncContext(const NamedEvent & e);
-public:
-    void * user_token() const;
-
-    void set_user_token(void * token);
-
-    void SuppressIOCP();
-protected:
-    OVERLAPPED overlapped_;
-    void * user_token_;
-};
-
-
-}
-
-#endif
\ No newline at end of file
+﻿#ifndef NCORE_SYS_ASYNC_CONTEXT_H_
+#define NCORE_SYS_ASYNC_CONTEXT_H_
+
+#include <ncore/ncore.h>
+#include "async_task.h"
+#include "timing_wheel.h"
+
+namespace ncore
+{
+
+
+class NamedEvent;
+class IOPortal;
+class AsyncContext;
+class Proactor;
+class SocketBufferPool;
+
+#if defined NCORE_LINUX
+/*异步请求类型（Linux）
+Linux上没有完成端口，前摄器在就绪时以非阻塞方式执行请求，
+再通过IOPortal::OnCompleted模拟完成通知。
+*/
+namespace AsyncRequestOp
+{
+enum Value
+{
+    kRequestNone = 0,
+    kRequestRead,       //readv/preadv
+    kRequestWrite,      //writev/pwritev
+    kRequestRecvMsg,
+    kRequestSendMsg,
+    kRequestAccept,
+    kRequestConnect,
+    kRequestShutdown,
+    kRequestRecvMMsg,   //recvmmsg，io_uring引擎下先poll再执行
+    kRequestSendMMsg,   //sendmmsg，同上
+    kRequestSendFile,   //报头、sendfile、报尾，同上
+    kRequestSpliceRecv, //splice从套接字到管道，同上
+    kRequestSpliceSend, //splice从管道到套接字，同上
+    kRequestRecvPooled, //从缓冲池取缓冲区后recv，io_uring引擎下由内核选取缓冲区
+};
+}
+
+struct AsyncRequest
+{
+    AsyncRequestOp::Value op;
+    int fd;
+    int flags;              //recvmsg/sendmsg的flags，shutdown的how
+    int64_t offset;         //小于0时使用文件当前位置
+    msghdr msg;             //所有请求的缓冲区都通过msg.msg_iov描述
+    iovec iov;
+    mmsghdr * mmsg;         //recvmmsg/sendmmsg的消息数组
+    unsigned int vlen;
+    int file_fd;            //sendfile的源文件，offset为文件位置
+    uint64_t file_remaining;//尚未发送的文件字节数
+    uint64_t file_sent;     //已经发送的字节数，包括报头和报尾
+    bool file_copying;      //sendfile不可用时改为pread+send
+    int pipe_fd;            //splice的管道，长度为iov.iov_len
+    SocketBufferPool * pool;//接收使用的缓冲池，长度为iov.iov_len
+    int buffer_group;       //io_uring的缓冲区组，为-1时等待可读后从池中取
+    void * pooled;          //装有数据的缓冲区
+    sockaddr * addr;        //accept/connect的地址
+    socklen_t addr_size;
+    int accepted;           //accept得到的新套接字
+    bool started;           //connect已经发起
+    uint32_t error;
+    uint32_t transfered;
+    IOPortal * portal;
+    AsyncContext * next;    //前摄器内部队列
+};
+#endif
+
+//异步请求的超时定时器，嵌在AsyncContext中，到期时取消该请求
+class AsyncDeadline : public AsyncTimer
+{
+public:
+    AsyncDeadline();
+
+    void Run();
+
+private:
+    Proactor * io_;
+    IOPortal * portal_;
+    AsyncContext * args_;
+    uint32_t timeout_;
+    bool expired_;
+
+    friend class AsyncContext;
+    friend class IOPortal;
+};
+
+class AsyncContext
+{
+protected:
+    AsyncContext();
+#if defined NCORE_WINDOWS
+    AsyncContext(const NamedEvent & e);
+#endif
+public:
+    void * user_token() const;
+
+    void set_user_token(void * token);
+
+    /*! 设置异步请求的超时
+    @param[in] ms 毫秒数，0表示不超时。
+    @remark 只对关联了前摄器的对象发起的异步请求有效，在发起请求之前设置，之后的每次请求都会使用。\n
+            请求在超时之前没有完成时被取消，以ERROR_TIMEOUT（Linux上为ETIMEDOUT）完成。\n
+    */
+    void set_timeout(uint32_t ms);
+    uint32_t timeout() const;
+
+#if defined NCORE_WINDOWS
+    void SuppressIOCP();
+#endif
+protected:
+#if defined NCORE_WINDOWS
+    OVERLAPPED overlapped_;
+#elif defined NCORE_LINUX
+    void PrepareRequest(AsyncRequestOp::Value op, int fd);
+
+    AsyncRequest request_;
+#endif
+    void * user_token_;
+    uint64_t submit_time_;          //发起请求的时间，只在统计时记录
+    AsyncCompletion completion_;
+    AsyncDeadline deadline_;
+
+    friend class Proactor;
+    friend class IOPortal;
+    friend class ProactorRoutines;
+};
+
+
+}
+
+#endif
@@ -0,0 +1,219 @@
+﻿#ifndef NCORE_SYS_ASYNC_CONTEXT_POOL_H_
+#define NCORE_SYS_ASYNC_CONTEXT_POOL_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include <type_traits>
+#include "spin_lock.h"
+
+namespace ncore
+{
+
+
+/*! 异步上下文池\n
+按块分配上下文，空闲的上下文挂在池内部的链表上，块直到池析构才释放。\n
+预留足够的数量之后，稳定运行时取出和归还都不分配内存。\n
+通常每个I/O线程持有一个池，在本线程取出；上下文可以在任意线程归还，总是回到取出它的池。\n
+T为SocketAsyncContext、FileStreamAsyncContext、NamedPipeAsyncContext等，需要有默认构造函数。\n
+*/
+template<typename T>
+class AsyncContextPool : public NonCopyableObject
+{
+public:
+    //每次扩充的上下文数量
+    static const size_t kSlabSize = 64;
+
+    /*! 池中上下文的句柄\n
+    析构时把上下文归还给池，可以移动，不能复制。\n
+    发起异步请求后用Detach放弃所有权，在完成回调中以Handle(&args)重新接管，
+    回调返回时上下文即回到池中。\n
+    */
+    class Handle
+    {
+    public:
+        Handle() : context_(0) {}
+
+        //接管Detach出去的上下文
+        explicit Handle(T * context) : context_(context) {}
+
+        Handle(Handle && other) : context_(other.Detach()) {}
+
+        ~Handle()
+        {
+            Reset();
+        }
+
+        Handle & operator=(Handle && other)
+        {
+            if(this != &other)
+            {
+                Reset();
+                context_ = other.Detach();
+            }
+            return *this;
+        }
+
+        T * get() const
+        {
+            return context_;
+        }
+
+        T & operator*() const
+        {
+            assert(context_ != 0);
+            return *context_;
+        }
+
+        T * operator->() const
+        {
+            assert(context_ != 0);
+            return context_;
+        }
+
+        bool empty() const
+        {
+            return context_ == 0;
+        }
+
+        //放弃所有权，请求在途期间上下文不会被归还
+        T * Detach()
+        {
+            T * context = context_;
+            context_ = 0;
+            return context;
+        }
+
+        //归还上下文
+        void Reset()
+        {
+            if(context_)
+            {
+                AsyncContextPool::Release(*context_);
+                context_ = 0;
+            }
+        }
+
+    private:
+        Handle(const Handle &);
+        Handle & operator=(const Handle &);
+
+    private:
+        T * context_;
+    };
+
+public:
+    AsyncContextPool()
+        : free_(0), capacity_(0), available_(0)
+    {
+    }
+
+    ~AsyncContextPool()
+    {
+        //上下文必须全部归还，否则在途的请求会访问已释放的内存
+        assert(available_ == capacity_);
+        for(size_t i = 0; i < slabs_.size(); ++i)
+            delete [] slabs_[i];
+    }
+
+    /*! 预留上下文
+    @param[in] count 池中至少要有的上下文数量，包括已经取出的。
+    @return 成功返回true；内存不足时返回false。
+    */
+    bool Reserve(size_t count)
+    {
+        lock_.Acquire();
+        bool ok = true;
+        while(ok && capacity_ < count)
+            ok = Grow();
+        lock_.Release();
+        return ok;
+    }
+
+    /*! 取出一个上下文
+    @return 上下文处于刚构造的状态；没有空闲的上下文时扩充一块，内存不足时返回空句柄。
+    */
+    Handle Acquire()
+    {
+        lock_.Acquire();
+        if(free_ == 0 && !Grow())
+        {
+            lock_.Release();
+            return Handle();
+        }
+        Node * node = free_;
+        free_ = node->next;
+        --available_;
+        lock_.Release();
+
+        node->next = 0;
+        return Handle(new (&node->storage) T());
+    }
+
+    //把上下文归还给取出它的池，可以在任意线程调用
+    static void Release(T & context)
+    {
+        //storage是Node的第一个成员，上下文的地址即Node的地址
+        Node * node = reinterpret_cast<Node *>(&context);
+        AsyncContextPool * pool = node->pool;
+        assert(pool != 0);
+
+        context.~T();
+
+        pool->lock_.Acquire();
+        node->next = pool->free_;
+        pool->free_ = node;
+        ++pool->available_;
+        pool->lock_.Release();
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    //空闲的上下文数量
+    size_t available() const
+    {
+        return available_;
+    }
+
+private:
+    struct Node
+    {
+        typename std::aligned_storage<sizeof(T),
+                                      std::alignment_of<T>::value>::type storage;
+        AsyncContextPool * pool;
+        Node * next;
+    };
+
+    //在锁内调用
+    bool Grow()
+    {
+        Node * slab = new (std::nothrow) Node[kSlabSize];
+        if(slab == 0)
+            return false;
+
+        slabs_.push_back(slab);
+        for(size_t i = 0; i < kSlabSize; ++i)
+        {
+            slab[i].pool = this;
+            slab[i].next = free_;
+            free_ = &slab[i];
+        }
+        capacity_ += kSlabSize;
+        available_ += kSlabSize;
+        return true;
+    }
+
+private:
+    SpinLock lock_;
+    Node * free_;
+    std::vector<Node *> slabs_;
+    size_t capacity_;
+    size_t available_;
+};
+
+
+}
+
+#endif
@@ -0,0 +1,147 @@
+﻿#ifndef NCORE_SYS_ASYNC_TASK_H_
+#define NCORE_SYS_ASYNC_TASK_H_
+
+#include <ncore/ncore.h>
+
+namespace ncore
+{
+
+
+class IOPortal;
+class AsyncContext;
+
+/*! 可排队执行的任务\n
+任务对象由调用者持有，从投递到执行完毕之间必须保持有效。\n
+排队使用任务内部的指针，投递不分配内存；同一个任务在执行之前不能重复投递。\n
+*/
+class AsyncTask
+{
+protected:
+    AsyncTask() : task_next_(0) {}
+    virtual ~AsyncTask() {}
+
+public:
+    virtual void Run() = 0;
+
+private:
+    AsyncTask * task_next_;
+
+    friend class AsyncTaskQueue;
+};
+
+//AsyncTask的侵入式队列，不加锁
+class AsyncTaskQueue
+{
+public:
+    AsyncTaskQueue() : head_(0), tail_(0) {}
+
+    //追加到队尾，返回追加之前队列是否为空
+    bool Push(AsyncTask & task)
+    {
+        bool was_empty = head_ == 0;
+        task.task_next_ = 0;
+        if(tail_)
+            tail_->task_next_ = &task;
+        else
+            head_ = &task;
+        tail_ = &task;
+        return was_empty;
+    }
+
+    //取走整条队列
+    AsyncTask * TakeAll()
+    {
+        AsyncTask * head = head_;
+        head_ = tail_ = 0;
+        return head;
+    }
+
+    bool empty() const
+    {
+        return head_ == 0;
+    }
+
+    /*! 从TakeAll取走的任务链中取出第一个
+    @remark 任务可能在执行中重新投递自己，因此要先取出再执行。\n
+    */
+    static AsyncTask * Next(AsyncTask *& head)
+    {
+        AsyncTask * task = head;
+        if(task)
+        {
+            head = task->task_next_;
+            task->task_next_ = 0;
+        }
+        return task;
+    }
+
+    //依次执行TakeAll取走的任务，返回执行的数量
+    static size_t Run(AsyncTask * head)
+    {
+        size_t count = 0;
+        while(AsyncTask * task = Next(head))
+        {
+            task->Run();
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    AsyncTask * head_;
+    AsyncTask * tail_;
+};
+
+template<typename T, typename Base = AsyncTask>
+class AsyncTaskAdapter : public Base
+{
+public:
+    typedef void (T::*TF)();
+public:
+    AsyncTaskAdapter()
+        : obj_(0),
+          func_(0)
+    {
+    }
+
+    void Register(T * obj, TF func)
+    {
+        obj_ = obj;
+        func_ = func;
+    }
+
+    void Run()
+    {
+        assert(obj_);
+        assert(func_);
+
+        if(obj_ && func_)
+            (obj_->*func_)();
+    }
+
+private:
+    T * obj_;
+    TF func_;
+};
+
+//被推迟的完成通知，嵌在AsyncContext中
+class AsyncCompletion : public AsyncTask
+{
+public:
+    AsyncCompletion();
+
+    void Run();
+
+private:
+    IOPortal * portal_;
+    AsyncContext * args_;
+    uint32_t error_;
+    uint32_t transfered_;
+
+    friend class IOPortal;
+};
+
+
+}
+
+#endif
@@ -0,0 +1,548 @@
+﻿#include "proactor.h"
+#include "file_stream_async_event_args.h"
+#include "file_stream.h"
+
+namespace ncore
+{
+
+
+static const int kInvalidHandle = -1;
+
+class FileStreamRoutines
+{
+private:
+    friend class FileStream;
+
+    static DateTime TimespecToDateTime(const timespec & ts)
+    {
+        int64_t tick = ts.tv_sec + DateTime::kWindowsEpochDeltaSeconds;
+        tick *= DateTime::kMicrosecondsPerSecond;
+        tick += ts.tv_nsec / 1000;
+        return DateTime(tick);
+    }
+
+    static timespec DateTimeToTimespec(const DateTime & dt)
+    {
+        timespec ts;
+        int64_t tick = dt.tick();
+        int64_t seconds = tick / DateTime::kMicrosecondsPerSecond;
+        seconds -= DateTime::kWindowsEpochDeltaSeconds;
+        ts.tv_sec = static_cast<time_t>(seconds);
+        ts.tv_nsec = static_cast<long>(
+            (tick % DateTime::kMicrosecondsPerSecond) * 1000);
+        return ts;
+    }
+
+    static bool CreateParentDirectory(const char * filename)
+    {
+        char path[kMaxPath];
+        size_t len = strlen(filename);
+        if(len >= kMaxPath)
+            return false;
+        memcpy(path, filename, len + 1);
+
+        char * last = strrchr(path, '/');
+        if(last == 0 || last == path)
+            return true;
+        *last = 0;
+
+        for(char * p = path + 1; *p; ++p)
+        {
+            if(*p != '/')
+                continue;
+            *p = 0;
+            if(mkdir(path, 0755) && errno != EEXIST)
+                return false;
+            *p = '/';
+        }
+        return !mkdir(path, 0755) || errno == EEXIST;
+    }
+
+    static int ToOpenFlags(FileAccess access, FileMode mode, FileOption option)
+    {
+        int flags = O_CLOEXEC | mode;
+        bool readable = (access & FileAccess::kRead) != 0;
+        bool writable = (access & FileAccess::kWrite) != 0;
+        if(readable && writable)
+            flags |= O_RDWR;
+        else if(writable)
+            flags |= O_WRONLY;
+        else
+            flags |= O_RDONLY;
+
+        if((option & FileOption::kWriteThrough) != 0)
+            flags |= O_DSYNC;
+        return flags;
+    }
+
+    static bool LockRange(int fd, int type, uint64_t offset, uint64_t size,
+                          bool wait)
+    {
+        struct flock fl;
+        memset(&fl, 0, sizeof(fl));
+        fl.l_type = static_cast<short>(type);
+        fl.l_whence = SEEK_SET;
+        fl.l_start = static_cast<off_t>(offset);
+        fl.l_len = static_cast<off_t>(size);
+
+        int cmd = wait ? F_OFD_SETLKW : F_OFD_SETLK;
+        while(fcntl(fd, cmd, &fl) < 0)
+        {
+            if(errno != EINTR)
+                return false;
+        }
+        return true;
+    }
+};
+
+
+void FileStream::InvokeIOCompleteRoution()
+{
+    //Linux上没有完成例程，异步操作的回调均在前摄器的Run中执行
+}
+
+FileStream::FileStream()
+    : handle_(kInvalidHandle), io_handler_(0)
+{
+
+}
+
+FileStream::~FileStream()
+{
+    fini();
+}
+
+FileStream::FileStream(FileStream && obj)
+    : handle_(kInvalidHandle), io_handler_(0)
+{
+    std::swap(handle_, obj.handle_);
+    std::swap(io_handler_, obj.io_handler_);
+}
+
+FileStream & FileStream::operator = (FileStream && obj)
+{
+    std::swap(handle_, obj.handle_);
+    std::swap(io_handler_, obj.io_handler_);
+    return *this;
+}
+
+bool FileStream::init(const char * filename,
+                      FileAccess access,
+                      FileShare /*share*/,
+                      FileMode mode,
+                      FileAttribute attr,
+                      FileOption option)
+{
+    if(handle_ != kInvalidHandle)
+        return true;
+
+    if(filename == 0)
+        return false;
+
+    if(mode != FileMode::kOpen)
+    {
+        //先创建目录
+        FileStreamRoutines::CreateParentDirectory(filename);
+    }
+
+    int flags = FileStreamRoutines::ToOpenFlags(access, mode, option);
+    mode_t perm = (attr & FileAttribute::kReadOnly) != 0 ? 0444 : 0644;
+    int fd = open(filename, flags, perm);
+    if(fd < 0)
+        return false;
+
+    if((option & FileOption::kDeleteOnClose) != 0)
+        unlink(filename);
+    if((option & FileOption::kRandomAccess) != 0)
+        posix_fadvise(fd, 0, 0, POSIX_FADV_RANDOM);
+    if((option & FileOption::kSequentialScan) != 0)
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    handle_ = fd;
+    return true;
+}
+
+void FileStream::fini()
+{
+    auto sh = handle_;
+    if(sh != kInvalidHandle)
+    {
+        if(io_handler_)
+            io_handler_->Dissociate(*this);
+        io_handler_ = 0;
+        handle_ = kInvalidHandle;
+        close(sh);
+    }
+}
+
+bool FileStream::Flush()
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    return fsync(handle_) == 0;
+}
+
+bool FileStream::SetFileSize(uint64_t size)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    if(ftruncate(handle_, static_cast<off_t>(size)))
+        return false;
+
+    return lseek(handle_, static_cast<off_t>(size), SEEK_SET) >= 0;
+}
+
+bool FileStream::Truncate()
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    off_t pos = lseek(handle_, 0, SEEK_CUR);
+    if(pos < 0)
+        return false;
+
+    return ftruncate(handle_, pos) == 0;
+}
+
+bool FileStream::Seek(int64_t & position, FilePosition file_position)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    off_t new_pos = lseek(handle_, static_cast<off_t>(position),
+                          file_position);
+    if(new_pos < 0)
+        return false;
+
+    position = new_pos;
+    return true;
+}
+
+bool FileStream::SetFilePos(uint64_t position)
+{
+    return Seek(reinterpret_cast<int64_t&>(position), FilePosition::kBegin);
+}
+
+bool FileStream::Tell(uint64_t & pos) const
+{
+    pos = 0;
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    off_t curr_pos = lseek(handle_, 0, SEEK_CUR);
+    if(curr_pos < 0)
+        return false;
+
+    pos = curr_pos;
+    return true;
+}
+
+bool FileStream::GetFileSize(uint64_t & file_size) const
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    struct stat st;
+    if(fstat(handle_, &st))
+        return false;
+
+    file_size = st.st_size;
+    return true;
+}
+
+bool FileStream::Read(void * data, uint32_t size_to_read,
+                      uint32_t & transfered)
+{
+    uint64_t pos = 0;
+    if(!Tell(pos))
+        return false;
+    if(!Read(data, size_to_read, pos, transfered))
+        return false;
+    int64_t new_pos = pos + transfered;
+    return Seek(new_pos, FilePosition::kBegin);
+}
+
+bool FileStream::Read(void * data, uint32_t size_to_read,
+                      uint64_t offset, uint32_t & transfered)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    if(data == 0)
+        return false;
+
+    //普通文件的读写不会返回EAGAIN，直接调用pread即可
+    ssize_t result = 0;
+    do
+    {
+        result = pread(handle_, data, size_to_read,
+                       static_cast<off_t>(offset));
+    }
+    while(result < 0 && errno == EINTR);
+
+    if(result < 0)
+        return false;
+
+    transfered = static_cast<uint32_t>(result);
+    return true;
+}
+
+bool FileStream::ReadAsync(FileStreamAsyncContext & args)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    if(args.data() == 0)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    args.last_op_ = AsyncFileStreamOp::kAsyncRead;
+    args.PrepareRequest(AsyncRequestOp::kRequestRead, handle_);
+    args.request_.iov.iov_base = args.data();
+    args.request_.iov.iov_len = args.count();
+
+    return io_handler_->Submit(args);
+}
+
+bool FileStream::Write(const void * data, uint32_t size_to_write,
+                       uint32_t & transfered)
+{
+    uint64_t pos = 0;
+    if(!Tell(pos))
+        return false;
+    if(!Write(data, size_to_write, pos, transfered))
+        return false;
+
+    int64_t new_pos = pos + transfered;
+    return Seek(new_pos, FilePosition::kBegin);
+}
+
+bool FileStream::Write(const void * data, uint32_t size_to_write,
+                       uint64_t offset, uint32_t & transfered)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    if(data == 0)
+        return false;
+
+    ssize_t result = 0;
+    do
+    {
+        result = pwrite(handle_, data, size_to_write,
+                        static_cast<off_t>(offset));
+    }
+    while(result < 0 && errno == EINTR);
+
+    if(result < 0)
+        return false;
+
+    transfered = static_cast<uint32_t>(result);
+    return true;
+}
+
+bool FileStream::WriteAsync(FileStreamAsyncContext & args)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    if(args.data() == 0)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    args.last_op_ = AsyncFileStreamOp::kAsyncWrite;
+    args.PrepareRequest(AsyncRequestOp::kRequestWrite, handle_);
+    args.request_.iov.iov_base = args.data();
+    args.request_.iov.iov_len = args.count();
+
+    return io_handler_->Submit(args);
+}
+
+bool FileStream::LockFile(uint64_t offset, uint64_t size)
+{
+    FileLockMode mode;
+    mode.Set(FileLockMode::kExclusiveLock);
+    mode.Set(FileLockMode::kFailImmediately);
+
+    return LockFile(offset, size, mode);
+}
+
+bool FileStream::LockFile(uint64_t offset, uint64_t size,
+                          FileLockMode lock_mode)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    int type = (lock_mode & FileLockMode::kExclusiveLock) != 0 ?
+               F_WRLCK : F_RDLCK;
+    bool wait = (lock_mode & FileLockMode::kFailImmediately) == 0;
+    return FileStreamRoutines::LockRange(handle_, type, offset, size, wait);
+}
+
+bool FileStream::LockFileAsync(FileStreamAsyncContext & args)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    //没有异步的文件锁，总是同步完成
+    args.last_op_ = AsyncFileStreamOp::kAsyncLock;
+    if(!LockFile(args.offset(), args.lock_size(), args.lock_mode()))
+        return false;
+
+    args.OnCompleted(0, 0);
+    return true;
+}
+
+bool FileStream::UnlockFile(uint64_t offset, uint64_t size)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    return FileStreamRoutines::LockRange(handle_, F_UNLCK, offset, size,
+                                         false);
+}
+
+bool FileStream::UnlockFileAsync(FileStreamAsyncContext & args)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    args.last_op_ = AsyncFileStreamOp::kAsyncUnlock;
+    if(!UnlockFile(args.offset(), args.lock_size()))
+        return false;
+
+    args.OnCompleted(0, 0);
+    return true;
+}
+
+bool FileStream::SetCreationTime(const DateTime &)
+{
+    //Linux不支持修改创建时间
+    return false;
+}
+
+bool FileStream::GetCreationTime(DateTime & dt)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+#if defined STATX_BTIME
+    struct statx stx;
+    if(statx(handle_, "", AT_EMPTY_PATH, STATX_BTIME, &stx))
+        return false;
+    if((stx.stx_mask & STATX_BTIME) == 0)
+        return false;
+
+    timespec ts;
+    ts.tv_sec = stx.stx_btime.tv_sec;
+    ts.tv_nsec = stx.stx_btime.tv_nsec;
+    dt = FileStreamRoutines::TimespecToDateTime(ts);
+    return dt.IsValid();
+#else
+    return false;
+#endif
+}
+
+bool FileStream::SetLastAccessTime(const DateTime & dt)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    timespec times[2];
+    times[0] = FileStreamRoutines::DateTimeToTimespec(dt);
+    times[1].tv_sec = 0;
+    times[1].tv_nsec = UTIME_OMIT;
+    return futimens(handle_, times) == 0;
+}
+
+bool FileStream::GetLastAccessTime(DateTime & dt)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    struct stat st;
+    if(fstat(handle_, &st))
+        return false;
+    dt = FileStreamRoutines::TimespecToDateTime(st.st_atim);
+    return dt.IsValid();
+}
+
+bool FileStream::SetLastWriteTime(const DateTime & dt)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    timespec times[2];
+    times[0].tv_sec = 0;
+    times[0].tv_nsec = UTIME_OMIT;
+    times[1] = FileStreamRoutines::DateTimeToTimespec(dt);
+    return futimens(handle_, times) == 0;
+}
+
+bool FileStream::GetLastWriteTime(DateTime & dt)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    struct stat st;
+    if(fstat(handle_, &st))
+        return false;
+    dt = FileStreamRoutines::TimespecToDateTime(st.st_mtim);
+    return dt.IsValid();
+}
+
+bool FileStream::IsValid()
+{
+    return handle_ != kInvalidHandle;
+}
+
+bool FileStream::Cancel()
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    return io_handler_->Cancel(*this);
+}
+
+bool FileStream::Associate(Proactor & io)
+{
+    if(handle_ == kInvalidHandle)
+        return false;
+
+    if(io.Associate(*this))
+    {
+        io_handler_ = &io;
+        return true;
+    }
+    return false;
+}
+
+void * FileStream::GetPlatformHandle()
+{
+    return reinterpret_cast<void *>(static_cast<intptr_t>(handle_));
+}
+
+void FileStream::OnCompleted(AsyncContext & args,
+                             uint32_t error,
+                             uint32_t transfered)
+{
+    auto & file_stream_args = static_cast<FileStreamAsyncContext&>(args);
+    file_stream_args.OnCompleted(error, transfered);
+}
+
+uint32_t FileStream::GetStatsOp(AsyncContext & args)
+{
+    return static_cast<FileStreamAsyncContext&>(args).last_op();
+}
+
+
+}
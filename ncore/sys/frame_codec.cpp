@@ -0,0 +1,459 @@
+﻿#include "frame_codec.h"
+#include "socket.h"
+#if defined NCORE_WINDOWS
+#include "named_pipe.h"
+#endif
+
+namespace ncore
+{
+
+#if defined NCORE_WINDOWS
+static const uint32_t kInvalidError = WSAEINVAL;
+static const uint32_t kNoBufferError = WSAENOBUFS;
+static const uint32_t kTooLargeError = WSAEMSGSIZE;
+static const uint32_t kMalformedError = WSAEINVAL;
+static const uint32_t kResetError = WSAECONNRESET;
+
+static uint32_t GetLastSocketError()
+{
+    return ::WSAGetLastError();
+}
+#elif defined NCORE_LINUX
+static const uint32_t kInvalidError = EINVAL;
+static const uint32_t kNoBufferError = ENOBUFS;
+static const uint32_t kTooLargeError = EMSGSIZE;
+static const uint32_t kMalformedError = EPROTO;
+static const uint32_t kResetError = ECONNRESET;
+
+static uint32_t GetLastSocketError()
+{
+    return errno;
+}
+#endif
+
+
+size_t FrameDecoder::EncodeHeader(FrameFormat::Value format, uint32_t size,
+                                  char * header)
+{
+    auto bytes = reinterpret_cast<uint8_t *>(header);
+    switch(format)
+    {
+    case FrameFormat::kFrameFixed16:
+        if(size > 0xFFFF)
+            return 0;
+        bytes[0] = static_cast<uint8_t>(size >> 8);
+        bytes[1] = static_cast<uint8_t>(size);
+        return 2;
+    case FrameFormat::kFrameFixed32:
+        bytes[0] = static_cast<uint8_t>(size >> 24);
+        bytes[1] = static_cast<uint8_t>(size >> 16);
+        bytes[2] = static_cast<uint8_t>(size >> 8);
+        bytes[3] = static_cast<uint8_t>(size);
+        return 4;
+    case FrameFormat::kFrameVarint:
+        {
+            size_t length = 0;
+            while(size >= 0x80)
+            {
+                bytes[length++] = static_cast<uint8_t>(size | 0x80);
+                size >>= 7;
+            }
+            bytes[length++] = static_cast<uint8_t>(size);
+            return length;
+        }
+    }
+    return 0;
+}
+
+FrameDecoder::FrameDecoder()
+    : format_(FrameFormat::kFrameFixed32), max_frame_size_(0),
+      min_receive_(0), data_(0), capacity_(0),
+      read_(0), write_(0), pending_(0)
+{
+}
+
+FrameDecoder::~FrameDecoder()
+{
+    fini();
+}
+
+bool FrameDecoder::init(FrameFormat::Value format, uint32_t max_frame_size,
+                        size_t capacity)
+{
+    if(data_ || capacity < kMaxHeaderSize)
+        return false;
+
+    data_ = static_cast<char *>(malloc(capacity));
+    if(data_ == 0)
+        return false;
+
+    format_ = format;
+    max_frame_size_ = max_frame_size;
+    min_receive_ = capacity / 4;
+    capacity_ = capacity;
+    read_ = 0;
+    write_ = 0;
+    pending_ = 0;
+    return true;
+}
+
+void FrameDecoder::fini()
+{
+    if(data_ == 0)
+        return;
+
+    free(data_);
+    data_ = 0;
+    capacity_ = 0;
+    read_ = 0;
+    write_ = 0;
+    pending_ = 0;
+}
+
+char * FrameDecoder::Prepare(size_t & size)
+{
+    if(data_ == 0)
+        return 0;
+
+    size_t buffered = write_ - read_;
+    if(buffered == 0)
+    {
+        read_ = 0;
+        write_ = 0;
+    }
+
+    //至少留出min_receive_，已知下一帧的长度时留出整个帧
+    size_t need = min_receive_;
+    if(pending_ > buffered && pending_ - buffered > need)
+        need = pending_ - buffered;
+
+    if(capacity_ - write_ < need)
+    {
+        //只移动不完整的部分，通常远小于缓冲区
+        if(read_)
+        {
+            memmove(data_, data_ + read_, buffered);
+            read_ = 0;
+            write_ = buffered;
+        }
+
+        if(capacity_ - write_ < need)
+        {
+            size_t capacity = capacity_;
+            while(capacity - write_ < need)
+                capacity *= 2;
+
+            auto data = static_cast<char *>(realloc(data_, capacity));
+            if(data == 0)
+                return 0;
+
+            data_ = data;
+            capacity_ = capacity;
+        }
+    }
+
+    size = capacity_ - write_;
+    return data_ + write_;
+}
+
+void FrameDecoder::Commit(size_t size)
+{
+    assert(write_ + size <= capacity_);
+    write_ += size;
+}
+
+FrameStatus::Value FrameDecoder::Next(FrameView & frame)
+{
+    size_t header_size = 0;
+    uint32_t frame_size = 0;
+    FrameStatus::Value status = ParseHeader(header_size, frame_size);
+    if(status != FrameStatus::kFrameReady)
+        return status;
+
+    if(frame_size > max_frame_size_)
+        return FrameStatus::kFrameTooLarge;
+
+    pending_ = header_size + frame_size;
+    if(write_ - read_ < pending_)
+        return FrameStatus::kFrameIncomplete;
+
+    frame.data = data_ + read_ + header_size;
+    frame.size = frame_size;
+    read_ += pending_;
+    pending_ = 0;
+    return FrameStatus::kFrameReady;
+}
+
+size_t FrameDecoder::buffered() const
+{
+    return write_ - read_;
+}
+
+size_t FrameDecoder::capacity() const
+{
+    return capacity_;
+}
+
+FrameStatus::Value FrameDecoder::ParseHeader(size_t & header_size,
+                                             uint32_t & frame_size) const
+{
+    auto bytes = reinterpret_cast<const uint8_t *>(data_ + read_);
+    size_t buffered = write_ - read_;
+    switch(format_)
+    {
+    case FrameFormat::kFrameFixed16:
+        if(buffered < 2)
+            return FrameStatus::kFrameIncomplete;
+        header_size = 2;
+        frame_size = (bytes[0] << 8) | bytes[1];
+        return FrameStatus::kFrameReady;
+    case FrameFormat::kFrameFixed32:
+        if(buffered < 4)
+            return FrameStatus::kFrameIncomplete;
+        header_size = 4;
+        frame_size = (static_cast<uint32_t>(bytes[0]) << 24) |
+                     (static_cast<uint32_t>(bytes[1]) << 16) |
+                     (static_cast<uint32_t>(bytes[2]) << 8) | bytes[3];
+        return FrameStatus::kFrameReady;
+    case FrameFormat::kFrameVarint:
+        {
+            uint32_t value = 0;
+            for(size_t index = 0; index < kMaxHeaderSize; ++index)
+            {
+                if(index == buffered)
+                    return FrameStatus::kFrameIncomplete;
+
+                uint8_t byte = bytes[index];
+                value |= static_cast<uint32_t>(byte & 0x7F) << (7 * index);
+                if(byte & 0x80)
+                    continue;
+
+                //第5个字节只能有低4位
+                if(index == kMaxHeaderSize - 1 && byte > 0x0F)
+                    return FrameStatus::kFrameMalformed;
+
+                header_size = index + 1;
+                frame_size = value;
+                return FrameStatus::kFrameReady;
+            }
+            return FrameStatus::kFrameMalformed;
+        }
+    }
+    return FrameStatus::kFrameMalformed;
+}
+
+
+FrameReader::FrameReader()
+    : socket_(0), pipe_(0), closed_(false), error_(0),
+      frame_count_(0), receive_count_(0)
+{
+    frame_.data = 0;
+    frame_.size = 0;
+    socket_adapter_.Register(this, &FrameReader::OnSocketReceived);
+    socket_args_.set_completion_delegate(&socket_adapter_);
+#if defined NCORE_WINDOWS
+    pipe_adapter_.Register(this, &FrameReader::OnPipeReceived);
+    pipe_args_.set_completion_delegate(&pipe_adapter_);
+#endif
+}
+
+FrameReader::~FrameReader()
+{
+    fini();
+}
+
+bool FrameReader::init(Socket & socket, FrameFormat::Value format,
+                       uint32_t max_frame_size, size_t capacity)
+{
+    if(socket_ || pipe_)
+        return false;
+
+    if(!decoder_.init(format, max_frame_size, capacity))
+        return false;
+
+    socket_ = &socket;
+    return true;
+}
+
+#if defined NCORE_WINDOWS
+bool FrameReader::init(NamedPipe & pipe, FrameFormat::Value format,
+                       uint32_t max_frame_size, size_t capacity)
+{
+    if(socket_ || pipe_)
+        return false;
+
+    if(!decoder_.init(format, max_frame_size, capacity))
+        return false;
+
+    pipe_ = &pipe;
+    return true;
+}
+#endif
+
+void FrameReader::fini()
+{
+    if(socket_ == 0 && pipe_ == 0)
+        return;
+
+    decoder_.fini();
+    socket_ = 0;
+    pipe_ = 0;
+    closed_ = false;
+    error_ = 0;
+}
+
+bool FrameReader::Start()
+{
+    if(socket_ == 0 && pipe_ == 0)
+        return false;
+
+    closed_ = false;
+    error_ = 0;
+    return Submit() == 0;
+}
+
+const char * FrameReader::frame() const
+{
+    return frame_.data;
+}
+
+uint32_t FrameReader::frame_size() const
+{
+    return frame_.size;
+}
+
+bool FrameReader::closed() const
+{
+    return closed_;
+}
+
+uint32_t FrameReader::error() const
+{
+    return error_;
+}
+
+uint64_t FrameReader::frame_count() const
+{
+    return frame_count_;
+}
+
+uint64_t FrameReader::receive_count() const
+{
+    return receive_count_;
+}
+
+void FrameReader::set_completion_delegate(FrameReaderHandler * handler)
+{
+    completion_delegate_ = handler;
+}
+
+uint32_t FrameReader::Submit()
+{
+    size_t size = 0;
+    char * buffer = decoder_.Prepare(size);
+    if(buffer == 0)
+        return kNoBufferError;
+
+    //一次接收不超过32位
+    if(size > 0x7FFFFFFF)
+        size = 0x7FFFFFFF;
+
+    if(socket_)
+    {
+        socket_args_.SetBuffer(buffer, size);
+        if(socket_->ReceiveAsync(socket_args_))
+            return 0;
+
+        uint32_t error = GetLastSocketError();
+        return error ? error : kInvalidError;
+    }
+
+#if defined NCORE_WINDOWS
+    pipe_args_.SetBuffer(buffer, size);
+    if(pipe_->ReadAsync(pipe_args_))
+        return 0;
+
+    uint32_t error = ::GetLastError();
+    return error ? error : kInvalidError;
+#else
+    return kInvalidError;
+#endif
+}
+
+void FrameReader::OnSocketReceived(SocketAsyncContext & args)
+{
+    OnReceived(args.error(), args.transfered());
+}
+
+#if defined NCORE_WINDOWS
+void FrameReader::OnPipeReceived(NamedPipeAsyncContext & args)
+{
+    uint32_t error = args.error();
+    //消息方式的管道中，消息比缓冲区大时剩余的部分下次再读
+    if(error == ERROR_MORE_DATA)
+        error = 0;
+
+    //写入方断开，等同于套接字的对端关闭
+    if(error == ERROR_BROKEN_PIPE)
+    {
+        OnReceived(0, 0);
+        return;
+    }
+
+    OnReceived(error, args.transfered());
+}
+#endif
+
+void FrameReader::OnReceived(uint32_t error, uint32_t transfered)
+{
+    ++receive_count_;
+    if(error)
+    {
+        Close(error);
+        return;
+    }
+
+    //对端关闭，缓冲区中还有不完整的帧时视为连接中断
+    if(transfered == 0)
+    {
+        Close(decoder_.buffered() ? kResetError : 0);
+        return;
+    }
+
+    decoder_.Commit(transfered);
+    while(true)
+    {
+        FrameStatus::Value status = decoder_.Next(frame_);
+        if(status == FrameStatus::kFrameIncomplete)
+            break;
+
+        if(status != FrameStatus::kFrameReady)
+        {
+            Close(status == FrameStatus::kFrameTooLarge ? kTooLargeError :
+                                                          kMalformedError);
+            return;
+        }
+
+        ++frame_count_;
+        completion_delegate_(*this);
+    }
+    frame_.data = 0;
+    frame_.size = 0;
+
+    uint32_t submit_error = Submit();
+    if(submit_error)
+        Close(submit_error);
+}
+
+void FrameReader::Close(uint32_t error)
+{
+    frame_.data = 0;
+    frame_.size = 0;
+    closed_ = true;
+    error_ = error;
+    //回调之后不再访问本对象，回调中可以fini
+    completion_delegate_(*this);
+}
+
+
+}
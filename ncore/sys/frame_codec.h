@@ -0,0 +1,226 @@
+﻿#ifndef NCORE_SYS_FRAME_CODEC_H_
+#define NCORE_SYS_FRAME_CODEC_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include <ncore/utils/async_result_delegate.h>
+#include <ncore/utils/async_result_adapter.h>
+#include "socket_async_event_args.h"
+#if defined NCORE_WINDOWS
+#include "named_pipe_async_event_args.h"
+#endif
+
+namespace ncore
+{
+
+
+class Socket;
+class NamedPipe;
+class FrameReader;
+
+typedef AsyncResultDelegate<FrameReader> FrameReaderDelegate;
+typedef AsyncResultHandler<FrameReader>  FrameReaderHandler;
+
+//帧头的格式，长度不包括帧头本身
+namespace FrameFormat
+{
+enum Value
+{
+    kFrameFixed16,          //2字节，网络字节序
+    kFrameFixed32,          //4字节，网络字节序
+    kFrameVarint,           //1~5字节，每字节低7位，低位在前，最高位表示后面还有
+};
+}
+
+//取帧的结果
+namespace FrameStatus
+{
+enum Value
+{
+    kFrameReady,            //取得一个完整的帧
+    kFrameIncomplete,       //数据不够一帧，需要继续接收
+    kFrameTooLarge,         //帧的长度超过上限
+    kFrameMalformed,        //varint的帧头超过5字节或者超出32位
+};
+}
+
+//一个完整的帧，指向解码器的缓冲区
+struct FrameView
+{
+    const char * data;
+    uint32_t size;
+};
+
+/*! 长度前缀的帧解码器\n
+数据直接接收到内部的缓冲区中，完整的帧以FrameView的形式取出，不复制。
+一次接收可以包含多个帧，一个帧也可以分多次接收。\n
+缓冲区前部已经取出的帧在下一次Prepare时被回收：剩余的不完整的部分移到开头，
+空间不够一个帧时按倍数扩大，所以每个帧总是连续的。\n
+取出的FrameView在下一次Prepare之前有效。\n
+*/
+class FrameDecoder : public NonCopyableObject
+{
+public:
+    static const uint32_t kDefaultMaxFrameSize = 16 * 1024 * 1024;
+    static const size_t kDefaultCapacity = 16 * 1024;
+    //各种格式中最长的帧头
+    static const size_t kMaxHeaderSize = 5;
+
+public:
+    /*! 编码帧头
+    @param[in] format   帧头的格式。
+    @param[in] size     帧的长度，kFrameFixed16时不能超过65535。
+    @param[out] header  至少kMaxHeaderSize字节的缓冲区。
+    @return 帧头的字节数，长度超出格式的范围时返回0。
+    @remark 发送时把帧头和帧体作为两段缓冲区一起提交，例如SocketSendQueue的两条消息。\n
+    */
+    static size_t EncodeHeader(FrameFormat::Value format, uint32_t size,
+                               char * header);
+
+public:
+    FrameDecoder();
+    ~FrameDecoder();
+
+    /*! 初始化
+    @param[in] format           帧头的格式。
+    @param[in] max_frame_size   帧的长度上限，不包括帧头。
+    @param[in] capacity         缓冲区的初始大小，每次接收至少留出它的四分之一。
+    @return 初始化成功后返回true；否则返回false。
+    */
+    bool init(FrameFormat::Value format,
+              uint32_t max_frame_size = kDefaultMaxFrameSize,
+              size_t capacity = kDefaultCapacity);
+
+    void fini();
+
+    /*! 准备接收的空间
+    @param[out] size 可以接收的字节数。
+    @return 接收数据的位置，失败时返回0。
+    @remark 回收已经取出的帧，之前取出的FrameView不再有效。\n
+            已经知道下一帧的长度时，保证空间足够容纳整个帧。\n
+    */
+    char * Prepare(size_t & size);
+
+    //接收完成后提交接收到的字节数
+    void Commit(size_t size);
+
+    /*! 取出下一个帧
+    @param[out] frame 为kFrameReady时是帧的内容，不包括帧头。
+    @return 取帧的结果，kFrameTooLarge和kFrameMalformed之后解码器不能再用，需要重新init。
+    */
+    FrameStatus::Value Next(FrameView & frame);
+
+    //缓冲区中还没有取出的字节数
+    size_t buffered() const;
+
+    size_t capacity() const;
+
+private:
+    //解析位于read_的帧头，数据不够时返回kFrameIncomplete
+    FrameStatus::Value ParseHeader(size_t & header_size, uint32_t & frame_size) const;
+
+private:
+    FrameFormat::Value format_;
+    uint32_t max_frame_size_;
+    size_t min_receive_;
+    char * data_;
+    size_t capacity_;
+    size_t read_;                   //下一个帧的起始位置
+    size_t write_;                  //接收到的数据的结束位置
+    size_t pending_;                //下一帧连同帧头的总长度，未知时为0
+};
+
+/*! 帧接收器\n
+在套接字或者命名管道上连续发起异步接收，每取得一个完整的帧回调一次。
+一次接收到的多个帧在同一个完成中依次回调，之后再发起下一次接收。\n
+回调中以frame()取得帧的内容，只在回调期间有效；closed()为true时是最后一次回调，
+error()为0表示对端在帧的边界上正常关闭，否则为出错的原因：
+帧过长为EMSGSIZE（Windows上为WSAEMSGSIZE），帧头不合法为EPROTO（WSAEINVAL），
+连接在帧的中间断开为ECONNRESET（WSAECONNRESET）。\n
+套接字或者命名管道需要事先关联到前摄器，使用期间不能在上面直接接收。\n
+*/
+class FrameReader : public NonCopyableObject
+{
+public:
+    FrameReader();
+    ~FrameReader();
+
+    /*! 初始化
+    @param[in] socket           已经连接并关联到前摄器的套接字。
+    @param[in] format           帧头的格式。
+    @param[in] max_frame_size   帧的长度上限。
+    @param[in] capacity         缓冲区的初始大小。
+    @return 初始化成功后返回true；否则返回false。
+    */
+    bool init(Socket & socket, FrameFormat::Value format,
+              uint32_t max_frame_size = FrameDecoder::kDefaultMaxFrameSize,
+              size_t capacity = FrameDecoder::kDefaultCapacity);
+
+#if defined NCORE_WINDOWS
+    //在已经连接并关联到前摄器的命名管道上接收
+    bool init(NamedPipe & pipe, FrameFormat::Value format,
+              uint32_t max_frame_size = FrameDecoder::kDefaultMaxFrameSize,
+              size_t capacity = FrameDecoder::kDefaultCapacity);
+#endif
+
+    //必须在closed()的回调之后调用，或者在Start之前调用
+    void fini();
+
+    /*! 开始接收
+    @return 发起接收成功后返回true，之后一定会有closed()的回调；否则返回false，不会回调。
+    @remark 关闭套接字或者管道使接收以错误结束。\n
+    */
+    bool Start();
+
+    //当前帧的内容
+    const char * frame() const;
+    uint32_t frame_size() const;
+
+    bool closed() const;
+    uint32_t error() const;
+
+    //取得的帧数和完成的接收次数，两者之比为每次接收合并的帧数
+    uint64_t frame_count() const;
+    uint64_t receive_count() const;
+
+    void set_completion_delegate(FrameReaderHandler * handler);
+
+private:
+    //成功时返回0，否则返回错误码
+    uint32_t Submit();
+
+    void OnSocketReceived(SocketAsyncContext & args);
+#if defined NCORE_WINDOWS
+    void OnPipeReceived(NamedPipeAsyncContext & args);
+#endif
+
+    //处理一次接收的结果，取出所有完整的帧后继续接收
+    void OnReceived(uint32_t error, uint32_t transfered);
+
+    void Close(uint32_t error);
+
+private:
+    Socket * socket_;
+    NamedPipe * pipe_;
+    FrameDecoder decoder_;
+    FrameView frame_;
+    bool closed_;
+    uint32_t error_;
+    uint64_t frame_count_;
+    uint64_t receive_count_;
+    SocketAsyncContext socket_args_;
+    SocketAsyncResultAdapter<FrameReader> socket_adapter_;
+#if defined NCORE_WINDOWS
+    NamedPipeAsyncContext pipe_args_;
+    NamedPipeAsyncResultAdapter<FrameReader> pipe_adapter_;
+#endif
+    FrameReaderDelegate completion_delegate_;
+};
+
+template <typename Adaptee>
+using FrameReaderAdapter = AsyncResultAdapter<Adaptee, FrameReader>;
+
+
+}
+
+#endif
@@ -0,0 +1,185 @@
+﻿#include "io_portal.h"
+#include "async_context.h"
+#include "strand.h"
+#include "proactor.h"
+#include "thread.h"
+#include "sys_info.h"
+#include "io_stats.h"
+#if defined NCORE_WINDOWS
+#include "named_event.h"
+#endif
+
+namespace ncore
+{
+
+#if defined NCORE_WINDOWS
+static const uint32_t kCanceledError = ERROR_OPERATION_ABORTED;
+static const uint32_t kTimeoutError = ERROR_TIMEOUT;
+
+static void WINAPI FreeCompleteEvent(void * data)
+{
+    delete static_cast<NamedEvent *>(data);
+}
+
+//纤程局部存储在线程退出时回调，用于销毁每个线程的完成事件
+static DWORD complete_event_index = FlsAlloc(FreeCompleteEvent);
+#elif defined NCORE_LINUX
+static const uint32_t kCanceledError = ECANCELED;
+static const uint32_t kTimeoutError = ETIMEDOUT;
+#endif
+
+AsyncCompletion::AsyncCompletion()
+    : portal_(0), args_(0), error_(0), transfered_(0)
+{
+}
+
+void AsyncCompletion::Run()
+{
+    assert(portal_ != 0);
+    assert(args_ != 0);
+    portal_->Complete(*args_, error_, transfered_);
+}
+
+
+AsyncDeadline::AsyncDeadline()
+    : io_(0), portal_(0), args_(0), timeout_(0), expired_(false)
+{
+}
+
+void AsyncDeadline::Run()
+{
+    assert(io_ != 0);
+    expired_ = true;
+    io_->Cancel(*portal_, *args_);
+}
+
+
+IOPortal::IOPortal()
+    : strand_(0), stats_(0)
+{
+}
+
+void IOPortal::set_strand(Strand * strand)
+{
+    strand_ = strand;
+}
+
+Strand * IOPortal::strand() const
+{
+    return strand_;
+}
+
+void IOPortal::set_stats(IOStats * stats)
+{
+    stats_ = stats;
+}
+
+IOStats * IOPortal::stats() const
+{
+    return stats_;
+}
+
+void IOPortal::StartDeadline(Proactor * io, AsyncContext & args)
+{
+    args.submit_time_ = stats_ ? SysInfo::MicroTickCount() : 0;
+
+    AsyncDeadline & deadline = args.deadline_;
+    deadline.expired_ = false;
+    if(io == 0 || deadline.timeout_ == 0)
+        return;
+
+    deadline.io_ = io;
+    deadline.portal_ = this;
+    deadline.args_ = &args;
+    io->SetTimer(deadline, deadline.timeout_);
+}
+
+bool IOPortal::StopDeadline(AsyncContext & args)
+{
+    AsyncDeadline & deadline = args.deadline_;
+    Proactor * io = deadline.io_;
+    if(io == 0)
+        return false;
+
+    //定时器已经到期时，到期处理可能正在其他线程上取消本请求
+    if(!io->CancelTimer(deadline))
+    {
+        while(deadline.firing())
+            Thread::Sleep(0, false);
+    }
+
+    deadline.io_ = 0;
+    return deadline.expired_;
+}
+
+#if defined NCORE_WINDOWS
+NamedEvent * IOPortal::GetCompleteEvent()
+{
+    if(complete_event_index == FLS_OUT_OF_INDEXES)
+        return 0;
+
+    auto complete_event = static_cast<NamedEvent *>(
+        FlsGetValue(complete_event_index));
+    if(complete_event)
+        return complete_event->Reset() ? complete_event : 0;
+
+    complete_event = new NamedEvent;
+    if(!complete_event->init(true, false) ||
+       !FlsSetValue(complete_event_index, complete_event))
+    {
+        delete complete_event;
+        return 0;
+    }
+    return complete_event;
+}
+#endif
+
+void IOPortal::Deliver(AsyncContext & args,
+                       uint32_t error,
+                       uint32_t transfered)
+{
+    //超时引起的取消以超时错误完成
+    if(StopDeadline(args) && error == kCanceledError)
+        error = kTimeoutError;
+
+    if(strand_ == 0)
+    {
+        Complete(args, error, transfered);
+        return;
+    }
+
+    AsyncCompletion & completion = args.completion_;
+    completion.portal_ = this;
+    completion.args_ = &args;
+    completion.error_ = error;
+    completion.transfered_ = transfered;
+    strand_->Post(completion);
+}
+
+void IOPortal::Complete(AsyncContext & args,
+                        uint32_t error,
+                        uint32_t transfered)
+{
+    IOStats * stats = stats_;
+    if(stats == 0)
+    {
+        OnCompleted(args, error, transfered);
+        return;
+    }
+
+    //回调中上下文可能被重用，对象本身也可能被销毁，先取出需要的信息
+    uint32_t op = GetStatsOp(args);
+    uint64_t submit_time = args.submit_time_;
+    uint64_t start_time = SysInfo::MicroTickCount();
+    OnCompleted(args, error, transfered);
+    uint64_t end_time = SysInfo::MicroTickCount();
+    stats->Record(op, submit_time, start_time, end_time, transfered, error);
+}
+
+uint32_t IOPortal::GetStatsOp(AsyncContext & /*args*/)
+{
+    return 0;
+}
+
+
+}
@@ -1,24 +1,83 @@
-#ifndef NCORE_SYS_IO_PORTAL_H_
-#define NCORE_SYS_IO_PORTAL_H_
-
-#include <ncore/ncore.h>
-
-namespace ncore
-{
-
-class AsyncContext;
-
-class IOPortal
-{
-private:
-    virtual void * GetPlatformHandle() = 0;
-    virtual void OnCompleted(AsyncContext & args,
-                             uint32_t error,
-                             uint32_t transfered) = 0;
-
-    friend class Proactor;
-};
-
-}
-
-#endif
\ No newline at end of file
+#ifndef NCORE_SYS_IO_PORTAL_H_
+#define NCORE_SYS_IO_PORTAL_H_
+
+#include <ncore/ncore.h>
+
+namespace ncore
+{
+
+class AsyncContext;
+class Strand;
+class Proactor;
+class NamedEvent;
+class IOStats;
+
+class IOPortal
+{
+protected:
+    IOPortal();
+
+    /*! 发起异步请求之前调用
+    @param[in] io   关联的前摄器，为0时不启动定时器。
+    @param[in] args 请求的上下文，设置了超时时启动定时器。
+    */
+    void StartDeadline(Proactor * io, AsyncContext & args);
+
+    /*! 请求完成或者发起失败时调用，停止定时器
+    @return 定时器已经到期时返回true。
+    @remark 定时器正在到期时等待其执行完毕，返回后上下文才可以重用。\n
+    */
+    bool StopDeadline(AsyncContext & args);
+
+#if defined NCORE_WINDOWS
+    /*! 同步操作等待完成使用的事件
+    @return 已复位的手动复位事件，创建失败时返回0。
+    @remark 每个线程一个，首次使用时创建，线程退出时销毁，同步操作不再每次创建内核对象。\n
+    */
+    static NamedEvent * GetCompleteEvent();
+#endif
+
+public:
+    /*! 设置串行执行器
+    @param[in] strand 为0时完成回调直接在前摄器线程上执行。
+    @remark 设置后，多个线程同时运行前摄器时，该对象的完成回调也不会并发执行。\n
+            应在投递异步请求之前设置。\n
+    */
+    void set_strand(Strand * strand);
+    Strand * strand() const;
+
+    /*! 设置统计
+    @param[in] stats 为0时不统计。
+    @remark 设置后记录每个异步请求的排队延迟、回调耗时和传输字节数，按操作类型汇总到stats。\n
+            多个对象可以共用一个IOStats；stats在对象销毁之前必须保持有效。应在投递异步请求之前设置。\n
+    */
+    void set_stats(IOStats * stats);
+    IOStats * stats() const;
+
+private:
+    virtual void * GetPlatformHandle() = 0;
+    virtual void OnCompleted(AsyncContext & args,
+                             uint32_t error,
+                             uint32_t transfered) = 0;
+
+    //统计使用的操作类型，见IOStats
+    virtual uint32_t GetStatsOp(AsyncContext & args);
+
+    //由前摄器调用，设置了Strand时经由Strand回调
+    void Deliver(AsyncContext & args, uint32_t error, uint32_t transfered);
+
+    //执行完成回调，设置了统计时记录耗时
+    void Complete(AsyncContext & args, uint32_t error, uint32_t transfered);
+
+    Strand * strand_;
+    IOStats * stats_;
+
+    friend class Proactor;
+    friend class ProactorRoutines;
+    friend class AsyncCompletion;
+    friend class AsyncDeadline;
+};
+
+}
+
+#endif
@@ -0,0 +1,109 @@
+﻿#ifndef NCORE_SYS_IO_RING_H_
+#define NCORE_SYS_IO_RING_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+
+#if defined NCORE_LINUX
+
+namespace ncore
+{
+
+
+/*! io_uring的薄封装\n
+直接使用系统调用，不依赖liburing。\n
+提交队列不是线程安全的，由调用者加锁；完成队列只允许一个线程消费。\n
+*/
+class IORing : public NonCopyableObject
+{
+public:
+    IORing();
+    ~IORing();
+
+    /*! 初始化
+    @param[in] entries 提交队列的大小，完成队列为其4倍。
+    @return 初始化成功后返回true；否则返回false。
+    */
+    bool init(uint32_t entries);
+    void fini();
+
+    /*! 获取一个空闲的SQE
+    @return 提交队列已满时返回0。
+    @remark 填写完毕后需要调用Commit才对内核可见。\n
+    */
+    io_uring_sqe * GetSqe();
+
+    //发布已填写的SQE
+    void Commit();
+
+    //已发布但内核尚未取走的SQE数量
+    uint32_t Pending() const;
+
+    //完成队列中尚未取出的事件数量
+    uint32_t Ready() const;
+
+    /*! 提交并等待完成事件
+    @param[in] wait_nr  至少等待的完成事件数，为0时只提交不等待。
+    @param[in] ms       等待的毫秒数，-1表示无限等待。
+    @return 系统调用失败时返回false，超时不算失败。
+    */
+    bool Enter(uint32_t wait_nr, int ms);
+
+    /*! 批量取出完成事件
+    @param[out] cqes    完成事件的缓冲区。
+    @param[in] count    缓冲区能容纳的数量。
+    @return 实际取出的数量，取出后完成队列的空间即被释放。
+    */
+    uint32_t Reap(io_uring_cqe * cqes, uint32_t count);
+
+    //注册稀疏的固定文件表
+    bool RegisterFiles(uint32_t count);
+    bool UpdateFile(uint32_t index, int fd);
+
+    //注册稀疏的固定缓冲区表
+    bool RegisterBuffers(uint32_t count);
+    bool UpdateBuffer(uint32_t index, void * buffer, size_t size);
+
+    /*! 注册提供给内核选取的缓冲区环
+    @param[in] ring     页对齐的io_uring_buf数组，由调用者通过tail发布缓冲区。
+    @param[in] entries  环的大小，为2的幂。
+    @param[in] group    缓冲区组，接收请求通过buf_group引用。
+    @return 注册成功后返回true；内核不支持时返回false。
+    */
+    bool RegisterBufRing(void * ring, uint32_t entries, uint16_t group);
+    bool UnregisterBufRing(uint16_t group);
+
+    int fd() const;
+
+private:
+    bool Register(uint32_t opcode, void * arg, uint32_t nr);
+
+private:
+    int fd_;
+    uint32_t features_;
+
+    void * sq_ring_;
+    size_t sq_ring_size_;
+    void * cq_ring_;
+    size_t cq_ring_size_;
+    io_uring_sqe * sqes_;
+    size_t sqes_size_;
+
+    uint32_t * sq_head_;
+    uint32_t * sq_tail_;
+    uint32_t sq_mask_;
+    uint32_t sq_entries_;
+    uint32_t sqe_tail_;
+
+    uint32_t * cq_head_;
+    uint32_t * cq_tail_;
+    uint32_t cq_mask_;
+    io_uring_cqe * cqes_;
+};
+
+
+}
+
+#endif
+
+#endif
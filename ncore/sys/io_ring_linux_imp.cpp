@@ -0,0 +1,317 @@
+﻿#include "io_ring.h"
+
+namespace ncore
+{
+
+
+class IORingRoutines
+{
+private:
+    friend class IORing;
+
+    static int Setup(uint32_t entries, io_uring_params & params)
+    {
+        return static_cast<int>(syscall(__NR_io_uring_setup, entries,
+                                        &params));
+    }
+
+    static int Enter(int fd, uint32_t to_submit, uint32_t min_complete,
+                     uint32_t flags, void * arg, size_t arg_size)
+    {
+        return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                        min_complete, flags, arg, arg_size));
+    }
+
+    static void * Map(int fd, size_t size, off_t offset)
+    {
+        void * ptr = mmap(0, size, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, fd, offset);
+        return ptr == MAP_FAILED ? 0 : ptr;
+    }
+
+    template<typename T>
+    static T * At(void * base, uint32_t offset)
+    {
+        return reinterpret_cast<T *>(static_cast<char *>(base) + offset);
+    }
+};
+
+
+IORing::IORing()
+    : fd_(-1), features_(0),
+      sq_ring_(0), sq_ring_size_(0),
+      cq_ring_(0), cq_ring_size_(0),
+      sqes_(0), sqes_size_(0),
+      sq_head_(0), sq_tail_(0), sq_mask_(0), sq_entries_(0), sqe_tail_(0),
+      cq_head_(0), cq_tail_(0), cq_mask_(0), cqes_(0)
+{
+}
+
+IORing::~IORing()
+{
+    fini();
+}
+
+bool IORing::init(uint32_t entries)
+{
+    if(fd_ >= 0)
+        return true;
+
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = entries * 4;
+
+    fd_ = IORingRoutines::Setup(entries, params);
+    if(fd_ < 0)
+        return false;
+
+    features_ = params.features;
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_ring_size_ = params.cq_off.cqes +
+                    params.cq_entries * sizeof(io_uring_cqe);
+    if(features_ & IORING_FEAT_SINGLE_MMAP)
+    {
+        sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+        cq_ring_size_ = sq_ring_size_;
+    }
+
+    sq_ring_ = IORingRoutines::Map(fd_, sq_ring_size_, IORING_OFF_SQ_RING);
+    if(sq_ring_ == 0)
+    {
+        fini();
+        return false;
+    }
+
+    if(features_ & IORING_FEAT_SINGLE_MMAP)
+    {
+        cq_ring_ = sq_ring_;
+    }
+    else
+    {
+        cq_ring_ = IORingRoutines::Map(fd_, cq_ring_size_, IORING_OFF_CQ_RING);
+        if(cq_ring_ == 0)
+        {
+            fini();
+            return false;
+        }
+    }
+
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void * sqes = IORingRoutines::Map(fd_, sqes_size_, IORING_OFF_SQES);
+    if(sqes == 0)
+    {
+        fini();
+        return false;
+    }
+    sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+    sq_head_ = IORingRoutines::At<uint32_t>(sq_ring_, params.sq_off.head);
+    sq_tail_ = IORingRoutines::At<uint32_t>(sq_ring_, params.sq_off.tail);
+    sq_mask_ = *IORingRoutines::At<uint32_t>(sq_ring_,
+                                             params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    sqe_tail_ = *sq_tail_;
+
+    //SQE与数组下标一一对应，之后不再修改数组
+    uint32_t * sq_array = IORingRoutines::At<uint32_t>(sq_ring_,
+                                                       params.sq_off.array);
+    for(uint32_t i = 0; i < sq_entries_; ++i)
+        sq_array[i] = i;
+
+    cq_head_ = IORingRoutines::At<uint32_t>(cq_ring_, params.cq_off.head);
+    cq_tail_ = IORingRoutines::At<uint32_t>(cq_ring_, params.cq_off.tail);
+    cq_mask_ = *IORingRoutines::At<uint32_t>(cq_ring_,
+                                             params.cq_off.ring_mask);
+    cqes_ = IORingRoutines::At<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+    return true;
+}
+
+void IORing::fini()
+{
+    if(sqes_)
+    {
+        munmap(sqes_, sqes_size_);
+        sqes_ = 0;
+    }
+
+    if(cq_ring_ && cq_ring_ != sq_ring_)
+        munmap(cq_ring_, cq_ring_size_);
+    cq_ring_ = 0;
+
+    if(sq_ring_)
+    {
+        munmap(sq_ring_, sq_ring_size_);
+        sq_ring_ = 0;
+    }
+
+    if(fd_ >= 0)
+    {
+        close(fd_);
+        fd_ = -1;
+    }
+
+    sq_head_ = sq_tail_ = 0;
+    cq_head_ = cq_tail_ = 0;
+    cqes_ = 0;
+}
+
+io_uring_sqe * IORing::GetSqe()
+{
+    uint32_t head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if(sqe_tail_ - head >= sq_entries_)
+        return 0;
+
+    io_uring_sqe * sqe = &sqes_[sqe_tail_ & sq_mask_];
+    ++sqe_tail_;
+    memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+void IORing::Commit()
+{
+    __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+}
+
+uint32_t IORing::Pending() const
+{
+    uint32_t tail = __atomic_load_n(sq_tail_, __ATOMIC_ACQUIRE);
+    return tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+}
+
+uint32_t IORing::Ready() const
+{
+    uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    return tail - __atomic_load_n(cq_head_, __ATOMIC_RELAXED);
+}
+
+bool IORing::Enter(uint32_t wait_nr, int ms)
+{
+    uint32_t flags = 0;
+    io_uring_getevents_arg arg;
+    __kernel_timespec ts;
+    memset(&arg, 0, sizeof(arg));
+
+    if(wait_nr)
+    {
+        flags |= IORING_ENTER_GETEVENTS;
+        if(ms >= 0)
+        {
+            ts.tv_sec = ms / 1000;
+            ts.tv_nsec = (ms % 1000) * 1000000LL;
+            arg.ts = reinterpret_cast<uint64_t>(&ts);
+        }
+        flags |= IORING_ENTER_EXT_ARG;
+    }
+
+    while(true)
+    {
+        int result = IORingRoutines::Enter(fd_, Pending(), wait_nr, flags,
+                                           wait_nr ? &arg : 0,
+                                           wait_nr ? sizeof(arg) : 0);
+        if(result >= 0)
+            return true;
+
+        if(errno == EINTR)
+            continue;
+
+        //超时或者完成队列溢出时，调用者照常收割即可
+        if(errno == ETIME || errno == EBUSY)
+            return true;
+
+        return false;
+    }
+}
+
+uint32_t IORing::Reap(io_uring_cqe * cqes, uint32_t count)
+{
+    uint32_t head = *cq_head_;
+    uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    uint32_t ready = tail - head;
+    if(ready > count)
+        ready = count;
+
+    for(uint32_t i = 0; i < ready; ++i)
+        cqes[i] = cqes_[(head + i) & cq_mask_];
+
+    if(ready)
+        __atomic_store_n(cq_head_, head + ready, __ATOMIC_RELEASE);
+    return ready;
+}
+
+bool IORing::RegisterFiles(uint32_t count)
+{
+    io_uring_rsrc_register reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.nr = count;
+    reg.flags = IORING_RSRC_REGISTER_SPARSE;
+    return Register(IORING_REGISTER_FILES2, &reg, sizeof(reg));
+}
+
+bool IORing::UpdateFile(uint32_t index, int fd)
+{
+    io_uring_rsrc_update2 update;
+    memset(&update, 0, sizeof(update));
+    update.offset = index;
+    update.data = reinterpret_cast<uint64_t>(&fd);
+    update.nr = 1;
+    return Register(IORING_REGISTER_FILES_UPDATE2, &update, sizeof(update));
+}
+
+bool IORing::RegisterBuffers(uint32_t count)
+{
+    io_uring_rsrc_register reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.nr = count;
+    reg.flags = IORING_RSRC_REGISTER_SPARSE;
+    return Register(IORING_REGISTER_BUFFERS2, &reg, sizeof(reg));
+}
+
+bool IORing::UpdateBuffer(uint32_t index, void * buffer, size_t size)
+{
+    iovec iov;
+    iov.iov_base = buffer;
+    iov.iov_len = size;
+
+    io_uring_rsrc_update2 update;
+    memset(&update, 0, sizeof(update));
+    update.offset = index;
+    update.data = reinterpret_cast<uint64_t>(&iov);
+    update.nr = 1;
+    return Register(IORING_REGISTER_BUFFERS_UPDATE, &update, sizeof(update));
+}
+
+bool IORing::RegisterBufRing(void * ring, uint32_t entries, uint16_t group)
+{
+    io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+    reg.ring_entries = entries;
+    reg.bgid = group;
+    return Register(IORING_REGISTER_PBUF_RING, &reg, 1);
+}
+
+bool IORing::UnregisterBufRing(uint16_t group)
+{
+    io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.bgid = group;
+    return Register(IORING_UNREGISTER_PBUF_RING, &reg, 1);
+}
+
+int IORing::fd() const
+{
+    return fd_;
+}
+
+bool IORing::Register(uint32_t opcode, void * arg, uint32_t nr)
+{
+    if(fd_ < 0)
+        return false;
+
+    return syscall(__NR_io_uring_register, fd_, opcode, arg, nr) >= 0;
+}
+
+
+}
@@ -0,0 +1,103 @@
+﻿#include "io_stats.h"
+
+namespace ncore
+{
+
+
+IOHistogram::IOHistogram()
+    : count(0), sum(0), max(0)
+{
+    memset(buckets, 0, sizeof(buckets));
+}
+
+void IOHistogram::Add(uint64_t value)
+{
+    size_t index = 0;
+    while(value >> index && index < kBuckets - 1)
+        ++index;
+
+    ++buckets[index];
+    ++count;
+    sum += value;
+    if(value > max)
+        max = value;
+}
+
+uint64_t IOHistogram::Mean() const
+{
+    return count ? sum / count : 0;
+}
+
+uint64_t IOHistogram::Percentile(double percent) const
+{
+    if(count == 0)
+        return 0;
+
+    uint64_t rank = static_cast<uint64_t>(count * percent / 100);
+    if(rank >= count)
+        rank = count - 1;
+
+    uint64_t seen = 0;
+    for(size_t index = 0; index < kBuckets; ++index)
+    {
+        seen += buckets[index];
+        if(seen > rank)
+        {
+            //第index个桶的上界为2^index - 1
+            uint64_t upper = (static_cast<uint64_t>(1) << index) - 1;
+            return upper < max ? upper : max;
+        }
+    }
+    return max;
+}
+
+
+IOOpStats::IOOpStats()
+    : errors(0)
+{
+}
+
+
+IOStats::IOStats()
+{
+}
+
+void IOStats::Record(uint32_t op,
+                     uint64_t submit_time,
+                     uint64_t start_time,
+                     uint64_t end_time,
+                     uint32_t bytes,
+                     uint32_t error)
+{
+    if(op >= kMaxOps)
+        op = 0;
+
+    lock_.Acquire();
+    IOOpStats & stats = ops_[op];
+    if(submit_time && start_time >= submit_time)
+        stats.queue_latency.Add(start_time - submit_time);
+    stats.handler_time.Add(end_time - start_time);
+    stats.bytes.Add(bytes);
+    if(error)
+        ++stats.errors;
+    lock_.Release();
+}
+
+void IOStats::Snapshot(IOStatsSnapshot & snapshot) const
+{
+    lock_.Acquire();
+    for(size_t op = 0; op < kMaxOps; ++op)
+        snapshot.ops[op] = ops_[op];
+    lock_.Release();
+}
+
+void IOStats::Reset()
+{
+    lock_.Acquire();
+    for(size_t op = 0; op < kMaxOps; ++op)
+        ops_[op] = IOOpStats();
+    lock_.Release();
+}
+
+
+}
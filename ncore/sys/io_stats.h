@@ -0,0 +1,98 @@
+﻿#ifndef NCORE_SYS_IO_STATS_H_
+#define NCORE_SYS_IO_STATS_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include "spin_lock.h"
+
+namespace ncore
+{
+
+
+/*! 以2的幂分桶的直方图\n
+第0个桶记录0，第i个桶记录[2^(i-1), 2^i)，最后一个桶同时记录更大的值。\n
+*/
+struct IOHistogram
+{
+    static const size_t kBuckets = 32;
+
+    uint64_t buckets[kBuckets];
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+
+    IOHistogram();
+
+    void Add(uint64_t value);
+
+    uint64_t Mean() const;
+
+    /*! 估计分位数
+    @param[in] percent 0到100之间。
+    @return 分位数所在桶的上界，不超过记录到的最大值；没有记录时返回0。
+    */
+    uint64_t Percentile(double percent) const;
+};
+
+//一类异步操作的统计
+struct IOOpStats
+{
+    IOHistogram queue_latency;      //从发起请求到开始回调的微秒数，包括在Strand中排队的时间
+    IOHistogram handler_time;       //完成回调执行的微秒数
+    IOHistogram bytes;              //每次完成传输的字节数
+    uint64_t errors;                //以错误完成的次数
+
+    IOOpStats();
+};
+
+struct IOStatsSnapshot;
+
+/*! 异步操作的延迟和吞吐统计\n
+通过IOPortal::set_stats启用，前摄器在完成时按操作类型记录。
+多个IOPortal可以共用一个IOStats，按前摄器或者用途汇总。\n
+操作类型的含义由IOPortal决定：Socket为SocketAsyncOp::Value，
+FileStream为AsyncFileStreamOp::Value，NamedPipe为AsyncNamedPipeOp::Value。\n
+*/
+class IOStats : public NonCopyableObject
+{
+public:
+    static const size_t kMaxOps = 16;
+
+public:
+    IOStats();
+
+    /*! 记录一次完成
+    @param[in] op           操作类型，超出范围的记为0。
+    @param[in] submit_time  发起请求的时间，为0时不记录排队延迟。
+    @param[in] start_time   开始回调的时间。
+    @param[in] end_time     回调返回的时间。
+    @param[in] bytes        传输的字节数。
+    @param[in] error        错误码。
+    @remark 时间均为SysInfo::MicroTickCount的微秒数。\n
+    */
+    void Record(uint32_t op,
+                uint64_t submit_time,
+                uint64_t start_time,
+                uint64_t end_time,
+                uint32_t bytes,
+                uint32_t error);
+
+    //复制当前的统计，可以在任意线程调用
+    void Snapshot(IOStatsSnapshot & snapshot) const;
+
+    void Reset();
+
+private:
+    mutable SpinLock lock_;
+    IOOpStats ops_[kMaxOps];
+};
+
+struct IOStatsSnapshot
+{
+    IOOpStats ops[IOStats::kMaxOps];
+};
+
+
+}
+
+#endif
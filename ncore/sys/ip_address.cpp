@@ -1,44 +1,462 @@
-﻿#include "ip_address.h"
-
-namespace ncore
-{
-
-
-const uint32_t IPAddress::kIPAny = 0x00000000;
-const uint32_t IPAddress::kIPBroadcast = 0xFFFFFFFF;
-const uint32_t IPAddress::kIPLoopback = 0x7F000001;
-
-IPAddress::IPAddress()
-{
-    memset(&addr_v6_, 0, sizeof(addr_v6_));
-}
-
-IPAddress::IPAddress(uint32_t addr)
-{
-    memset(&addr_v6_, 0, sizeof(addr_v6_));
-    SetAddress(addr);
-}
-
-uint32_t IPAddress::Address() const
-{
-    return ntohl(addr_v4_.S_un.S_addr);
-}
-
-void IPAddress::SetAddress(uint32_t addr)
-{
-    addr_v4_.S_un.S_addr = htonl(addr);
-    addr_size_ = sizeof(addr_v4_);
-}
-
-AddressFamily IPAddress::AddressFamily() const
-{
-    if(addr_size_ == sizeof(addr_v4_))
-        return AddressFamily::kInterNetwork;
-    else if(addr_size_ == sizeof(addr_v6_))
-        return AddressFamily::kInterNetworkV6;
-
-    return AddressFamily::kUnspecificAddressFamily;
-}
-
-
-}
\ No newline at end of file
+﻿#include "ip_address.h"
+#if defined NCORE_LINUX
+#include <net/if.h>
+#endif
+
+namespace ncore
+{
+
+
+const uint32_t IPAddress::kIPAny = 0x00000000;
+const uint32_t IPAddress::kIPBroadcast = 0xFFFFFFFF;
+const uint32_t IPAddress::kIPLoopback = 0x7F000001;
+
+static const char kHexDigits[] = "0123456789abcdef";
+
+//十六进制字符的值，不是十六进制字符时为-1
+static const int8_t kHexValues[256] =
+{
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+static int HexValue(char c)
+{
+    return kHexValues[static_cast<uint8_t>(c)];
+}
+
+//四段十进制，每段0~255，不接受前导0
+static bool ParseIPv4(const char * p, const char * end, uint32_t & value)
+{
+    uint32_t result = 0;
+    for(int part = 0; part < 4; ++part)
+    {
+        if(part)
+        {
+            if(p == end || *p != '.')
+                return false;
+            ++p;
+        }
+
+        const char * start = p;
+        uint32_t octet = 0;
+        while(p < end && *p >= '0' && *p <= '9' && p - start < 3)
+            octet = octet * 10 + (*p++ - '0');
+
+        if(p == start || octet > 255 || (p - start > 1 && *start == '0'))
+            return false;
+        result = (result << 8) | octet;
+    }
+
+    if(p != end)
+        return false;
+
+    value = result;
+    return true;
+}
+
+static bool ParseIPv6(const char * p, const char * end, uint8_t (&bytes)[16])
+{
+    uint16_t groups[8];
+    int count = 0;
+    int gap = -1;                   //::的位置
+
+    if(p < end && *p == ':')
+    {
+        if(end - p < 2 || p[1] != ':')
+            return false;
+        gap = 0;
+        p += 2;
+    }
+
+    while(p < end)
+    {
+        if(count == 8)
+            return false;
+
+        const char * start = p;
+        uint32_t value = 0;
+        int digit = 0;
+        while(p < end && (digit = HexValue(*p)) >= 0 && p - start < 4)
+        {
+            value = (value << 4) | digit;
+            ++p;
+        }
+        if(p == start)
+            return false;
+
+        //最后32位写成IPv4的形式
+        if(p < end && *p == '.')
+        {
+            uint32_t v4 = 0;
+            if(count > 6 || !ParseIPv4(start, end, v4))
+                return false;
+            groups[count++] = static_cast<uint16_t>(v4 >> 16);
+            groups[count++] = static_cast<uint16_t>(v4);
+            p = end;
+            break;
+        }
+
+        groups[count++] = static_cast<uint16_t>(value);
+        if(p == end)
+            break;
+        if(*p != ':')
+            return false;
+        if(++p == end)
+            return false;
+        if(*p == ':')
+        {
+            if(gap >= 0)
+                return false;
+            gap = count;
+            ++p;
+        }
+    }
+
+    //没有::时必须是8组，有::时至少省略一组
+    if(gap < 0 ? count != 8 : count == 8)
+        return false;
+
+    //在::的位置补上省略的0
+    int zeros = gap < 0 ? 0 : 8 - count;
+    int index = 0;
+    for(int group = 0; group <= count; ++group)
+    {
+        if(group == gap)
+        {
+            memset(bytes + index * 2, 0, zeros * 2);
+            index += zeros;
+        }
+        if(group == count)
+            break;
+
+        bytes[index * 2] = static_cast<uint8_t>(groups[group] >> 8);
+        bytes[index * 2 + 1] = static_cast<uint8_t>(groups[group]);
+        ++index;
+    }
+    return true;
+}
+
+//十进制的接口序号，Linux下还可以是接口名
+static bool ParseScope(const char * p, const char * end, uint32_t & scope_id)
+{
+    if(p == end)
+        return false;
+
+    uint64_t value = 0;
+    const char * digit = p;
+    while(digit < end && *digit >= '0' && *digit <= '9' && value <= 0xFFFFFFFF)
+        value = value * 10 + (*digit++ - '0');
+    if(digit == end)
+    {
+        if(value > 0xFFFFFFFF)
+            return false;
+        scope_id = static_cast<uint32_t>(value);
+        return true;
+    }
+
+#if defined NCORE_LINUX
+    char name[IF_NAMESIZE];
+    size_t length = end - p;
+    if(length >= sizeof(name))
+        return false;
+    memcpy(name, p, length);
+    name[length] = 0;
+    scope_id = if_nametoindex(name);
+    return scope_id != 0;
+#else
+    return false;
+#endif
+}
+
+static char * WriteDecimal(char * p, uint32_t value)
+{
+    char digits[10];
+    int count = 0;
+    do
+    {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while(value);
+
+    while(count)
+        *p++ = digits[--count];
+    return p;
+}
+
+static char * WriteIPv4(char * p, const uint8_t * bytes)
+{
+    for(int index = 0; index < 4; ++index)
+    {
+        if(index)
+            *p++ = '.';
+        p = WriteDecimal(p, bytes[index]);
+    }
+    return p;
+}
+
+static char * WriteHex(char * p, uint16_t value)
+{
+    bool leading = true;
+    for(int shift = 12; shift >= 0; shift -= 4)
+    {
+        int digit = (value >> shift) & 0xF;
+        if(leading && digit == 0 && shift)
+            continue;
+        leading = false;
+        *p++ = kHexDigits[digit];
+    }
+    return p;
+}
+
+static char * WriteIPv6(char * p, const uint8_t * bytes)
+{
+    static const uint8_t kMappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+    if(!memcmp(bytes, kMappedPrefix, sizeof(kMappedPrefix)))
+    {
+        memcpy(p, "::ffff:", 7);
+        return WriteIPv4(p + 7, bytes + 12);
+    }
+
+    uint16_t groups[8];
+    for(int index = 0; index < 8; ++index)
+        groups[index] = static_cast<uint16_t>((bytes[index * 2] << 8) | bytes[index * 2 + 1]);
+
+    //最长的一段连续的0，至少两组，一样长时取前面的
+    int best = -1;
+    int best_length = 1;
+    for(int index = 0; index < 8;)
+    {
+        if(groups[index])
+        {
+            ++index;
+            continue;
+        }
+        int start = index;
+        while(index < 8 && groups[index] == 0)
+            ++index;
+        if(index - start > best_length)
+        {
+            best = start;
+            best_length = index - start;
+        }
+    }
+
+    for(int index = 0; index < 8; ++index)
+    {
+        if(index == best)
+        {
+            *p++ = ':';
+            *p++ = ':';
+            index += best_length - 1;
+            continue;
+        }
+        if(index && index != best + best_length)
+            *p++ = ':';
+        p = WriteHex(p, groups[index]);
+    }
+    return p;
+}
+
+//把64位的值打散，用于哈希
+static uint64_t Mix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+bool IPAddress::Parse(const char * text, size_t length, IPAddress & address)
+{
+    if(text == 0)
+        return false;
+
+    const char * end = text + length;
+    const char * colon = static_cast<const char *>(memchr(text, ':', length));
+    if(colon == 0)
+    {
+        uint32_t value = 0;
+        if(!ParseIPv4(text, end, value))
+            return false;
+        address.SetAddress(value);
+        return true;
+    }
+
+    const char * percent = static_cast<const char *>(memchr(text, '%', length));
+    uint32_t scope_id = 0;
+    if(percent && !ParseScope(percent + 1, end, scope_id))
+        return false;
+
+    in6_addr addr;
+    uint8_t (&bytes)[16] = *reinterpret_cast<uint8_t (*)[16]>(&addr);
+    if(!ParseIPv6(text, percent ? percent : end, bytes))
+        return false;
+
+    address.SetAddressV6(addr, scope_id);
+    return true;
+}
+
+bool IPAddress::Parse(const char * text, IPAddress & address)
+{
+    return text ? Parse(text, strlen(text), address) : false;
+}
+
+IPAddress::IPAddress()
+    : addr_size_(0), scope_id_(0)
+{
+    memset(&addr_v6_, 0, sizeof(addr_v6_));
+}
+
+IPAddress::IPAddress(int32_t addr)
+    : scope_id_(0)
+{
+    memset(&addr_v6_, 0, sizeof(addr_v6_));
+    SetAddress(static_cast<uint32_t>(addr));
+}
+
+IPAddress::IPAddress(uint32_t addr)
+    : scope_id_(0)
+{
+    memset(&addr_v6_, 0, sizeof(addr_v6_));
+    SetAddress(addr);
+}
+
+IPAddress::IPAddress(const in6_addr & addr, uint32_t scope_id)
+{
+    SetAddressV6(addr, scope_id);
+}
+
+uint32_t IPAddress::Address() const
+{
+    return ntohl(addr_v4_.s_addr);
+}
+
+void IPAddress::SetAddress(uint32_t addr)
+{
+    memset(&addr_v6_, 0, sizeof(addr_v6_));
+    addr_v4_.s_addr = htonl(addr);
+    addr_size_ = sizeof(addr_v4_);
+    scope_id_ = 0;
+}
+
+const in6_addr & IPAddress::AddressV6() const
+{
+    return addr_v6_;
+}
+
+void IPAddress::SetAddressV6(const in6_addr & addr, uint32_t scope_id)
+{
+    addr_v6_ = addr;
+    addr_size_ = sizeof(addr_v6_);
+    scope_id_ = scope_id;
+}
+
+uint32_t IPAddress::ScopeId() const
+{
+    return scope_id_;
+}
+
+AddressFamily IPAddress::AddressFamily() const
+{
+    if(addr_size_ == sizeof(addr_v4_))
+        return AddressFamily::kInterNetwork;
+    else if(addr_size_ == sizeof(addr_v6_))
+        return AddressFamily::kInterNetworkV6;
+
+    return AddressFamily::kUnspecificAddressFamily;
+}
+
+size_t IPAddress::ToString(char * buffer, size_t size) const
+{
+    char text[kMaxStringLength];
+    char * p = text;
+    auto bytes = reinterpret_cast<const uint8_t *>(&addr_v6_);
+    switch(AddressFamily())
+    {
+    case AddressFamily::kInterNetwork:
+        p = WriteIPv4(p, bytes);
+        break;
+    case AddressFamily::kInterNetworkV6:
+        p = WriteIPv6(p, bytes);
+        if(scope_id_)
+        {
+            *p++ = '%';
+            p = WriteDecimal(p, scope_id_);
+        }
+        break;
+    default:
+        break;
+    }
+
+    size_t length = p - text;
+    if(buffer == 0 || size <= length)
+        return 0;
+
+    memcpy(buffer, text, length);
+    buffer[length] = 0;
+    return length;
+}
+
+std::string IPAddress::ToString() const
+{
+    char text[kMaxStringLength];
+    size_t length = ToString(text, sizeof(text));
+    return std::string(text, length);
+}
+
+size_t IPAddress::Hash() const
+{
+    uint64_t words[2];
+    memcpy(words, &addr_v6_, sizeof(words));
+    if(addr_size_ == sizeof(addr_v4_))
+        return static_cast<size_t>(Mix(Address()));
+
+    uint64_t hash = Mix(words[0] ^ scope_id_);
+    return static_cast<size_t>(Mix(hash ^ words[1]));
+}
+
+bool IPAddress::operator==(const IPAddress & obj) const
+{
+    if(addr_size_ != obj.addr_size_)
+        return false;
+    if(addr_size_ == sizeof(addr_v4_))
+        return addr_v4_.s_addr == obj.addr_v4_.s_addr;
+    return scope_id_ == obj.scope_id_ &&
+           !memcmp(&addr_v6_, &obj.addr_v6_, sizeof(addr_v6_));
+}
+
+bool IPAddress::operator!=(const IPAddress & obj) const
+{
+    return !(*this == obj);
+}
+
+bool IPAddress::operator<(const IPAddress & obj) const
+{
+    if(addr_size_ != obj.addr_size_)
+        return addr_size_ < obj.addr_size_;
+
+    int result = memcmp(&addr_v6_, &obj.addr_v6_, addr_size_);
+    if(result)
+        return result < 0;
+    return scope_id_ < obj.scope_id_;
+}
+
+
+}
@@ -1,37 +1,98 @@
-﻿#ifndef NCORE_SYS_IP_ADDRESS_H_
-#define NCORE_SYS_IP_ADDRESS_H_
-
-#include <ncore/ncore.h>
-#include "network_define.h"
-
-namespace ncore
-{
-
-class IPAddress
-{
-public:
-    static const uint32_t kIPAny;
-    static const uint32_t kIPBroadcast;
-    static const uint32_t kIPLoopback;
-public:
-    IPAddress();
-    IPAddress(int32_t addr);
-    IPAddress(uint32_t addr);
-
-    uint32_t Address() const;
-    void SetAddress(uint32_t addr);
-
-    AddressFamily AddressFamily() const;
-private:
-    size_t addr_size_;
-    union 
-    {
-        in_addr addr_v4_;
-        in6_addr addr_v6_;
-    };
-};
-
-
-}
-
+﻿#ifndef NCORE_SYS_IP_ADDRESS_H_
+#define NCORE_SYS_IP_ADDRESS_H_
+
+#include <ncore/ncore.h>
+#include "network_define.h"
+
+namespace ncore
+{
+
+/*! IP地址\n
+可以是IPv4或者IPv6的地址，IPv6的链路本地地址还可以带有范围（接口序号）。\n
+解析和格式化都是手写的，不分配内存，也不调用inet_pton/inet_ntop；
+可以比较和计算哈希值，用作std::unordered_map等容器的键。\n
+*/
+class IPAddress
+{
+public:
+    static const uint32_t kIPAny;
+    static const uint32_t kIPBroadcast;
+    static const uint32_t kIPLoopback;
+    //ToString需要的最大缓冲区，包括范围和结尾的0
+    static const size_t kMaxStringLength = 64;
+public:
+    /*! 解析IPv4或者IPv6的地址
+    @param[in] text     "192.168.0.1"、"::1"、"fe80::1%2"等，不需要以0结尾。
+    @param[in] length   text的长度。
+    @param[out] address 解析得到的地址。
+    @return 解析成功后返回true；否则返回false，address不变。
+    @remark IPv4只接受四段十进制，不接受前导0；IPv6可以用::省略连续的0，最后32位可以写成IPv4的形式。\n
+            范围可以是十进制的接口序号，Linux下还可以是接口名。\n
+    */
+    static bool Parse(const char * text, size_t length, IPAddress & address);
+
+    //解析以0结尾的字符串
+    static bool Parse(const char * text, IPAddress & address);
+
+public:
+    IPAddress();
+    IPAddress(int32_t addr);
+    IPAddress(uint32_t addr);
+    //初始化成IPv6地址，scope_id为接口序号
+    IPAddress(const in6_addr & addr, uint32_t scope_id = 0);
+
+    uint32_t Address() const;
+    void SetAddress(uint32_t addr);
+
+    //IPv6的地址，IPv4地址时没有意义
+    const in6_addr & AddressV6() const;
+    void SetAddressV6(const in6_addr & addr, uint32_t scope_id = 0);
+
+    //IPv6地址的范围，没有时为0
+    uint32_t ScopeId() const;
+
+    ncore::AddressFamily AddressFamily() const;
+
+    /*! 格式化到调用者的缓冲区
+    @param[out] buffer  存放结果的缓冲区，以0结尾。
+    @param[in] size     缓冲区的大小，kMaxStringLength总是足够的。
+    @return 写入的字符数，不包括结尾的0；缓冲区不够时返回0。
+    @remark IPv6按RFC 5952输出：小写，压缩最长的一段连续的0，IPv4映射的地址写成::ffff:a.b.c.d。\n
+    */
+    size_t ToString(char * buffer, size_t size) const;
+    std::string ToString() const;
+
+    //可以用作哈希表的键
+    size_t Hash() const;
+
+    bool operator==(const IPAddress & obj) const;
+    bool operator!=(const IPAddress & obj) const;
+    //先按地址族，再按地址的字节序，最后按范围排序
+    bool operator<(const IPAddress & obj) const;
+
+private:
+    size_t addr_size_;
+    union 
+    {
+        in_addr addr_v4_;
+        in6_addr addr_v6_;
+    };
+    uint32_t scope_id_;
+};
+
+
+}
+
+namespace std
+{
+template<>
+struct hash<ncore::IPAddress>
+{
+    size_t operator()(const ncore::IPAddress & address) const
+    {
+        return address.Hash();
+    }
+};
+}
+
 #endif //NCORE_SYS_IP_ADDRESS_H_
\ No newline at end of file
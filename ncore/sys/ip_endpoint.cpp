@@ -1,103 +1,314 @@
-﻿#include <ncore/utils/karma.h>
-#include "ip_endpoint.h"
-
-namespace ncore
-{
-
-
-const uint16_t IPEndPoint::kPortAny = 0;
-const IPEndPoint IPEndPoint::kAny(IPAddress::kIPAny, IPEndPoint::kPortAny);
-
-IPEndPoint IPEndPoint::FromSockAddr(const sockaddr & sockaddr)
-{
-    IPEndPoint ep;
-    switch(sockaddr.sa_family)
-    {
-    case AF_INET:
-        {
-            auto v4 = reinterpret_cast<const sockaddr_in *>(&sockaddr);
-            ep.SetAddress(ntohl(v4->sin_addr.S_un.S_addr));
-            ep.SetPort(ntohs(v4->sin_port));
-        }
-        break;
-    }
-    return ep;
-}
-
-IPEndPoint IPEndPoint::FromIPv4(const char * addr)
-{
-    uint32_t ip = 0;
-    uint16_t port = 0;
-
-    if(!addr)
-        return IPEndPoint();
-
-    char litera[32] = {0};
-    Karma::Copy(litera, addr);
-    
-    char * spliter = std::strchr(litera, ':');
-
-    if(spliter)
-    {
-        port = static_cast<uint16_t>(std::atoi(spliter + 1));
-        *spliter = 0;
-    }
-
-    ip = inet_addr(litera);
-
-    return IPEndPoint(ip, port);
-}
-
-IPEndPoint::IPEndPoint()
-{
-    ep_size_ = sizeof(ep_v6_);
-    memset(&ep_v6_, 0, sizeof(ep_v6_));
-}
-
-IPEndPoint::IPEndPoint(uint32_t ip, uint16_t port)
-{  
-    memset(&ep_v6_, 0, sizeof(ep_v6_));
-    ep_.sa_family = AF_INET;
-    ep_v4_.sin_addr.S_un.S_addr = htonl(ip);
-    ep_v4_.sin_port = htons(port);
-    ep_size_ = sizeof(ep_v4_);
-}
-
-IPEndPoint::~IPEndPoint()
-{
-}
-
-void IPEndPoint::SetAddress(uint32_t ip)
-{
-    ep_.sa_family = AF_INET;
-    ep_v4_.sin_addr.S_un.S_addr = htonl(ip);
-    ep_size_ = sizeof(ep_v4_);
-}
-
-void IPEndPoint::SetPort(uint16_t port)
-{
-    ep_v4_.sin_port = htons(port);
-}
-
-IPAddress IPEndPoint::Host() const
-{
-    switch(ep_.sa_family)
-    {
-    case AF_INET:
-        uint32_t addr_v4 = ntohl(ep_v4_.sin_addr.S_un.S_addr);
-        return IPAddress(addr_v4);
-    }
-    return IPAddress();
-}
-
-uint16_t IPEndPoint::Port() const
-{
-    return ntohs(ep_v4_.sin_port);
-}
-
-AddressFamily IPEndPoint::AddressFamily() const
-{
-    return static_cast<ncore::AddressFamily>(ep_.sa_family);
-}
-
+﻿#include "ip_endpoint.h"
+
+namespace ncore
+{
+
+
+const uint16_t IPEndPoint::kPortAny = 0;
+const IPEndPoint IPEndPoint::kAny(IPAddress::kIPAny, IPEndPoint::kPortAny);
+
+IPEndPoint IPEndPoint::FromSockAddr(const sockaddr & sockaddr)
+{
+    IPEndPoint ep;
+    switch(sockaddr.sa_family)
+    {
+    case AF_INET:
+        {
+            auto v4 = reinterpret_cast<const sockaddr_in *>(&sockaddr);
+            ep.SetAddress(ntohl(v4->sin_addr.s_addr));
+            ep.SetPort(ntohs(v4->sin_port));
+        }
+        break;
+    case AF_INET6:
+        {
+            auto v6 = reinterpret_cast<const sockaddr_in6 *>(&sockaddr);
+            ep.ep_v6_ = *v6;
+            ep.ep_size_ = sizeof(ep.ep_v6_);
+        }
+        break;
+    }
+    return ep;
+}
+
+IPEndPoint IPEndPoint::FromIPv4(const char * addr)
+{
+    uint32_t ip = 0;
+    uint16_t port = 0;
+
+    if(!addr)
+        return IPEndPoint();
+
+    //Karma只有Windows的实现，这里直接截断复制
+    char litera[32] = {0};
+    strncpy(litera, addr, sizeof(litera) - 1);
+    
+    char * spliter = std::strchr(litera, ':');
+
+    if(spliter)
+    {
+        port = static_cast<uint16_t>(std::atoi(spliter + 1));
+        *spliter = 0;
+    }
+
+    ip = inet_addr(litera);
+
+    return IPEndPoint(ip, port);
+}
+
+//1~5位十进制，不超过65535
+static bool ParsePort(const char * p, const char * end, uint16_t & port)
+{
+    if(p == end || end - p > 5)
+        return false;
+
+    uint32_t value = 0;
+    for(; p < end; ++p)
+    {
+        if(*p < '0' || *p > '9')
+            return false;
+        value = value * 10 + (*p - '0');
+    }
+    if(value > 0xFFFF)
+        return false;
+
+    port = static_cast<uint16_t>(value);
+    return true;
+}
+
+bool IPEndPoint::Parse(const char * text, size_t length, IPEndPoint & endpoint)
+{
+    if(text == 0 || length == 0)
+        return false;
+
+    const char * end = text + length;
+    const char * host = text;
+    const char * host_end = end;
+    const char * port = 0;
+    if(*text == '[')
+    {
+        //"[addr]"或者"[addr]:port"
+        host = text + 1;
+        host_end = static_cast<const char *>(memchr(host, ']', end - host));
+        if(host_end == 0)
+            return false;
+        if(host_end + 1 != end)
+        {
+            if(host_end[1] != ':')
+                return false;
+            port = host_end + 2;
+        }
+    }
+    else
+    {
+        //只有一个冒号时是IPv4的端口，多个冒号是没有端口的IPv6地址
+        const char * colon = static_cast<const char *>(memchr(text, ':', length));
+        if(colon && !memchr(colon + 1, ':', end - colon - 1))
+        {
+            host_end = colon;
+            port = colon + 1;
+        }
+    }
+
+    uint16_t port_value = 0;
+    if(port && !ParsePort(port, end, port_value))
+        return false;
+
+    IPAddress address;
+    if(!IPAddress::Parse(host, host_end - host, address))
+        return false;
+
+    endpoint = IPEndPoint(address, port_value);
+    return true;
+}
+
+bool IPEndPoint::Parse(const char * text, IPEndPoint & endpoint)
+{
+    return text ? Parse(text, strlen(text), endpoint) : false;
+}
+
+IPEndPoint::IPEndPoint()
+{
+    ep_size_ = sizeof(ep_v6_);
+    memset(&ep_storage_, 0, sizeof(ep_storage_));
+}
+
+IPEndPoint::IPEndPoint(uint32_t ip, uint16_t port)
+{  
+    memset(&ep_storage_, 0, sizeof(ep_storage_));
+    ep_.sa_family = AF_INET;
+    ep_v4_.sin_addr.s_addr = htonl(ip);
+    ep_v4_.sin_port = htons(port);
+    ep_size_ = sizeof(ep_v4_);
+}
+
+IPEndPoint::IPEndPoint(const IPAddress & address, uint16_t port)
+{
+    memset(&ep_storage_, 0, sizeof(ep_storage_));
+    SetAddress(address);
+    SetPort(port);
+}
+
+IPEndPoint::~IPEndPoint()
+{
+}
+
+void IPEndPoint::SetAddress(uint32_t ip)
+{
+    ep_.sa_family = AF_INET;
+    ep_v4_.sin_addr.s_addr = htonl(ip);
+    ep_size_ = sizeof(ep_v4_);
+}
+
+void IPEndPoint::SetAddress(const IPAddress & address)
+{
+    if(address.AddressFamily() != AddressFamily::kInterNetworkV6)
+    {
+        SetAddress(address.Address());
+        return;
+    }
+
+    //sin_port与sin6_port的位置相同，端口不变
+    ep_v6_.sin6_family = AF_INET6;
+    ep_v6_.sin6_flowinfo = 0;
+    ep_v6_.sin6_addr = address.AddressV6();
+    ep_v6_.sin6_scope_id = address.ScopeId();
+    ep_size_ = sizeof(ep_v6_);
+}
+
+void IPEndPoint::SetPort(uint16_t port)
+{
+    ep_v4_.sin_port = htons(port);
+}
+
+IPAddress IPEndPoint::Host() const
+{
+    switch(ep_.sa_family)
+    {
+    case AF_INET:
+        return IPAddress(static_cast<uint32_t>(ntohl(ep_v4_.sin_addr.s_addr)));
+    case AF_INET6:
+        return IPAddress(ep_v6_.sin6_addr, ep_v6_.sin6_scope_id);
+    }
+    return IPAddress();
+}
+
+uint16_t IPEndPoint::Port() const
+{
+    return ntohs(ep_v4_.sin_port);
+}
+
+AddressFamily IPEndPoint::AddressFamily() const
+{
+    return static_cast<ncore::AddressFamily>(ep_.sa_family);
+}
+
+size_t IPEndPoint::ToString(char * buffer, size_t size) const
+{
+    ncore::AddressFamily family = AddressFamily();
+    if(family != kInterNetwork && family != kInterNetworkV6)
+        return 0;
+
+    char text[kMaxStringLength];
+    char * p = text;
+    if(family == kInterNetworkV6)
+        *p++ = '[';
+    p += Host().ToString(p, IPAddress::kMaxStringLength);
+    if(family == kInterNetworkV6)
+        *p++ = ']';
+    *p++ = ':';
+
+    char digits[5];
+    int count = 0;
+    uint16_t port = Port();
+    do
+    {
+        digits[count++] = static_cast<char>('0' + port % 10);
+        port /= 10;
+    } while(port);
+    while(count)
+        *p++ = digits[--count];
+
+    size_t length = p - text;
+    if(buffer == 0 || size <= length)
+        return 0;
+
+    memcpy(buffer, text, length);
+    buffer[length] = 0;
+    return length;
+}
+
+std::string IPEndPoint::ToString() const
+{
+    char text[kMaxStringLength];
+    size_t length = ToString(text, sizeof(text));
+    return std::string(text, length);
+}
+
+size_t IPEndPoint::Hash() const
+{
+    switch(ep_.sa_family)
+    {
+    case AF_INET:
+    case AF_INET6:
+        //地址的哈希已经打散，端口乘以黄金分割数后混入
+        return Host().Hash() ^
+               static_cast<size_t>(Port() * 0x9E3779B97F4A7C15ULL);
+    }
+
+    //FNV-1a
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    auto bytes = reinterpret_cast<const uint8_t *>(&ep_storage_);
+    for(size_t index = 0; index < ep_size_ && index < sizeof(ep_storage_); ++index)
+    {
+        hash ^= bytes[index];
+        hash *= 0x100000001B3ULL;
+    }
+    return static_cast<size_t>(hash);
+}
+
+bool IPEndPoint::operator==(const IPEndPoint & obj) const
+{
+    if(ep_.sa_family != obj.ep_.sa_family)
+        return false;
+
+    switch(ep_.sa_family)
+    {
+    case AF_INET:
+    case AF_INET6:
+        return Port() == obj.Port() && Host() == obj.Host();
+    }
+
+    return ep_size_ == obj.ep_size_ &&
+           !memcmp(&ep_storage_, &obj.ep_storage_, ep_size_);
+}
+
+bool IPEndPoint::operator!=(const IPEndPoint & obj) const
+{
+    return !(*this == obj);
+}
+
+bool IPEndPoint::operator<(const IPEndPoint & obj) const
+{
+    if(ep_.sa_family != obj.ep_.sa_family)
+        return ep_.sa_family < obj.ep_.sa_family;
+
+    switch(ep_.sa_family)
+    {
+    case AF_INET:
+    case AF_INET6:
+        {
+            IPAddress host = Host();
+            IPAddress obj_host = obj.Host();
+            if(host != obj_host)
+                return host < obj_host;
+            return Port() < obj.Port();
+        }
+    }
+
+    if(ep_size_ != obj.ep_size_)
+        return ep_size_ < obj.ep_size_;
+    return memcmp(&ep_storage_, &obj.ep_storage_, ep_size_) < 0;
+}
+
+
 }
\ No newline at end of file
@@ -1,45 +1,98 @@
-﻿#ifndef NCORE_SYS_IP_ENDPOINT_H_
-#define NCORE_SYS_IP_ENDPOINT_H_
-
-#include "ip_address.h"
-
-namespace ncore
-{
-
-
-class IPEndPoint
-{
-public:
-    static const uint16_t kPortAny;
-    static const IPEndPoint kAny;
-public:
-    static IPEndPoint FromSockAddr(const sockaddr & sockaddr);
-    //"127.0.0.1:80"
-    static IPEndPoint FromIPv4(const char * addr);
-public:
-    IPEndPoint();
-    IPEndPoint(uint32_t ip, uint16_t port);//初始化成ipv4地址
-    ~IPEndPoint();
-
-    void SetAddress(uint32_t ip);
-    void SetPort(uint16_t port);
- 
-    IPAddress Host() const;
-    uint16_t Port() const;
-    AddressFamily AddressFamily() const;
-private:
-    size_t ep_size_;
-    union
-    {
-        sockaddr ep_;
-        sockaddr_in ep_v4_;
-        sockaddr_in6 ep_v6_;
-    };
-
-    friend class Socket;
-};
-
-
-}
-
+﻿#ifndef NCORE_SYS_IP_ENDPOINT_H_
+#define NCORE_SYS_IP_ENDPOINT_H_
+
+#include "ip_address.h"
+
+namespace ncore
+{
+
+
+/*! IP地址和端口\n
+可以是IPv4或者IPv6的地址，可以比较和计算哈希值，用作连接表等容器的键。\n
+*/
+class IPEndPoint
+{
+public:
+    static const uint16_t kPortAny;
+    static const IPEndPoint kAny;
+    //ToString需要的最大缓冲区，包括结尾的0
+    static const size_t kMaxStringLength = IPAddress::kMaxStringLength + 8;
+public:
+    static IPEndPoint FromSockAddr(const sockaddr & sockaddr);
+    //"127.0.0.1:80"
+    static IPEndPoint FromIPv4(const char * addr);
+
+    /*! 解析地址和端口
+    @param[in] text     "127.0.0.1:80"、"[::1]:443"、"[fe80::1%2]:80"，不需要以0结尾。
+                        端口可以省略，省略时为0；没有方括号的IPv6地址不能带端口，例如"::1"。
+    @param[in] length   text的长度。
+    @param[out] endpoint 解析得到的地址。
+    @return 解析成功后返回true；否则返回false，endpoint不变。
+    @remark 不分配内存，地址的格式见IPAddress::Parse。\n
+    */
+    static bool Parse(const char * text, size_t length, IPEndPoint & endpoint);
+
+    //解析以0结尾的字符串
+    static bool Parse(const char * text, IPEndPoint & endpoint);
+public:
+    IPEndPoint();
+    IPEndPoint(uint32_t ip, uint16_t port);//初始化成ipv4地址
+    IPEndPoint(const IPAddress & address, uint16_t port);
+    ~IPEndPoint();
+
+    void SetAddress(uint32_t ip);
+    //按address的地址族设置为IPv4或者IPv6的地址，端口不变
+    void SetAddress(const IPAddress & address);
+    void SetPort(uint16_t port);
+ 
+    IPAddress Host() const;
+    uint16_t Port() const;
+    ncore::AddressFamily AddressFamily() const;
+
+    /*! 格式化到调用者的缓冲区
+    @param[out] buffer  存放结果的缓冲区，以0结尾。
+    @param[in] size     缓冲区的大小，kMaxStringLength总是足够的。
+    @return 写入的字符数，不包括结尾的0；缓冲区不够或者不是IP地址时返回0。
+    @remark IPv4为"a.b.c.d:port"，IPv6为"[addr]:port"。\n
+    */
+    size_t ToString(char * buffer, size_t size) const;
+    std::string ToString() const;
+
+    //可以用作哈希表的键，其他地址族（例如UnixEndPoint）按地址的字节计算
+    size_t Hash() const;
+
+    bool operator==(const IPEndPoint & obj) const;
+    bool operator!=(const IPEndPoint & obj) const;
+    //先按地址族，再按地址，最后按端口排序
+    bool operator<(const IPEndPoint & obj) const;
+private:
+    size_t ep_size_;
+    union
+    {
+        sockaddr ep_;
+        sockaddr_in ep_v4_;
+        sockaddr_in6 ep_v6_;
+        sockaddr_storage ep_storage_;   //容纳任何地址族，包括UnixEndPoint
+    };
+
+    friend class Socket;
+    friend class SocketRoutines;
+    friend class UnixEndPoint;
+};
+
+
+}
+
+namespace std
+{
+template<>
+struct hash<ncore::IPEndPoint>
+{
+    size_t operator()(const ncore::IPEndPoint & endpoint) const
+    {
+        return endpoint.Hash();
+    }
+};
+}
+
 #endif
\ No newline at end of file
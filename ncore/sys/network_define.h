@@ -1,38 +1,47 @@
-﻿#ifndef NCORE_SYS_NETWORK_DEFINE_H_
-#define NCORE_SYS_NETWORK_DEFINE_H_
-
-#include <ncore/ncore.h>
-
-namespace ncore
-{
-
-enum AddressFamily
-{
-    kUnknownAddressFamily = -1,
-    kUnspecificAddressFamily = AF_UNSPEC,
-    kInterNetwork = AF_INET,
-    kInterNetworkV6 = AF_INET6,
-};
-
-enum ProtocolType
-{
-    kTCP = IPPROTO_TCP,
-    kUDP = IPPROTO_UDP,
-};
-
-enum SocketType
-{
-    kStream = SOCK_STREAM,
-    kDgram = SOCK_DGRAM,
-};
-
-enum SocketShutdown
-{
-    kReceive = SD_RECEIVE,
-    kSend = SD_SEND,
-    kBoth = SD_BOTH,
-};
-
-}
-
+﻿#ifndef NCORE_SYS_NETWORK_DEFINE_H_
+#define NCORE_SYS_NETWORK_DEFINE_H_
+
+#include <ncore/ncore.h>
+
+namespace ncore
+{
+
+enum AddressFamily
+{
+    kUnknownAddressFamily = -1,
+    kUnspecificAddressFamily = AF_UNSPEC,
+    kInterNetwork = AF_INET,
+    kInterNetworkV6 = AF_INET6,
+    kUnix = AF_UNIX,                //本机进程间通信，地址为UnixEndPoint
+};
+
+enum ProtocolType
+{
+    kUnspecificProtocol = 0,        //由地址族决定，用于kUnix
+    kTCP = IPPROTO_TCP,
+    kUDP = IPPROTO_UDP,
+};
+
+enum SocketType
+{
+    kStream = SOCK_STREAM,
+    kDgram = SOCK_DGRAM,
+    kSeqPacket = SOCK_SEQPACKET,    //保留消息边界的连接，Windows不支持
+};
+
+enum SocketShutdown
+{
+#if defined NCORE_WINDOWS
+    kReceive = SD_RECEIVE,
+    kSend = SD_SEND,
+    kBoth = SD_BOTH,
+#elif defined NCORE_LINUX
+    kReceive = SHUT_RD,
+    kSend = SHUT_WR,
+    kBoth = SHUT_RDWR,
+#endif
+};
+
+}
+
 #endif
\ No newline at end of file
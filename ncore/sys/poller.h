@@ -0,0 +1,129 @@
+﻿#ifndef NCORE_SYS_POLLER_H_
+#define NCORE_SYS_POLLER_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include <ncore/base/atomic.h>
+#include "spin_lock.h"
+
+namespace ncore
+{
+
+
+class Socket;
+
+//关注的就绪事件，可以组合
+namespace PollEvent
+{
+enum Value
+{
+    kPollReadable = 1,
+    kPollWritable = 2,
+    kPollError = 4,         //只出现在结果中，总是报告
+    kPollHangup = 8,        //只出现在结果中，总是报告
+};
+}
+
+//触发方式，kPollEdge和kPollOneShot可以组合
+namespace PollMode
+{
+enum Value
+{
+    kPollLevel = 0,         //水平触发，就绪期间每次等待都报告
+    kPollEdge = 1,          //边缘触发，状态变为就绪时报告一次
+    kPollOneShot = 2,       //报告一次后停止关注，以Modify重新启用
+};
+}
+
+//一个就绪事件
+struct PollResult
+{
+    void * token;           //注册时传入的值
+    uint32_t events;        //PollEvent的组合
+};
+
+/*! 就绪通知\n
+把许多套接字注册到一个对象上，一次等待取回一批就绪事件，用于不使用完成模型的反应器式组件。\n
+Linux下使用epoll，还可以注册eventfd、管道等任意文件描述符；
+Windows下使用WSAPoll，只支持套接字，没有边缘触发，kPollEdge按水平触发处理，
+kPollOneShot在报告之后由本对象停止关注。\n
+注册、修改和注销可以在其他线程上与Wait同时进行，Windows下从下一次Wait开始生效。\n
+*/
+class Poller : public NonCopyableObject
+{
+public:
+    //Wait一次最多取回的事件数
+    static const size_t kMaxResults = 256;
+
+public:
+    Poller();
+    ~Poller();
+
+    bool init();
+    void fini();
+
+    /*! 注册套接字
+    @param[in] socket   套接字，必须已经初始化，注销之前不能关闭。
+    @param[in] events   关注的事件，PollEvent::kPollReadable、kPollWritable的组合。
+    @param[in] mode     触发方式，PollMode的组合。
+    @param[in] token    就绪时在PollResult中返回。
+    @return 注册成功后返回true；已经注册过或者失败时返回false。
+    */
+    bool Add(Socket & socket, uint32_t events, uint32_t mode, void * token);
+
+    /*! 修改关注的事件
+    @remark kPollOneShot的套接字报告之后需要调用此方法重新启用。\n
+    */
+    bool Modify(Socket & socket, uint32_t events, uint32_t mode, void * token);
+
+    bool Remove(Socket & socket);
+
+#if defined NCORE_LINUX
+    //注册任意的文件描述符，例如eventfd、管道
+    bool Add(int fd, uint32_t events, uint32_t mode, void * token);
+    bool Modify(int fd, uint32_t events, uint32_t mode, void * token);
+    bool Remove(int fd);
+#endif
+
+    /*! 等待就绪事件
+    @param[in] results  存放就绪事件的数组。
+    @param[in] count    数组的大小，超过kMaxResults时按kMaxResults处理。
+    @param[in] ms       等待的毫秒数，为-1时一直等待。
+    @return 取回的事件数，超时返回0，出错返回-1。
+    */
+    int Wait(PollResult * results, size_t count, int ms);
+
+    //注册的个数
+    size_t size() const;
+
+private:
+#if defined NCORE_LINUX
+    bool Control(int op, int fd, uint32_t events, uint32_t mode, void * token);
+#elif defined NCORE_WINDOWS
+    struct Entry
+    {
+        SOCKET socket;
+        uint32_t events;
+        uint32_t mode;
+        void * token;
+    };
+
+    //在锁内调用，没有时返回entries_.size()
+    size_t Find(SOCKET socket) const;
+#endif
+
+private:
+#if defined NCORE_LINUX
+    int epoll_fd_;
+    Atomic count_;
+#elif defined NCORE_WINDOWS
+    mutable SpinLock lock_;
+    std::vector<Entry> entries_;
+    bool initialized_;
+#endif
+};
+
+
+}
+
+#endif
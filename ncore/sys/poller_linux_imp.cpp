@@ -0,0 +1,152 @@
+﻿#include "poller.h"
+#include "socket.h"
+
+namespace ncore
+{
+
+
+static uint32_t ToEpollEvents(uint32_t events, uint32_t mode)
+{
+    uint32_t result = 0;
+    if(events & PollEvent::kPollReadable)
+        result |= EPOLLIN | EPOLLRDHUP;
+    if(events & PollEvent::kPollWritable)
+        result |= EPOLLOUT;
+    if(mode & PollMode::kPollEdge)
+        result |= EPOLLET;
+    if(mode & PollMode::kPollOneShot)
+        result |= EPOLLONESHOT;
+    return result;
+}
+
+static uint32_t FromEpollEvents(uint32_t events)
+{
+    uint32_t result = 0;
+    if(events & EPOLLIN)
+        result |= PollEvent::kPollReadable;
+    if(events & EPOLLOUT)
+        result |= PollEvent::kPollWritable;
+    if(events & EPOLLERR)
+        result |= PollEvent::kPollError;
+    if(events & (EPOLLHUP | EPOLLRDHUP))
+        result |= PollEvent::kPollHangup;
+    return result;
+}
+
+
+Poller::Poller()
+    : epoll_fd_(-1)
+{
+    count_ = 0;
+}
+
+Poller::~Poller()
+{
+    fini();
+}
+
+bool Poller::init()
+{
+    if(epoll_fd_ != -1)
+        return false;
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    return epoll_fd_ != -1;
+}
+
+void Poller::fini()
+{
+    if(epoll_fd_ == -1)
+        return;
+
+    close(epoll_fd_);
+    epoll_fd_ = -1;
+    count_ = 0;
+}
+
+bool Poller::Add(Socket & socket, uint32_t events, uint32_t mode, void * token)
+{
+    return Add(socket.s_, events, mode, token);
+}
+
+bool Poller::Modify(Socket & socket, uint32_t events, uint32_t mode,
+                    void * token)
+{
+    return Modify(socket.s_, events, mode, token);
+}
+
+bool Poller::Remove(Socket & socket)
+{
+    return Remove(socket.s_);
+}
+
+bool Poller::Add(int fd, uint32_t events, uint32_t mode, void * token)
+{
+    if(!Control(EPOLL_CTL_ADD, fd, events, mode, token))
+        return false;
+
+    ++count_;
+    return true;
+}
+
+bool Poller::Modify(int fd, uint32_t events, uint32_t mode, void * token)
+{
+    return Control(EPOLL_CTL_MOD, fd, events, mode, token);
+}
+
+bool Poller::Remove(int fd)
+{
+    if(epoll_fd_ == -1 || fd == -1)
+        return false;
+
+    //2.6.9之前的内核要求非空的event
+    epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    if(epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, &ev))
+        return false;
+
+    --count_;
+    return true;
+}
+
+int Poller::Wait(PollResult * results, size_t count, int ms)
+{
+    if(epoll_fd_ == -1 || results == 0 || count == 0)
+        return -1;
+
+    if(count > kMaxResults)
+        count = kMaxResults;
+
+    epoll_event events[kMaxResults];
+    int result = epoll_wait(epoll_fd_, events, static_cast<int>(count), ms);
+    if(result < 0)
+        return errno == EINTR ? 0 : -1;
+
+    for(int index = 0; index < result; ++index)
+    {
+        results[index].token = events[index].data.ptr;
+        results[index].events = FromEpollEvents(events[index].events);
+    }
+    return result;
+}
+
+size_t Poller::size() const
+{
+    return static_cast<size_t>(static_cast<int>(count_));
+}
+
+bool Poller::Control(int op, int fd, uint32_t events, uint32_t mode,
+                     void * token)
+{
+    if(epoll_fd_ == -1 || fd == -1)
+        return false;
+
+    epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = ToEpollEvents(events, mode);
+    ev.data.ptr = token;
+    return epoll_ctl(epoll_fd_, op, fd, &ev) == 0;
+}
+
+
+}
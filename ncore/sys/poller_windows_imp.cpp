@@ -0,0 +1,198 @@
+﻿#include "poller.h"
+#include "socket.h"
+#include "thread.h"
+
+namespace ncore
+{
+
+
+//WSAPoll不接受POLLPRI，只关注普通数据
+static SHORT ToPollEvents(uint32_t events)
+{
+    SHORT result = 0;
+    if(events & PollEvent::kPollReadable)
+        result |= POLLRDNORM;
+    if(events & PollEvent::kPollWritable)
+        result |= POLLWRNORM;
+    return result;
+}
+
+static uint32_t FromPollEvents(SHORT events)
+{
+    uint32_t result = 0;
+    if(events & POLLRDNORM)
+        result |= PollEvent::kPollReadable;
+    if(events & POLLWRNORM)
+        result |= PollEvent::kPollWritable;
+    if(events & (POLLERR | POLLNVAL))
+        result |= PollEvent::kPollError;
+    if(events & POLLHUP)
+        result |= PollEvent::kPollHangup;
+    return result;
+}
+
+
+Poller::Poller()
+    : initialized_(false)
+{
+}
+
+Poller::~Poller()
+{
+    fini();
+}
+
+bool Poller::init()
+{
+    if(initialized_)
+        return false;
+
+    initialized_ = true;
+    return true;
+}
+
+void Poller::fini()
+{
+    if(!initialized_)
+        return;
+
+    lock_.Acquire();
+    entries_.clear();
+    lock_.Release();
+    initialized_ = false;
+}
+
+bool Poller::Add(Socket & socket, uint32_t events, uint32_t mode, void * token)
+{
+    if(!initialized_ || socket.s_ == INVALID_SOCKET)
+        return false;
+
+    lock_.Acquire();
+    bool added = Find(socket.s_) == entries_.size();
+    if(added)
+    {
+        Entry entry = {socket.s_, events, mode, token};
+        entries_.push_back(entry);
+    }
+    lock_.Release();
+    return added;
+}
+
+bool Poller::Modify(Socket & socket, uint32_t events, uint32_t mode,
+                    void * token)
+{
+    if(!initialized_)
+        return false;
+
+    lock_.Acquire();
+    size_t index = Find(socket.s_);
+    bool found = index != entries_.size();
+    if(found)
+    {
+        entries_[index].events = events;
+        entries_[index].mode = mode;
+        entries_[index].token = token;
+    }
+    lock_.Release();
+    return found;
+}
+
+bool Poller::Remove(Socket & socket)
+{
+    if(!initialized_)
+        return false;
+
+    lock_.Acquire();
+    size_t index = Find(socket.s_);
+    bool found = index != entries_.size();
+    if(found)
+    {
+        entries_[index] = entries_.back();
+        entries_.pop_back();
+    }
+    lock_.Release();
+    return found;
+}
+
+int Poller::Wait(PollResult * results, size_t count, int ms)
+{
+    if(!initialized_ || results == 0 || count == 0)
+        return -1;
+
+    //在锁外等待，等待期间的修改从下一次Wait开始生效
+    std::vector<WSAPOLLFD> fds;
+    std::vector<void *> tokens;
+    lock_.Acquire();
+    fds.reserve(entries_.size());
+    tokens.reserve(entries_.size());
+    for(size_t index = 0; index < entries_.size(); ++index)
+    {
+        const Entry & entry = entries_[index];
+        //报告过的kPollOneShot不再关注
+        if(entry.events == 0)
+            continue;
+
+        WSAPOLLFD fd = {0};
+        fd.fd = entry.socket;
+        fd.events = ToPollEvents(entry.events);
+        fds.push_back(fd);
+        tokens.push_back(entry.token);
+    }
+    lock_.Release();
+
+    //WSAPoll不接受空的数组
+    if(fds.empty())
+    {
+        if(ms > 0)
+            Thread::Sleep(ms, false);
+        return 0;
+    }
+
+    int ready = WSAPoll(&fds[0], static_cast<ULONG>(fds.size()), ms);
+    if(ready <= 0)
+        return ready == 0 ? 0 : -1;
+
+    int result = 0;
+    lock_.Acquire();
+    for(size_t index = 0; index < fds.size(); ++index)
+    {
+        if(fds[index].revents == 0)
+            continue;
+
+        //等待期间注销的套接字不再报告
+        size_t entry = Find(fds[index].fd);
+        if(entry == entries_.size())
+            continue;
+
+        if(entries_[entry].mode & PollMode::kPollOneShot)
+            entries_[entry].events = 0;
+
+        results[result].token = tokens[index];
+        results[result].events = FromPollEvents(fds[index].revents);
+        if(static_cast<size_t>(++result) == count)
+            break;
+    }
+    lock_.Release();
+    return result;
+}
+
+size_t Poller::size() const
+{
+    lock_.Acquire();
+    size_t size = entries_.size();
+    lock_.Release();
+    return size;
+}
+
+size_t Poller::Find(SOCKET socket) const
+{
+    for(size_t index = 0; index < entries_.size(); ++index)
+    {
+        if(entries_[index].socket == socket)
+            return index;
+    }
+    return entries_.size();
+}
+
+
+}
@@ -0,0 +1,219 @@
+﻿#include "proactor.h"
+#include "sys_info.h"
+#include "thread.h"
+
+namespace ncore
+{
+
+
+/*
+前摄器中与平台无关的部分：定时器、推迟的任务
+*/
+#if defined NCORE_WINDOWS
+__declspec(thread) Proactor::DispatchScope * Proactor::DispatchScope::current_ = 0;
+#elif defined NCORE_LINUX
+__thread Proactor::DispatchScope * Proactor::DispatchScope::current_ = 0;
+#endif
+
+Proactor::DispatchScope::DispatchScope(Proactor & proactor)
+    : proactor_(&proactor), previous_(current_)
+{
+    current_ = this;
+}
+
+Proactor::DispatchScope::~DispatchScope()
+{
+    //先退出范围，任务中再推迟的任务归外层范围
+    current_ = previous_;
+    AsyncTaskQueue::Run(deferred_.TakeAll());
+}
+
+bool Proactor::Defer(AsyncTask & task)
+{
+    DispatchScope * scope = DispatchScope::current_;
+    if(scope == 0 || scope->proactor_ != this)
+        return false;
+
+    scope->deferred_.Push(task);
+    return true;
+}
+
+void Proactor::SetTimer(AsyncTimer & timer, uint32_t ms)
+{
+    uint64_t now = SysInfo::TickCount64();
+    uint64_t expire = now + ms;
+    bool wake = false;
+
+    timer_lock_.Acquire();
+    timers_.Reset(now);
+    timers_.Add(timer, expire);
+    //比等待中的线程醒来得早时需要唤醒，让其重新计算等待时间
+    if(expire < timer_wake_)
+    {
+        timer_wake_ = expire;
+        wake = true;
+    }
+    timer_lock_.Release();
+
+    if(wake)
+        Wake();
+}
+
+bool Proactor::CancelTimer(AsyncTimer & timer)
+{
+    timer_lock_.Acquire();
+    bool removed = timers_.Remove(timer);
+    timer_lock_.Release();
+    return removed;
+}
+
+int Proactor::GetWaitTime(int ms)
+{
+    timer_lock_.Acquire();
+    if(timers_.size() == 0)
+    {
+        timer_wake_ = static_cast<uint64_t>(-1);
+        timer_lock_.Release();
+        return ms;
+    }
+
+    uint64_t now = SysInfo::TickCount64();
+    uint64_t next = timers_.NextExpire();
+    uint64_t wait = next > now ? next - now : 0;
+    if(ms >= 0 && wait > static_cast<uint64_t>(ms))
+        wait = static_cast<uint64_t>(ms);
+    timer_wake_ = now + wait;
+    timer_lock_.Release();
+
+    //NextExpire不超过256个刻度，不会溢出
+    return static_cast<int>(wait);
+}
+
+size_t Proactor::RunTimers()
+{
+    AsyncTaskQueue expired;
+
+    timer_lock_.Acquire();
+    if(timers_.size() == 0)
+    {
+        timer_lock_.Release();
+        return 0;
+    }
+    timers_.Advance(SysInfo::TickCount64(), expired);
+    timer_lock_.Release();
+
+    size_t count = 0;
+    AsyncTask * head = expired.TakeAll();
+    while(AsyncTask * task = AsyncTaskQueue::Next(head))
+    {
+        AsyncTimer * timer = static_cast<AsyncTimer *>(task);
+        timer->Run();
+        //Run中可能重新启动了定时器
+        timer->timer_state_.CompareExchange(AsyncTimer::kTimerIdle,
+                                            AsyncTimer::kTimerFiring);
+        ++count;
+    }
+    return count;
+}
+
+
+/*
+混合等待：先忙轮询，预算用完后阻塞等待
+*/
+size_t Proactor::RunHybrid(int ms, size_t max_events)
+{
+    //间隔超过1秒时按1秒估计，避免一次长时间空闲拉高估计值
+    const uint64_t kMaxSpinGap = 1000000;
+    //落空后暂停次数的上限，约为数微秒
+    const uint32_t kMaxSpinPauses = 64;
+
+    if(ms == 0 || max_events == 0 || spin_limit_ == 0)
+        return RunBatch(ms, max_events);
+
+    uint64_t start = SysInfo::MicroTickCount();
+    uint64_t now = start;
+    uint32_t budget = spin_budget_;
+    uint32_t pauses = 1;
+    uint32_t polls = 0;
+
+    while(budget > 0 && now - start < budget)
+    {
+        size_t processed = RunBatch(0, max_events);
+        ++polls;
+        now = SysInfo::MicroTickCount();
+        if(processed)
+        {
+            spin_polls_ += polls;
+            ++spin_hits_;
+            UpdateSpinBudget(now - start);
+            return processed;
+        }
+
+        //退避，减少空转时对完成端口的争用
+        for(uint32_t i = 0; i < pauses; ++i)
+            Thread::Pause();
+        if(pauses < kMaxSpinPauses)
+            pauses <<= 1;
+    }
+
+    if(polls)
+        spin_polls_ += polls;
+    ++blocking_waits_;
+
+    int remain = ms;
+    if(ms > 0)
+    {
+        uint64_t spent = (now - start) / 1000;
+        remain = spent < static_cast<uint64_t>(ms) ? ms - static_cast<int>(spent) : 0;
+    }
+
+    size_t processed = RunBatch(remain, max_events);
+    if(spin_adaptive_)
+    {
+        //超时说明间隔至少为等待的时间，同样参与估计
+        uint64_t gap = SysInfo::MicroTickCount() - start;
+        UpdateSpinBudget(gap < kMaxSpinGap ? gap : kMaxSpinGap);
+    }
+    return processed;
+}
+
+void Proactor::SetSpinPolicy(uint32_t max_spin_us, bool adaptive)
+{
+    spin_limit_ = max_spin_us;
+    spin_adaptive_ = adaptive;
+    spin_budget_ = max_spin_us;
+    spin_gap_ = 0;
+}
+
+ProactorSpinStats Proactor::spin_stats() const
+{
+    ProactorSpinStats stats;
+    stats.spin_hits = static_cast<uint32_t>(static_cast<int>(spin_hits_));
+    stats.blocking_waits = static_cast<uint32_t>(static_cast<int>(blocking_waits_));
+    stats.spin_polls = static_cast<uint32_t>(static_cast<int>(spin_polls_));
+    stats.spin_budget = spin_budget_;
+    return stats;
+}
+
+void Proactor::UpdateSpinBudget(uint64_t gap)
+{
+    //估计的间隔很短时也至少忙轮询1微秒
+    const uint32_t kMinSpinBudget = 1;
+
+    if(!spin_adaptive_)
+        return;
+
+    //指数加权平均，新的样本占1/8；多个线程同时更新时估计值是近似的
+    uint64_t estimate = (static_cast<uint64_t>(spin_gap_) * 7 + gap) / 8;
+    spin_gap_ = static_cast<uint32_t>(estimate);
+
+    uint64_t budget = estimate * 2;
+    if(budget > spin_limit_)
+        budget = 0;
+    else if(budget < kMinSpinBudget)
+        budget = kMinSpinBudget;
+    spin_budget_ = static_cast<uint32_t>(budget);
+}
+
+
+}
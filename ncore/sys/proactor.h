@@ -1,35 +1,281 @@
-﻿#ifndef NCORE_SYS_PROACTOR_H_
-#define NCORE_SYS_PROACTOR_H_
-
-#include <ncore/base/object.h>
-
-namespace ncore
-{
-
-class IOPortal;
-
-//前摄器
-class Proactor : public NonCopyableObject
-{
-public:
-    Proactor();
-    ~Proactor();	
-    bool init();
-    void fini();
-
-    //等待一个异步结果
-    void Run(int ms);
-
-    //关联到前摄器
-    bool Associate(IOPortal & portal);
-
-private:
-#if defined NCORE_WINDOWS
-    HANDLE comp_port_;
-#endif
-};
-
-
-}
-
-#endif
\ No newline at end of file
+﻿#ifndef NCORE_SYS_PROACTOR_H_
+#define NCORE_SYS_PROACTOR_H_
+
+#include <ncore/base/object.h>
+#include <ncore/base/atomic.h>
+#include "spin_lock.h"
+#include "async_task.h"
+#include "timing_wheel.h"
+#if defined NCORE_LINUX
+#include "io_ring.h"
+#endif
+
+namespace ncore
+{
+
+class IOPortal;
+class AsyncContext;
+class SocketBufferPool;
+
+#if defined NCORE_LINUX
+//前摄器的驱动方式
+namespace ProactorEngine
+{
+enum Value
+{
+    kEpoll,         //就绪通知，由前摄器执行非阻塞的系统调用
+    kIORing,        //io_uring，由内核完成请求
+};
+}
+#endif
+
+//混合等待的统计，计数器可能回绕
+struct ProactorSpinStats
+{
+    uint32_t spin_hits;         //忙轮询期间取到完成事件的次数
+    uint32_t blocking_waits;    //忙轮询没有取到、转入阻塞等待的次数
+    uint32_t spin_polls;        //忙轮询中非阻塞地取完成事件的总次数
+    uint32_t spin_budget;       //当前的忙轮询预算，微秒
+};
+
+//前摄器
+class Proactor : public NonCopyableObject
+{
+public:
+    Proactor();
+    ~Proactor();	
+    bool init();
+    void fini();
+
+    //等待一个异步结果
+    void Run(int ms);
+
+    /*! 批量等待异步结果
+    @param[in] ms           等待的毫秒数。
+    @param[in] max_events   一次最多处理的完成事件数。
+    @return 本次处理的完成事件数，超时返回0。
+    @remark 一次等待取出多个完成事件，按取出的顺序依次回调。\n
+            epoll引擎的max_events限制的是就绪事件数，一个就绪事件可能完成同一fd上排队的多个请求，
+            因此返回值可能大于max_events。\n
+    */
+    size_t RunBatch(int ms, size_t max_events);
+
+    /*! 先忙轮询再阻塞地批量等待异步结果
+    @param[in] ms           等待的毫秒数。
+    @param[in] max_events   一次最多处理的完成事件数。
+    @return 本次处理的完成事件数，超时返回0。
+    @remark 在忙轮询预算内反复不等待地取完成事件，每次落空后加倍暂停的次数；
+            预算用完仍没有取到时，以剩余的时间阻塞等待。\n
+            省去了线程睡眠和唤醒的开销，代价是空闲时占用处理器。
+            没有调用SetSpinPolicy或者ms为0时等同于RunBatch。\n
+    */
+    size_t RunHybrid(int ms, size_t max_events);
+
+    /*! 设置RunHybrid的忙轮询预算
+    @param[in] max_spin_us  忙轮询的最长微秒数，0表示不忙轮询。
+    @param[in] adaptive     是否按完成事件的到达间隔调整预算。
+    @remark 自适应时预算取估计的到达间隔的两倍，不超过max_spin_us；
+            到达间隔超过max_spin_us的一半时不再忙轮询，直接阻塞等待，
+            阻塞等待测得的间隔同样参与估计，到达变密集后重新开始忙轮询。\n
+    */
+    void SetSpinPolicy(uint32_t max_spin_us, bool adaptive);
+
+    ProactorSpinStats spin_stats() const;
+
+    //关联到前摄器
+    bool Associate(IOPortal & portal);
+
+    /*! 投递任务，由某个正在执行Run的线程执行
+    @param[in] task 任务，执行完毕之前必须保持有效。
+    @return 投递成功后返回true；否则返回false。
+    @remark 可以在任意线程调用。两次唤醒之间的多次投递只产生一次唤醒，且只唤醒一个等待的线程。\n
+            任务计入Run/RunBatch处理的完成事件数；fini时尚未执行的任务被丢弃。\n
+    */
+    bool Post(AsyncTask & task);
+
+    /*! 推迟任务到本次分发结束
+    @param[in] task 任务，执行完毕之前必须保持有效。
+    @return 当前线程正在执行本前摄器的Run/RunBatch/RunHybrid时返回true；否则返回false，任务不会执行。
+    @remark 任务在本次取出的完成事件全部回调之后、Run返回之前，在当前线程上执行，
+            用于把一批回调中产生的零散的写合并成一次发送。不产生唤醒，也不计入处理的完成事件数。\n
+    */
+    bool Defer(AsyncTask & task);
+
+    /*! 启动定时器
+    @param[in] timer    定时器，到期后在某个执行Run的线程上执行。
+    @param[in] ms       距离到期的毫秒数。
+    @remark 定时器由分层时间轮管理，启动和停止都是O(1)，精度为1毫秒。\n
+            已启动的定时器被重新启动；定时器可以在自己的Run中重新启动，
+            但到期后Run返回之前不能在其他线程上重新启动。\n
+            有定时器时Run/RunBatch的等待会被缩短，可能在ms之前返回0。\n
+    */
+    void SetTimer(AsyncTimer & timer, uint32_t ms);
+
+    /*! 停止定时器
+    @return 定时器尚未到期时返回true；已经到期或没有启动时返回false。
+    */
+    bool CancelTimer(AsyncTimer & timer);
+
+    /*! 取消一个异步请求
+    @param[in] portal   发起请求的对象。
+    @param[in] args     请求的上下文。
+    @return 请求尚未完成时返回true；否则返回false。
+    @remark 被取消的请求照常完成，错误码为ERROR_OPERATION_ABORTED（Linux上为ECANCELED）。\n
+    */
+    bool Cancel(IOPortal & portal, AsyncContext & args);
+
+#if defined NCORE_LINUX
+    /*! 以指定的引擎初始化
+    @param[in] engine 引擎类型，init()等同于使用kEpoll。
+    @return 初始化成功后返回true；否则返回false，内核不支持io_uring时也返回false。
+    @remark io_uring引擎下，Associate会把fd注册为固定文件，
+            Run一次系统调用即可提交所有待提交的请求并批量收割完成事件。\n
+    */
+    bool init(ProactorEngine::Value engine);
+
+    ProactorEngine::Value engine() const;
+
+    /*! 注册固定缓冲区
+    @param[in] buffer   缓冲区。
+    @param[in] size     大小。
+    @return 注册成功后返回true；否则返回false，epoll引擎总是返回false。
+    @remark 落在已注册缓冲区内的单块缓冲区，文件读写以及无标志的套接字接收
+            将使用READ_FIXED/WRITE_FIXED，省去每次请求时的页面固定。\n
+            缓冲区在UnregisterBuffer之前必须保持有效。\n
+    */
+    bool RegisterBuffer(void * buffer, size_t size);
+    bool UnregisterBuffer(void * buffer);
+
+    /*! 注册接收缓冲池
+    @param[in] pool 缓冲池，同一时刻只能注册到一个前摄器。
+    @return 注册成功后返回true；否则返回false，epoll引擎或者内核不支持时返回false。
+    @remark 注册之后，该前摄器上的Socket::ReceivePooledAsync由内核在数据到达时选取缓冲区，
+            池中的缓冲区全部交给内核，SocketBufferPool::Acquire不再能取出。\n
+            未注册时ReceivePooledAsync照常工作，等待可读之后从池中取缓冲区。\n
+    */
+    bool RegisterBufferPool(SocketBufferPool & pool);
+
+    //所有缓冲区归还、并且没有在途的接收时才能注销
+    bool UnregisterBufferPool(SocketBufferPool & pool);
+
+    //取消关联，未完成的异步请求以ECANCELED完成
+    void Dissociate(IOPortal & portal);
+
+    //投递异步请求，由IOPortal的实现调用
+    bool Submit(AsyncContext & args);
+
+    //取消IOPortal上所有未完成的异步请求
+    bool Cancel(IOPortal & portal);
+#endif
+
+private:
+    static const size_t kMaxBatchEvents = 64;
+
+    //Run/RunBatch的分发范围，可以嵌套，析构时执行本线程推迟到该范围的任务
+    class DispatchScope
+    {
+    public:
+        explicit DispatchScope(Proactor & proactor);
+        ~DispatchScope();
+
+    private:
+        DispatchScope(const DispatchScope &);
+        DispatchScope & operator=(const DispatchScope &);
+
+    private:
+        Proactor * proactor_;
+        DispatchScope * previous_;
+        AsyncTaskQueue deferred_;
+#if defined NCORE_WINDOWS
+        static __declspec(thread) DispatchScope * current_;
+#elif defined NCORE_LINUX
+        static __thread DispatchScope * current_;
+#endif
+
+        friend class Proactor;
+    };
+
+    AsyncTask * TakePosted();
+
+    //唤醒一个等待中的线程
+    bool Wake();
+
+    //按最近的定时器缩短等待时间
+    int GetWaitTime(int ms);
+
+    //推进时间轮并执行到期的定时器，返回执行的数量
+    size_t RunTimers();
+
+    //以一次等待测得的完成事件到达间隔更新忙轮询预算
+    void UpdateSpinBudget(uint64_t gap);
+
+    SpinLock posted_lock_;
+    AsyncTaskQueue posted_;
+    SpinLock timer_lock_;
+    TimingWheel timers_;
+    uint64_t timer_wake_;           //等待中的线程最迟醒来的时间
+    uint32_t spin_limit_;           //忙轮询的上限，微秒
+    bool spin_adaptive_;
+    volatile uint32_t spin_budget_; //当前的忙轮询预算，微秒
+    volatile uint32_t spin_gap_;    //估计的完成事件到达间隔，微秒
+    Atomic spin_hits_;
+    Atomic blocking_waits_;
+    Atomic spin_polls_;
+
+#if defined NCORE_WINDOWS
+    HANDLE comp_port_;
+#elif defined NCORE_LINUX
+    struct PortalEntry;
+
+    struct FixedBuffer
+    {
+        char * base;
+        size_t size;
+    };
+
+    static const size_t kEntryChunkSize = 1024;
+    static const size_t kMaxEntryChunks = 1024;
+    static const uint32_t kRingEntries = 1024;
+    static const uint32_t kMaxFixedFiles = 4096;
+    static const uint32_t kMaxFixedBuffers = 64;
+
+    PortalEntry * GetEntry(int fd, bool create);
+    void Complete(AsyncContext * head, AsyncContext * tail);
+    void Drain(PortalEntry & entry, bool readable, bool writable,
+               AsyncContext *& head, AsyncContext *& tail);
+    void TakeCompleted(AsyncContext *& head, AsyncContext *& tail);
+    size_t Dispatch(AsyncContext * head);
+
+    bool InitRing();
+    size_t RunRing(int ms, size_t max_events);
+    bool ArmWake();
+    bool PushRequest(AsyncContext & args, int fixed_index);
+    void FlushRequests();
+    int FindFixedBuffer(const iovec & iov);
+    bool OnRingCompleted(AsyncContext & args, int result, uint32_t flags);
+
+    ProactorEngine::Value engine_;
+    int epoll_fd_;
+    int wake_fd_;
+    SpinLock completed_lock_;
+    AsyncContext * completed_head_;
+    AsyncContext * completed_tail_;
+    SpinLock entries_lock_;
+    PortalEntry * entries_[kMaxEntryChunks];
+
+    IORing ring_;
+    SpinLock sq_lock_;
+    SpinLock cq_lock_;
+    SpinLock fixed_lock_;
+    bool fixed_files_;
+    std::vector<int> free_files_;
+    bool fixed_buffers_;
+    FixedBuffer buffers_[kMaxFixedBuffers];
+    uint16_t next_buffer_group_;
+#endif
+};
+
+
+}
+
+#endif
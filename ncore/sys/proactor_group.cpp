@@ -0,0 +1,229 @@
+﻿#include "thread.h"
+#include "sys_info.h"
+#include "proactor_group.h"
+
+namespace ncore
+{
+
+
+ProactorWorkerStats::ProactorWorkerStats()
+    : completions(0), batches(0), portals(0), cpu(-1)
+{
+}
+
+/*
+I/O线程，循环批量处理自己前摄器上的完成事件
+*/
+class ProactorGroup::Worker : public NonCopyableObject
+{
+public:
+    Worker()
+        : completions_(0), batches_(0), cpu_(-1)
+    {
+        io_proc_.Register(this, &Worker::IOProc);
+    }
+
+    ~Worker()
+    {
+        Stop();
+    }
+
+    bool Start(int cpu)
+    {
+        if(!io_handler_.init())
+            return false;
+
+        if(!io_thread_.init(io_proc_))
+            return false;
+
+        if(cpu >= 0 && io_thread_.SetAffinity(static_cast<uint32_t>(cpu)))
+            cpu_ = cpu;
+
+        running_ = 1;
+        if(io_thread_.Start())
+            return true;
+
+        running_ = 0;
+        return false;
+    }
+
+    void Stop()
+    {
+        //线程最多在一次等待超时后退出
+        running_ = 0;
+        io_thread_.fini();
+        io_handler_.fini();
+    }
+
+    void GetStats(ProactorWorkerStats & stats) const
+    {
+        stats.completions = completions_;
+        stats.batches = batches_;
+        stats.portals = portals_;
+        stats.cpu = cpu_;
+    }
+
+    Proactor & io_handler()
+    {
+        return io_handler_;
+    }
+
+    Atomic & portals()
+    {
+        return portals_;
+    }
+
+private:
+    void IOProc()
+    {
+        while(running_)
+        {
+            size_t count = io_handler_.RunBatch(kDefaultWaitTime,
+                                                kDefaultBatchSize);
+            if(count)
+            {
+                completions_ += count;
+                ++batches_;
+            }
+        }
+    }
+
+private:
+    Proactor io_handler_;
+    Thread io_thread_;
+    ThreadProcAdapter<Worker> io_proc_;
+    Atomic running_;
+    Atomic portals_;
+    volatile uint64_t completions_;
+    volatile uint64_t batches_;
+    int cpu_;
+};
+
+
+ProactorGroup::ProactorGroup()
+    : balance_(ProactorBalance::kRoundRobin)
+{
+}
+
+ProactorGroup::~ProactorGroup()
+{
+    fini();
+}
+
+bool ProactorGroup::init()
+{
+    return init(0, false, ProactorBalance::kRoundRobin);
+}
+
+bool ProactorGroup::init(size_t thread_count, bool pin_threads,
+                         ProactorBalance::Value balance)
+{
+    if(!workers_.empty())
+        return true;
+
+    int processors = SysInfo::GetLogicalProcessorNumber();
+    if(processors <= 0)
+        processors = 1;
+
+    if(thread_count == 0)
+        thread_count = static_cast<size_t>(processors);
+
+    balance_ = balance;
+    next_ = 0;
+
+    for(size_t i = 0; i < thread_count; ++i)
+    {
+        Worker * worker = new Worker();
+        workers_.push_back(worker);
+
+        int cpu = pin_threads ? static_cast<int>(i % processors) : -1;
+        if(!worker->Start(cpu))
+        {
+            fini();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ProactorGroup::fini()
+{
+    for(size_t i = 0; i < workers_.size(); ++i)
+        workers_[i]->Stop();
+
+    for(size_t i = 0; i < workers_.size(); ++i)
+        delete workers_[i];
+
+    workers_.clear();
+}
+
+void ProactorGroup::Release(Proactor & io)
+{
+    for(size_t i = 0; i < workers_.size(); ++i)
+    {
+        Worker & worker = *workers_[i];
+        if(&worker.io_handler() != &io)
+            continue;
+
+        if(worker.portals() > 0)
+            --worker.portals();
+        return;
+    }
+}
+
+size_t ProactorGroup::Select()
+{
+    size_t count = workers_.size();
+    if(count == 0)
+        return 0;
+
+    if(balance_ == ProactorBalance::kLeastLoaded)
+    {
+        //从轮转位置开始扫描，负载相同时也能分散开
+        size_t start = static_cast<unsigned int>(++next_) % count;
+        size_t selected = start;
+        int least = workers_[start]->portals();
+        for(size_t i = 1; i < count; ++i)
+        {
+            size_t index = (start + i) % count;
+            int portals = workers_[index]->portals();
+            if(portals < least)
+            {
+                least = portals;
+                selected = index;
+            }
+        }
+        return selected;
+    }
+
+    return static_cast<unsigned int>(++next_) % count;
+}
+
+size_t ProactorGroup::size() const
+{
+    return workers_.size();
+}
+
+Proactor & ProactorGroup::proactor(size_t index)
+{
+    assert(index < workers_.size());
+    return workers_[index]->io_handler();
+}
+
+bool ProactorGroup::GetStats(size_t index, ProactorWorkerStats & stats) const
+{
+    if(index >= workers_.size())
+        return false;
+
+    workers_[index]->GetStats(stats);
+    return true;
+}
+
+void ProactorGroup::OnAssociated(size_t index)
+{
+    ++workers_[index]->portals();
+}
+
+
+}
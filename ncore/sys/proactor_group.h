@@ -0,0 +1,115 @@
+﻿#ifndef NCORE_SYS_PROACTOR_GROUP_H_
+#define NCORE_SYS_PROACTOR_GROUP_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include <ncore/base/atomic.h>
+#include "proactor.h"
+
+namespace ncore
+{
+
+
+//关联时选择前摄器的策略
+namespace ProactorBalance
+{
+enum Value
+{
+    kRoundRobin,        //轮流分配
+    kLeastLoaded,       //分配给关联对象最少的线程
+};
+}
+
+//单个I/O线程的统计
+struct ProactorWorkerStats
+{
+    uint64_t completions;       //已回调的完成事件数
+    uint64_t batches;           //取到完成事件的等待次数
+    int portals;                //当前关联的对象数
+    int cpu;                    //绑定的逻辑处理器，-1表示未绑定
+
+    ProactorWorkerStats();
+};
+
+/*! 前摄器线程组\n
+每个I/O线程拥有一个前摄器，关联的对象被分散到各个线程上。\n
+同一个对象的所有回调都在同一个线程上执行。\n
+*/
+class ProactorGroup : public NonCopyableObject
+{
+public:
+    static const int kDefaultWaitTime = 100;
+    static const size_t kDefaultBatchSize = 64;
+
+public:
+    ProactorGroup();
+    ~ProactorGroup();
+
+    /*! 初始化，线程数为逻辑处理器数，不绑定处理器，轮流分配
+    @return 初始化成功后返回true；否则返回false。
+    */
+    bool init();
+
+    /*! 初始化
+    @param[in] thread_count 线程数，为0时使用逻辑处理器数。
+    @param[in] pin_threads  是否把第i个线程绑定到第i个逻辑处理器。
+    @param[in] balance      关联时选择前摄器的策略。
+    @return 初始化成功后返回true；否则返回false。
+    */
+    bool init(size_t thread_count, bool pin_threads,
+              ProactorBalance::Value balance);
+
+    //停止所有线程，等待正在执行的回调返回
+    void fini();
+
+    /*! 按策略选择一个前摄器并关联
+    @param[in] portal 具有Associate(Proactor &)方法的对象，如Socket、FileStream。
+    @return 关联成功后返回所选的前摄器；否则返回0。
+    @remark 对象关闭后应调用Release，以维护最少负载策略的统计。\n
+    */
+    template<typename Portal>
+    Proactor * Associate(Portal & portal)
+    {
+        size_t index = Select();
+        if(index >= size())
+            return 0;
+
+        Proactor & io = proactor(index);
+        if(!portal.Associate(io))
+            return 0;
+
+        OnAssociated(index);
+        return &io;
+    }
+
+    //关联的对象关闭后调用
+    void Release(Proactor & io);
+
+    //按策略选出下一个前摄器的序号
+    size_t Select();
+
+    size_t size() const;
+    Proactor & proactor(size_t index);
+
+    /*! 获得I/O线程的统计
+    @param[in] index    线程序号。
+    @param[out] stats   统计数据，由其他线程读取，为近似值。
+    @return 序号有效时返回true；否则返回false。
+    */
+    bool GetStats(size_t index, ProactorWorkerStats & stats) const;
+
+private:
+    class Worker;
+
+    void OnAssociated(size_t index);
+
+private:
+    std::vector<Worker *> workers_;
+    ProactorBalance::Value balance_;
+    Atomic next_;
+};
+
+
+}
+
+#endif
@@ -0,0 +1,1534 @@
+﻿#include "io_portal.h"
+#include "async_context.h"
+#include "proactor.h"
+#include "socket_buffer_pool.h"
+
+namespace ncore
+{
+
+//sendfile一次最多发送的字节数，与内核的MAX_RW_COUNT相同
+static const uint64_t kMaxSendFileChunk = 0x7FFFF000;
+
+/*
+每个关联的文件描述符对应一个PortalEntry，按fd分块索引，
+块一旦分配直到fini才释放，所以Submit可以无锁地查找。
+fd关闭后再被复用时，Associate会重置对应的PortalEntry。
+io_uring引擎下，队列头部的请求已提交给内核，其余的请求等待头部完成后再提交，
+以保证同一方向上的请求按顺序完成。
+*/
+struct Proactor::PortalEntry
+{
+    SpinLock lock;
+    IOPortal * portal;
+    bool always_ready;              //普通文件不支持epoll，总是就绪
+    int fixed_index;                //io_uring固定文件的下标
+    AsyncContext * read_head;
+    AsyncContext * read_tail;
+    AsyncContext * write_head;
+    AsyncContext * write_tail;
+
+    PortalEntry()
+        : portal(0), always_ready(false), fixed_index(-1),
+          read_head(0), read_tail(0),
+          write_head(0), write_tail(0)
+    {
+    }
+};
+
+class ProactorRoutines
+{
+private:
+    friend class Proactor;
+
+    //io_uring中非请求的完成事件
+    static const uint64_t kWakeData = 1;
+    static const uint64_t kCancelData = 2;
+
+    //当前线程正在执行Run的前摄器，回调中投递的请求延迟到下一次Run时批量提交
+    static __thread Proactor * running_;
+
+    static int GetFd(IOPortal & portal)
+    {
+        return static_cast<int>(reinterpret_cast<intptr_t>(
+            portal.GetPlatformHandle()));
+    }
+
+    static bool IsReadRequest(const AsyncRequest & req)
+    {
+        switch(req.op)
+        {
+        case AsyncRequestOp::kRequestRead:
+        case AsyncRequestOp::kRequestRecvMsg:
+        case AsyncRequestOp::kRequestAccept:
+        case AsyncRequestOp::kRequestRecvMMsg:
+        case AsyncRequestOp::kRequestSpliceRecv:
+        case AsyncRequestOp::kRequestRecvPooled:
+            return true;
+        default:
+            break;
+        }
+        return false;
+    }
+
+    //io_uring没有recvmmsg/sendmmsg/sendfile，以poll等待就绪后在完成时执行；
+    //splice与其余请求一样以非阻塞方式执行，避免在内核线程中阻塞；
+    //缓冲池没有注册到该前摄器时，就绪后再从池中取缓冲区
+    static bool IsPollRequest(const AsyncRequest & req)
+    {
+        return req.op == AsyncRequestOp::kRequestRecvMMsg ||
+               req.op == AsyncRequestOp::kRequestSendMMsg ||
+               req.op == AsyncRequestOp::kRequestSendFile ||
+               req.op == AsyncRequestOp::kRequestSpliceRecv ||
+               req.op == AsyncRequestOp::kRequestSpliceSend ||
+               (req.op == AsyncRequestOp::kRequestRecvPooled &&
+                req.buffer_group < 0);
+    }
+
+    static void Append(AsyncContext *& head, AsyncContext *& tail,
+                       AsyncContext * args, AsyncRequest & req)
+    {
+        req.next = 0;
+        if(tail)
+            GetRequest(*tail).next = args;
+        else
+            head = args;
+        tail = args;
+    }
+
+    static AsyncRequest & GetRequest(AsyncContext & args)
+    {
+        return args.request_;
+    }
+
+    static bool IsSingleBuffer(const AsyncRequest & req)
+    {
+        return req.msg.msg_iovlen == 1 && req.msg.msg_name == 0 &&
+               req.msg.msg_control == 0;
+    }
+
+    //把请求翻译为SQE，buf_index为-1表示不使用固定缓冲区
+    static void PrepareSqe(io_uring_sqe & sqe, AsyncRequest & req,
+                           int fixed_index, int buf_index)
+    {
+        const iovec & iov = req.msg.msg_iov[0];
+        uint64_t offset = req.offset < 0 ? static_cast<uint64_t>(-1) :
+                          static_cast<uint64_t>(req.offset);
+
+        switch(req.op)
+        {
+        case AsyncRequestOp::kRequestRead:
+            if(buf_index >= 0)
+            {
+                sqe.opcode = IORING_OP_READ_FIXED;
+                sqe.addr = reinterpret_cast<uint64_t>(iov.iov_base);
+                sqe.len = static_cast<uint32_t>(iov.iov_len);
+                sqe.buf_index = static_cast<uint16_t>(buf_index);
+            }
+            else
+            {
+                sqe.opcode = IORING_OP_READV;
+                sqe.addr = reinterpret_cast<uint64_t>(req.msg.msg_iov);
+                sqe.len = static_cast<uint32_t>(req.msg.msg_iovlen);
+            }
+            sqe.off = offset;
+            break;
+        case AsyncRequestOp::kRequestWrite:
+            if(buf_index >= 0)
+            {
+                sqe.opcode = IORING_OP_WRITE_FIXED;
+                sqe.addr = reinterpret_cast<uint64_t>(iov.iov_base);
+                sqe.len = static_cast<uint32_t>(iov.iov_len);
+                sqe.buf_index = static_cast<uint16_t>(buf_index);
+            }
+            else
+            {
+                sqe.opcode = IORING_OP_WRITEV;
+                sqe.addr = reinterpret_cast<uint64_t>(req.msg.msg_iov);
+                sqe.len = static_cast<uint32_t>(req.msg.msg_iovlen);
+            }
+            sqe.off = offset;
+            break;
+        case AsyncRequestOp::kRequestRecvMsg:
+            if(buf_index >= 0 && req.flags == 0)
+            {
+                //无标志的接收等同于read
+                sqe.opcode = IORING_OP_READ_FIXED;
+                sqe.addr = reinterpret_cast<uint64_t>(iov.iov_base);
+                sqe.len = static_cast<uint32_t>(iov.iov_len);
+                sqe.buf_index = static_cast<uint16_t>(buf_index);
+                sqe.off = static_cast<uint64_t>(-1);
+            }
+            else if(IsSingleBuffer(req))
+            {
+                sqe.opcode = IORING_OP_RECV;
+                sqe.addr = reinterpret_cast<uint64_t>(iov.iov_base);
+                sqe.len = static_cast<uint32_t>(iov.iov_len);
+                sqe.msg_flags = req.flags;
+            }
+            else
+            {
+                sqe.opcode = IORING_OP_RECVMSG;
+                sqe.addr = reinterpret_cast<uint64_t>(&req.msg);
+                sqe.msg_flags = req.flags;
+            }
+            break;
+        case AsyncRequestOp::kRequestSendMsg:
+            //write会在对端关闭时触发SIGPIPE，发送不使用固定缓冲区
+            if(IsSingleBuffer(req))
+            {
+                sqe.opcode = IORING_OP_SEND;
+                sqe.addr = reinterpret_cast<uint64_t>(iov.iov_base);
+                sqe.len = static_cast<uint32_t>(iov.iov_len);
+            }
+            else
+            {
+                sqe.opcode = IORING_OP_SENDMSG;
+                sqe.addr = reinterpret_cast<uint64_t>(&req.msg);
+            }
+            sqe.msg_flags = req.flags | MSG_NOSIGNAL;
+            break;
+        case AsyncRequestOp::kRequestAccept:
+            sqe.opcode = IORING_OP_ACCEPT;
+            sqe.addr = reinterpret_cast<uint64_t>(req.addr);
+            sqe.addr2 = reinterpret_cast<uint64_t>(&req.addr_size);
+            sqe.accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+            break;
+        case AsyncRequestOp::kRequestConnect:
+            sqe.opcode = IORING_OP_CONNECT;
+            sqe.addr = reinterpret_cast<uint64_t>(req.addr);
+            sqe.off = req.addr_size;
+            break;
+        case AsyncRequestOp::kRequestShutdown:
+            sqe.opcode = IORING_OP_SHUTDOWN;
+            sqe.len = static_cast<uint32_t>(req.flags);
+            break;
+        case AsyncRequestOp::kRequestRecvMMsg:
+        case AsyncRequestOp::kRequestSpliceRecv:
+            sqe.opcode = IORING_OP_POLL_ADD;
+            sqe.poll32_events = POLLIN;
+            break;
+        case AsyncRequestOp::kRequestSendMMsg:
+        case AsyncRequestOp::kRequestSendFile:
+        case AsyncRequestOp::kRequestSpliceSend:
+            sqe.opcode = IORING_OP_POLL_ADD;
+            sqe.poll32_events = POLLOUT;
+            break;
+        case AsyncRequestOp::kRequestRecvPooled:
+            if(req.buffer_group >= 0)
+            {
+                //数据到达时由内核从缓冲区组中选取
+                sqe.opcode = IORING_OP_RECV;
+                sqe.len = static_cast<uint32_t>(req.iov.iov_len);
+                sqe.flags |= IOSQE_BUFFER_SELECT;
+                sqe.buf_group = static_cast<uint16_t>(req.buffer_group);
+            }
+            else
+            {
+                sqe.opcode = IORING_OP_POLL_ADD;
+                sqe.poll32_events = POLLIN;
+            }
+            break;
+        default:
+            sqe.opcode = IORING_OP_NOP;
+            break;
+        }
+
+        if(fixed_index >= 0)
+        {
+            sqe.fd = fixed_index;
+            sqe.flags |= IOSQE_FIXED_FILE;
+        }
+        else
+        {
+            sqe.fd = req.fd;
+        }
+    }
+
+    //后面还有数据时带MSG_MORE，最后一段不带，否则会在内核中滞留
+    static int GetSendFlags(const AsyncRequest & req, size_t size)
+    {
+        int flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+        if(size < req.file_remaining || req.msg.msg_iov[1].iov_len)
+            flags |= MSG_MORE;
+        return flags;
+    }
+
+    //sendfile不支持该文件时，读取后发送
+    static ssize_t CopyFile(AsyncRequest & req)
+    {
+        char buffer[16384];
+        size_t count = sizeof(buffer);
+        if(req.file_remaining < count)
+            count = static_cast<size_t>(req.file_remaining);
+
+        ssize_t size = pread(req.file_fd, buffer, count, req.offset);
+        if(size <= 0)
+            return size;
+
+        //只前进实际发送的部分，未发送的下次重新读取
+        return send(req.fd, buffer, size, GetSendFlags(req, size));
+    }
+
+    //文件超过4GB时合计的字节数截断为0xFFFFFFFF，不回绕
+    static uint32_t FileSent(const AsyncRequest & req)
+    {
+        if(req.file_sent > 0xFFFFFFFFULL)
+            return 0xFFFFFFFF;
+        return static_cast<uint32_t>(req.file_sent);
+    }
+
+    /*
+    依次发送报头（msg_iov[0]）、文件和报尾（msg_iov[1]），进度保存在请求中，
+    返回false表示需要等待可写。io_uring引擎下poll的结果会覆盖transfered，因此另记file_sent。
+    */
+    static bool SendFile(AsyncRequest & req)
+    {
+        iovec & header = req.msg.msg_iov[0];
+        iovec & trailer = req.msg.msg_iov[1];
+        while(true)
+        {
+            ssize_t result = 0;
+            bool in_file = false;
+            if(header.iov_len)
+            {
+                result = send(req.fd, header.iov_base, header.iov_len,
+                              GetSendFlags(req, 0));
+            }
+            else if(req.file_remaining)
+            {
+                in_file = true;
+                if(req.file_copying)
+                {
+                    result = CopyFile(req);
+                }
+                else
+                {
+                    off_t offset = req.offset;
+                    result = sendfile(req.fd, req.file_fd, &offset,
+                                      static_cast<size_t>(std::min<uint64_t>(
+                                          req.file_remaining, kMaxSendFileChunk)));
+                }
+            }
+            else if(trailer.iov_len)
+            {
+                result = send(req.fd, trailer.iov_base, trailer.iov_len,
+                              MSG_DONTWAIT | MSG_NOSIGNAL);
+            }
+            else
+            {
+                req.error = 0;
+                req.transfered = FileSent(req);
+                return true;
+            }
+
+            if(result > 0)
+            {
+                size_t size = static_cast<size_t>(result);
+                req.file_sent += size;
+                if(in_file)
+                {
+                    req.offset += size;
+                    req.file_remaining -= size;
+                }
+                else
+                {
+                    iovec & current = header.iov_len ? header : trailer;
+                    current.iov_base = static_cast<char *>(current.iov_base) + size;
+                    current.iov_len -= size;
+                }
+                continue;
+            }
+
+            //文件比指定的长度短
+            if(result == 0 && in_file)
+            {
+                req.file_remaining = 0;
+                continue;
+            }
+
+            if(errno == EINTR)
+                continue;
+
+            if(errno == EAGAIN || errno == EWOULDBLOCK)
+                return false;
+
+            if(in_file && !req.file_copying &&
+               (errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP))
+            {
+                req.file_copying = true;
+                continue;
+            }
+
+            req.error = errno;
+            req.transfered = FileSent(req);
+            return true;
+        }
+    }
+
+    //可读之后才从池中取缓冲区，没有数据时归还
+    static bool RecvPooled(AsyncRequest & req)
+    {
+        void * buffer = req.pool->Acquire();
+        if(buffer == 0)
+        {
+            req.error = ENOBUFS;
+            req.transfered = 0;
+            return true;
+        }
+
+        ssize_t result = 0;
+        do
+        {
+            result = recv(req.fd, buffer, req.iov.iov_len, MSG_DONTWAIT);
+        } while(result < 0 && errno == EINTR);
+
+        if(result > 0)
+        {
+            req.pooled = buffer;
+            req.error = 0;
+            req.transfered = static_cast<uint32_t>(result);
+            return true;
+        }
+
+        int error = errno;
+        req.pool->Release(buffer);
+        if(result < 0 && (error == EAGAIN || error == EWOULDBLOCK))
+            return false;
+
+        req.error = result < 0 ? error : 0;
+        req.transfered = 0;
+        return true;
+    }
+
+    //以非阻塞方式执行请求，返回false表示需要等待就绪
+    static bool Perform(AsyncRequest & req)
+    {
+        ssize_t result = 0;
+        while(true)
+        {
+            switch(req.op)
+            {
+            case AsyncRequestOp::kRequestRead:
+                if(req.offset < 0)
+                    result = readv(req.fd, req.msg.msg_iov, req.msg.msg_iovlen);
+                else
+                    result = preadv(req.fd, req.msg.msg_iov,
+                                    req.msg.msg_iovlen, req.offset);
+                break;
+            case AsyncRequestOp::kRequestWrite:
+                if(req.offset < 0)
+                    result = writev(req.fd, req.msg.msg_iov,
+                                    req.msg.msg_iovlen);
+                else
+                    result = pwritev(req.fd, req.msg.msg_iov,
+                                     req.msg.msg_iovlen, req.offset);
+                break;
+            case AsyncRequestOp::kRequestRecvMsg:
+                result = recvmsg(req.fd, &req.msg, req.flags);
+                break;
+            case AsyncRequestOp::kRequestSendMsg:
+                result = sendmsg(req.fd, &req.msg, req.flags | MSG_NOSIGNAL);
+                break;
+            case AsyncRequestOp::kRequestAccept:
+                result = accept4(req.fd, req.addr, &req.addr_size,
+                                 SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if(result >= 0)
+                {
+                    req.accepted = static_cast<int>(result);
+                    result = 0;
+                }
+                break;
+            case AsyncRequestOp::kRequestConnect:
+                if(!req.started)
+                {
+                    req.started = true;
+                    result = connect(req.fd, req.addr, req.addr_size);
+                    if(result < 0 && errno == EINPROGRESS)
+                        return false;
+                }
+                else
+                {
+                    int error = 0;
+                    socklen_t size = sizeof(error);
+                    result = getsockopt(req.fd, SOL_SOCKET, SO_ERROR,
+                                        &error, &size);
+                    if(result == 0 && error != 0)
+                    {
+                        errno = error;
+                        result = -1;
+                    }
+                    else if(result == 0)
+                    {
+                        //可写事件也可能早于连接完成
+                        sockaddr_storage peer;
+                        socklen_t peer_size = sizeof(peer);
+                        auto peer_ptr = reinterpret_cast<sockaddr *>(&peer);
+                        if(getpeername(req.fd, peer_ptr, &peer_size) < 0)
+                        {
+                            if(errno == ENOTCONN)
+                                return false;
+                            result = -1;
+                        }
+                    }
+                }
+                if(result == 0 && req.iov.iov_len != 0)
+                {
+                    //与ConnectEx一致，连接成功后发送缓冲区中的数据
+                    req.op = AsyncRequestOp::kRequestSendMsg;
+                    continue;
+                }
+                break;
+            case AsyncRequestOp::kRequestShutdown:
+                result = shutdown(req.fd, req.flags);
+                break;
+            case AsyncRequestOp::kRequestRecvMMsg:
+                result = recvmmsg(req.fd, req.mmsg, req.vlen,
+                                  req.flags | MSG_DONTWAIT, 0);
+                break;
+            case AsyncRequestOp::kRequestSendMMsg:
+                result = sendmmsg(req.fd, req.mmsg, req.vlen,
+                                  req.flags | MSG_DONTWAIT | MSG_NOSIGNAL);
+                break;
+            case AsyncRequestOp::kRequestSendFile:
+                return SendFile(req);
+            case AsyncRequestOp::kRequestSpliceRecv:
+                result = splice(req.fd, 0, req.pipe_fd, 0, req.iov.iov_len,
+                                SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+                break;
+            case AsyncRequestOp::kRequestSpliceSend:
+                result = splice(req.pipe_fd, 0, req.fd, 0, req.iov.iov_len,
+                                SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+                break;
+            case AsyncRequestOp::kRequestRecvPooled:
+                return RecvPooled(req);
+            default:
+                errno = EINVAL;
+                result = -1;
+                break;
+            }
+
+            if(result >= 0)
+            {
+                req.error = 0;
+                req.transfered = static_cast<uint32_t>(result);
+                return true;
+            }
+
+            if(errno == EINTR)
+                continue;
+
+            if(errno == EAGAIN || errno == EWOULDBLOCK)
+                return false;
+
+            req.error = errno;
+            req.transfered = 0;
+            return true;
+        }
+    }
+};
+
+__thread Proactor * ProactorRoutines::running_ = 0;
+
+/*
+前摄器
+*/
+Proactor::Proactor()
+    : timer_wake_(static_cast<uint64_t>(-1)),
+      spin_limit_(0), spin_adaptive_(false), spin_budget_(0), spin_gap_(0),
+      engine_(ProactorEngine::kEpoll), epoll_fd_(-1), wake_fd_(-1),
+      completed_head_(0), completed_tail_(0),
+      fixed_files_(false), fixed_buffers_(false), next_buffer_group_(0)
+{
+    memset(entries_, 0, sizeof(entries_));
+    memset(buffers_, 0, sizeof(buffers_));
+}
+
+Proactor::~Proactor()
+{
+    fini();
+}
+
+bool Proactor::init()
+{
+    return init(ProactorEngine::kEpoll);
+}
+
+bool Proactor::init(ProactorEngine::Value engine)
+{
+    if(wake_fd_ >= 0)
+        return true;
+
+    engine_ = engine;
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(wake_fd_ < 0)
+        return false;
+
+    if(engine_ == ProactorEngine::kIORing)
+    {
+        if(!InitRing())
+        {
+            fini();
+            return false;
+        }
+        return true;
+    }
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if(epoll_fd_ < 0)
+    {
+        fini();
+        return false;
+    }
+
+    epoll_event ev;
+    ev.events = EPOLLIN | EPOLLET;
+    ev.data.fd = wake_fd_;
+    if(epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev))
+    {
+        fini();
+        return false;
+    }
+
+    return true;
+}
+
+void Proactor::fini()
+{
+    if(wake_fd_ >= 0)
+    {
+        close(wake_fd_);
+        wake_fd_ = -1;
+    }
+
+    if(epoll_fd_ >= 0)
+    {
+        close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+
+    ring_.fini();
+    fixed_files_ = false;
+    fixed_buffers_ = false;
+    free_files_.clear();
+    memset(buffers_, 0, sizeof(buffers_));
+
+    for(size_t i = 0; i < kMaxEntryChunks; ++i)
+    {
+        delete [] entries_[i];
+        entries_[i] = 0;
+    }
+
+    completed_head_ = 0;
+    completed_tail_ = 0;
+    posted_.TakeAll();
+    return;
+}
+
+ProactorEngine::Value Proactor::engine() const
+{
+    return engine_;
+}
+
+void Proactor::Run(int ms)
+{
+    RunBatch(ms, 1);
+}
+
+size_t Proactor::RunBatch(int ms, size_t max_events)
+{
+    if(max_events == 0)
+        return 0;
+
+    DispatchScope scope(*this);
+    if(engine_ == ProactorEngine::kIORing)
+        return RunRing(ms, max_events);
+
+    assert(epoll_fd_ >= 0);
+
+    if(epoll_fd_ < 0)
+        return 0;
+
+    epoll_event events[kMaxBatchEvents];
+    size_t processed = 0;
+    size_t dispatched = 0;
+    int timeout = GetWaitTime(ms);
+
+    while(processed < max_events)
+    {
+        size_t wanted = max_events - processed;
+        if(wanted > kMaxBatchEvents)
+            wanted = kMaxBatchEvents;
+        int count = epoll_wait(epoll_fd_, events, static_cast<int>(wanted),
+                               timeout);
+        if(count <= 0)
+            break;
+
+        AsyncContext * head = 0;
+        AsyncContext * tail = 0;
+        AsyncTask * posted = 0;
+
+        for(int i = 0; i < count; ++i)
+        {
+            epoll_event & ev = events[i];
+            if(ev.data.fd == wake_fd_)
+            {
+                uint64_t value = 0;
+                while(read(wake_fd_, &value, sizeof(value)) > 0);
+                TakeCompleted(head, tail);
+                posted = TakePosted();
+                continue;
+            }
+
+            PortalEntry * entry = GetEntry(ev.data.fd, false);
+            if(entry == 0)
+                continue;
+
+            //边沿触发，就绪的请求必须一次取尽
+            const uint32_t kErrorEvents = EPOLLERR | EPOLLHUP;
+            bool readable = (ev.events & (EPOLLIN | EPOLLRDHUP | kErrorEvents)) != 0;
+            bool writable = (ev.events & (EPOLLOUT | kErrorEvents)) != 0;
+            Drain(*entry, readable, writable, head, tail);
+        }
+
+        dispatched += Dispatch(head);
+        dispatched += AsyncTaskQueue::Run(posted);
+        processed += count;
+
+        //取满了说明可能还有积压，继续不等待地取
+        if(static_cast<size_t>(count) < wanted)
+            break;
+        timeout = 0;
+    }
+
+    dispatched += RunTimers();
+    return dispatched;
+}
+
+bool Proactor::Associate(IOPortal & portal)
+{
+    if(wake_fd_ < 0)
+        return false;
+
+    int fd = ProactorRoutines::GetFd(portal);
+    if(fd < 0)
+        return false;
+
+    int flags = fcntl(fd, F_GETFL);
+    if(flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
+        return false;
+
+    PortalEntry * entry = GetEntry(fd, true);
+    if(entry == 0)
+        return false;
+
+    if(engine_ == ProactorEngine::kIORing)
+    {
+        //普通文件的请求可以并发，其余的按方向排队
+        struct stat st;
+        bool regular = fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+
+        int fixed_index = entry->fixed_index;
+        if(fixed_index < 0 && fixed_files_)
+        {
+            fixed_lock_.Acquire();
+            if(!free_files_.empty())
+            {
+                fixed_index = free_files_.back();
+                free_files_.pop_back();
+            }
+            fixed_lock_.Release();
+        }
+
+        //固定文件表满了或者注册失败时退回普通的fd
+        if(fixed_index >= 0 && !ring_.UpdateFile(fixed_index, fd))
+        {
+            fixed_lock_.Acquire();
+            free_files_.push_back(fixed_index);
+            fixed_lock_.Release();
+            fixed_index = -1;
+        }
+
+        entry->lock.Acquire();
+        entry->portal = &portal;
+        entry->always_ready = regular;
+        entry->fixed_index = fixed_index;
+        entry->lock.Release();
+        return true;
+    }
+
+    epoll_event ev;
+    ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    ev.data.fd = fd;
+
+    bool always_ready = false;
+    if(epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev))
+    {
+        if(errno == EEXIST)
+        {
+            if(epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev))
+                return false;
+        }
+        else if(errno == EPERM)
+        {
+            always_ready = true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    entry->lock.Acquire();
+    entry->portal = &portal;
+    entry->always_ready = always_ready;
+    entry->lock.Release();
+    return true;
+}
+
+void Proactor::Dissociate(IOPortal & portal)
+{
+    if(wake_fd_ < 0)
+        return;
+
+    int fd = ProactorRoutines::GetFd(portal);
+    PortalEntry * entry = GetEntry(fd, false);
+    if(entry == 0 || entry->portal != &portal)
+        return;
+
+    Cancel(portal);
+    if(engine_ == ProactorEngine::kEpoll)
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, 0);
+
+    entry->lock.Acquire();
+    int fixed_index = entry->fixed_index;
+    entry->portal = 0;
+    entry->fixed_index = -1;
+    entry->lock.Release();
+
+    //固定文件持有文件的引用，必须在close之前释放
+    if(fixed_index >= 0)
+    {
+        ring_.UpdateFile(fixed_index, -1);
+        fixed_lock_.Acquire();
+        free_files_.push_back(fixed_index);
+        fixed_lock_.Release();
+    }
+}
+
+bool Proactor::Submit(AsyncContext & args)
+{
+    AsyncRequest & req = args.request_;
+    PortalEntry * entry = GetEntry(req.fd, false);
+    if(entry == 0)
+    {
+        errno = EBADF;
+        return false;
+    }
+
+    bool completed = false;
+    entry->lock.Acquire();
+    if(entry->portal == 0)
+    {
+        entry->lock.Release();
+        errno = EBADF;
+        return false;
+    }
+
+    //定时器在请求可见之前启动，到期处理需要获得entry的锁才能取消请求
+    IOPortal * portal = entry->portal;
+    req.portal = portal;
+    portal->StartDeadline(this, args);
+
+    if(engine_ == ProactorEngine::kIORing && entry->always_ready)
+    {
+        bool pushed = PushRequest(args, entry->fixed_index);
+        entry->lock.Release();
+        if(pushed)
+            FlushRequests();
+        else
+            portal->StopDeadline(args);
+        return pushed;
+    }
+
+    bool is_read = ProactorRoutines::IsReadRequest(req);
+    AsyncContext *& head = is_read ? entry->read_head : entry->write_head;
+    AsyncContext *& tail = is_read ? entry->read_tail : entry->write_tail;
+
+    if(engine_ == ProactorEngine::kIORing)
+    {
+        //只有队列头部的请求交给内核
+        bool pushed = true;
+        if(head == 0)
+            pushed = PushRequest(args, entry->fixed_index);
+        if(pushed)
+            ProactorRoutines::Append(head, tail, &args, req);
+        entry->lock.Release();
+        if(pushed)
+            FlushRequests();
+        else
+            portal->StopDeadline(args);
+        return pushed;
+    }
+
+    //队列非空时必须排队，以保证同一方向上的请求按顺序完成
+    if(head == 0 && ProactorRoutines::Perform(req))
+        completed = true;
+    else
+        ProactorRoutines::Append(head, tail, &args, req);
+    entry->lock.Release();
+
+    if(completed)
+    {
+        req.next = 0;
+        Complete(&args, &args);
+    }
+    return true;
+}
+
+bool Proactor::Cancel(IOPortal & portal)
+{
+    int fd = ProactorRoutines::GetFd(portal);
+    PortalEntry * entry = GetEntry(fd, false);
+    if(entry == 0)
+        return false;
+
+    AsyncContext * head = 0;
+    AsyncContext * tail = 0;
+
+    entry->lock.Acquire();
+    if(entry->portal != &portal)
+    {
+        entry->lock.Release();
+        return false;
+    }
+
+    AsyncContext * queues[] = {entry->read_head, entry->write_head};
+    if(engine_ == ProactorEngine::kIORing)
+    {
+        //队列头部已经交给内核，由内核以ECANCELED完成
+        for(size_t i = 0; i < 2; ++i)
+        {
+            if(queues[i] == 0)
+                continue;
+            AsyncRequest & req = queues[i]->request_;
+            queues[i] = req.next;
+            req.next = 0;
+        }
+        entry->read_tail = entry->read_head;
+        entry->write_tail = entry->write_head;
+
+        sq_lock_.Acquire();
+        io_uring_sqe * sqe = ring_.GetSqe();
+        if(sqe)
+        {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->cancel_flags = IORING_ASYNC_CANCEL_FD |
+                                IORING_ASYNC_CANCEL_ALL;
+            sqe->fd = fd;
+            if(entry->fixed_index >= 0)
+            {
+                sqe->fd = entry->fixed_index;
+                sqe->cancel_flags |= IORING_ASYNC_CANCEL_FD_FIXED;
+            }
+            sqe->user_data = ProactorRoutines::kCancelData;
+            ring_.Commit();
+        }
+        sq_lock_.Release();
+        ring_.Enter(0, 0);
+    }
+    else
+    {
+        entry->read_head = entry->read_tail = 0;
+        entry->write_head = entry->write_tail = 0;
+    }
+    entry->lock.Release();
+
+    for(size_t i = 0; i < 2; ++i)
+    {
+        AsyncContext * args = queues[i];
+        while(args)
+        {
+            AsyncRequest & req = args->request_;
+            AsyncContext * next = req.next;
+            req.error = ECANCELED;
+            req.transfered = 0;
+            ProactorRoutines::Append(head, tail, args, req);
+            args = next;
+        }
+    }
+
+    if(head)
+        Complete(head, tail);
+    return true;
+}
+
+bool Proactor::Cancel(IOPortal & portal, AsyncContext & args)
+{
+    int fd = ProactorRoutines::GetFd(portal);
+    PortalEntry * entry = GetEntry(fd, false);
+    if(entry == 0)
+        return false;
+
+    AsyncRequest & target = args.request_;
+    bool found = false;
+    bool in_kernel = false;
+
+    entry->lock.Acquire();
+    if(entry->portal != &portal)
+    {
+        entry->lock.Release();
+        return false;
+    }
+
+    AsyncContext ** heads[] = {&entry->read_head, &entry->write_head};
+    AsyncContext ** tails[] = {&entry->read_tail, &entry->write_tail};
+    for(size_t i = 0; i < 2 && !found; ++i)
+    {
+        AsyncContext * prev = 0;
+        AsyncContext * current = *heads[i];
+        while(current && current != &args)
+        {
+            prev = current;
+            current = current->request_.next;
+        }
+        if(current == 0)
+            continue;
+
+        found = true;
+        //io_uring引擎下队列头部已经交给内核，由内核以ECANCELED完成
+        if(engine_ == ProactorEngine::kIORing && prev == 0)
+        {
+            in_kernel = true;
+            break;
+        }
+
+        if(prev)
+            prev->request_.next = target.next;
+        else
+            *heads[i] = target.next;
+        if(*tails[i] == &args)
+            *tails[i] = prev;
+    }
+
+    //普通文件的请求不排队，不在队列中时可能仍在内核中
+    if(!found && engine_ == ProactorEngine::kIORing && entry->always_ready)
+        in_kernel = true;
+
+    if(in_kernel)
+    {
+        sq_lock_.Acquire();
+        io_uring_sqe * sqe = ring_.GetSqe();
+        if(sqe)
+        {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->addr = reinterpret_cast<uint64_t>(&args);
+            sqe->user_data = ProactorRoutines::kCancelData;
+            ring_.Commit();
+        }
+        sq_lock_.Release();
+        ring_.Enter(0, 0);
+    }
+    entry->lock.Release();
+
+    if(found && !in_kernel)
+    {
+        target.next = 0;
+        target.error = ECANCELED;
+        target.transfered = 0;
+        Complete(&args, &args);
+    }
+    return found || in_kernel;
+}
+
+Proactor::PortalEntry * Proactor::GetEntry(int fd, bool create)
+{
+    if(fd < 0)
+        return 0;
+
+    size_t chunk = static_cast<size_t>(fd) / kEntryChunkSize;
+    size_t index = static_cast<size_t>(fd) % kEntryChunkSize;
+    if(chunk >= kMaxEntryChunks)
+        return 0;
+
+    PortalEntry * entries = __atomic_load_n(&entries_[chunk],
+                                            __ATOMIC_ACQUIRE);
+    if(entries == 0 && create)
+    {
+        entries_lock_.Acquire();
+        entries = entries_[chunk];
+        if(entries == 0)
+        {
+            entries = new PortalEntry[kEntryChunkSize];
+            __atomic_store_n(&entries_[chunk], entries, __ATOMIC_RELEASE);
+        }
+        entries_lock_.Release();
+    }
+
+    if(entries == 0)
+        return 0;
+
+    return &entries[index];
+}
+
+void Proactor::Complete(AsyncContext * head, AsyncContext * tail)
+{
+    bool was_empty = false;
+
+    completed_lock_.Acquire();
+    was_empty = completed_head_ == 0;
+    if(completed_tail_)
+        completed_tail_->request_.next = head;
+    else
+        completed_head_ = head;
+    completed_tail_ = tail;
+    completed_lock_.Release();
+
+    //队列由空变为非空时才需要唤醒
+    if(was_empty)
+        Wake();
+}
+
+bool Proactor::Post(AsyncTask & task)
+{
+    if(wake_fd_ < 0)
+        return false;
+
+    posted_lock_.Acquire();
+    bool was_empty = posted_.Push(task);
+    posted_lock_.Release();
+
+    //与完成通知共用唤醒事件，队列由空变为非空时才需要唤醒
+    if(was_empty)
+        Wake();
+    return true;
+}
+
+bool Proactor::Wake()
+{
+    if(wake_fd_ < 0)
+        return false;
+
+    uint64_t value = 1;
+    while(write(wake_fd_, &value, sizeof(value)) < 0 && errno == EINTR);
+    return true;
+}
+
+AsyncTask * Proactor::TakePosted()
+{
+    posted_lock_.Acquire();
+    AsyncTask * head = posted_.TakeAll();
+    posted_lock_.Release();
+    return head;
+}
+
+void Proactor::Drain(PortalEntry & entry, bool readable, bool writable,
+                     AsyncContext *& head, AsyncContext *& tail)
+{
+    entry.lock.Acquire();
+    AsyncContext ** heads[] = {&entry.read_head, &entry.write_head};
+    AsyncContext ** tails[] = {&entry.read_tail, &entry.write_tail};
+    bool ready[] = {readable, writable};
+
+    for(size_t i = 0; i < 2; ++i)
+    {
+        if(!ready[i])
+            continue;
+
+        AsyncContext *& queue_head = *heads[i];
+        AsyncContext *& queue_tail = *tails[i];
+        while(queue_head)
+        {
+            AsyncContext * args = queue_head;
+            AsyncRequest & req = args->request_;
+            if(!ProactorRoutines::Perform(req))
+                break;
+
+            queue_head = req.next;
+            if(queue_head == 0)
+                queue_tail = 0;
+            ProactorRoutines::Append(head, tail, args, req);
+        }
+    }
+    entry.lock.Release();
+}
+
+void Proactor::TakeCompleted(AsyncContext *& head, AsyncContext *& tail)
+{
+    completed_lock_.Acquire();
+    AsyncContext * completed_head = completed_head_;
+    AsyncContext * completed_tail = completed_tail_;
+    completed_head_ = 0;
+    completed_tail_ = 0;
+    completed_lock_.Release();
+
+    if(completed_head == 0)
+        return;
+
+    if(tail)
+        tail->request_.next = completed_head;
+    else
+        head = completed_head;
+    tail = completed_tail;
+}
+
+size_t Proactor::Dispatch(AsyncContext * head)
+{
+    size_t count = 0;
+    while(head)
+    {
+        //回调中可能重新投递该上下文，先取出next
+        AsyncContext & args = *head;
+        AsyncRequest & req = args.request_;
+        head = req.next;
+        req.next = 0;
+        req.portal->Deliver(args, req.error, req.transfered);
+        ++count;
+    }
+    return count;
+}
+
+bool Proactor::RegisterBuffer(void * buffer, size_t size)
+{
+    if(!fixed_buffers_ || buffer == 0 || size == 0)
+        return false;
+
+    bool registered = false;
+    fixed_lock_.Acquire();
+    for(uint32_t i = 0; i < kMaxFixedBuffers; ++i)
+    {
+        if(buffers_[i].base != 0)
+            continue;
+        if(ring_.UpdateBuffer(i, buffer, size))
+        {
+            buffers_[i].base = static_cast<char *>(buffer);
+            buffers_[i].size = size;
+            registered = true;
+        }
+        break;
+    }
+    fixed_lock_.Release();
+    return registered;
+}
+
+bool Proactor::UnregisterBuffer(void * buffer)
+{
+    if(!fixed_buffers_ || buffer == 0)
+        return false;
+
+    bool unregistered = false;
+    fixed_lock_.Acquire();
+    for(uint32_t i = 0; i < kMaxFixedBuffers; ++i)
+    {
+        if(buffers_[i].base != buffer)
+            continue;
+        //进行中的请求持有缓冲区的引用，可以直接替换为空
+        ring_.UpdateBuffer(i, 0, 0);
+        buffers_[i].base = 0;
+        buffers_[i].size = 0;
+        unregistered = true;
+        break;
+    }
+    fixed_lock_.Release();
+    return unregistered;
+}
+
+bool Proactor::RegisterBufferPool(SocketBufferPool & pool)
+{
+    if(engine_ != ProactorEngine::kIORing || ring_.fd() < 0)
+        return false;
+
+    fixed_lock_.Acquire();
+    uint16_t group = next_buffer_group_++;
+    fixed_lock_.Release();
+    return pool.AttachRing(*this, ring_, group);
+}
+
+bool Proactor::UnregisterBufferPool(SocketBufferPool & pool)
+{
+    if(engine_ != ProactorEngine::kIORing || ring_.fd() < 0)
+        return false;
+
+    return pool.DetachRing(*this, ring_);
+}
+
+bool Proactor::InitRing()
+{
+    if(!ring_.init(kRingEntries))
+        return false;
+
+    //固定文件表不能超过RLIMIT_NOFILE
+    uint32_t max_files = kMaxFixedFiles;
+    rlimit limit;
+    if(getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < max_files)
+        max_files = static_cast<uint32_t>(limit.rlim_cur);
+
+    //固定文件和固定缓冲区需要较新的内核，不支持时退回普通方式
+    fixed_files_ = ring_.RegisterFiles(max_files);
+    if(fixed_files_)
+    {
+        free_files_.reserve(max_files);
+        for(uint32_t i = max_files; i > 0; --i)
+            free_files_.push_back(static_cast<int>(i - 1));
+    }
+    fixed_buffers_ = ring_.RegisterBuffers(kMaxFixedBuffers);
+
+    if(!ArmWake())
+        return false;
+    return ring_.Enter(0, 0);
+}
+
+size_t Proactor::RunRing(int ms, size_t max_events)
+{
+    assert(ring_.fd() >= 0);
+
+    if(ring_.fd() < 0)
+        return 0;
+
+    //完成队列中已有事件且没有待提交的请求时，无需进入内核
+    if(ring_.Ready() == 0 || ring_.Pending() != 0)
+    {
+        //一次系统调用完成提交和等待
+        int timeout = GetWaitTime(ms);
+        if(!ring_.Enter(timeout == 0 ? 0 : 1, timeout))
+            return RunTimers();
+    }
+
+    io_uring_cqe cqes[kMaxBatchEvents];
+    size_t processed = 0;
+
+    while(processed < max_events)
+    {
+        size_t wanted = max_events - processed;
+        if(wanted > kMaxBatchEvents)
+            wanted = kMaxBatchEvents;
+
+        cq_lock_.Acquire();
+        uint32_t count = ring_.Reap(cqes, static_cast<uint32_t>(wanted));
+        cq_lock_.Release();
+        if(count == 0)
+            break;
+
+        AsyncContext * head = 0;
+        AsyncContext * tail = 0;
+        AsyncTask * posted = 0;
+        bool woken = false;
+        bool rearm = false;
+
+        for(uint32_t i = 0; i < count; ++i)
+        {
+            io_uring_cqe & cqe = cqes[i];
+            if(cqe.user_data == ProactorRoutines::kCancelData)
+                continue;
+
+            //一批中可能有多个唤醒完成，队列只在批末取一次，不能覆盖已取出的任务
+            if(cqe.user_data == ProactorRoutines::kWakeData)
+            {
+                uint64_t value = 0;
+                while(read(wake_fd_, &value, sizeof(value)) > 0);
+                if((cqe.flags & IORING_CQE_F_MORE) == 0)
+                    rearm = true;
+                woken = true;
+                continue;
+            }
+
+            auto args = reinterpret_cast<AsyncContext *>(cqe.user_data);
+            if(OnRingCompleted(*args, cqe.res, cqe.flags))
+                ProactorRoutines::Append(head, tail, args, args->request_);
+        }
+
+        if(woken)
+        {
+            TakeCompleted(head, tail);
+            posted = TakePosted();
+        }
+
+        if(rearm)
+            ArmWake();
+
+        //回调中投递的请求在下一次Run时随等待一起提交
+        Proactor * running = ProactorRoutines::running_;
+        ProactorRoutines::running_ = this;
+        processed += Dispatch(head);
+        processed += AsyncTaskQueue::Run(posted);
+        ProactorRoutines::running_ = running;
+
+        if(count < wanted)
+            break;
+    }
+
+    processed += RunTimers();
+    return processed;
+}
+
+bool Proactor::ArmWake()
+{
+    //用多次触发的poll监听唤醒事件，Complete投递的完成通知经由它送达
+    sq_lock_.Acquire();
+    io_uring_sqe * sqe = ring_.GetSqe();
+    if(sqe)
+    {
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = wake_fd_;
+        sqe->poll32_events = POLLIN;
+        sqe->len = IORING_POLL_ADD_MULTI;
+        sqe->user_data = ProactorRoutines::kWakeData;
+        ring_.Commit();
+    }
+    sq_lock_.Release();
+    return sqe != 0;
+}
+
+bool Proactor::PushRequest(AsyncContext & args, int fixed_index)
+{
+    AsyncRequest & req = args.request_;
+    int buf_index = -1;
+    if(fixed_buffers_ && req.msg.msg_iovlen == 1)
+        buf_index = FindFixedBuffer(req.msg.msg_iov[0]);
+
+    sq_lock_.Acquire();
+    io_uring_sqe * sqe = ring_.GetSqe();
+    if(sqe == 0)
+    {
+        //提交队列已满，先提交再重试
+        ring_.Enter(0, 0);
+        sqe = ring_.GetSqe();
+    }
+
+    if(sqe)
+    {
+        ProactorRoutines::PrepareSqe(*sqe, req, fixed_index, buf_index);
+        sqe->user_data = reinterpret_cast<uint64_t>(&args);
+        ring_.Commit();
+    }
+    sq_lock_.Release();
+
+    if(sqe == 0)
+    {
+        errno = EBUSY;
+        return false;
+    }
+    return true;
+}
+
+void Proactor::FlushRequests()
+{
+    //在Run的回调中投递的请求留待下一次Run批量提交
+    if(ProactorRoutines::running_ != this)
+        ring_.Enter(0, 0);
+}
+
+int Proactor::FindFixedBuffer(const iovec & iov)
+{
+    const char * begin = static_cast<const char *>(iov.iov_base);
+    const char * end = begin + iov.iov_len;
+
+    int index = -1;
+    fixed_lock_.Acquire();
+    for(uint32_t i = 0; i < kMaxFixedBuffers; ++i)
+    {
+        const FixedBuffer & fb = buffers_[i];
+        if(fb.base && begin >= fb.base && end <= fb.base + fb.size)
+        {
+            index = static_cast<int>(i);
+            break;
+        }
+    }
+    fixed_lock_.Release();
+    return index;
+}
+
+bool Proactor::OnRingCompleted(AsyncContext & args, int result,
+                               uint32_t flags)
+{
+    AsyncRequest & req = args.request_;
+    req.error = result < 0 ? -result : 0;
+    req.transfered = result < 0 ? 0 : static_cast<uint32_t>(result);
+
+    if(flags & IORING_CQE_F_BUFFER)
+    {
+        //内核选取的缓冲区，读到结束时没有数据，直接归还
+        uint32_t index = flags >> IORING_CQE_BUFFER_SHIFT;
+        void * buffer = req.pool->TakeRing(index);
+        if(result > 0)
+            req.pooled = buffer;
+        else
+            req.pool->Release(buffer);
+    }
+
+    if(req.op == AsyncRequestOp::kRequestAccept && result >= 0)
+    {
+        req.accepted = result;
+        req.transfered = 0;
+    }
+
+    PortalEntry * entry = GetEntry(req.fd, false);
+    if(entry == 0)
+        return true;
+
+    entry->lock.Acquire();
+    if(req.op == AsyncRequestOp::kRequestConnect && result == 0 &&
+       req.iov.iov_len != 0)
+    {
+        //与ConnectEx一致，连接成功后发送缓冲区中的数据，仍占据队列头部
+        req.op = AsyncRequestOp::kRequestSendMsg;
+        if(PushRequest(args, entry->fixed_index))
+        {
+            entry->lock.Release();
+            return false;
+        }
+        req.error = EBUSY;
+    }
+    else if(ProactorRoutines::IsPollRequest(req) && result >= 0)
+    {
+        //poll只表示就绪，此时执行recvmmsg/sendmmsg；被抢先时重新poll
+        if(!ProactorRoutines::Perform(req))
+        {
+            if(PushRequest(args, entry->fixed_index))
+            {
+                entry->lock.Release();
+                return false;
+            }
+            req.error = EBUSY;
+            req.transfered = 0;
+        }
+    }
+
+    AsyncContext * failed_head = 0;
+    AsyncContext * failed_tail = 0;
+    if(!entry->always_ready)
+    {
+        bool is_read = ProactorRoutines::IsReadRequest(req);
+        AsyncContext *& head = is_read ? entry->read_head : entry->write_head;
+        AsyncContext *& tail = is_read ? entry->read_tail : entry->write_tail;
+        if(head == &args)
+        {
+            head = req.next;
+            if(head == 0)
+                tail = 0;
+
+            //提交下一个排队的请求，提交失败的直接完成
+            while(head)
+            {
+                AsyncContext * next = head;
+                if(PushRequest(*next, entry->fixed_index))
+                    break;
+                head = next->request_.next;
+                if(head == 0)
+                    tail = 0;
+                next->request_.error = EBUSY;
+                next->request_.transfered = 0;
+                ProactorRoutines::Append(failed_head, failed_tail, next,
+                                         next->request_);
+            }
+        }
+    }
+    entry->lock.Release();
+
+    req.next = 0;
+    if(failed_head)
+        Complete(failed_head, failed_tail);
+    return true;
+}
+
+
+}
@@ -1,89 +1,223 @@
-﻿#include "io_portal.h"
-#include "thread.h"
-#include "proactor.h"
-
-namespace ncore
-{
-
-/*
-前摄器
-*/
-Proactor::Proactor() : comp_port_(0)
-{
-}
-
-Proactor::~Proactor()
-{
-    fini();
-}
-
-bool Proactor::init()
-{
-    if(comp_port_)
-        return true;
-
-    comp_port_ = CreateIoCompletionPort(INVALID_HANDLE_VALUE, 0, 0, 0);
-
-    return comp_port_ ? true : false;
-}
-
-void Proactor::fini()
-{
-    if(comp_port_)
-    {
-        CloseHandle(comp_port_);
-        comp_port_ = 0;
-    }
-    return;
-}
-
-void Proactor::Run(int ms)
-{
-    assert(comp_port_ != 0);
-
-    if(comp_port_ == 0)
-        return;
-
-    BOOL status = false;
-    DWORD transfered = 0;
-    ULONG_PTR comp_key = 0;
-    LPOVERLAPPED overlapped = 0;
-
-    status = GetQueuedCompletionStatus(comp_port_,
-                                       &transfered,
-                                       &comp_key,
-                                       &overlapped,
-                                       ms);
-
-    if(overlapped)
-    {
-        auto & args = *reinterpret_cast<AsyncContext*>(overlapped);
-        auto portal = reinterpret_cast<IOPortal*>(comp_key);
-        auto error = status ? 0 : GetLastError();
-
-        portal->OnCompleted(args, error, transfered);
-    }
-    else
-    {
-        uint32_t err = GetLastError();
-        if(err == WAIT_TIMEOUT)
-            Thread::Sleep(0, true);
-    }
-}
-
-bool Proactor::Associate(IOPortal & portal)
-{
-    if(comp_port_ == 0)
-        return false;
-    
-    HANDLE handle = portal.GetPlatformHandle();
-    ULONG_PTR comp_key = reinterpret_cast<ULONG_PTR>(&portal);
-
-    if(!CreateIoCompletionPort(handle, comp_port_, comp_key, 0))
-        return false;
-
-    return true;
-}
- 
-}
-
+﻿#include "io_portal.h"
+#include "thread.h"
+#include "proactor.h"
+
+namespace ncore
+{
+
+
+class ProactorRoutines
+{
+private:
+    friend class Proactor;
+
+    typedef ULONG (WINAPI * NtStatusToDosError)(LONG status);
+
+    //GetQueuedCompletionStatusEx不返回每个请求的错误码，需要从NTSTATUS转换
+    static uint32_t GetError(const OVERLAPPED & overlapped)
+    {
+        static NtStatusToDosError convert = reinterpret_cast<NtStatusToDosError>(
+            GetProcAddress(GetModuleHandleW(L"ntdll.dll"),
+                           "RtlNtStatusToDosError"));
+
+        LONG status = static_cast<LONG>(overlapped.Internal);
+        if(status == 0)
+            return 0;
+
+        if(convert == 0)
+            return ERROR_GEN_FAILURE;
+
+        return convert(status);
+    }
+};
+
+/*
+前摄器
+*/
+Proactor::Proactor()
+    : timer_wake_(static_cast<uint64_t>(-1)),
+      spin_limit_(0), spin_adaptive_(false), spin_budget_(0), spin_gap_(0),
+      comp_port_(0)
+{
+}
+
+Proactor::~Proactor()
+{
+    fini();
+}
+
+bool Proactor::init()
+{
+    if(comp_port_)
+        return true;
+
+    comp_port_ = CreateIoCompletionPort(INVALID_HANDLE_VALUE, 0, 0, 0);
+
+    return comp_port_ ? true : false;
+}
+
+void Proactor::fini()
+{
+    if(comp_port_)
+    {
+        CloseHandle(comp_port_);
+        comp_port_ = 0;
+    }
+    posted_.TakeAll();
+    return;
+}
+
+void Proactor::Run(int ms)
+{
+    assert(comp_port_ != 0);
+
+    if(comp_port_ == 0)
+        return;
+
+    DispatchScope scope(*this);
+
+    BOOL status = false;
+    DWORD transfered = 0;
+    ULONG_PTR comp_key = 0;
+    LPOVERLAPPED overlapped = 0;
+
+    status = GetQueuedCompletionStatus(comp_port_,
+                                       &transfered,
+                                       &comp_key,
+                                       &overlapped,
+                                       GetWaitTime(ms));
+
+    if(overlapped)
+    {
+        auto & args = *reinterpret_cast<AsyncContext*>(overlapped);
+        auto portal = reinterpret_cast<IOPortal*>(comp_key);
+        auto error = status ? 0 : GetLastError();
+
+        portal->Deliver(args, error, transfered);
+    }
+    else if(status && comp_key == reinterpret_cast<ULONG_PTR>(this))
+    {
+        AsyncTaskQueue::Run(TakePosted());
+    }
+    else
+    {
+        uint32_t err = GetLastError();
+        if(err == WAIT_TIMEOUT)
+            Thread::Sleep(0, true);
+    }
+
+    RunTimers();
+}
+
+size_t Proactor::RunBatch(int ms, size_t max_events)
+{
+    assert(comp_port_ != 0);
+
+    if(comp_port_ == 0 || max_events == 0)
+        return 0;
+
+    DispatchScope scope(*this);
+    OVERLAPPED_ENTRY entries[kMaxBatchEvents];
+    size_t processed = 0;
+    DWORD timeout = GetWaitTime(ms);
+
+    while(processed < max_events)
+    {
+        size_t wanted = max_events - processed;
+        if(wanted > kMaxBatchEvents)
+            wanted = kMaxBatchEvents;
+        ULONG count = static_cast<ULONG>(wanted);
+        ULONG removed = 0;
+        if(!GetQueuedCompletionStatusEx(comp_port_, entries, count,
+                                        &removed, timeout, FALSE))
+        {
+            //ms为0的轮询不让出处理器，由调用者决定如何退避
+            if(processed == 0 && ms != 0 && GetLastError() == WAIT_TIMEOUT)
+                Thread::Sleep(0, true);
+            break;
+        }
+
+        for(ULONG i = 0; i < removed; ++i)
+        {
+            OVERLAPPED_ENTRY & entry = entries[i];
+            if(entry.lpOverlapped == 0)
+            {
+                if(entry.lpCompletionKey == reinterpret_cast<ULONG_PTR>(this))
+                    processed += AsyncTaskQueue::Run(TakePosted());
+                continue;
+            }
+
+            auto & args = *reinterpret_cast<AsyncContext*>(entry.lpOverlapped);
+            auto portal = reinterpret_cast<IOPortal*>(entry.lpCompletionKey);
+            auto error = ProactorRoutines::GetError(*entry.lpOverlapped);
+
+            portal->Deliver(args, error, entry.dwNumberOfBytesTransferred);
+            ++processed;
+        }
+
+        //取满了说明可能还有积压，继续不等待地取
+        if(removed < count)
+            break;
+        timeout = 0;
+    }
+
+    processed += RunTimers();
+    return processed;
+}
+
+bool Proactor::Associate(IOPortal & portal)
+{
+    if(comp_port_ == 0)
+        return false;
+    
+    HANDLE handle = portal.GetPlatformHandle();
+    ULONG_PTR comp_key = reinterpret_cast<ULONG_PTR>(&portal);
+
+    if(!CreateIoCompletionPort(handle, comp_port_, comp_key, 0))
+        return false;
+
+    return true;
+}
+
+bool Proactor::Post(AsyncTask & task)
+{
+    if(comp_port_ == 0)
+        return false;
+
+    posted_lock_.Acquire();
+    bool was_empty = posted_.Push(task);
+    posted_lock_.Release();
+
+    //已有唤醒通知在途时，取出通知的线程会一并执行新的任务
+    if(!was_empty)
+        return true;
+
+    return Wake();
+}
+
+bool Proactor::Cancel(IOPortal & portal, AsyncContext & args)
+{
+    HANDLE handle = portal.GetPlatformHandle();
+    return CancelIoEx(handle, &args.overlapped_) ? true : false;
+}
+
+AsyncTask * Proactor::TakePosted()
+{
+    posted_lock_.Acquire();
+    AsyncTask * head = posted_.TakeAll();
+    posted_lock_.Release();
+    return head;
+}
+
+bool Proactor::Wake()
+{
+    if(comp_port_ == 0)
+        return false;
+
+    //完成键为前摄器本身且没有OVERLAPPED的通知，取出后执行投递的任务
+    ULONG_PTR comp_key = reinterpret_cast<ULONG_PTR>(this);
+    return PostQueuedCompletionStatus(comp_port_, 0, comp_key, 0) ? true : false;
+}
+ 
+}
+
@@ -0,0 +1,96 @@
+﻿#include "file_stream.h"
+#include "socket_async_event_args.h"
+#include "socket.h"
+
+namespace ncore
+{
+
+
+/*
+套接字中与平台无关的部分
+*/
+static const uint32_t kCopyBlockSize = 65536;
+
+bool Socket::SendFile(FileStream & file, uint64_t offset, uint32_t length,
+                      uint32_t & transfered)
+{
+    SocketBuffer empty = {0, 0};
+    return SendFile(file, offset, length, empty, empty, transfered);
+}
+
+bool Socket::SendFileByCopy(FileStream & file, uint64_t offset,
+                            uint64_t length, const SocketBuffer & header,
+                            const SocketBuffer & trailer,
+                            uint64_t & transfered)
+{
+    transfered = 0;
+    if(length == 0)
+    {
+        uint64_t file_size = 0;
+        if(!file.GetFileSize(file_size))
+            return false;
+        if(file_size > offset)
+            length = file_size - offset;
+    }
+
+    uint32_t sent = 0;
+    bool succeed = SendAll(header.data, header.size, sent);
+    transfered += sent;
+    if(!succeed)
+        return false;
+
+    std::vector<char> block(static_cast<size_t>(
+        std::min<uint64_t>(length, kCopyBlockSize)) + 1);
+    uint64_t remaining = length;
+    while(remaining)
+    {
+        uint32_t size = static_cast<uint32_t>(
+            std::min<uint64_t>(remaining, kCopyBlockSize));
+        uint32_t read = 0;
+        if(!file.Read(&block[0], size, offset, read))
+            return false;
+
+        //文件比指定的长度短
+        if(read == 0)
+            break;
+
+        succeed = SendAll(&block[0], read, sent);
+        transfered += sent;
+        if(!succeed)
+            return false;
+
+        offset += read;
+        remaining -= read;
+    }
+
+    succeed = SendAll(trailer.data, trailer.size, sent);
+    transfered += sent;
+    return succeed;
+}
+
+uint32_t Socket::ClampTransfered(uint64_t transfered)
+{
+    if(transfered > 0xFFFFFFFFULL)
+        return 0xFFFFFFFF;
+    return static_cast<uint32_t>(transfered);
+}
+
+bool Socket::SendAll(const void * data, size_t size, uint32_t & transfered)
+{
+    transfered = 0;
+    const char * position = static_cast<const char *>(data);
+    while(transfered < size)
+    {
+        uint32_t sent = 0;
+        if(!Send(position + transfered,
+                 static_cast<uint32_t>(size - transfered), sent))
+            return false;
+        if(sent == 0)
+            return false;
+        transfered += sent;
+    }
+    return true;
+}
+
+
+}
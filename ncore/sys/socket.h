@@ -1,341 +1,539 @@
-﻿#ifndef NCORE_SYS_SOCKET_H_
-#define NCORE_SYS_SOCKET_H_
-
-#include <ncore/ncore.h>
-#include <ncore/base/object.h>
-#include "io_portal.h"
-#include "ip_endpoint.h"
-#include "network_define.h"
-
-/*!
-@file socket.h
-*/
-namespace ncore
-{
-
-
-class Proactor;
-class SocketAsyncContext;
-
-/*! 套接字类\n
-可以创建两种方式的套接字：\n
-一种是TCP，即面向连接的可靠的传输协议；\n
-另一种是UDP，即无连接的，不可靠的数据报传输协议。\n
-通信模式分为“同步（阻塞）”模式和“异步（非阻塞）”模式。\n
-*/
-class Socket : public NonCopyableObject,
-               public IOPortal
-{
-public:
-    Socket();
-    ~Socket();
-
-    Socket(Socket && obj);
-    Socket & operator = (Socket && obj);
-
-    /*! 初始化，创建套接字
-    @param[in] af         地址族描述。
-    @param[in] type       套接字的类型描述。
-    @param[in] protocol   协议类型。
-    @return 初始化成功后返回true；否则返回false。
-    @remark 如果af为kInterNetworkV6，会创建双模式的套接字，该套接字能同时使用IPv4和IPv6。\n
-    */
-    bool init(AddressFamily af, 
-              SocketType type,
-              ProtocolType protocol);
-
-    /*! 反初始化，销毁套接字
-    @remark 等同于Close方法。
-    */
-    void fini();
-
-    /*! 销毁套接字，释放资源。
-    @return 销毁成功后返回true；否则返回false。
-    @remark 套接字销毁后将不再可用，除非重新init。\n
-            如果该套接字已经建立了连接，则在Close之前，应该使用Shutdown，以确保数据完全接收和发送。\n
-    */
-    bool Close();
-
-    /*! 绑定
-    @param[in] endpoint 绑定到指定的IP地址和Port。
-    @return 绑定成功后返回true；否则返回false。
-    @remark 做为服务端，都应该使用此方法绑定到IPEndPoint上，然后才能进行监听、接受连接和数据的收发。\n
-    */
-    bool Bind(const IPEndPoint & endpoint);
-
-    /*! 监听
-    @param[in] backlog 最大等待数量，默认为25。
-    @return 监听成功后返回true；否则返回false。
-    @remark 做为TCP服务端，应该使用此方法来进入监听模式，然后才能接受客户端的连接。\n
-            在此之前，需要先使用Bind方法。\n
-    */
-    bool Listen(int backlog = 25);
-
-    /*! 关闭连接
-    @param[in] how 关闭连接的方式。
-    @return 关闭成功后返回true；否则返回false。
-    @remark 做为TCP使用，在销毁之前应该使用此方法，以确保数据能都正确接收和发送。\n
-            当使用此方法后，意味着即将关闭套接字，接着应该使用Close方法。\n
-    */
-    bool Shutdown(SocketShutdown how);
-
-    /*! 同步（阻塞）接受连接
-    @return 接受到连接后返回一个新的Socket。
-    @remark 做为TCP服务端，使用此方法来接受客户端的连接，接受成功后，可以用返回的Socket与客户端进行通信。\n
-            在此之前，需要先使用Listen方法。\n
-    */
-    Socket Accept();
-
-    /*! 同步（阻塞）接受连接
-    @param[in] timeout 接受的超时时间。
-    @return 在timeout时间内返回接受到的Socket，需要使用IsValid判断此Socket是否有效。
-    */
-    Socket Accept(uint32_t timeout);
-
-    /*! 异步（非阻塞）接受连接
-    @param[in] args 异步操作的上下文对象。
-    @return 发起异步接受成功后返回true；否则，返回false。
-    @remark 做为TCP服务端，使用此方法来发起异步接受客户端的连接。\n
-            在此之前，需要将当前套接字与一个Proactor进行关联。\n
-            上下文对象需要设置用于接受客户端连接的Socket，该Socket需要与Proactor进行关联，
-            当连接成功后，服务端可以使用该Socket与客户端进行通信。
-            同时，上下文对象还需要设置一个用于数据收发的缓冲区，指定缓冲区的最小大小为kMinAcceptBufferSize，
-            如果大于kMinAcceptBufferSize，意味着接受成功的同时会接收到大于kMinAcceptBufferSize的部分的数据。
-            另外，上下文对象还需要设置一个异步接受完成的回调函数，回调函数可以通过SocketAsyncEventAdapter进行适配，
-            当异步接受完成时，在此回调函数中会返回该上下文对象。\n
-    */
-    bool AcceptAsync(SocketAsyncContext & args);
-
-    /*! 同步（阻塞）连接
-    @param[in] endpoint 连接到指定的IP地址和Port。
-    @return 连接成功后返回true；否则返回false。
-    @remark 做为TCP服务端，使用此方法来连接到服务端。\n
-    */
-    bool Connect(const IPEndPoint & endpoint);
-
-    /*! 同步（阻塞）连接
-    @param[in] endpoint 连接到指定的IP地址和Port。
-    @param[in] timeout  连接的超时时间。
-    @return 在timeout时间内进行连接。如果连接成功，返回true；否则返回false。
-    */
-    bool Connect(const IPEndPoint & endpoint, uint32_t timeout);
-
-    /*! 异步（非阻塞）连接
-    @param[in] args 异步操作的上下文对象。
-    @return 发起异步连接成功后返回true；否则，返回false。
-    @remark 做为TCP客户端，使用此方法来发起异步连接到服务端。\n
-            在此之前，需要将当前套接字与一个Proactor进行关联。\n
-            上下文对象需要设置服务端的IPEndPoint。
-            同时，上下文对象还需要设置一个异步连接完成的回调函数，回调函数可以通过SocketAsyncEventAdapter进行适配，
-            当异步连接完成时，在此回调函数中会返回该上下文对象。\n
-    */
-    bool ConnectAsync(SocketAsyncContext & args);
-
-    /*! 同步（阻塞）断开连接
-    @param[in] reuse 断开后是否重用。
-    @remark 做为TCP使用，用来断开套接字的连接。\n
-            如果reuse为false，则该套接字将不再可用；否则该套接字还能继续使用。\n
-    */
-    void Disconnect(bool reuse);
-
-    /*! 异步（非阻塞）断开连接
-    @param[in] args 异步操作的上下文对象。
-    @return 发起异步断开连接成功后返回true；否则，返回false。
-    @remark 做为TCP使用，使用此方法来发起异步断开连接。\n
-            发起异步断开连接的Socket应该是异步接受或者异步连接的Socket。\n
-    */
-    bool DisconnectAsync(SocketAsyncContext & args);
-
-    /*! 同步（阻塞）接收数据
-    @param[in] data           接收数据的缓冲区。
-    @param[in] size_to_recv   期望接收的数据的大小。
-    @param[out] transfered    当前接收的数据的大小。
-    @return 接收成功后返回true；否则返回false。
-    @remark 做为TCP使用，用来接收数据。\n
-            如果发送方断开连接或者关闭，则transfered等于0。\n
-    */
-    bool Receive(void * data, uint32_t size_to_recv, uint32_t & transfered);
-
-    /*! 同步（阻塞）接收数据
-    @param[in] data           接收数据的缓冲区。
-    @param[in] size_to_recv   期望接收的数据的大小。
-    @param[in] timeout        接收的超时时间。
-    @param[out] transfered    当前接收的数据的大小。
-    @return 接收成功后返回true；否则返回false。
-    @remark 做为TCP使用，用来在指定的时间内接收数据。\n
-            如果发送方断开连接或者关闭，则transfered等于0。\n
-    */
-    bool Receive(void * data, uint32_t size_to_recv, 
-                 uint32_t timeout, uint32_t & transfered);
-
-    /*! 异步（非阻塞）接收数据
-    @param[in] args 异步操作的上下文对象。
-    @return 发起异步接收成功后返回true；否则返回false。
-    @remark 做为TCP使用，用来接收数据。\n
-            服务端使用上下文对象的accept_socket方法可以得到与客户端建立连接的Socket；
-            客户端直接使用进行异步连接的Socket。\n
-            上下文对象需要设置一个用于接收数据的缓冲区，并指定要接收的最大大小。
-            同时，上下文对象还需要设置一个异步接受完成的回调函数，回调函数可以通过SocketAsyncEventAdapter进行适配，
-            当异步接收完成时，在此回调函数中会返回该上下文对象，可以根据该上下文对象的transfered方法判断实际接收到的数据的大小。\n
-    */
-    bool ReceiveAsync(SocketAsyncContext & args);
-
-    /*! 同步（阻塞）发送数据
-    @param[in] data           发送数据的缓冲区。
-    @param[in] size_to_recv   期望发送的数据的大小。
-    @param[out] transfered    当前发送的数据的大小。
-    @return 发送成功后返回true；否则返回false。
-    @remark 做为TCP使用，用来发送数据。\n
-            如果接收方断开连接或者关闭，transfered等于0。\n
-    */
-    bool Send(const void * data, uint32_t size_to_send, uint32_t & transfered);
-
-    /*! 同步（阻塞）发送数据
-    @param[in] data           发送数据的缓冲区。
-    @param[in] size_to_recv   期望发送的数据的大小。
-    @param[in] timeout        发送的超时时间。
-    @param[out] transfered    当前发送的数据的大小。
-    @return 发送成功后返回true；否则返回false。
-    @remark 做为TCP使用，用来在指定的时间内发送数据。\n
-            如果接收方断开连接或者关闭，transfered等于0。\n
-    */
-    bool Send(const void * data, uint32_t size_to_send, 
-              uint32_t timeout, uint32_t & transfered);
-
-    /*! 异步（非阻塞）发送数据
-    @param[in] args 异步操作的上下文对象。
-    @return 发起异步发送成功后返回true；否则返回false。
-    @remark 做为TCP使用，用来发送数据。\n
-            服务端使用上下文对象的accept_socket方法可以得到与客户端建立连接的Socket；
-            客户端直接使用进行异步连接的Socket。\n
-            上下文对象需要设置一个用于发送数据的缓冲区，并指定要发送数据的大小。
-            同时，上下文对象还需要设置一个异步接受完成的回调函数，回调函数可以通过SocketAsyncEventAdapter进行适配，
-            当异步发送完成时，在此回调函数中会返回该上下文对象，可以根据该上下文对象的count方法和transfered方法判断数据是否全部发送完毕。\n
-    */
-    bool SendAsync(SocketAsyncContext & args);
-
-    /*! 同步（阻塞）接收数据
-    @param[in] data           接收数据的缓冲区。
-    @param[in] size_to_recv   期望接收的数据的大小。
-    @param[out] transfered    当前接收的数据的大小。
-    @param[out] endpoint      数据来源的地址。
-    @return 接收成功后返回true；否则返回false。
-    @remark 做为UDP使用，用来接收数据。\n
-            如果发送方断开连接或者关闭，transfered等于0。\n
-    */
-    bool ReceiveFrom(void * data, uint32_t size_to_recv, 
-                     uint32_t & transfered, IPEndPoint & endpoint);
-
-    /*! 同步（阻塞）接收数据
-    @param[in] data           接收数据的缓冲区。
-    @param[in] size_to_recv   期望接收的数据的大小。
-    @param[in] timeout        接收的超时时间。
-    @param[out] transfered    当前接收的数据的大小。
-    @param[out] endpoint      数据来源的地址。
-    @return 接收成功后返回true；否则返回false。
-    @remark 做为UDP使用，用来在指定的时间内接收数据。\n
-            如果发送方断开连接或者关闭，transfered等于0。\n
-    */
-    bool ReceiveFrom(void * data, uint32_t size_to_recv, uint32_t timeout,
-                     uint32_t & transfered, IPEndPoint & endpoint);
-
-    /*! 异步（非阻塞）接收数据
-    @param[in] args 异步操作的上下文对象。
-    @return 发起异步接收成功后返回true；否则返回false。
-    @remark 做为UDP使用，用来接收数据。\n
-            在此之前，需要将当前套接字与一个Proactor进行关联。\n
-            上下文对象需要设置用于接收到数据的客户端的IPEndPoint。
-            同时，上下文对象还需要设置一个用于接收数据的缓冲区，并指定要接收的最大大小。
-            另外，上下文对象还需要设置一个异步接受完成的回调函数，回调函数可以通过SocketAsyncEventAdapter进行适配，
-            当异步接收完成时，在此回调函数中会返回该上下文对象，可以根据该上下文对象的transfered方法判断实际接收到的数据的大小。\n
-    */
-    bool ReceiveFromAsync(SocketAsyncContext & args);
-
-    /*! 同步（阻塞）发送数据
-    @param[in] data           发送数据的缓冲区。
-    @param[in] size_to_recv   期望发送的数据的大小。
-    @param[in] endpoint       数据发送的地址。
-    @param[out] transfered    当前发送的数据的大小。
-    @return 发送成功后返回true；否则返回false。
-    @remark 做为UDP使用，用来发送数据。\n
-            如果接收方断开连接或者关闭，transfered等于0。\n
-    */
-    bool SendTo(const void * data, uint32_t size_to_send, 
-               const IPEndPoint & endpoint, uint32_t & transfered);
-
-    /*! 同步（阻塞）发送数据
-    @param[in] data           发送数据的缓冲区。
-    @param[in] size_to_recv   期望发送的数据的大小。
-    @param[in] endpoint       数据发送的地址。
-    @param[in] timeout        发送的超时时间。
-    @param[out] transfered    当前发送的数据的大小。
-    @return 发送成功后返回true；否则返回false。
-    @remark 做为UDP使用，用来在指定的时间内发送数据。\n
-            如果接收方断开连接或者关闭，transfered等于0。\n
-    */
-    bool SendTo(const void * data, uint32_t size_to_send, 
-                const IPEndPoint & endpoint, uint32_t timeout,
-                uint32_t & transfered);
-
-    /*! 异步（非阻塞）发送数据
-    @param[in] args 异步操作的上下文对象。
-    @return 发起异步发送成功后返回true；否则返回false。
-    @remark 做为UDP使用，用来发送数据。\n
-            在此之前，需要将当前套接字与一个Proactor进行关联。\n
-            上下文对象需要设置用于发送到的服务端的IPEndPoint。
-            同时，上下文对象还需要设置一个用于发送数据的缓冲区，并指定要发送数据的大小。
-            另外，上下文对象还需要设置一个异步接受完成的回调函数，回调函数可以通过SocketAsyncEventAdapter进行适配，
-            当异步发送完成时，在此回调函数中会返回该上下文对象，可以根据该上下文对象的count方法和transfered方法判断数据是否全部发送完毕。\n
-    */
-    bool SendToAsync(SocketAsyncContext & args);
-
-    /*! 判断套接字是否可读
-    @return 可读返回true；否则返回false。
-    @remark 如果套接字处于Listen状态，当返回值为true时，此时使用Accept将保证是非阻塞的；\n
-            其他情况下返回true时，此时使用Receive/ReceiveAsync，ReceiveFrom/ReceiveFromAsync将保证是非阻塞的。\n
-    */
-    bool CanRead();
-
-    /*! 判断套接字是否可写
-    @return 可写返回true；否则返回false。
-    @remark 如果套接字处于异步（非阻塞）连接状态，当返回值为true时，意味着连接成功；\n
-            其他情况下返回true时，此时使用Send/SendAsync，SendTo/SendToAsync能保证返回true。\n
-    */
-    bool CanWrite();
-
-    /*! 判断套接字是否有效
-    @return 有效返回true；否则返回false。
-    @remark 如果返回false，则使用其他方法也将返回false。\n
-    */
-    bool IsValid();
-
-    /*! 取消套接字的操作
-    @return 取消成功返回true；否则返回false。
-    */
-    bool Cancel();
-
-    /*! 关联到前摄器
-    @param[in] io 前摄器对象。
-    @return 关联成功返回true；否则返回false。
-    @remark 将套接字绑定到完成端口上，用以进行异步操作。\n
-            当套接字与前摄器成功关联后，在主循环中调用前摄器的Run方法即可进行异步事件的处理。\n
-    */
-    bool Associate(Proactor & io);
-
-private:
-    void * GetPlatformHandle();
-
-    void OnCompleted(AsyncContext & args,
-                     uint32_t error, 
-                     uint32_t transfered);
-
-    bool WaitSocketAsyncEvent(SocketAsyncContext & args);
-
-private:
-    Proactor * io_handler_;
-    SOCKET s_;
-};
-
-}
-
-#endif NCORE_SYS_SOCKET_H_
\ No newline at end of file
+﻿#ifndef NCORE_SYS_SOCKET_H_
+#define NCORE_SYS_SOCKET_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include "io_portal.h"
+#include "ip_endpoint.h"
+#include "network_define.h"
+
+/*!
+@file socket.h
+*/
+namespace ncore
+{
+
+
+class Proactor;
+class SocketAsyncContext;
+class SocketBatchAsyncContext;
+class SocketFileAsyncContext;
+class FileStream;
+class SocketBufferPool;
+struct SocketDatagram;
+struct SocketBuffer;
+
+/*! 套接字类\n
+可以创建两种方式的套接字：\n
+一种是TCP，即面向连接的可靠的传输协议；\n
+另一种是UDP，即无连接的，不可靠的数据报传输协议。\n
+另外还可以创建本机进程间通信的AF_UNIX套接字，地址使用UnixEndPoint。\n
+通信模式分为“同步（阻塞）”模式和“异步（非阻塞）”模式。\n
+*/
+class Socket : public NonCopyableObject,
+               public IOPortal
+{
+#if defined NCORE_WINDOWS
+    typedef SOCKET HandleType;
+#elif defined NCORE_LINUX
+    typedef int HandleType;
+#endif
+public:
+    Socket();
+    ~Socket();
+
+    Socket(Socket && obj);
+    Socket & operator = (Socket && obj);
+
+    /*! 初始化，创建套接字
+    @param[in] af         地址族描述。
+    @param[in] type       套接字的类型描述。
+    @param[in] protocol   协议类型。
+    @return 初始化成功后返回true；否则返回false。
+    @remark 如果af为kInterNetworkV6，会创建双模式的套接字，该套接字能同时使用IPv4和IPv6。\n
+            af为kUnix时创建本机进程间通信的套接字，type为kStream或kSeqPacket，protocol为kUnspecificProtocol，
+            地址使用UnixEndPoint。\n
+    */
+    bool init(AddressFamily af, 
+              SocketType type,
+              ProtocolType protocol);
+
+    /*! 反初始化，销毁套接字
+    @remark 等同于Close方法。
+    */
+    void fini();
+
+    /*! 销毁套接字，释放资源。
+    @return 销毁成功后返回true；否则返回false。
+    @remark 套接字销毁后将不再可用，除非重新init。\n
+            如果该套接字已经建立了连接，则在Close之前，应该使用Shutdown，以确保数据完全接收和发送。\n
+    */
+    bool Close();
+
+    /*! 绑定
+    @param[in] endpoint 绑定到指定的IP地址和Port。
+    @return 绑定成功后返回true；否则返回false。
+    @remark 做为服务端，都应该使用此方法绑定到IPEndPoint上，然后才能进行监听、接受连接和数据的收发。\n
+    */
+    bool Bind(const IPEndPoint & endpoint);
+
+    /*! 取得绑定的本地地址
+    @param[out] endpoint 套接字绑定的IP地址和Port。
+    @return 成功后返回true；否则返回false，不是IPv4或者IPv6的套接字时也返回false。
+    @remark 绑定到端口0时由系统分配端口，使用此方法取得分配到的端口。\n
+    */
+    bool LocalEndPoint(IPEndPoint & endpoint) const;
+
+    /*! 监听
+    @param[in] backlog 最大等待数量，默认为25。
+    @return 监听成功后返回true；否则返回false。
+    @remark 做为TCP服务端，应该使用此方法来进入监听模式，然后才能接受客户端的连接。\n
+            在此之前，需要先使用Bind方法。\n
+    */
+    bool Listen(int backlog = 25);
+
+    /*! 关闭连接
+    @param[in] how 关闭连接的方式。
+    @return 关闭成功后返回true；否则返回false。
+    @remark 做为TCP使用，在销毁之前应该使用此方法，以确保数据能都正确接收和发送。\n
+            当使用此方法后，意味着即将关闭套接字，接着应该使用Close方法。\n
+    */
+    bool Shutdown(SocketShutdown how);
+
+    /*! 同步（阻塞）接受连接
+    @return 接受到连接后返回一个新的Socket。
+    @remark 做为TCP服务端，使用此方法来接受客户端的连接，接受成功后，可以用返回的Socket与客户端进行通信。\n
+            在此之前，需要先使用Listen方法。\n
+    */
+    Socket Accept();
+
+    /*! 同步（阻塞）接受连接
+    @param[in] timeout 接受的超时时间。
+    @return 在timeout时间内返回接受到的Socket，需要使用IsValid判断此Socket是否有效。
+    */
+    Socket Accept(uint32_t timeout);
+
+    /*! 异步（非阻塞）接受连接
+    @param[in] args 异步操作的上下文对象。
+    @return 发起异步接受成功后返回true；否则，返回false。
+    @remark 做为TCP服务端，使用此方法来发起异步接受客户端的连接。\n
+            在此之前，需要将当前套接字与一个Proactor进行关联。\n
+            上下文对象需要设置用于接受客户端连接的Socket，该Socket需要与Proactor进行关联，
+            当连接成功后，服务端可以使用该Socket与客户端进行通信。
+            同时，上下文对象还需要设置一个用于数据收发的缓冲区，指定缓冲区的最小大小为kMinAcceptBufferSize，
+            如果大于kMinAcceptBufferSize，意味着接受成功的同时会接收到大于kMinAcceptBufferSize的部分的数据。
+            另外，上下文对象还需要设置一个异步接受完成的回调函数，回调函数可以通过SocketAsyncEventAdapter进行适配，
+            当异步接受完成时，在此回调函数中会返回该上下文对象。\n
+    */
+    bool AcceptAsync(SocketAsyncContext & args);
+
+    /*! 同步（阻塞）连接
+    @param[in] endpoint 连接到指定的IP地址和Port。
+    @return 连接成功后返回true；否则返回false。
+    @remark 做为TCP服务端，使用此方法来连接到服务端。\n
+    */
+    bool Connect(const IPEndPoint & endpoint);
+
+    /*! 同步（阻塞）连接
+    @param[in] endpoint 连接到指定的IP地址和Port。
+    @param[in] timeout  连接的超时时间。
+    @return 在timeout时间内进行连接。如果连接成功，返回true；否则返回false。
+    */
+    bool Connect(const IPEndPoint & endpoint, uint32_t timeout);
+
+    /*! 异步（非阻塞）连接
+    @param[in] args 异步操作的上下文对象。
+    @return 发起异步连接成功后返回true；否则，返回false。
+    @remark 做为TCP客户端，使用此方法来发起异步连接到服务端。\n
+            在此之前，需要将当前套接字与一个Proactor进行关联。\n
+            上下文对象需要设置服务端的IPEndPoint。
+            同时，上下文对象还需要设置一个异步连接完成的回调函数，回调函数可以通过SocketAsyncEventAdapter进行适配，
+            当异步连接完成时，在此回调函数中会返回该上下文对象。\n
+    */
+    bool ConnectAsync(SocketAsyncContext & args);
+
+    /*! 同步（阻塞）断开连接
+    @param[in] reuse 断开后是否重用。
+    @remark 做为TCP使用，用来断开套接字的连接。\n
+            如果reuse为false，则该套接字将不再可用；否则该套接字还能继续使用。\n
+    */
+    void Disconnect(bool reuse);
+
+    /*! 异步（非阻塞）断开连接
+    @param[in] args 异步操作的上下文对象。
+    @return 发起异步断开连接成功后返回true；否则，返回false。
+    @remark 做为TCP使用，使用此方法来发起异步断开连接。\n
+            发起异步断开连接的Socket应该是异步接受或者异步连接的Socket。\n
+    */
+    bool DisconnectAsync(SocketAsyncContext & args);
+
+    /*! 同步（阻塞）接收数据
+    @param[in] data           接收数据的缓冲区。
+    @param[in] size_to_recv   期望接收的数据的大小。
+    @param[out] transfered    当前接收的数据的大小。
+    @return 接收成功后返回true；否则返回false。
+    @remark 做为TCP使用，用来接收数据。\n
+            如果发送方断开连接或者关闭，则transfered等于0。\n
+    */
+    bool Receive(void * data, uint32_t size_to_recv, uint32_t & transfered);
+
+    /*! 同步（阻塞）接收数据
+    @param[in] data           接收数据的缓冲区。
+    @param[in] size_to_recv   期望接收的数据的大小。
+    @param[in] timeout        接收的超时时间。
+    @param[out] transfered    当前接收的数据的大小。
+    @return 接收成功后返回true；否则返回false。
+    @remark 做为TCP使用，用来在指定的时间内接收数据。\n
+            如果发送方断开连接或者关闭，则transfered等于0。\n
+            Linux下阻塞的套接字以SO_RCVTIMEO计时，超时不变时只有一次recv；
+            Windows下先以WSAPoll等待可读再recv，不需要事件和重叠结构。\n
+    */
+    bool Receive(void * data, uint32_t size_to_recv, 
+                 uint32_t timeout, uint32_t & transfered);
+
+    /*! 异步（非阻塞）接收数据
+    @param[in] args 异步操作的上下文对象。
+    @return 发起异步接收成功后返回true；否则返回false。
+    @remark 做为TCP使用，用来接收数据。\n
+            服务端使用上下文对象的accept_socket方法可以得到与客户端建立连接的Socket；
+            客户端直接使用进行异步连接的Socket。\n
+            上下文对象需要设置一个用于接收数据的缓冲区，并指定要接收的最大大小。
+            同时，上下文对象还需要设置一个异步接受完成的回调函数，回调函数可以通过SocketAsyncEventAdapter进行适配，
+            当异步接收完成时，在此回调函数中会返回该上下文对象，可以根据该上下文对象的transfered方法判断实际接收到的数据的大小。\n
+            上下文对象以SetBuffers设置多段缓冲区时，数据依次分散接收到各段中。\n
+    */
+    bool ReceiveAsync(SocketAsyncContext & args);
+
+    /*! 异步（非阻塞）接收数据，缓冲区从缓冲池中取得
+    @param[in] args 异步操作的上下文对象，不需要设置缓冲区。
+    @param[in] pool 缓冲池，多个套接字可以共用。
+    @return 发起异步接收成功后返回true；否则返回false。
+    @remark 做为TCP使用。请求在数据到达时才取得缓冲区，等待中不占用缓冲区，适合大量空闲的连接。\n
+            完成时buffer()为装有数据的缓冲区，count()为缓冲区的大小，transfered()为接收到的字节数；
+            回调用完数据后调用pool.Release(args.buffer())归还，可以在回调之外归还。\n
+            出错或者对端关闭时buffer()为0，不需要归还；池中没有空闲的缓冲区时以ENOBUFS（Windows上为WSAENOBUFS）完成。\n
+            Linux下需要与Proactor关联，缓冲池注册到该前摄器时由io_uring选取缓冲区（见Proactor::RegisterBufferPool），
+            否则等待可读后从池中取出；Windows下以零字节的WSARecv等待数据到达，再从池中取出缓冲区接收。\n
+    */
+    bool ReceivePooledAsync(SocketAsyncContext & args, SocketBufferPool & pool);
+
+    /*! 同步（阻塞）发送数据
+    @param[in] data           发送数据的缓冲区。
+    @param[in] size_to_recv   期望发送的数据的大小。
+    @param[out] transfered    当前发送的数据的大小。
+    @return 发送成功后返回true；否则返回false。
+    @remark 做为TCP使用，用来发送数据。\n
+            如果接收方断开连接或者关闭，transfered等于0。\n
+    */
+    bool Send(const void * data, uint32_t size_to_send, uint32_t & transfered);
+
+    /*! 同步（阻塞）发送数据
+    @param[in] data           发送数据的缓冲区。
+    @param[in] size_to_recv   期望发送的数据的大小。
+    @param[in] timeout        发送的超时时间。
+    @param[out] transfered    当前发送的数据的大小。
+    @return 发送成功后返回true；否则返回false。
+    @remark 做为TCP使用，用来在指定的时间内发送数据。\n
+            如果接收方断开连接或者关闭，transfered等于0。\n
+    */
+    bool Send(const void * data, uint32_t size_to_send, 
+              uint32_t timeout, uint32_t & transfered);
+
+    /*! 异步（非阻塞）发送数据
+    @param[in] args 异步操作的上下文对象。
+    @return 发起异步发送成功后返回true；否则返回false。
+    @remark 做为TCP使用，用来发送数据。\n
+            服务端使用上下文对象的accept_socket方法可以得到与客户端建立连接的Socket；
+            客户端直接使用进行异步连接的Socket。\n
+            上下文对象需要设置一个用于发送数据的缓冲区，并指定要发送数据的大小。
+            同时，上下文对象还需要设置一个异步接受完成的回调函数，回调函数可以通过SocketAsyncEventAdapter进行适配，
+            当异步发送完成时，在此回调函数中会返回该上下文对象，可以根据该上下文对象的count方法和transfered方法判断数据是否全部发送完毕。\n
+            上下文对象以SetBuffers设置多段缓冲区时，各段一次聚集发送；没有发送完时用ConsumeBuffers跳过已发送的部分后再次发送。\n
+    */
+    bool SendAsync(SocketAsyncContext & args);
+
+    /*! 同步（阻塞）发送文件
+    @param[in] file           文件流。
+    @param[in] offset         文件中的起始位置。
+    @param[in] length         发送的字节数，为0时发送到文件尾。
+    @param[out] transfered    发送的数据的大小，超过0xFFFFFFFF时为0xFFFFFFFF。
+    @return 发送成功后返回true；否则返回false。
+    @remark 做为TCP使用，数据由内核直接从文件发送到套接字，不经过用户态的缓冲区。\n
+            Linux下使用sendfile，Windows下使用TransmitFile；不支持时改为读取文件后发送。\n
+    */
+    bool SendFile(FileStream & file, uint64_t offset, uint32_t length,
+                  uint32_t & transfered);
+
+    /*! 同步（阻塞）发送文件
+    @param[in] file           文件流。
+    @param[in] offset         文件中的起始位置。
+    @param[in] length         发送的字节数，为0时发送到文件尾。
+    @param[in] header         在文件之前发送的数据，可以为空。
+    @param[in] trailer        在文件之后发送的数据，可以为空。
+    @param[out] transfered    发送的数据的大小，包括报头和报尾。
+    @return 发送成功后返回true；否则返回false。
+    @remark length为0时文件可以超过4GB，发送的字节数在内部按64位累计，
+            超过0xFFFFFFFF时transfered为0xFFFFFFFF，不会回绕成较小的值。\n
+    */
+    bool SendFile(FileStream & file, uint64_t offset, uint32_t length,
+                  const SocketBuffer & header, const SocketBuffer & trailer,
+                  uint32_t & transfered);
+
+    /*! 异步（非阻塞）发送文件
+    @param[in] args 发送文件的上下文对象。
+    @return 发起异步发送成功后返回true；否则返回false。
+    @remark 上下文对象需要用SetFile设置文件和范围，可以用SetHeader和SetTrailer设置报头和报尾。\n
+            与SendAsync不同，请求在全部发送或者出错时才完成，transfered为合计发送的字节数，
+            超过0xFFFFFFFF时为0xFFFFFFFF。\n
+            Linux下需要与Proactor关联；sendfile不支持该文件时改为读取后发送。
+            Windows下TransmitFile不可用时返回false，可以改用同步的SendFile。\n
+    */
+    bool SendFileAsync(SocketFileAsyncContext & args);
+
+    /*! 同步（阻塞）接收数据
+    @param[in] data           接收数据的缓冲区。
+    @param[in] size_to_recv   期望接收的数据的大小。
+    @param[out] transfered    当前接收的数据的大小。
+    @param[out] endpoint      数据来源的地址。
+    @return 接收成功后返回true；否则返回false。
+    @remark 做为UDP使用，用来接收数据。\n
+            如果发送方断开连接或者关闭，transfered等于0。\n
+    */
+    bool ReceiveFrom(void * data, uint32_t size_to_recv, 
+                     uint32_t & transfered, IPEndPoint & endpoint);
+
+    /*! 同步（阻塞）接收数据
+    @param[in] data           接收数据的缓冲区。
+    @param[in] size_to_recv   期望接收的数据的大小。
+    @param[in] timeout        接收的超时时间。
+    @param[out] transfered    当前接收的数据的大小。
+    @param[out] endpoint      数据来源的地址。
+    @return 接收成功后返回true；否则返回false。
+    @remark 做为UDP使用，用来在指定的时间内接收数据。\n
+            如果发送方断开连接或者关闭，transfered等于0。\n
+    */
+    bool ReceiveFrom(void * data, uint32_t size_to_recv, uint32_t timeout,
+                     uint32_t & transfered, IPEndPoint & endpoint);
+
+    /*! 异步（非阻塞）接收数据
+    @param[in] args 异步操作的上下文对象。
+    @return 发起异步接收成功后返回true；否则返回false。
+    @remark 做为UDP使用，用来接收数据。\n
+            在此之前，需要将当前套接字与一个Proactor进行关联。\n
+            上下文对象需要设置用于接收到数据的客户端的IPEndPoint。
+            同时，上下文对象还需要设置一个用于接收数据的缓冲区，并指定要接收的最大大小。
+            另外，上下文对象还需要设置一个异步接受完成的回调函数，回调函数可以通过SocketAsyncEventAdapter进行适配，
+            当异步接收完成时，在此回调函数中会返回该上下文对象，可以根据该上下文对象的transfered方法判断实际接收到的数据的大小。\n
+    */
+    bool ReceiveFromAsync(SocketAsyncContext & args);
+
+    /*! 同步（阻塞）发送数据
+    @param[in] data           发送数据的缓冲区。
+    @param[in] size_to_recv   期望发送的数据的大小。
+    @param[in] endpoint       数据发送的地址。
+    @param[out] transfered    当前发送的数据的大小。
+    @return 发送成功后返回true；否则返回false。
+    @remark 做为UDP使用，用来发送数据。\n
+            如果接收方断开连接或者关闭，transfered等于0。\n
+    */
+    bool SendTo(const void * data, uint32_t size_to_send, 
+               const IPEndPoint & endpoint, uint32_t & transfered);
+
+    /*! 同步（阻塞）发送数据
+    @param[in] data           发送数据的缓冲区。
+    @param[in] size_to_recv   期望发送的数据的大小。
+    @param[in] endpoint       数据发送的地址。
+    @param[in] timeout        发送的超时时间。
+    @param[out] transfered    当前发送的数据的大小。
+    @return 发送成功后返回true；否则返回false。
+    @remark 做为UDP使用，用来在指定的时间内发送数据。\n
+            如果接收方断开连接或者关闭，transfered等于0。\n
+    */
+    bool SendTo(const void * data, uint32_t size_to_send, 
+                const IPEndPoint & endpoint, uint32_t timeout,
+                uint32_t & transfered);
+
+    /*! 异步（非阻塞）发送数据
+    @param[in] args 异步操作的上下文对象。
+    @return 发起异步发送成功后返回true；否则返回false。
+    @remark 做为UDP使用，用来发送数据。\n
+            在此之前，需要将当前套接字与一个Proactor进行关联。\n
+            上下文对象需要设置用于发送到的服务端的IPEndPoint。
+            同时，上下文对象还需要设置一个用于发送数据的缓冲区，并指定要发送数据的大小。
+            另外，上下文对象还需要设置一个异步接受完成的回调函数，回调函数可以通过SocketAsyncEventAdapter进行适配，
+            当异步发送完成时，在此回调函数中会返回该上下文对象，可以根据该上下文对象的count方法和transfered方法判断数据是否全部发送完毕。\n
+    */
+    bool SendToAsync(SocketAsyncContext & args);
+
+    /*! 同步（阻塞）批量接收数据报
+    @param[in] datagrams      数据报数组，每个数据报需要设置缓冲区data和大小size。
+    @param[in] count          数组的大小。
+    @param[in] timeout        等待第一个数据报的超时时间。
+    @param[out] received      接收到的数据报个数。
+    @return 至少接收到一个数据报时返回true；否则返回false。
+    @remark 做为UDP使用，第一个数据报到达后只取已经到达的数据报，不再等待。\n
+            每个数据报的transfered和endpoint为其长度和来源地址。\n
+            Linux下使用recvmmsg，一次系统调用接收多个数据报；Windows下逐个接收。\n
+    */
+    bool ReceiveFromBatch(SocketDatagram * datagrams, size_t count,
+                          uint32_t timeout, size_t & received);
+
+    /*! 异步（非阻塞）批量接收数据报
+    @param[in] args 批量收发的上下文对象。
+    @return 发起异步接收成功后返回true；否则返回false。
+    @remark 在此之前，需要将当前套接字与一个Proactor进行关联。\n
+            完成时上下文的transfered为接收到的数据报个数，与ReceiveFromBatch一样只等待第一个数据报。\n
+    */
+    bool ReceiveFromBatchAsync(SocketBatchAsyncContext & args);
+
+    /*! 同步（阻塞）批量发送数据报
+    @param[in] datagrams      数据报数组，每个数据报需要设置数据data、长度size和目标地址endpoint。
+    @param[in] count          数组的大小。
+    @param[out] sent          发送的数据报个数。
+    @return 全部发送成功后返回true；否则返回false。
+    @remark 做为UDP使用。已连接的套接字可以不设置endpoint。\n
+            Linux下使用sendmmsg；目标相同、长度相同（最后一个可以较短）的数据报在内核支持时以UDP GSO合并发送。\n
+    */
+    bool SendToBatch(SocketDatagram * datagrams, size_t count, size_t & sent);
+
+    /*! 异步（非阻塞）批量发送数据报
+    @param[in] args 批量收发的上下文对象。
+    @return 发起异步发送成功后返回true；否则返回false。
+    @remark 在此之前，需要将当前套接字与一个Proactor进行关联。\n
+            完成时上下文的transfered为发送的数据报个数。\n
+    */
+    bool SendToBatchAsync(SocketBatchAsyncContext & args);
+
+#if defined NCORE_LINUX
+    /*! 创建一对互相连接的AF_UNIX套接字
+    @param[in] type     kStream或kSeqPacket。
+    @param[out] first   一端，必须还没有初始化。
+    @param[out] second  另一端，必须还没有初始化。
+    @return 创建成功后返回true；否则返回false。
+    @remark 在fork之前创建，父子进程各保留一端，用SendSocket传递套接字。\n
+    */
+    static bool CreatePair(SocketType type, Socket & first, Socket & second);
+
+    /*! 同步（阻塞）传递套接字
+    @param[in] socket         要传递的套接字，对端收到的是它的副本，发送后本进程可以关闭。
+    @param[in] data           随同发送的数据，不能为空。
+    @param[in] size_to_send   数据的大小，至少为1。
+    @param[out] transfered    发送的数据的大小。
+    @return 发送成功后返回true；否则返回false。
+    @remark 只用于kUnix的套接字，以SCM_RIGHTS把描述符交给对端进程，
+            例如前端进程把接受到的连接交给工作进程处理。\n
+            套接字附在数据的第一个字节上，kStream的套接字没有全部发送时，剩余的数据用Send发送。\n
+    */
+    bool SendSocket(const Socket & socket, const void * data,
+                    uint32_t size_to_send, uint32_t & transfered);
+
+    /*! 同步（阻塞）接收传递的套接字
+    @param[out] socket        接收到的套接字，必须还没有初始化。
+    @param[in] data           接收数据的缓冲区。
+    @param[in] size_to_recv   缓冲区的大小，至少为1。
+    @param[out] transfered    接收到的数据的大小。
+    @return 接收成功后返回true；否则返回false。
+    @remark 数据中没有附带套接字时socket仍然无效；对端关闭时transfered等于0。\n
+            接收到的套接字设置了FD_CLOEXEC，可以与Proactor关联后使用异步方法。\n
+    */
+    bool ReceiveSocket(Socket & socket, void * data,
+                       uint32_t size_to_recv, uint32_t & transfered);
+#endif
+
+    /*! 设置内核的发送节奏
+    @param[in] rate 每秒发送的字节数上限，为0时取消限制。
+    @return 设置成功后返回true；否则返回false。
+    @remark Linux下为SO_MAX_PACING_RATE，由TCP自身的节奏控制或者fq队列规则按速率发出报文，
+            避免突发的大量报文挤满网卡队列；内核不支持时返回false。\n
+            Windows没有对应的选项，总是返回false，错误码为WSAEOPNOTSUPP，
+            需要限速时使用SocketSendQueue::set_pacing。\n
+    */
+    bool SetPacingRate(uint64_t rate);
+
+    /*! 判断套接字是否可读
+    @return 可读返回true；否则返回false。
+    @remark 如果套接字处于Listen状态，当返回值为true时，此时使用Accept将保证是非阻塞的；\n
+            其他情况下返回true时，此时使用Receive/ReceiveAsync，ReceiveFrom/ReceiveFromAsync将保证是非阻塞的。\n
+    */
+    bool CanRead();
+
+    /*! 判断套接字是否可写
+    @return 可写返回true；否则返回false。
+    @remark 如果套接字处于异步（非阻塞）连接状态，当返回值为true时，意味着连接成功；\n
+            其他情况下返回true时，此时使用Send/SendAsync，SendTo/SendToAsync能保证返回true。\n
+    */
+    bool CanWrite();
+
+    /*! 判断套接字是否有效
+    @return 有效返回true；否则返回false。
+    @remark 如果返回false，则使用其他方法也将返回false。\n
+    */
+    bool IsValid();
+
+    /*! 取消套接字的操作
+    @return 取消成功返回true；否则返回false。
+    */
+    bool Cancel();
+
+    /*! 关联到前摄器
+    @param[in] io 前摄器对象。
+    @return 关联成功返回true；否则返回false。
+    @remark 将套接字绑定到完成端口上，用以进行异步操作。\n
+            当套接字与前摄器成功关联后，在主循环中调用前摄器的Run方法即可进行异步事件的处理。\n
+    */
+    bool Associate(Proactor & io);
+
+private:
+    void * GetPlatformHandle();
+
+    void OnCompleted(AsyncContext & args,
+                     uint32_t error, 
+                     uint32_t transfered);
+
+    uint32_t GetStatsOp(AsyncContext & args);
+
+    //逐块读取文件后发送，用于sendfile/TransmitFile不可用时，length为0时发送到文件尾
+    bool SendFileByCopy(FileStream & file, uint64_t offset, uint64_t length,
+                        const SocketBuffer & header, const SocketBuffer & trailer,
+                        uint64_t & transfered);
+
+    //发送文件时按64位累计，报告给调用者时截断到32位能表示的最大值
+    static uint32_t ClampTransfered(uint64_t transfered);
+
+    //发送全部数据
+    bool SendAll(const void * data, size_t size, uint32_t & transfered);
+
+#if defined NCORE_LINUX
+    //以splice在套接字和管道之间传递，供SocketRelay使用
+    bool SpliceRecvAsync(SocketAsyncContext & args, int pipe, uint32_t size);
+    bool SpliceSendAsync(SocketAsyncContext & args, int pipe, uint32_t size);
+#endif
+
+#if defined NCORE_WINDOWS
+    bool WaitSocketAsyncEvent(SocketAsyncContext & args);
+#endif
+
+private:
+    Proactor * io_handler_;
+    HandleType s_;
+#if defined NCORE_LINUX
+    //同步操作缓存的套接字状态，省去每次调用时的查询和设置
+    struct SyncState
+    {
+        int fd;                 //缓存所属的套接字，与s_不同时重新查询
+        bool nonblocking;
+        uint32_t recv_timeout;  //已设置的SO_RCVTIMEO，毫秒，-1为不超时
+        uint32_t send_timeout;  //已设置的SO_SNDTIMEO
+    };
+    SyncState sync_;
+#endif
+
+    friend class SocketRoutines;
+    friend class SocketRelay;
+    friend class SocketListener;
+    friend class Poller;
+};
+
+}
+
+#endif //NCORE_SYS_SOCKET_H_
\ No newline at end of file
@@ -1,116 +1,283 @@
-﻿#include "socket_async_event_args.h"
-
-
-namespace ncore
-{
-
-
-SocketAsyncContext::SocketAsyncContext()
-    : AsyncContext(), error_(0), transfered_(0),
-      buffer_(0), count_(0), socket_flags_(0),
-      accept_socket_(0), connect_socket_(0), 
-      last_op_(SocketAsyncOp::kAsyncUnknow),
-      completion_delegate_(), reuse_(false)
-{
-}
-
-SocketAsyncContext::SocketAsyncContext(NamedEvent & e)
-    : AsyncContext(e), error_(0), transfered_(0),
-      buffer_(0), count_(0), socket_flags_(0),
-      accept_socket_(0), connect_socket_(0), 
-      last_op_(SocketAsyncOp::kAsyncUnknow),
-      completion_delegate_(), reuse_(false)
-{
-}
-
-void SocketAsyncContext::SetBuffer(const void * buffer, size_t size)
-{
-    buffer_ = const_cast<void *>(buffer);
-    count_ = size;
-}
-
-void SocketAsyncContext::SetBuffer(void * buffer, size_t size)
-{
-    buffer_ = buffer;
-    count_ = size;
-}
-
-void * SocketAsyncContext::buffer() const
-{
-    return buffer_;
-}
-
-size_t SocketAsyncContext::count() const
-{
-    return count_;
-}
-
-uint32_t SocketAsyncContext::error() const
-{
-    return error_;
-}
-
-uint32_t SocketAsyncContext::transfered() const
-{
-    return transfered_;
-}
-
-uint32_t SocketAsyncContext::socket_flags() const
-{
-    return socket_flags_;
-}
-
-SocketAsyncOp::Value SocketAsyncContext::last_op() const
-{
-    return last_op_;
-}
-
-IPEndPoint SocketAsyncContext::remote_endpoint() const
-{
-    return remote_endpoint_;
-}
-
-Socket * SocketAsyncContext::accept_socket() const
-{
-    return accept_socket_;
-}
-
-Socket * SocketAsyncContext::connect_socket() const
-{
-    return connect_socket_;
-}
-
-bool SocketAsyncContext::reuse() const
-{
-    return reuse_;
-}
-
-void SocketAsyncContext::set_accept_socket(Socket & socket)
-{
-    accept_socket_ = &socket;
-}
-
-void SocketAsyncContext::set_remote_endpoint(const IPEndPoint & ep)
-{
-    remote_endpoint_ = ep;
-}
-
-void SocketAsyncContext::set_reuse(bool value)
-{
-    reuse_ = value;
-}
-
-void SocketAsyncContext::set_completion_delegate(
-    SocketAsyncResultHandler * handler
-) {
-    completion_delegate_ = handler;
-}
-
-void SocketAsyncContext::OnCompleted(uint32_t error, uint32_t transfered)
-{
-    error_ = error;
-    transfered_ = transfered;
-    completion_delegate_(*this);
-}
-
+﻿#include "socket_async_event_args.h"
+
+
+namespace ncore
+{
+
+
+SocketAsyncContext::SocketAsyncContext()
+    : AsyncContext(), error_(0), transfered_(0),
+      buffer_(0), count_(0), buffer_count_(0), socket_flags_(0),
+      accept_socket_(0), connect_socket_(0), 
+      last_op_(SocketAsyncOp::kAsyncUnknow), buffer_pool_(0),
+      completion_delegate_(), reuse_(false)
+{
+}
+
+#if defined NCORE_WINDOWS
+SocketAsyncContext::SocketAsyncContext(NamedEvent & e)
+    : AsyncContext(e), error_(0), transfered_(0),
+      buffer_(0), count_(0), buffer_count_(0), socket_flags_(0),
+      accept_socket_(0), connect_socket_(0), 
+      last_op_(SocketAsyncOp::kAsyncUnknow), buffer_pool_(0),
+      completion_delegate_(), reuse_(false)
+{
+}
+#endif
+
+void SocketAsyncContext::SetBuffer(const void * buffer, size_t size)
+{
+    buffer_ = const_cast<void *>(buffer);
+    count_ = size;
+    buffer_count_ = 0;
+}
+
+void SocketAsyncContext::SetBuffer(void * buffer, size_t size)
+{
+    buffer_ = buffer;
+    count_ = size;
+    buffer_count_ = 0;
+}
+
+bool SocketAsyncContext::SetBuffers(const SocketBuffer * buffers, size_t count)
+{
+    if(buffers == 0 || count == 0 || count > kMaxBuffers)
+        return false;
+
+    size_t total = 0;
+    for(size_t index = 0; index < count; ++index)
+    {
+        buffers_[index] = buffers[index];
+        total += buffers[index].size;
+    }
+
+    buffer_ = 0;
+    count_ = total;
+    buffer_count_ = count;
+    return true;
+}
+
+bool SocketAsyncContext::ConsumeBuffers(size_t size)
+{
+    if(size > count_)
+        size = count_;
+    count_ -= size;
+
+    if(buffer_count_ == 0)
+    {
+        buffer_ = static_cast<char *>(buffer_) + size;
+        return count_ != 0;
+    }
+
+    //丢弃已经传输完的段，保留至少一段，调整剩余的第一段
+    size_t first = 0;
+    while(first + 1 < buffer_count_ && size >= buffers_[first].size)
+    {
+        size -= buffers_[first].size;
+        ++first;
+    }
+    buffers_[first].data = static_cast<char *>(buffers_[first].data) + size;
+    buffers_[first].size -= size;
+
+    if(first)
+    {
+        buffer_count_ -= first;
+        memmove(buffers_, buffers_ + first, buffer_count_ * sizeof(SocketBuffer));
+    }
+    return count_ != 0;
+}
+
+const SocketBuffer * SocketAsyncContext::buffers() const
+{
+    return buffer_count_ ? buffers_ : 0;
+}
+
+size_t SocketAsyncContext::buffer_count() const
+{
+    return buffer_count_;
+}
+
+void * SocketAsyncContext::buffer() const
+{
+    return buffer_;
+}
+
+size_t SocketAsyncContext::count() const
+{
+    return count_;
+}
+
+uint32_t SocketAsyncContext::error() const
+{
+    return error_;
+}
+
+uint32_t SocketAsyncContext::transfered() const
+{
+    return transfered_;
+}
+
+uint32_t SocketAsyncContext::socket_flags() const
+{
+    return socket_flags_;
+}
+
+SocketAsyncOp::Value SocketAsyncContext::last_op() const
+{
+    return last_op_;
+}
+
+IPEndPoint SocketAsyncContext::remote_endpoint() const
+{
+    return remote_endpoint_;
+}
+
+Socket * SocketAsyncContext::accept_socket() const
+{
+    return accept_socket_;
+}
+
+Socket * SocketAsyncContext::connect_socket() const
+{
+    return connect_socket_;
+}
+
+bool SocketAsyncContext::reuse() const
+{
+    return reuse_;
+}
+
+SocketBufferPool * SocketAsyncContext::buffer_pool() const
+{
+    return buffer_pool_;
+}
+
+void SocketAsyncContext::set_accept_socket(Socket & socket)
+{
+    accept_socket_ = &socket;
+}
+
+void SocketAsyncContext::set_remote_endpoint(const IPEndPoint & ep)
+{
+    remote_endpoint_ = ep;
+}
+
+void SocketAsyncContext::set_reuse(bool value)
+{
+    reuse_ = value;
+}
+
+void SocketAsyncContext::set_socket_flags(uint32_t flags)
+{
+    socket_flags_ = flags;
+}
+
+void SocketAsyncContext::set_completion_delegate(
+    SocketAsyncResultHandler * handler
+) {
+    completion_delegate_ = handler;
+}
+
+void SocketAsyncContext::OnCompleted(uint32_t error, uint32_t transfered)
+{
+    error_ = error;
+    transfered_ = transfered;
+    completion_delegate_(*this);
+}
+
+
+SocketBatchAsyncContext::SocketBatchAsyncContext()
+    : SocketAsyncContext(), datagrams_(0), datagram_count_(0)
+{
+#if defined NCORE_LINUX
+    segmented_ = false;
+#endif
+}
+
+bool SocketBatchAsyncContext::SetDatagrams(SocketDatagram * datagrams,
+                                           size_t count)
+{
+    if(datagrams == 0 || count == 0 || count > kMaxDatagrams)
+        return false;
+
+    datagrams_ = datagrams;
+    datagram_count_ = count;
+    return true;
+}
+
+SocketDatagram * SocketBatchAsyncContext::datagrams() const
+{
+    return datagrams_;
+}
+
+size_t SocketBatchAsyncContext::datagram_count() const
+{
+    return datagram_count_;
+}
+
+
+SocketFileAsyncContext::SocketFileAsyncContext()
+    : SocketAsyncContext(), file_(0), file_offset_(0), file_length_(0)
+{
+    header_.data = 0;
+    header_.size = 0;
+    trailer_ = header_;
+}
+
+#if defined NCORE_WINDOWS
+SocketFileAsyncContext::SocketFileAsyncContext(NamedEvent & e)
+    : SocketAsyncContext(e), file_(0), file_offset_(0), file_length_(0)
+{
+    header_.data = 0;
+    header_.size = 0;
+    trailer_ = header_;
+}
+#endif
+
+void SocketFileAsyncContext::SetFile(FileStream & file,
+                                     uint64_t offset,
+                                     uint32_t length)
+{
+    file_ = &file;
+    file_offset_ = offset;
+    file_length_ = length;
+}
+
+void SocketFileAsyncContext::SetHeader(const void * data, size_t size)
+{
+    header_.data = const_cast<void *>(data);
+    header_.size = data ? size : 0;
+}
+
+void SocketFileAsyncContext::SetTrailer(const void * data, size_t size)
+{
+    trailer_.data = const_cast<void *>(data);
+    trailer_.size = data ? size : 0;
+}
+
+FileStream * SocketFileAsyncContext::file() const
+{
+    return file_;
+}
+
+uint64_t SocketFileAsyncContext::file_offset() const
+{
+    return file_offset_;
+}
+
+uint32_t SocketFileAsyncContext::file_length() const
+{
+    return file_length_;
+}
+
+const SocketBuffer & SocketFileAsyncContext::header() const
+{
+    return header_;
+}
+
+const SocketBuffer & SocketFileAsyncContext::trailer() const
+{
+    return trailer_;
+}
+
 }
\ No newline at end of file
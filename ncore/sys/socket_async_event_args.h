@@ -1,87 +1,229 @@
-﻿#ifndef NCORE_SYS_SOCKET_ASYNC_EVENT_ARGS_H_
-#define NCORE_SYS_SOCKET_ASYNC_EVENT_ARGS_H_
-
-#include <ncore/ncore.h>
-#include <ncore/utils/async_result_delegate.h>
-#include <ncore/utils/async_result_adapter.h>
-#include "async_context.h"
-#include "ip_endpoint.h"
-
-namespace ncore
-{
-
-
-class Socket;
-
-/*Socket异步操作类型*/
-namespace SocketAsyncOp
-{
-enum Value
-{
-    kAsyncUnknow = 0,
-    kAsyncAccept,
-    kAsyncConnect,
-    kAsyncDisconnect,
-    kAsyncSend,
-    kAsyncRecv,
-    kAsyncSendTo,
-    kAsyncRecvFrom,
-};
-}
-
-class SocketAsyncContext;
-
-typedef AsyncResultDelegate<SocketAsyncContext> SocketAsyncResultDelegate;
-typedef AsyncResultHandler<SocketAsyncContext>  SocketAsyncResultHandler;
-
-class SocketAsyncContext : public AsyncContext
-{
-public:
-    SocketAsyncContext();
-    SocketAsyncContext(NamedEvent & e);
-
-    void SetBuffer(const void * buffer, size_t size);
-    void SetBuffer(void * buffer, size_t size);
-
-    void * buffer() const;
-    size_t count() const;
-    uint32_t error() const;
-    uint32_t transfered() const;
-    uint32_t socket_flags() const;
-    SocketAsyncOp::Value last_op() const;
-    Socket * accept_socket() const;
-    Socket * connect_socket() const;
-    IPEndPoint remote_endpoint() const;
-    bool reuse() const;
-
-    void set_accept_socket(Socket & socket);
-    void set_remote_endpoint(const IPEndPoint & ep);
-    void set_reuse(bool value);
-    void set_completion_delegate(SocketAsyncResultHandler * handler);
-private:
-    void OnCompleted(uint32_t error, uint32_t transfered);
-private:
-    void * buffer_;
-    size_t count_;
-    uint32_t error_;
-    uint32_t transfered_;
-    uint32_t socket_flags_;
-    Socket * accept_socket_;
-    Socket * connect_socket_;
-    SocketAsyncOp::Value last_op_;
-    IPEndPoint remote_endpoint_;
-    SocketAsyncResultDelegate completion_delegate_;
-    bool reuse_;
-
-    friend class Socket;
-    friend class SocketRoutines;
-};
-
-template <typename Adaptee>
-using SocketAsyncResultAdapter = 
-AsyncResultAdapter<Adaptee, SocketAsyncContext>;
-
-
-}
-
+﻿#ifndef NCORE_SYS_SOCKET_ASYNC_EVENT_ARGS_H_
+#define NCORE_SYS_SOCKET_ASYNC_EVENT_ARGS_H_
+
+#include <ncore/ncore.h>
+#include <ncore/utils/async_result_delegate.h>
+#include <ncore/utils/async_result_adapter.h>
+#include "async_context.h"
+#include "ip_endpoint.h"
+
+namespace ncore
+{
+
+
+class Socket;
+class FileStream;
+class SocketBufferPool;
+
+/*Socket异步操作类型*/
+namespace SocketAsyncOp
+{
+enum Value
+{
+    kAsyncUnknow = 0,
+    kAsyncAccept,
+    kAsyncConnect,
+    kAsyncDisconnect,
+    kAsyncSend,
+    kAsyncRecv,
+    kAsyncSendTo,
+    kAsyncRecvFrom,
+    kAsyncSendToBatch,
+    kAsyncRecvFromBatch,
+    kAsyncSendFile,
+    kAsyncSpliceRecv,
+    kAsyncSpliceSend,
+    kAsyncRecvPooled,
+};
+}
+
+/*! 分散/聚集I/O中的一段缓冲区\n
+Linux上与iovec的布局相同。\n
+*/
+struct SocketBuffer
+{
+    void * data;
+    size_t size;
+};
+
+//批量收发中的一个数据报
+struct SocketDatagram
+{
+    void * data;            //缓冲区
+    uint32_t size;          //接收时为缓冲区大小，发送时为数据报的长度
+    uint32_t transfered;    //实际收发的字节数
+    IPEndPoint endpoint;    //接收时为来源地址，发送时为目标地址
+};
+
+class SocketAsyncContext;
+
+typedef AsyncResultDelegate<SocketAsyncContext> SocketAsyncResultDelegate;
+typedef AsyncResultHandler<SocketAsyncContext>  SocketAsyncResultHandler;
+
+class SocketAsyncContext : public AsyncContext
+{
+public:
+    //SetBuffers最多支持的段数
+    static const size_t kMaxBuffers = 8;
+
+public:
+    SocketAsyncContext();
+#if defined NCORE_WINDOWS
+    SocketAsyncContext(NamedEvent & e);
+#endif
+
+    void SetBuffer(const void * buffer, size_t size);
+    void SetBuffer(void * buffer, size_t size);
+
+    /*! 设置多段缓冲区，用于分散接收和聚集发送
+    @param[in] buffers  缓冲区数组，数组本身被复制，各段数据在请求完成之前必须保持有效。
+    @param[in] count    段数，不超过kMaxBuffers。
+    @return 段数为0或者超过上限时返回false。
+    @remark 设置后SendAsync、ReceiveAsync、SendToAsync和ReceiveFromAsync一次提交所有段，
+            count()和transfered()均为各段合计的字节数；调用SetBuffer恢复为单块缓冲区。\n
+    */
+    bool SetBuffers(const SocketBuffer * buffers, size_t count);
+
+    /*! 跳过已经传输的字节
+    @param[in] size 已经传输的字节数，通常为transfered()。
+    @return 还有未传输的数据时返回true。
+    @remark 部分完成后调用，再次提交同一个上下文即可传输剩余的部分。\n
+    */
+    bool ConsumeBuffers(size_t size);
+
+    const SocketBuffer * buffers() const;
+    size_t buffer_count() const;
+
+    void * buffer() const;
+    size_t count() const;
+    uint32_t error() const;
+    uint32_t transfered() const;
+    uint32_t socket_flags() const;
+    SocketAsyncOp::Value last_op() const;
+    Socket * accept_socket() const;
+    Socket * connect_socket() const;
+    IPEndPoint remote_endpoint() const;
+    bool reuse() const;
+
+    //Socket::ReceivePooledAsync使用的缓冲池，buffer()用完后归还到这里
+    SocketBufferPool * buffer_pool() const;
+
+    void set_accept_socket(Socket & socket);
+    void set_remote_endpoint(const IPEndPoint & ep);
+    void set_reuse(bool value);
+
+    //发送时作为send/WSASend的flags，例如Linux上的MSG_MORE；接收完成后为返回的标志
+    void set_socket_flags(uint32_t flags);
+    void set_completion_delegate(SocketAsyncResultHandler * handler);
+private:
+    void OnCompleted(uint32_t error, uint32_t transfered);
+private:
+    void * buffer_;
+    size_t count_;
+    SocketBuffer buffers_[kMaxBuffers];
+    size_t buffer_count_;
+    uint32_t error_;
+    uint32_t transfered_;
+    uint32_t socket_flags_;
+    Socket * accept_socket_;
+    Socket * connect_socket_;
+    SocketAsyncOp::Value last_op_;
+    IPEndPoint remote_endpoint_;
+    SocketBufferPool * buffer_pool_;
+    SocketAsyncResultDelegate completion_delegate_;
+    bool reuse_;
+
+    friend class Socket;
+    friend class SocketRoutines;
+};
+
+/*! 批量收发数据报的上下文\n
+用于Socket::ReceiveFromBatchAsync和SendToBatchAsync，完成时transfered()为完成的数据报个数，
+每个数据报的字节数和地址写回SocketDatagram。\n
+完成回调与SocketAsyncContext相同，回调中得到的上下文可以转换为SocketBatchAsyncContext。\n
+*/
+class SocketBatchAsyncContext : public SocketAsyncContext
+{
+public:
+    //一次请求最多的数据报个数
+    static const size_t kMaxDatagrams = 64;
+
+public:
+    SocketBatchAsyncContext();
+
+    /*! 设置数据报数组
+    @param[in] datagrams    数据报数组，在请求完成之前必须保持有效。
+    @param[in] count        个数，不超过kMaxDatagrams。
+    @return 个数为0或者超过上限时返回false。
+    */
+    bool SetDatagrams(SocketDatagram * datagrams, size_t count);
+
+    SocketDatagram * datagrams() const;
+    size_t datagram_count() const;
+
+private:
+    SocketDatagram * datagrams_;
+    size_t datagram_count_;
+#if defined NCORE_LINUX
+    mmsghdr msgs_[kMaxDatagrams];
+    iovec iovs_[kMaxDatagrams];
+    alignas(cmsghdr) char control_[CMSG_SPACE(sizeof(uint16_t))];
+    bool segmented_;                //以UDP GSO一次发送
+#endif
+
+    friend class Socket;
+    friend class SocketRoutines;
+};
+
+/*! 发送文件的上下文\n
+用于Socket::SendFileAsync，依次发送报头、文件中的一段和报尾，
+完成时transfered()为三者合计发送的字节数。\n
+*/
+class SocketFileAsyncContext : public SocketAsyncContext
+{
+public:
+    SocketFileAsyncContext();
+#if defined NCORE_WINDOWS
+    SocketFileAsyncContext(NamedEvent & e);
+#endif
+
+    /*! 设置要发送的文件
+    @param[in] file     文件流，在请求完成之前必须保持打开。
+    @param[in] offset   起始位置。
+    @param[in] length   发送的字节数，为0时发送到文件尾。
+    */
+    void SetFile(FileStream & file, uint64_t offset, uint32_t length);
+
+    //在文件之前和之后发送的数据，在请求完成之前必须保持有效，可以为空
+    void SetHeader(const void * data, size_t size);
+    void SetTrailer(const void * data, size_t size);
+
+    FileStream * file() const;
+    uint64_t file_offset() const;
+    uint32_t file_length() const;
+    const SocketBuffer & header() const;
+    const SocketBuffer & trailer() const;
+
+private:
+    FileStream * file_;
+    uint64_t file_offset_;
+    uint32_t file_length_;
+    SocketBuffer header_;
+    SocketBuffer trailer_;
+#if defined NCORE_WINDOWS
+    TRANSMIT_FILE_BUFFERS transmit_buffers_;
+#elif defined NCORE_LINUX
+    iovec iovs_[2];                 //报头和报尾，发送过程中前移
+#endif
+
+    friend class Socket;
+};
+
+template <typename Adaptee>
+using SocketAsyncResultAdapter = 
+AsyncResultAdapter<Adaptee, SocketAsyncContext>;
+
+
+}
+
 #endif
\ No newline at end of file
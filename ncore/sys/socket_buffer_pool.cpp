@@ -0,0 +1,124 @@
+﻿#include "socket_buffer_pool.h"
+
+namespace ncore
+{
+
+
+SocketBufferPool::SocketBufferPool()
+    : buffer_size_(0), count_(0), available_(0)
+#if defined NCORE_LINUX
+      , owner_(0), ring_(0), ring_entries_(0), ring_tail_(0), group_(0)
+#endif
+{
+}
+
+SocketBufferPool::~SocketBufferPool()
+{
+    fini();
+}
+
+bool SocketBufferPool::init(uint32_t buffer_size, uint32_t count)
+{
+    if(count_ || buffer_size == 0 || count == 0 || count > kMaxBuffers)
+        return false;
+
+    storage_.resize(static_cast<size_t>(buffer_size) * count);
+    free_.reserve(count);
+    //倒序放入，先取出低地址的缓冲区
+    for(uint32_t i = count; i > 0; --i)
+        free_.push_back(i - 1);
+
+    buffer_size_ = buffer_size;
+    count_ = count;
+    available_ = count;
+    return true;
+}
+
+void SocketBufferPool::fini()
+{
+    if(count_ == 0)
+        return;
+
+#if defined NCORE_LINUX
+    assert(owner_ == 0);
+#endif
+    assert(available_ == count_);
+    std::vector<char>().swap(storage_);
+    std::vector<uint32_t>().swap(free_);
+    buffer_size_ = 0;
+    count_ = 0;
+    available_ = 0;
+}
+
+void * SocketBufferPool::Acquire()
+{
+    void * buffer = 0;
+    lock_.Acquire();
+    if(!free_.empty())
+    {
+        buffer = BufferAt(free_.back());
+        free_.pop_back();
+        --available_;
+    }
+    lock_.Release();
+    return buffer;
+}
+
+void SocketBufferPool::Release(void * buffer)
+{
+    if(buffer == 0)
+        return;
+
+    uint32_t index = IndexOf(buffer);
+    assert(index < count_);
+    if(index >= count_)
+        return;
+
+    lock_.Acquire();
+#if defined NCORE_LINUX
+    if(ring_)
+        PushRing(index);
+    else
+        free_.push_back(index);
+#else
+    free_.push_back(index);
+#endif
+    ++available_;
+    lock_.Release();
+}
+
+uint32_t SocketBufferPool::buffer_size() const
+{
+    return buffer_size_;
+}
+
+uint32_t SocketBufferPool::count() const
+{
+    return count_;
+}
+
+uint32_t SocketBufferPool::available() const
+{
+    lock_.Acquire();
+    uint32_t available = available_;
+    lock_.Release();
+    return available;
+}
+
+char * SocketBufferPool::BufferAt(uint32_t index) const
+{
+    return const_cast<char *>(&storage_[0]) +
+           static_cast<size_t>(index) * buffer_size_;
+}
+
+uint32_t SocketBufferPool::IndexOf(void * buffer) const
+{
+    const char * base = &storage_[0];
+    const char * p = static_cast<const char *>(buffer);
+    if(p < base || p >= base + storage_.size())
+        return count_;
+    return static_cast<uint32_t>((p - base) / buffer_size_);
+}
+
+
+}
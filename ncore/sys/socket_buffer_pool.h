@@ -0,0 +1,100 @@
+﻿#ifndef NCORE_SYS_SOCKET_BUFFER_POOL_H_
+#define NCORE_SYS_SOCKET_BUFFER_POOL_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include "spin_lock.h"
+
+namespace ncore
+{
+
+
+class Proactor;
+class IORing;
+
+/*! 共享的接收缓冲池\n
+一组等长的缓冲区，供多个套接字的Socket::ReceivePooledAsync共用。
+接收请求在数据到达时才从池中取得缓冲区，等待中的连接不占用缓冲区。\n
+完成回调通过SocketAsyncContext::buffer()取得装有数据的缓冲区，用完后调用Release归还。\n
+Linux下通过Proactor::RegisterBufferPool注册到io_uring引擎后，
+缓冲区交给内核（provided buffers），由内核在数据到达时选取；
+其他情况下等待可读之后从池中取出缓冲区再接收。\n
+*/
+class SocketBufferPool : public NonCopyableObject
+{
+public:
+    SocketBufferPool();
+    ~SocketBufferPool();
+
+    /*! 初始化
+    @param[in] buffer_size  每个缓冲区的大小。
+    @param[in] count        缓冲区的个数，不超过kMaxBuffers。
+    @return 初始化成功后返回true；否则返回false。
+    */
+    bool init(uint32_t buffer_size, uint32_t count);
+
+    //必须在所有缓冲区归还、并且从前摄器注销之后调用
+    void fini();
+
+    /*! 取出一个缓冲区
+    @return 池为空时返回0；注册到前摄器之后缓冲区由内核选取，总是返回0。
+    */
+    void * Acquire();
+
+    //归还缓冲区，可以在任意线程调用
+    void Release(void * buffer);
+
+    uint32_t buffer_size() const;
+    uint32_t count() const;
+
+    //尚未被取出的缓冲区个数
+    uint32_t available() const;
+
+public:
+    //缓冲区编号在io_uring中为16位
+    static const uint32_t kMaxBuffers = 32768;
+
+private:
+    char * BufferAt(uint32_t index) const;
+    uint32_t IndexOf(void * buffer) const;
+
+#if defined NCORE_LINUX
+    //把空闲的缓冲区全部移入提供给内核的环，并以group注册
+    bool AttachRing(Proactor & owner, IORing & ring, uint16_t group);
+
+    //所有缓冲区归还之后才能注销
+    bool DetachRing(Proactor & owner, IORing & ring);
+
+    //放回环中，在锁内调用
+    void PushRing(uint32_t index);
+
+    //内核选取了编号为index的缓冲区
+    void * TakeRing(uint32_t index);
+
+    //在proactor上接收时使用的缓冲区组，未注册到该前摄器时返回-1
+    int GetGroup(const Proactor & proactor) const;
+#endif
+
+private:
+    mutable SpinLock lock_;
+    std::vector<char> storage_;
+    std::vector<uint32_t> free_;
+    uint32_t buffer_size_;
+    uint32_t count_;
+    uint32_t available_;
+#if defined NCORE_LINUX
+    Proactor * owner_;
+    io_uring_buf_ring * ring_;
+    uint32_t ring_entries_;
+    uint16_t ring_tail_;
+    uint16_t group_;
+#endif
+
+    friend class Proactor;
+    friend class Socket;
+};
+
+
+}
+
+#endif
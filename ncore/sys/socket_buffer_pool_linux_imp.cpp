@@ -0,0 +1,108 @@
+﻿#include "io_ring.h"
+#include "socket_buffer_pool.h"
+
+namespace ncore
+{
+
+
+bool SocketBufferPool::AttachRing(Proactor & owner, IORing & ring,
+                                  uint16_t group)
+{
+    //环的大小为2的幂
+    uint32_t entries = 1;
+    while(entries < count_)
+        entries <<= 1;
+    size_t size = entries * sizeof(io_uring_buf);
+
+    lock_.Acquire();
+    if(count_ == 0 || owner_ != 0)
+    {
+        lock_.Release();
+        return false;
+    }
+
+    //环需要页对齐，匿名映射同时把tail清零
+    void * memory = mmap(0, size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(memory == MAP_FAILED)
+    {
+        lock_.Release();
+        return false;
+    }
+
+    if(!ring.RegisterBufRing(memory, entries, group))
+    {
+        munmap(memory, size);
+        lock_.Release();
+        return false;
+    }
+
+    owner_ = &owner;
+    ring_ = static_cast<io_uring_buf_ring *>(memory);
+    ring_entries_ = entries;
+    ring_tail_ = 0;
+    group_ = group;
+    for(size_t i = 0; i < free_.size(); ++i)
+        PushRing(free_[i]);
+    free_.clear();
+    lock_.Release();
+    return true;
+}
+
+bool SocketBufferPool::DetachRing(Proactor & owner, IORing & ring)
+{
+    lock_.Acquire();
+    if(owner_ != &owner || available_ != count_)
+    {
+        lock_.Release();
+        return false;
+    }
+
+    ring.UnregisterBufRing(group_);
+    munmap(ring_, ring_entries_ * sizeof(io_uring_buf));
+    owner_ = 0;
+    ring_ = 0;
+    ring_entries_ = 0;
+    ring_tail_ = 0;
+
+    //缓冲区都已归还，全部回到空闲表
+    for(uint32_t i = count_; i > 0; --i)
+        free_.push_back(i - 1);
+    lock_.Release();
+    return true;
+}
+
+void SocketBufferPool::PushRing(uint32_t index)
+{
+    //C++下bufs前有一个空结构体占位，直接按io_uring_buf数组寻址；
+    //第0项的resv与tail重叠，只写其余的字段
+    io_uring_buf * bufs = reinterpret_cast<io_uring_buf *>(ring_);
+    io_uring_buf & buf = bufs[ring_tail_ & (ring_entries_ - 1)];
+    buf.addr = reinterpret_cast<uint64_t>(BufferAt(index));
+    buf.len = buffer_size_;
+    buf.bid = static_cast<uint16_t>(index);
+    ++ring_tail_;
+    __atomic_store_n(&ring_->tail, ring_tail_, __ATOMIC_RELEASE);
+}
+
+void * SocketBufferPool::TakeRing(uint32_t index)
+{
+    if(index >= count_)
+        return 0;
+
+    lock_.Acquire();
+    --available_;
+    lock_.Release();
+    return BufferAt(index);
+}
+
+int SocketBufferPool::GetGroup(const Proactor & proactor) const
+{
+    lock_.Acquire();
+    int group = owner_ == &proactor ? static_cast<int>(group_) : -1;
+    lock_.Release();
+    return group;
+}
+
+
+}
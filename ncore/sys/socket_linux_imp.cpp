@@ -0,0 +1,1459 @@
+﻿#include "file_stream.h"
+#include "proactor.h"
+#include "socket_async_event_args.h"
+#include "socket.h"
+#include "socket_buffer_pool.h"
+
+namespace ncore
+{
+
+
+static const int kInvalidSocket = -1;
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+#ifndef SO_MAX_PACING_RATE
+#define SO_MAX_PACING_RATE 47
+#endif
+
+//UDP GSO一次最多的分段数和负载
+static const size_t kMaxSegments = 64;
+static const size_t kMaxSegmentedSize = 65507;
+
+//sendfile一次最多发送的字节数，与内核的MAX_RW_COUNT相同
+static const uint64_t kMaxSendFileChunk = 0x7FFFF000;
+
+//每个分段另加的UDP头和IP头
+static const uint32_t kSegmentOverheadV4 = 8 + 20;
+static const uint32_t kSegmentOverheadV6 = 8 + 40;
+
+//多段缓冲区直接作为iovec数组提交
+static_assert(sizeof(SocketBuffer) == sizeof(iovec) &&
+              offsetof(SocketBuffer, data) == offsetof(iovec, iov_base) &&
+              offsetof(SocketBuffer, size) == offsetof(iovec, iov_len),
+              "SocketBuffer must match iovec");
+
+
+class SocketRoutines
+{
+private:
+    friend class Socket;
+
+    //等待套接字就绪，timeout为-1时无限等待
+    static bool WaitFor(int s, short events, uint32_t timeout)
+    {
+        pollfd pfd;
+        pfd.fd = s;
+        pfd.events = events;
+        pfd.revents = 0;
+
+        int ms = timeout == static_cast<uint32_t>(-1) ? -1 :
+                 static_cast<int>(timeout);
+        while(true)
+        {
+            int result = poll(&pfd, 1, ms);
+            if(result > 0)
+                return true;
+            if(result == 0)
+            {
+                errno = ETIMEDOUT;
+                return false;
+            }
+            if(errno != EINTR)
+                return false;
+        }
+    }
+
+    static bool IsWouldBlock()
+    {
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+
+    //SCM_RIGHTS的控制信息，一次传递一个描述符
+    union RightsControl
+    {
+        cmsghdr align;
+        char buffer[CMSG_SPACE(sizeof(int))];
+    };
+
+    static const uint32_t kUnknownTimeout = static_cast<uint32_t>(-2);
+
+    static void ResetSync(Socket & socket)
+    {
+        socket.sync_.fd = kInvalidSocket;
+        socket.sync_.nonblocking = false;
+        socket.sync_.recv_timeout = kUnknownTimeout;
+        socket.sync_.send_timeout = kUnknownTimeout;
+    }
+
+    /*! 准备同步操作的超时
+    @remark 阻塞的套接字由内核以SO_RCVTIMEO/SO_SNDTIMEO计时，只在超时改变时设置；
+            非阻塞的套接字（例如已关联到前摄器）不设置，由调用者以poll等待。\n
+    */
+    static bool PrepareSync(Socket & socket, int optname, uint32_t timeout)
+    {
+        Socket::SyncState & state = socket.sync_;
+        if(state.fd != socket.s_)
+        {
+            int flags = fcntl(socket.s_, F_GETFL);
+            if(flags < 0)
+                return false;
+
+            //accept得到的套接字继承了监听套接字的超时，第一次总是设置
+            state.fd = socket.s_;
+            state.nonblocking = (flags & O_NONBLOCK) != 0;
+            state.recv_timeout = kUnknownTimeout;
+            state.send_timeout = kUnknownTimeout;
+        }
+
+        if(state.nonblocking)
+            return true;
+
+        uint32_t & current = optname == SO_RCVTIMEO ? state.recv_timeout :
+                                                      state.send_timeout;
+        if(current == timeout)
+            return true;
+
+        //内核把0当作不超时，收发0毫秒的超时由调用者以MSG_DONTWAIT处理，
+        //accept和connect按最短的超时设置
+        timeval tv = {0, 0};
+        if(timeout != static_cast<uint32_t>(-1))
+        {
+            tv.tv_sec = timeout / 1000;
+            tv.tv_usec = (timeout % 1000) * 1000;
+            if(timeout == 0)
+                tv.tv_usec = 1;
+        }
+        if(setsockopt(socket.s_, SOL_SOCKET, optname, &tv, sizeof(tv)))
+            return false;
+
+        current = timeout;
+        return true;
+    }
+
+    //阻塞的套接字返回EAGAIN说明内核的计时已经到期，不必再poll
+    static bool IsSyncTimeout(const Socket & socket, int flags)
+    {
+        if(socket.sync_.nonblocking || (flags & MSG_DONTWAIT))
+            return false;
+
+        errno = ETIMEDOUT;
+        return true;
+    }
+
+    static void PrepareBuffer(SocketAsyncContext & args,
+                              AsyncRequestOp::Value op, int s)
+    {
+        args.PrepareRequest(op, s);
+        if(args.buffer_count_)
+        {
+            args.request_.msg.msg_iov = reinterpret_cast<iovec *>(args.buffers_);
+            args.request_.msg.msg_iovlen = args.buffer_count_;
+            return;
+        }
+        args.request_.iov.iov_base = args.buffer_;
+        args.request_.iov.iov_len = args.count_;
+    }
+
+    static bool HasBuffer(const SocketAsyncContext & args)
+    {
+        return args.buffer_ != 0 || args.buffer_count_ != 0;
+    }
+
+    static void PrepareDatagrams(SocketDatagram * datagrams, size_t count,
+                                 mmsghdr * msgs, iovec * iovs, bool send)
+    {
+        memset(msgs, 0, sizeof(mmsghdr) * count);
+        for(size_t index = 0; index < count; ++index)
+        {
+            SocketDatagram & datagram = datagrams[index];
+            IPEndPoint & endpoint = datagram.endpoint;
+            msghdr & msg = msgs[index].msg_hdr;
+            iovs[index].iov_base = datagram.data;
+            iovs[index].iov_len = datagram.size;
+            msg.msg_iov = &iovs[index];
+            msg.msg_iovlen = 1;
+            if(!send)
+            {
+                msg.msg_name = &endpoint.ep_;
+                msg.msg_namelen = sizeof(endpoint.ep_storage_);
+            }
+            else if(endpoint.ep_size_)
+            {
+                //已连接的套接字可以不指定地址
+                msg.msg_name = &endpoint.ep_;
+                msg.msg_namelen = static_cast<socklen_t>(endpoint.ep_size_);
+            }
+            datagram.transfered = 0;
+        }
+    }
+
+    static void FinishDatagrams(SocketDatagram * datagrams,
+                                const mmsghdr * msgs, size_t count, bool send)
+    {
+        for(size_t index = 0; index < count; ++index)
+        {
+            datagrams[index].transfered = msgs[index].msg_len;
+            if(!send)
+                datagrams[index].endpoint.ep_size_ = msgs[index].msg_hdr.msg_namelen;
+        }
+    }
+
+    //探测内核是否支持UDP_SEGMENT，只缓存支持的结果，不是UDP的套接字同样返回false
+    static bool CanSegment(int s)
+    {
+        if(segment_support_ > 0)
+            return true;
+        if(segment_support_ < 0)
+            return false;
+
+        int size = 0;
+        socklen_t size_len = sizeof(size);
+        if(getsockopt(s, SOL_UDP, UDP_SEGMENT, &size, &size_len) != 0)
+            return false;
+        segment_support_ = 1;
+        return true;
+    }
+
+    //已连接的套接字取路径MTU允许的最大分段，未连接或者取不到时返回0
+    static uint32_t GetMaxSegment(int s)
+    {
+        int domain = 0;
+        socklen_t domain_len = sizeof(domain);
+        if(getsockopt(s, SOL_SOCKET, SO_DOMAIN, &domain, &domain_len) != 0)
+            return 0;
+
+        int mtu = 0;
+        socklen_t mtu_len = sizeof(mtu);
+        int result = domain == AF_INET6
+                   ? getsockopt(s, IPPROTO_IPV6, IPV6_MTU, &mtu, &mtu_len)
+                   : getsockopt(s, IPPROTO_IP, IP_MTU, &mtu, &mtu_len);
+        uint32_t overhead = domain == AF_INET6 ? kSegmentOverheadV6
+                                               : kSegmentOverheadV4;
+        if(result != 0 || mtu <= static_cast<int>(overhead))
+            return 0;
+        return static_cast<uint32_t>(mtu) - overhead;
+    }
+
+    /*
+    目标相同、长度相同（最后一个可以较短）的数据报以UDP GSO合并为一次sendmsg，
+    由内核或者网卡分段，条件不满足时返回false，改用sendmmsg。
+    分段超过路径MTU时不使用GSO；未连接的套接字取不到路径MTU，
+    分段超过出口MTU时sendmsg以EMSGSIZE或者EINVAL失败，由调用者改用sendmmsg。
+    */
+    static bool PrepareSegmented(int s, SocketDatagram * datagrams, size_t count,
+                                 msghdr & msg, iovec * iovs, char * control)
+    {
+        if(count < 2 || count > kMaxSegments)
+            return false;
+
+        const IPEndPoint & target = datagrams[0].endpoint;
+        uint32_t segment = datagrams[0].size;
+        size_t total = 0;
+        for(size_t index = 0; index < count; ++index)
+        {
+            const SocketDatagram & datagram = datagrams[index];
+            if(datagram.size == 0 || datagram.size > segment)
+                return false;
+            if(datagram.size != segment && index != count - 1)
+                return false;
+            if(datagram.endpoint.ep_size_ != target.ep_size_ ||
+               memcmp(&datagram.endpoint.ep_, &target.ep_, target.ep_size_))
+                return false;
+            total += datagram.size;
+        }
+        if(total > kMaxSegmentedSize || !CanSegment(s))
+            return false;
+
+        uint32_t max_segment = GetMaxSegment(s);
+        if(max_segment && segment > max_segment)
+            return false;
+
+        for(size_t index = 0; index < count; ++index)
+        {
+            iovs[index].iov_base = datagrams[index].data;
+            iovs[index].iov_len = datagrams[index].size;
+            datagrams[index].transfered = 0;
+        }
+
+        memset(&msg, 0, sizeof(msg));
+        if(target.ep_size_)
+        {
+            msg.msg_name = const_cast<sockaddr *>(&target.ep_);
+            msg.msg_namelen = static_cast<socklen_t>(target.ep_size_);
+        }
+        msg.msg_iov = iovs;
+        msg.msg_iovlen = count;
+        msg.msg_control = control;
+        msg.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+        memset(control, 0, msg.msg_controllen);
+
+        cmsghdr * cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        uint16_t segment_size = static_cast<uint16_t>(segment);
+        memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+        return true;
+    }
+
+    //length为0时取到文件尾的长度，可以超过4GB
+    static bool GetFileLength(int fd, uint64_t offset, uint32_t length,
+                              uint64_t & remaining)
+    {
+        remaining = length;
+        if(length)
+            return true;
+
+        struct stat st;
+        if(fstat(fd, &st) != 0)
+            return false;
+
+        uint64_t size = static_cast<uint64_t>(st.st_size);
+        if(size > offset)
+            remaining = size - offset;
+        return true;
+    }
+
+    //sendfile对该文件不可用，改为读取后发送
+    static bool IsSendFileUnsupported()
+    {
+        return errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP;
+    }
+
+    /*
+    GSO发送失败，返回true时改用sendmmsg重新发送。
+    网卡不支持校验和卸载时以EIO失败，此后不再使用；
+    分段超过路径MTU时以EMSGSIZE或者EINVAL失败，只对本次发送改用sendmmsg。
+    */
+    static bool OnSegmentFailed(int error)
+    {
+        if(error == EIO)
+            segment_support_ = -1;
+        return error == EIO || error == EMSGSIZE || error == EINVAL;
+    }
+
+    //0为未探测，1为支持，-1为发送失败后禁用
+    static volatile int segment_support_;
+};
+
+volatile int SocketRoutines::segment_support_ = 0;
+
+
+Socket::Socket()
+    : io_handler_(0),
+      s_(kInvalidSocket)
+{
+    SocketRoutines::ResetSync(*this);
+}
+
+Socket::~Socket()
+{
+    Close();
+}
+
+Socket::Socket(Socket && obj)
+    : io_handler_(0),
+      s_(kInvalidSocket)
+{
+    SocketRoutines::ResetSync(*this);
+    std::swap(s_, obj.s_);
+    std::swap(io_handler_, obj.io_handler_);
+    std::swap(sync_, obj.sync_);
+}
+
+Socket & Socket::operator = (Socket && obj)
+{
+    std::swap(s_, obj.s_);
+    std::swap(io_handler_, obj.io_handler_);
+    std::swap(sync_, obj.sync_);
+    return *this;
+}
+
+bool Socket::init(AddressFamily af,
+                  SocketType type,
+                  ProtocolType protocol)
+{
+    if(s_ != kInvalidSocket)
+        return true;
+
+    s_ = socket(af, type | SOCK_CLOEXEC, protocol);
+
+    return s_ != kInvalidSocket ? true : false;
+}
+
+void Socket::fini()
+{
+    Close();
+    return;
+}
+
+bool Socket::Close()
+{
+    auto ss = s_;
+    if(ss == kInvalidSocket)
+        return false;
+    if(io_handler_)
+        io_handler_->Dissociate(*this);
+    s_ = kInvalidSocket;
+    SocketRoutines::ResetSync(*this);
+    if(close(ss))
+        return false;
+    return true;
+}
+
+bool Socket::Bind(const IPEndPoint & endpoint)
+{
+    auto sa_ptr = reinterpret_cast<const sockaddr *>(&endpoint.ep_);
+    if(!bind(s_, sa_ptr, endpoint.ep_size_))
+        return true;
+    return false;
+}
+
+bool Socket::LocalEndPoint(IPEndPoint & endpoint) const
+{
+    sockaddr_storage storage;
+    socklen_t size = sizeof(storage);
+    auto sa_ptr = reinterpret_cast<sockaddr *>(&storage);
+    if(getsockname(s_, sa_ptr, &size))
+        return false;
+    if(sa_ptr->sa_family != AF_INET && sa_ptr->sa_family != AF_INET6)
+        return false;
+    endpoint = IPEndPoint::FromSockAddr(*sa_ptr);
+    return true;
+}
+
+bool Socket::Listen(int backlog)
+{
+    return listen(s_, backlog) ? false : true;
+}
+
+bool Socket::Shutdown(SocketShutdown how)
+{
+    return shutdown(s_, how) ? false : true;
+}
+
+Socket Socket::Accept()
+{
+    return Accept(-1);
+}
+
+Socket Socket::Accept(uint32_t timeout)
+{
+    Socket accept_socket;
+
+    if(s_ == kInvalidSocket)
+        return accept_socket;
+
+    //accept也受SO_RCVTIMEO的限制
+    if(!SocketRoutines::PrepareSync(*this, SO_RCVTIMEO, timeout))
+        return accept_socket;
+
+    while(true)
+    {
+        int s = accept4(s_, 0, 0, SOCK_CLOEXEC);
+        if(s != kInvalidSocket)
+        {
+            accept_socket.s_ = s;
+            break;
+        }
+
+        if(errno == EINTR)
+            continue;
+
+        if(!SocketRoutines::IsWouldBlock())
+            break;
+
+        if(SocketRoutines::IsSyncTimeout(*this, 0))
+            break;
+
+        if(!SocketRoutines::WaitFor(s_, POLLIN, timeout))
+            break;
+    }
+
+    return accept_socket;
+}
+
+bool Socket::AcceptAsync(SocketAsyncContext & args)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    //Linux上没有完成例程，异步操作必须关联到前摄器
+    if(io_handler_ == 0)
+        return false;
+
+    //accept会得到新的套接字，所以accept_socket无需预先创建
+    if(args.accept_socket_ == 0)
+        return false;
+
+    SocketRoutines::PrepareBuffer(args, AsyncRequestOp::kRequestAccept, s_);
+    args.request_.addr = &args.remote_endpoint_.ep_;
+    args.request_.addr_size = sizeof(args.remote_endpoint_.ep_storage_);
+    args.last_op_ = SocketAsyncOp::kAsyncAccept;
+    return io_handler_->Submit(args);
+}
+
+bool Socket::Connect(const IPEndPoint & endpoint)
+{
+    return Connect(endpoint, -1);
+}
+
+bool Socket::Connect(const IPEndPoint & endpoint, uint32_t timeout)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    //阻塞的connect受SO_SNDTIMEO的限制，不必临时切换为非阻塞模式
+    if(!SocketRoutines::PrepareSync(*this, SO_SNDTIMEO, timeout))
+        return false;
+
+    auto sa_ptr = reinterpret_cast<const sockaddr *>(&endpoint.ep_);
+    if(!connect(s_, sa_ptr, endpoint.ep_size_))
+        return true;
+
+    if(errno != EINPROGRESS)
+        return false;
+
+    //超时之后连接仍在进行，套接字不能再用来连接
+    if(SocketRoutines::IsSyncTimeout(*this, 0))
+        return false;
+
+    if(!SocketRoutines::WaitFor(s_, POLLOUT, timeout))
+        return false;
+
+    int error = 0;
+    socklen_t size = sizeof(error);
+    if(getsockopt(s_, SOL_SOCKET, SO_ERROR, &error, &size))
+        return false;
+
+    errno = error;
+    return error == 0;
+}
+
+bool Socket::ConnectAsync(SocketAsyncContext & args)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    SocketRoutines::PrepareBuffer(args, AsyncRequestOp::kRequestConnect, s_);
+    args.request_.addr = &args.remote_endpoint_.ep_;
+    args.request_.addr_size = args.remote_endpoint_.ep_size_;
+    args.connect_socket_ = this;
+    args.last_op_ = SocketAsyncOp::kAsyncConnect;
+    return io_handler_->Submit(args);
+}
+
+void Socket::Disconnect(bool reuse)
+{
+    if(s_ == kInvalidSocket)
+        return;
+
+    shutdown(s_, SHUT_RDWR);
+
+    //Linux上的套接字不能重用，关闭后可作为accept_socket再次使用
+    if(reuse)
+        Close();
+
+    return;
+}
+
+bool Socket::DisconnectAsync(SocketAsyncContext & args)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    SocketRoutines::PrepareBuffer(args, AsyncRequestOp::kRequestShutdown, s_);
+    args.request_.flags = SHUT_RDWR;
+    args.last_op_ = SocketAsyncOp::kAsyncDisconnect;
+    return io_handler_->Submit(args);
+}
+
+bool Socket::Receive(void * data, uint32_t size_to_recv, uint32_t & transfered)
+{
+    return Receive(data, size_to_recv, -1, transfered);
+}
+
+bool Socket::Receive(void * data, uint32_t size_to_recv, uint32_t timeout,
+                     uint32_t & transfered)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(data == 0)
+        return false;
+
+    int flags = 0;
+    if(timeout == 0)
+        flags = MSG_DONTWAIT;
+    else if(!SocketRoutines::PrepareSync(*this, SO_RCVTIMEO, timeout))
+        return false;
+
+    while(true)
+    {
+        ssize_t result = recv(s_, data, size_to_recv, flags);
+        if(result >= 0)
+        {
+            transfered = static_cast<uint32_t>(result);
+            return true;
+        }
+
+        if(errno == EINTR)
+            continue;
+
+        if(!SocketRoutines::IsWouldBlock())
+            return false;
+
+        if(SocketRoutines::IsSyncTimeout(*this, flags))
+            return false;
+
+        if(!SocketRoutines::WaitFor(s_, POLLIN, timeout))
+            return false;
+    }
+}
+
+bool Socket::ReceiveAsync(SocketAsyncContext & args)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    if(!SocketRoutines::HasBuffer(args))
+        return false;
+
+    SocketRoutines::PrepareBuffer(args, AsyncRequestOp::kRequestRecvMsg, s_);
+    args.last_op_ = SocketAsyncOp::kAsyncRecv;
+    return io_handler_->Submit(args);
+}
+
+bool Socket::Send(const void * data, uint32_t size_to_send,
+                  uint32_t & transfered)
+{
+    return Send(data, size_to_send, -1, transfered);
+}
+
+bool Socket::Send(const void * data, uint32_t size_to_send, uint32_t timeout,
+                  uint32_t & transfered)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(data == 0)
+        return false;
+
+    int flags = MSG_NOSIGNAL;
+    if(timeout == 0)
+        flags |= MSG_DONTWAIT;
+    else if(!SocketRoutines::PrepareSync(*this, SO_SNDTIMEO, timeout))
+        return false;
+
+    while(true)
+    {
+        ssize_t result = send(s_, data, size_to_send, flags);
+        if(result >= 0)
+        {
+            transfered = static_cast<uint32_t>(result);
+            return true;
+        }
+
+        if(errno == EINTR)
+            continue;
+
+        if(!SocketRoutines::IsWouldBlock())
+            return false;
+
+        if(SocketRoutines::IsSyncTimeout(*this, flags))
+            return false;
+
+        if(!SocketRoutines::WaitFor(s_, POLLOUT, timeout))
+            return false;
+    }
+}
+
+bool Socket::SendAsync(SocketAsyncContext & args)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    if(!SocketRoutines::HasBuffer(args))
+        return false;
+
+    SocketRoutines::PrepareBuffer(args, AsyncRequestOp::kRequestSendMsg, s_);
+    args.request_.flags = args.socket_flags_;
+    args.last_op_ = SocketAsyncOp::kAsyncSend;
+    return io_handler_->Submit(args);
+}
+
+bool Socket::SendFile(FileStream & file, uint64_t offset, uint32_t length,
+                      const SocketBuffer & header, const SocketBuffer & trailer,
+                      uint32_t & transfered)
+{
+    transfered = 0;
+    if(s_ == kInvalidSocket)
+        return false;
+
+    int fd = file.handle_;
+    uint64_t remaining = 0;
+    if(fd < 0 || !SocketRoutines::GetFileLength(fd, offset, length, remaining))
+        return false;
+
+    //后面还有数据时报头带MSG_MORE，与文件的第一段合并成报文
+    int header_flags = MSG_NOSIGNAL;
+    if(remaining || trailer.size)
+        header_flags |= MSG_MORE;
+
+    uint32_t sent = 0;
+    while(sent < header.size)
+    {
+        const char * data = static_cast<const char *>(header.data) + sent;
+        ssize_t result = send(s_, data, header.size - sent, header_flags);
+        if(result > 0)
+        {
+            sent += static_cast<uint32_t>(result);
+            continue;
+        }
+        if(result < 0 && errno == EINTR)
+            continue;
+        if(result < 0 && SocketRoutines::IsWouldBlock() &&
+           SocketRoutines::WaitFor(s_, POLLOUT, -1))
+            continue;
+        transfered = sent;
+        return false;
+    }
+
+    //length为0时文件可能超过4GB，按64位累计，返回前再截断
+    uint64_t total = sent;
+    off_t position = static_cast<off_t>(offset);
+    while(remaining)
+    {
+        size_t count = static_cast<size_t>(
+            std::min<uint64_t>(remaining, kMaxSendFileChunk));
+        ssize_t result = sendfile(s_, fd, &position, count);
+        if(result > 0)
+        {
+            remaining -= static_cast<uint64_t>(result);
+            total += static_cast<uint64_t>(result);
+            continue;
+        }
+
+        //文件比指定的长度短
+        if(result == 0)
+            break;
+
+        if(errno == EINTR)
+            continue;
+
+        if(SocketRoutines::IsWouldBlock())
+        {
+            if(!SocketRoutines::WaitFor(s_, POLLOUT, -1))
+            {
+                transfered = ClampTransfered(total);
+                return false;
+            }
+            continue;
+        }
+
+        if(!SocketRoutines::IsSendFileUnsupported())
+        {
+            transfered = ClampTransfered(total);
+            return false;
+        }
+
+        //报头已经发送，剩余的文件和报尾改为读取后发送
+        SocketBuffer empty = {0, 0};
+        uint64_t copied = 0;
+        bool succeed = SendFileByCopy(file, static_cast<uint64_t>(position),
+                                      remaining, empty, trailer, copied);
+        transfered = ClampTransfered(total + copied);
+        return succeed;
+    }
+
+    bool succeed = SendAll(trailer.data, trailer.size, sent);
+    transfered = ClampTransfered(total + sent);
+    return succeed;
+}
+
+bool Socket::SendFileAsync(SocketFileAsyncContext & args)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    if(args.file_ == 0)
+        return false;
+
+    int fd = args.file_->handle_;
+    uint64_t remaining = 0;
+    if(fd < 0 || !SocketRoutines::GetFileLength(fd, args.file_offset_,
+                                                args.file_length_, remaining))
+        return false;
+
+    args.PrepareRequest(AsyncRequestOp::kRequestSendFile, s_);
+    args.iovs_[0].iov_base = args.header_.data;
+    args.iovs_[0].iov_len = args.header_.size;
+    args.iovs_[1].iov_base = args.trailer_.data;
+    args.iovs_[1].iov_len = args.trailer_.size;
+    args.request_.msg.msg_iov = args.iovs_;
+    args.request_.msg.msg_iovlen = 2;
+    args.request_.offset = static_cast<int64_t>(args.file_offset_);
+    args.request_.file_fd = fd;
+    args.request_.file_remaining = remaining;
+    args.last_op_ = SocketAsyncOp::kAsyncSendFile;
+    return io_handler_->Submit(args);
+}
+
+bool Socket::ReceivePooledAsync(SocketAsyncContext & args, SocketBufferPool & pool)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    args.PrepareRequest(AsyncRequestOp::kRequestRecvPooled, s_);
+    args.request_.pool = &pool;
+    args.request_.buffer_group = pool.GetGroup(*io_handler_);
+    args.request_.iov.iov_len = pool.buffer_size();
+    args.SetBuffer(static_cast<void *>(0), 0);
+    args.buffer_pool_ = &pool;
+    args.last_op_ = SocketAsyncOp::kAsyncRecvPooled;
+    return io_handler_->Submit(args);
+}
+
+bool Socket::SpliceRecvAsync(SocketAsyncContext & args, int pipe, uint32_t size)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    args.PrepareRequest(AsyncRequestOp::kRequestSpliceRecv, s_);
+    args.request_.pipe_fd = pipe;
+    args.request_.iov.iov_len = size;
+    args.last_op_ = SocketAsyncOp::kAsyncSpliceRecv;
+    return io_handler_->Submit(args);
+}
+
+bool Socket::SpliceSendAsync(SocketAsyncContext & args, int pipe, uint32_t size)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    args.PrepareRequest(AsyncRequestOp::kRequestSpliceSend, s_);
+    args.request_.pipe_fd = pipe;
+    args.request_.iov.iov_len = size;
+    args.last_op_ = SocketAsyncOp::kAsyncSpliceSend;
+    return io_handler_->Submit(args);
+}
+
+bool Socket::ReceiveFrom(void * data, uint32_t size_to_recv,
+                        uint32_t & transfered, IPEndPoint & endpoint)
+{
+    return ReceiveFrom(data, size_to_recv, -1, transfered, endpoint);
+}
+
+bool Socket::ReceiveFrom(void * data, uint32_t size_to_recv, uint32_t timeout,
+                        uint32_t & transfered, IPEndPoint & endpoint)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(data == 0)
+        return false;
+
+    int flags = 0;
+    if(timeout == 0)
+        flags = MSG_DONTWAIT;
+    else if(!SocketRoutines::PrepareSync(*this, SO_RCVTIMEO, timeout))
+        return false;
+
+    while(true)
+    {
+        socklen_t sa_size = sizeof(endpoint.ep_storage_);
+        ssize_t result = recvfrom(s_, data, size_to_recv, flags,
+                                  &endpoint.ep_, &sa_size);
+        if(result >= 0)
+        {
+            endpoint.ep_size_ = sa_size;
+            transfered = static_cast<uint32_t>(result);
+            return true;
+        }
+
+        if(errno == EINTR)
+            continue;
+
+        if(!SocketRoutines::IsWouldBlock())
+            return false;
+
+        if(SocketRoutines::IsSyncTimeout(*this, flags))
+            return false;
+
+        if(!SocketRoutines::WaitFor(s_, POLLIN, timeout))
+            return false;
+    }
+}
+
+bool Socket::ReceiveFromAsync(SocketAsyncContext & args)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    if(!SocketRoutines::HasBuffer(args))
+        return false;
+
+    SocketRoutines::PrepareBuffer(args, AsyncRequestOp::kRequestRecvMsg, s_);
+    args.request_.msg.msg_name = &args.remote_endpoint_.ep_;
+    args.request_.msg.msg_namelen = sizeof(args.remote_endpoint_.ep_storage_);
+    args.last_op_ = SocketAsyncOp::kAsyncRecvFrom;
+    return io_handler_->Submit(args);
+}
+
+bool Socket::SendTo(const void * data, uint32_t size_to_send,
+                    const IPEndPoint & endpoint, uint32_t & transfered)
+{
+    return SendTo(data, size_to_send, endpoint, -1, transfered);
+}
+
+bool Socket::SendTo(const void * data, uint32_t size_to_send,
+                    const IPEndPoint & endpoint, uint32_t timeout,
+                    uint32_t & transfered)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(data == 0)
+        return false;
+
+    int flags = MSG_NOSIGNAL;
+    if(timeout == 0)
+        flags |= MSG_DONTWAIT;
+    else if(!SocketRoutines::PrepareSync(*this, SO_SNDTIMEO, timeout))
+        return false;
+
+    while(true)
+    {
+        ssize_t result = sendto(s_, data, size_to_send, flags,
+                                &endpoint.ep_, endpoint.ep_size_);
+        if(result >= 0)
+        {
+            transfered = static_cast<uint32_t>(result);
+            return true;
+        }
+
+        if(errno == EINTR)
+            continue;
+
+        if(!SocketRoutines::IsWouldBlock())
+            return false;
+
+        if(SocketRoutines::IsSyncTimeout(*this, flags))
+            return false;
+
+        if(!SocketRoutines::WaitFor(s_, POLLOUT, timeout))
+            return false;
+    }
+}
+
+bool Socket::SendToAsync(SocketAsyncContext & args)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    if(!SocketRoutines::HasBuffer(args))
+        return false;
+
+    SocketRoutines::PrepareBuffer(args, AsyncRequestOp::kRequestSendMsg, s_);
+    args.request_.flags = args.socket_flags_;
+    args.request_.msg.msg_name = &args.remote_endpoint_.ep_;
+    args.request_.msg.msg_namelen = args.remote_endpoint_.ep_size_;
+    args.last_op_ = SocketAsyncOp::kAsyncSendTo;
+    return io_handler_->Submit(args);
+}
+
+bool Socket::ReceiveFromBatch(SocketDatagram * datagrams, size_t count,
+                              uint32_t timeout, size_t & received)
+{
+    received = 0;
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(datagrams == 0 || count == 0)
+        return false;
+
+    mmsghdr msgs[SocketBatchAsyncContext::kMaxDatagrams];
+    iovec iovs[SocketBatchAsyncContext::kMaxDatagrams];
+    while(received < count)
+    {
+        size_t chunk = count - received;
+        if(chunk > SocketBatchAsyncContext::kMaxDatagrams)
+            chunk = SocketBatchAsyncContext::kMaxDatagrams;
+        SocketRoutines::PrepareDatagrams(datagrams + received, chunk,
+                                         msgs, iovs, false);
+        int result = recvmmsg(s_, msgs, static_cast<unsigned int>(chunk),
+                              MSG_DONTWAIT, 0);
+        if(result > 0)
+        {
+            SocketRoutines::FinishDatagrams(datagrams + received, msgs,
+                                            result, false);
+            received += result;
+            //已经取空接收队列
+            if(static_cast<size_t>(result) < chunk)
+                return true;
+            continue;
+        }
+
+        if(result < 0 && errno == EINTR)
+            continue;
+
+        //只等待第一个数据报，之后只取已经到达的
+        if(received || (result < 0 && !SocketRoutines::IsWouldBlock()))
+            return received != 0;
+
+        if(!SocketRoutines::WaitFor(s_, POLLIN, timeout))
+            return false;
+    }
+    return true;
+}
+
+bool Socket::ReceiveFromBatchAsync(SocketBatchAsyncContext & args)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    if(args.datagram_count_ == 0)
+        return false;
+
+    args.PrepareRequest(AsyncRequestOp::kRequestRecvMMsg, s_);
+    SocketRoutines::PrepareDatagrams(args.datagrams_, args.datagram_count_,
+                                     args.msgs_, args.iovs_, false);
+    args.request_.mmsg = args.msgs_;
+    args.request_.vlen = static_cast<unsigned int>(args.datagram_count_);
+    args.segmented_ = false;
+    args.last_op_ = SocketAsyncOp::kAsyncRecvFromBatch;
+    return io_handler_->Submit(args);
+}
+
+bool Socket::SendToBatch(SocketDatagram * datagrams, size_t count,
+                         size_t & sent)
+{
+    sent = 0;
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(datagrams == 0 || count == 0)
+        return false;
+
+    mmsghdr msgs[SocketBatchAsyncContext::kMaxDatagrams];
+    iovec iovs[SocketBatchAsyncContext::kMaxDatagrams];
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(uint16_t))];
+    while(sent < count)
+    {
+        size_t chunk = count - sent;
+        if(chunk > SocketBatchAsyncContext::kMaxDatagrams)
+            chunk = SocketBatchAsyncContext::kMaxDatagrams;
+        SocketDatagram * first = datagrams + sent;
+        int result = 0;
+        bool segmented = SocketRoutines::PrepareSegmented(s_, first, chunk,
+                                                          msgs[0].msg_hdr,
+                                                          iovs, control);
+        if(segmented)
+        {
+            if(sendmsg(s_, &msgs[0].msg_hdr, MSG_NOSIGNAL) >= 0)
+            {
+                for(size_t index = 0; index < chunk; ++index)
+                    first[index].transfered = first[index].size;
+                result = static_cast<int>(chunk);
+            }
+            else if(SocketRoutines::OnSegmentFailed(errno))
+            {
+                segmented = false;
+            }
+            else
+            {
+                result = -1;
+            }
+        }
+
+        if(!segmented)
+        {
+            SocketRoutines::PrepareDatagrams(first, chunk, msgs, iovs, true);
+            result = sendmmsg(s_, msgs, static_cast<unsigned int>(chunk),
+                              MSG_NOSIGNAL);
+            if(result > 0)
+                SocketRoutines::FinishDatagrams(first, msgs, result, true);
+        }
+
+        if(result > 0)
+        {
+            sent += result;
+            continue;
+        }
+
+        if(result < 0 && errno == EINTR)
+            continue;
+
+        if(result < 0 && !SocketRoutines::IsWouldBlock())
+            return false;
+
+        if(!SocketRoutines::WaitFor(s_, POLLOUT, -1))
+            return false;
+    }
+    return true;
+}
+
+bool Socket::SendToBatchAsync(SocketBatchAsyncContext & args)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    if(args.datagram_count_ == 0)
+        return false;
+
+    args.PrepareRequest(AsyncRequestOp::kRequestSendMMsg, s_);
+    args.segmented_ = SocketRoutines::PrepareSegmented(s_, args.datagrams_,
+                                                       args.datagram_count_,
+                                                       args.request_.msg,
+                                                       args.iovs_,
+                                                       args.control_);
+    if(args.segmented_)
+    {
+        args.request_.op = AsyncRequestOp::kRequestSendMsg;
+    }
+    else
+    {
+        SocketRoutines::PrepareDatagrams(args.datagrams_, args.datagram_count_,
+                                         args.msgs_, args.iovs_, true);
+        args.request_.mmsg = args.msgs_;
+        args.request_.vlen = static_cast<unsigned int>(args.datagram_count_);
+    }
+    args.request_.flags = args.socket_flags_;
+    args.last_op_ = SocketAsyncOp::kAsyncSendToBatch;
+    return io_handler_->Submit(args);
+}
+
+bool Socket::CreatePair(SocketType type, Socket & first, Socket & second)
+{
+    if(first.s_ != kInvalidSocket || second.s_ != kInvalidSocket)
+        return false;
+
+    int fds[2];
+    if(socketpair(AF_UNIX, type | SOCK_CLOEXEC, 0, fds))
+        return false;
+
+    first.s_ = fds[0];
+    second.s_ = fds[1];
+    return true;
+}
+
+bool Socket::SendSocket(const Socket & socket, const void * data,
+                        uint32_t size_to_send, uint32_t & transfered)
+{
+    if(s_ == kInvalidSocket || socket.s_ == kInvalidSocket)
+        return false;
+
+    //只有控制信息的消息在流式套接字上不会送达，至少带一个字节
+    if(data == 0 || size_to_send == 0)
+        return false;
+
+    iovec iov;
+    iov.iov_base = const_cast<void *>(data);
+    iov.iov_len = size_to_send;
+
+    SocketRoutines::RightsControl control;
+    memset(&control, 0, sizeof(control));
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buffer;
+    msg.msg_controllen = sizeof(control.buffer);
+
+    cmsghdr * cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &socket.s_, sizeof(int));
+
+    while(true)
+    {
+        ssize_t result = sendmsg(s_, &msg, MSG_NOSIGNAL);
+        if(result >= 0)
+        {
+            transfered = static_cast<uint32_t>(result);
+            return true;
+        }
+
+        if(errno == EINTR)
+            continue;
+
+        if(!SocketRoutines::IsWouldBlock())
+            return false;
+
+        if(!SocketRoutines::WaitFor(s_, POLLOUT, -1))
+            return false;
+    }
+}
+
+bool Socket::ReceiveSocket(Socket & socket, void * data,
+                           uint32_t size_to_recv, uint32_t & transfered)
+{
+    if(s_ == kInvalidSocket || socket.s_ != kInvalidSocket)
+        return false;
+
+    if(data == 0 || size_to_recv == 0)
+        return false;
+
+    iovec iov;
+    iov.iov_base = data;
+    iov.iov_len = size_to_recv;
+
+    SocketRoutines::RightsControl control;
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buffer;
+    msg.msg_controllen = sizeof(control.buffer);
+
+    ssize_t result = 0;
+    while(true)
+    {
+        result = recvmsg(s_, &msg, MSG_CMSG_CLOEXEC);
+        if(result >= 0)
+            break;
+
+        if(errno == EINTR)
+            continue;
+
+        if(!SocketRoutines::IsWouldBlock())
+            return false;
+
+        if(!SocketRoutines::WaitFor(s_, POLLIN, -1))
+            return false;
+    }
+
+    //只接收一个套接字，对端一次附带多个时关闭其余的
+    for(cmsghdr * cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        if(cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+            continue;
+
+        size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for(size_t index = 0; index < count; ++index)
+        {
+            int fd = kInvalidSocket;
+            memcpy(&fd, CMSG_DATA(cmsg) + index * sizeof(int), sizeof(int));
+            if(socket.s_ == kInvalidSocket)
+                socket.s_ = fd;
+            else
+                close(fd);
+        }
+    }
+
+    transfered = static_cast<uint32_t>(result);
+    return true;
+}
+
+bool Socket::CanRead()
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    return SocketRoutines::WaitFor(s_, POLLIN, 0);
+}
+
+bool Socket::CanWrite()
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    return SocketRoutines::WaitFor(s_, POLLOUT, 0);
+}
+
+bool Socket::SetPacingRate(uint64_t rate)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    //~0U表示不限制；4.13之前的内核只读取32位，能用32位表示时按32位设置
+    if(rate == 0)
+        rate = 0xFFFFFFFFULL;
+
+    if(rate > 0xFFFFFFFFULL)
+    {
+        return setsockopt(s_, SOL_SOCKET, SO_MAX_PACING_RATE,
+                          &rate, sizeof(rate)) == 0;
+    }
+
+    uint32_t value = static_cast<uint32_t>(rate);
+    return setsockopt(s_, SOL_SOCKET, SO_MAX_PACING_RATE,
+                      &value, sizeof(value)) == 0;
+}
+
+bool Socket::IsValid()
+{
+    return s_ != kInvalidSocket;
+}
+
+bool Socket::Cancel()
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    return io_handler_->Cancel(*this);
+}
+
+bool Socket::Associate(Proactor & io)
+{
+    if(s_ == kInvalidSocket)
+        return false;
+
+    if(io.Associate(*this))
+    {
+        //前摄器把套接字切换为非阻塞模式
+        SocketRoutines::ResetSync(*this);
+        io_handler_ = &io;
+        return true;
+    }
+    return false;
+}
+
+void * Socket::GetPlatformHandle()
+{
+    return reinterpret_cast<void *>(static_cast<intptr_t>(s_));
+}
+
+void Socket::OnCompleted(AsyncContext & args,
+                         uint32_t error,
+                         uint32_t transfered)
+{
+    auto & sock_args = static_cast<SocketAsyncContext&>(args);
+    auto & req = sock_args.request_;
+    switch(sock_args.last_op())
+    {
+    case SocketAsyncOp::kAsyncAccept:
+        {
+            sock_args.remote_endpoint_.ep_size_ = req.addr_size;
+            if(error == 0)
+            {
+                //接管accept得到的套接字，并沿用accept_socket的前摄器
+                Socket & accept_socket = *sock_args.accept_socket_;
+                accept_socket.Close();
+                accept_socket.s_ = req.accepted;
+                req.accepted = kInvalidSocket;
+                if(accept_socket.io_handler_)
+                    accept_socket.Associate(*accept_socket.io_handler_);
+            }
+        }
+        break;
+    case SocketAsyncOp::kAsyncRecvFrom:
+        {
+            sock_args.remote_endpoint_.ep_size_ = req.msg.msg_namelen;
+            sock_args.socket_flags_ = req.msg.msg_flags;
+        }
+        break;
+    case SocketAsyncOp::kAsyncRecv:
+        {
+            sock_args.socket_flags_ = req.msg.msg_flags;
+        }
+        break;
+    case SocketAsyncOp::kAsyncRecvPooled:
+        {
+            //缓冲区交给回调，由回调归还
+            sock_args.buffer_ = req.pooled;
+            sock_args.count_ = req.pooled ? req.iov.iov_len : 0;
+            req.pooled = 0;
+        }
+        break;
+    case SocketAsyncOp::kAsyncDisconnect:
+        {
+            if(sock_args.reuse())
+                Close();
+        }
+        break;
+    case SocketAsyncOp::kAsyncRecvFromBatch:
+    case SocketAsyncOp::kAsyncSendToBatch:
+        {
+            //transfered改为完成的数据报个数
+            auto & batch = static_cast<SocketBatchAsyncContext&>(args);
+            bool send = batch.last_op() == SocketAsyncOp::kAsyncSendToBatch;
+            if(batch.segmented_)
+            {
+                if(error == 0)
+                {
+                    for(size_t index = 0; index < batch.datagram_count_; ++index)
+                        batch.datagrams_[index].transfered = batch.datagrams_[index].size;
+                    transfered = static_cast<uint32_t>(batch.datagram_count_);
+                }
+                else if(SocketRoutines::OnSegmentFailed(error))
+                {
+                    //改用sendmmsg重新投递，投递失败时以原来的错误完成
+                    batch.segmented_ = false;
+                    batch.PrepareRequest(AsyncRequestOp::kRequestSendMMsg, s_);
+                    SocketRoutines::PrepareDatagrams(batch.datagrams_,
+                                                     batch.datagram_count_,
+                                                     batch.msgs_, batch.iovs_,
+                                                     true);
+                    batch.request_.mmsg = batch.msgs_;
+                    batch.request_.vlen = static_cast<unsigned int>(batch.datagram_count_);
+                    batch.request_.flags = batch.socket_flags_;
+                    if(io_handler_ && io_handler_->Submit(batch))
+                        return;
+                }
+            }
+            else if(error == 0)
+            {
+                SocketRoutines::FinishDatagrams(batch.datagrams_, batch.msgs_,
+                                                transfered, send);
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    sock_args.OnCompleted(error, transfered);
+}
+
+uint32_t Socket::GetStatsOp(AsyncContext & args)
+{
+    return static_cast<SocketAsyncContext&>(args).last_op();
+}
+
+
+}
@@ -0,0 +1,292 @@
+﻿#include "proactor.h"
+#include "proactor_group.h"
+#include "socket_listener.h"
+#include "thread.h"
+
+namespace ncore
+{
+
+
+#if defined NCORE_WINDOWS
+static uint32_t GetSocketError()
+{
+    return WSAGetLastError();
+}
+
+static bool IsResourceExhausted(uint32_t error)
+{
+    return error == WSAEMFILE || error == WSAENOBUFS;
+}
+#elif defined NCORE_LINUX
+static uint32_t GetSocketError()
+{
+    return errno;
+}
+
+static bool IsResourceExhausted(uint32_t error)
+{
+    return error == EMFILE || error == ENFILE ||
+           error == ENOBUFS || error == ENOMEM;
+}
+#endif
+
+
+SocketAcceptContext::SocketAcceptContext()
+    : listener_(0), shard_(0), error_(0)
+{
+    memset(address_buffer_, 0, sizeof(address_buffer_));
+    adapter_.Register(this, &SocketAcceptContext::OnAccepted);
+    deliver_task_.Register(this, &SocketAcceptContext::OnDelivered);
+    backoff_timer_.Register(this, &SocketAcceptContext::OnBackoff);
+    args_.set_completion_delegate(&adapter_);
+}
+
+Socket & SocketAcceptContext::accepted_socket()
+{
+    return socket_;
+}
+
+Proactor & SocketAcceptContext::proactor() const
+{
+    return *listener_->shards_[shard_]->proactor;
+}
+
+size_t SocketAcceptContext::shard() const
+{
+    return shard_;
+}
+
+IPEndPoint SocketAcceptContext::remote_endpoint() const
+{
+    return args_.remote_endpoint();
+}
+
+uint32_t SocketAcceptContext::error() const
+{
+    return error_;
+}
+
+SocketListener & SocketAcceptContext::listener() const
+{
+    return *listener_;
+}
+
+void SocketAcceptContext::OnAccepted(SocketAsyncContext & args)
+{
+    error_ = args.error();
+    listener_->OnAccepted(*this);
+}
+
+void SocketAcceptContext::OnDelivered()
+{
+    listener_->Deliver(*this);
+}
+
+void SocketAcceptContext::OnBackoff()
+{
+    error_ = 0;
+    listener_->Resubmit(*this);
+}
+
+
+SocketListener::Shard::Shard()
+    : proactor(0), stopping(false)
+{
+    pending = 0;
+    accepted = 0;
+}
+
+
+SocketListener::SocketListener()
+    : family_(AddressFamily::kUnspecificAddressFamily), started_(false)
+{
+}
+
+SocketListener::~SocketListener()
+{
+    fini();
+}
+
+bool SocketListener::init(ProactorGroup & group, const IPEndPoint & endpoint,
+                          size_t accepts_per_shard, int backlog)
+{
+    if(!shards_.empty() || group.size() == 0)
+        return false;
+
+    if(accepts_per_shard == 0 || endpoint.Port() == 0)
+        return false;
+
+    family_ = endpoint.AddressFamily();
+    for(size_t index = 0; index < group.size(); ++index)
+    {
+        Shard * shard = new Shard;
+        shard->proactor = &group.proactor(index);
+        shards_.push_back(shard);
+
+        for(size_t count = 0; count < accepts_per_shard; ++count)
+        {
+            SocketAcceptContext * context = new SocketAcceptContext;
+            context->listener_ = this;
+            context->shard_ = index;
+            shard->contexts.push_back(context);
+        }
+
+        if(!Listen(*shard, index, endpoint, backlog))
+        {
+            Clear();
+            return false;
+        }
+    }
+
+    started_ = false;
+    return true;
+}
+
+void SocketListener::fini()
+{
+    if(shards_.empty())
+        return;
+
+    //先禁止再次投递，再取消在途的请求
+    for(size_t index = 0; index < shards_.size(); ++index)
+    {
+        Shard & shard = *shards_[index];
+        shard.lock.Acquire();
+        shard.stopping = true;
+        shard.lock.Release();
+    }
+    Cancel();
+
+    //推迟投递的请求没有在途的accept，停止定时器即可；已经到期的由定时器自己结束
+    for(size_t index = 0; index < shards_.size(); ++index)
+    {
+        Shard & shard = *shards_[index];
+        for(size_t count = 0; count < shard.contexts.size(); ++count)
+        {
+            if(shard.proactor->CancelTimer(shard.contexts[count]->backoff_timer_))
+                --shard.pending;
+        }
+    }
+
+    //被取消的请求在各自的I/O线程上完成
+    for(size_t index = 0; index < shards_.size(); ++index)
+    {
+        while(shards_[index]->pending != 0)
+            Thread::Sleep(1, false);
+    }
+
+    Clear();
+    started_ = false;
+}
+
+bool SocketListener::Start()
+{
+    if(shards_.empty() || started_)
+        return false;
+
+    started_ = true;
+    bool succeed = true;
+    for(size_t index = 0; index < shards_.size(); ++index)
+    {
+        Shard & shard = *shards_[index];
+        for(size_t count = 0; count < shard.contexts.size(); ++count)
+        {
+            if(!Submit(*shard.contexts[count]))
+                succeed = false;
+        }
+    }
+    return succeed;
+}
+
+size_t SocketListener::shard_count() const
+{
+    return shards_.size();
+}
+
+size_t SocketListener::accepted(size_t shard) const
+{
+    if(shard >= shards_.size())
+        return 0;
+
+    return static_cast<size_t>(static_cast<int>(shards_[shard]->accepted));
+}
+
+void SocketListener::set_completion_delegate(SocketAcceptResultHandler * handler)
+{
+    completion_delegate_ = handler;
+}
+
+bool SocketListener::Submit(SocketAcceptContext & context)
+{
+    Shard & shard = *shards_[context.shard_];
+    shard.lock.Acquire();
+    bool submitted = !shard.stopping;
+    if(submitted)
+    {
+        ++shard.pending;
+        submitted = PostAccept(context);
+        if(!submitted)
+            --shard.pending;
+    }
+    shard.lock.Release();
+    return submitted;
+}
+
+void SocketListener::Deliver(SocketAcceptContext & context)
+{
+    Shard & shard = *shards_[context.shard_];
+    if(context.error_ == 0)
+    {
+        ++shard.accepted;
+        completion_delegate_(context);
+    }
+    else if(!shard.stopping)
+    {
+        completion_delegate_(context);
+    }
+
+    //回调没有取走的连接在此关闭
+    context.socket_.Close();
+    Resubmit(context);
+}
+
+void SocketListener::Resubmit(SocketAcceptContext & context)
+{
+    //句柄或者内存耗尽时立即再次投递的accept会马上失败，在I/O线程上空转；
+    //Windows下预先创建接受套接字，耗尽时投递本身失败
+    Shard & shard = *shards_[context.shard_];
+    bool exhausted = IsResourceExhausted(context.error_);
+    if(!exhausted && !Submit(context))
+        exhausted = IsResourceExhausted(GetSocketError());
+
+    if(exhausted)
+    {
+        //与fini互斥，停止之后不再启动定时器
+        shard.lock.Acquire();
+        bool backoff = !shard.stopping;
+        if(backoff)
+            shard.proactor->SetTimer(context.backoff_timer_, kAcceptBackoff);
+        shard.lock.Release();
+        if(backoff)
+            return;
+    }
+
+    //先投递下一个请求，fini看到pending为0时不会再有新的请求
+    --shard.pending;
+}
+
+void SocketListener::Clear()
+{
+    for(size_t index = 0; index < shards_.size(); ++index)
+    {
+        Shard * shard = shards_[index];
+        for(size_t count = 0; count < shard->contexts.size(); ++count)
+            delete shard->contexts[count];
+        shard->socket.Close();
+        delete shard;
+    }
+    shards_.clear();
+}
+
+
+}
@@ -0,0 +1,161 @@
+﻿#ifndef NCORE_SYS_SOCKET_LISTENER_H_
+#define NCORE_SYS_SOCKET_LISTENER_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include <ncore/base/atomic.h>
+#include <ncore/utils/async_result_delegate.h>
+#include <ncore/utils/async_result_adapter.h>
+#include "async_task.h"
+#include "ip_endpoint.h"
+#include "socket.h"
+#include "socket_async_event_args.h"
+#include "spin_lock.h"
+#include "timing_wheel.h"
+
+namespace ncore
+{
+
+
+class Proactor;
+class ProactorGroup;
+class SocketListener;
+
+/*! 接受连接的上下文\n
+每个分片预先投递若干个，接受完成后在所属分片的I/O线程上回调，回调返回后自动再次投递。\n
+*/
+class SocketAcceptContext
+{
+public:
+    SocketAcceptContext();
+
+    /*! 接受到的连接
+    @remark 已关联到所属分片的前摄器。需要保留时在回调中以移动构造取走，否则回调返回后关闭。\n
+    */
+    Socket & accepted_socket();
+
+    //所属分片的前摄器，接受到的连接的回调都在它的线程上执行
+    Proactor & proactor() const;
+
+    size_t shard() const;
+    IPEndPoint remote_endpoint() const;
+    uint32_t error() const;
+    SocketListener & listener() const;
+
+private:
+    void OnAccepted(SocketAsyncContext & args);
+    void OnDelivered();
+    void OnBackoff();
+
+private:
+    SocketListener * listener_;
+    size_t shard_;
+    uint32_t error_;
+    Socket socket_;
+    SocketAsyncContext args_;
+    SocketAsyncResultAdapter<SocketAcceptContext> adapter_;
+    AsyncTaskAdapter<SocketAcceptContext> deliver_task_;
+    AsyncTimerAdapter<SocketAcceptContext> backoff_timer_;
+    char address_buffer_[64];       //AcceptEx的地址缓冲区，不接收数据
+
+    friend class SocketListener;
+};
+
+typedef AsyncResultDelegate<SocketAcceptContext> SocketAcceptResultDelegate;
+typedef AsyncResultHandler<SocketAcceptContext>  SocketAcceptResultHandler;
+
+template <typename Adaptee>
+using SocketAcceptResultAdapter = AsyncResultAdapter<Adaptee, SocketAcceptContext>;
+
+/*! 分片的监听器\n
+ProactorGroup的每个I/O线程是一个分片，各自保持若干个预先投递的接受请求，
+接受到的连接关联到该分片的前摄器，并在该线程上回调，建立连接的过程不跨线程。\n
+Linux下每个分片有自己的监听套接字（SO_REUSEPORT），由内核把新连接分散到各个分片；
+Windows下没有这样的分流，所有分片共用一个监听套接字，
+AcceptEx的接受套接字预先关联到所属分片，完成后把回调投递到该分片的线程。\n
+*/
+class SocketListener : public NonCopyableObject
+{
+public:
+    static const size_t kDefaultAcceptsPerShard = 16;
+    static const int kDefaultBacklog = 1024;
+    //句柄或者内存耗尽时推迟再次投递的毫秒数
+    static const uint32_t kAcceptBackoff = 50;
+
+public:
+    SocketListener();
+    ~SocketListener();
+
+    /*! 初始化，创建并绑定各分片的监听套接字
+    @param[in] group                I/O线程组，每个线程一个分片，必须已经初始化。
+    @param[in] endpoint             监听的地址，端口不能为0。
+    @param[in] accepts_per_shard    每个分片预先投递的接受请求数。
+    @param[in] backlog              每个监听套接字的等待队列长度。
+    @return 初始化成功后返回true；否则返回false。
+    */
+    bool init(ProactorGroup & group, const IPEndPoint & endpoint,
+              size_t accepts_per_shard = kDefaultAcceptsPerShard,
+              int backlog = kDefaultBacklog);
+
+    //停止接受并等待投递的请求全部完成，不能在完成回调中调用
+    void fini();
+
+    /*! 投递各分片的接受请求
+    @return 未初始化、已经开始或者投递失败时返回false。
+    @remark 在此之前设置完成回调，之后每接受到一个连接回调一次。\n
+    */
+    bool Start();
+
+    size_t shard_count() const;
+
+    //分片接受到的连接数
+    size_t accepted(size_t shard) const;
+
+    void set_completion_delegate(SocketAcceptResultHandler * handler);
+
+private:
+    //各分片的状态互不共享，接受连接时不在线程间争用
+    struct Shard
+    {
+        Proactor * proactor;
+        Socket socket;              //Windows下只有第0个分片的有效
+        std::vector<SocketAcceptContext *> contexts;
+        SpinLock lock;
+        bool stopping;
+        Atomic pending;             //已投递尚未回调的接受请求数
+        Atomic accepted;
+
+        Shard();
+    };
+
+    //投递一个接受请求，停止之后返回false
+    bool Submit(SocketAcceptContext & context);
+
+    //在所属分片的线程上回调并再次投递
+    void Deliver(SocketAcceptContext & context);
+
+    //再次投递，资源耗尽时改由定时器推迟投递，推迟期间仍然计入pending
+    void Resubmit(SocketAcceptContext & context);
+
+    void Clear();
+
+    //平台相关的部分
+    bool Listen(Shard & shard, size_t index, const IPEndPoint & endpoint,
+                int backlog);
+    bool PostAccept(SocketAcceptContext & context);
+    void OnAccepted(SocketAcceptContext & context);
+    void Cancel();
+
+private:
+    std::vector<Shard *> shards_;
+    AddressFamily family_;
+    bool started_;
+    SocketAcceptResultDelegate completion_delegate_;
+
+    friend class SocketAcceptContext;
+};
+
+
+}
+
+#endif
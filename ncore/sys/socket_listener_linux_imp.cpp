@@ -0,0 +1,51 @@
+﻿#include "proactor.h"
+#include "socket_listener.h"
+
+namespace ncore
+{
+
+
+bool SocketListener::Listen(Shard & shard, size_t, const IPEndPoint & endpoint,
+                            int backlog)
+{
+    Socket & socket = shard.socket;
+    if(!socket.init(endpoint.AddressFamily(), SocketType::kStream,
+                    ProtocolType::kTCP))
+        return false;
+
+    //每个分片一个监听套接字，内核按连接的四元组分散到各个分片
+    int on = 1;
+    if(setsockopt(socket.s_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) ||
+       setsockopt(socket.s_, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)))
+        return false;
+
+    if(!socket.Bind(endpoint) || !socket.Listen(backlog))
+        return false;
+
+    return socket.Associate(*shard.proactor);
+}
+
+bool SocketListener::PostAccept(SocketAcceptContext & context)
+{
+    Shard & shard = *shards_[context.shard_];
+
+    //accept完成时新套接字沿用accept_socket的前摄器
+    context.socket_.io_handler_ = shard.proactor;
+    context.args_.set_accept_socket(context.socket_);
+    return shard.socket.AcceptAsync(context.args_);
+}
+
+void SocketListener::OnAccepted(SocketAcceptContext & context)
+{
+    //监听套接字关联在所属分片上，完成已经在该线程
+    Deliver(context);
+}
+
+void SocketListener::Cancel()
+{
+    for(size_t index = 0; index < shards_.size(); ++index)
+        shards_[index]->socket.Cancel();
+}
+
+
+}
@@ -0,0 +1,71 @@
+﻿#include "proactor.h"
+#include "socket_listener.h"
+
+namespace ncore
+{
+
+
+//与Socket::AcceptAsync要求的最小缓冲区相同，只容纳两端的地址，不接收数据
+static const size_t kAcceptBufferSize = (sizeof(sockaddr_in) + 16) * 2;
+
+bool SocketListener::Listen(Shard & shard, size_t index,
+                            const IPEndPoint & endpoint, int backlog)
+{
+    //没有SO_REUSEPORT的分流，只在第0个分片上监听
+    if(index != 0)
+        return true;
+
+    Socket & socket = shard.socket;
+    if(!socket.init(endpoint.AddressFamily(), SocketType::kStream,
+                    ProtocolType::kTCP))
+        return false;
+
+    if(!socket.Bind(endpoint) || !socket.Listen(backlog))
+        return false;
+
+    return socket.Associate(*shard.proactor);
+}
+
+bool SocketListener::PostAccept(SocketAcceptContext & context)
+{
+    static_assert(sizeof(context.address_buffer_) >= kAcceptBufferSize,
+                  "address buffer is too small");
+
+    Shard & shard = *shards_[context.shard_];
+    Socket & socket = context.socket_;
+    if(!socket.init(family_, SocketType::kStream, ProtocolType::kTCP))
+        return false;
+
+    //接受套接字预先关联到所属分片，之后的请求都在该分片的线程上完成
+    if(!socket.Associate(*shard.proactor))
+    {
+        socket.Close();
+        return false;
+    }
+
+    context.args_.SetBuffer(context.address_buffer_, kAcceptBufferSize);
+    context.args_.set_accept_socket(socket);
+    if(!shards_[0]->socket.AcceptAsync(context.args_))
+    {
+        socket.Close();
+        return false;
+    }
+    return true;
+}
+
+void SocketListener::OnAccepted(SocketAcceptContext & context)
+{
+    //AcceptEx在监听套接字所在的线程完成，转到所属分片的线程回调
+    Shard & shard = *shards_[context.shard_];
+    if(!shard.proactor->Post(context.deliver_task_))
+        Deliver(context);
+}
+
+void SocketListener::Cancel()
+{
+    //CancelIo只取消本线程发起的请求，关闭监听套接字以取消所有分片的AcceptEx
+    shards_[0]->socket.Close();
+}
+
+
+}
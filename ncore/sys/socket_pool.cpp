@@ -0,0 +1,482 @@
+﻿#include "proactor.h"
+#include "socket_pool.h"
+#include "sys_info.h"
+#include "thread.h"
+
+namespace ncore
+{
+
+
+#if defined NCORE_WINDOWS
+static const uint32_t kCanceledError = ERROR_OPERATION_ABORTED;
+
+static uint32_t GetSocketError()
+{
+    return WSAGetLastError();
+}
+#elif defined NCORE_LINUX
+static const uint32_t kCanceledError = ECANCELED;
+
+static uint32_t GetSocketError()
+{
+    return errno;
+}
+#endif
+
+
+PooledSocket::PooledSocket(const IPEndPoint & endpoint)
+    : endpoint_(endpoint), idle_since_(0), reused_(false)
+{
+}
+
+Socket & PooledSocket::socket()
+{
+    return socket_;
+}
+
+const IPEndPoint & PooledSocket::endpoint() const
+{
+    return endpoint_;
+}
+
+bool PooledSocket::reused() const
+{
+    return reused_;
+}
+
+
+const PooledSocketHandle::Type PooledSocketHandle::kInvalidHandle = 0;
+
+bool PooledSocketHandle::Free(Type handle)
+{
+    handle->socket_.fini();
+    delete handle;
+    return true;
+}
+
+
+SocketPoolRequest::SocketPoolRequest()
+    : pool_(0), connection_(0), error_(0), next_(0)
+{
+    connect_adapter_.Register(this, &SocketPoolRequest::OnConnected);
+    deliver_task_.Register(this, &SocketPoolRequest::OnDelivered);
+    args_.set_completion_delegate(&connect_adapter_);
+}
+
+PooledSocket * SocketPoolRequest::connection() const
+{
+    return connection_;
+}
+
+uint32_t SocketPoolRequest::error() const
+{
+    return error_;
+}
+
+const IPEndPoint & SocketPoolRequest::endpoint() const
+{
+    return endpoint_;
+}
+
+void SocketPoolRequest::set_connect_timeout(uint32_t ms)
+{
+    args_.set_timeout(ms);
+}
+
+void SocketPoolRequest::set_completion_delegate(SocketPoolResultHandler * handler)
+{
+    completion_delegate_ = handler;
+}
+
+void SocketPoolRequest::OnConnected(SocketAsyncContext & /*args*/)
+{
+    pool_->OnDialed(*this);
+}
+
+void SocketPoolRequest::OnDelivered()
+{
+    //回调中可能再次提交本请求
+    SocketPool * pool = pool_;
+    completion_delegate_(*this);
+    --pool->pending_;
+}
+
+
+SocketPool::Endpoint::Endpoint(const IPEndPoint & ep, size_t capacity)
+    : endpoint(ep), idle(capacity), connections(0),
+      waiters_head(0), waiters_tail(0)
+{
+}
+
+
+SocketPool::SocketPool()
+    : proactor_(0), max_per_endpoint_(0), idle_timeout_(0), stopping_(false)
+{
+    pending_ = 0;
+    evict_timer_.Register(this, &SocketPool::OnEvictTimer);
+}
+
+SocketPool::~SocketPool()
+{
+    fini();
+}
+
+bool SocketPool::init(Proactor & proactor, size_t max_per_endpoint,
+                      uint32_t idle_timeout)
+{
+    if(proactor_ != 0 || max_per_endpoint == 0)
+        return false;
+
+    proactor_ = &proactor;
+    max_per_endpoint_ = max_per_endpoint;
+    idle_timeout_ = idle_timeout;
+    stopping_ = false;
+
+    //每半个超时周期检查一次，空闲连接最多多保留半个周期
+    if(idle_timeout_)
+        proactor_->SetTimer(evict_timer_, idle_timeout_ / 2 + 1);
+    return true;
+}
+
+void SocketPool::fini()
+{
+    if(proactor_ == 0)
+        return;
+
+    //先禁止新的请求，再取出所有等待的请求
+    std::vector<SocketPoolRequest *> waiters;
+    lock_.Acquire();
+    stopping_ = true;
+    for(size_t index = 0; index < endpoints_.size(); ++index)
+    {
+        Endpoint & entry = *endpoints_[index];
+        for(SocketPoolRequest * waiter = PopWaiter(entry); waiter != 0;
+            waiter = PopWaiter(entry))
+        {
+            waiters.push_back(waiter);
+        }
+    }
+    lock_.Release();
+
+    //定时器在自己的回调中重新启动，停止时可能正在到期
+    if(!proactor_->CancelTimer(evict_timer_))
+    {
+        while(evict_timer_.firing())
+            Thread::Sleep(0, false);
+    }
+
+    //没有其他线程执行前摄器时投递的回调不会执行，等待的请求直接在本线程回调
+    for(size_t index = 0; index < waiters.size(); ++index)
+    {
+        SocketPoolRequest & waiter = *waiters[index];
+        waiter.connection_ = 0;
+        waiter.error_ = kCanceledError;
+        waiter.OnDelivered();
+    }
+
+    //正在建立的连接和已经投递的回调由前摄器完成，本线程也执行它，不依赖其他线程
+    while(pending_ != 0)
+        proactor_->Run(1);
+
+    for(size_t index = 0; index < endpoints_.size(); ++index)
+    {
+        Endpoint * entry = endpoints_[index];
+        assert(entry->connections == entry->idle.size());
+        entry->idle.Clear();
+        delete entry;
+    }
+    endpoints_.clear();
+    proactor_ = 0;
+}
+
+bool SocketPool::CheckoutAsync(SocketPoolRequest & request,
+                               const IPEndPoint & endpoint)
+{
+    lock_.Acquire();
+    if(proactor_ == 0 || stopping_)
+    {
+        lock_.Release();
+        return false;
+    }
+    Endpoint * entry = FindEndpoint(endpoint, true);
+    ++pending_;
+    lock_.Release();
+
+    request.pool_ = this;
+    request.endpoint_ = endpoint;
+    request.connection_ = 0;
+    request.error_ = 0;
+    request.next_ = 0;
+
+    for(;;)
+    {
+        PooledSocket * connection = TakeIdle(*entry);
+        if(connection)
+        {
+            connection->reused_ = true;
+            Deliver(request, connection, 0);
+            return true;
+        }
+
+        //空闲连接在锁内放回，锁内仍为空时才能排队，否则再取一次
+        lock_.Acquire();
+        if(entry->idle.size())
+        {
+            lock_.Release();
+            continue;
+        }
+
+        //fini已经取走了等待的请求，之后不能再排队
+        if(stopping_)
+        {
+            lock_.Release();
+            Deliver(request, 0, kCanceledError);
+            return true;
+        }
+
+        bool dial = entry->connections < max_per_endpoint_;
+        if(dial)
+        {
+            ++entry->connections;
+        }
+        else if(entry->waiters_tail)
+        {
+            entry->waiters_tail->next_ = &request;
+            entry->waiters_tail = &request;
+        }
+        else
+        {
+            entry->waiters_head = &request;
+            entry->waiters_tail = &request;
+        }
+        lock_.Release();
+
+        if(dial)
+            Dial(*entry, request);
+        return true;
+    }
+}
+
+void SocketPool::Release(PooledSocket * connection, bool reusable)
+{
+    if(connection == 0)
+        return;
+
+    lock_.Acquire();
+    Endpoint * entry = FindEndpoint(connection->endpoint_, false);
+    assert(entry != 0);
+    if(!reusable || stopping_)
+    {
+        lock_.Release();
+        Discard(*entry, connection);
+        return;
+    }
+
+    SocketPoolRequest * waiter = PopWaiter(*entry);
+    if(waiter == 0)
+    {
+        connection->idle_since_ = SysInfo::TickCount64();
+        entry->idle.Put(connection);
+    }
+    lock_.Release();
+
+    if(waiter)
+    {
+        connection->reused_ = true;
+        Deliver(*waiter, connection, 0);
+    }
+}
+
+size_t SocketPool::Evict()
+{
+    if(idle_timeout_ == 0)
+        return 0;
+
+    //Endpoint在fini之前不会被删除，复制之后在锁外关闭连接
+    lock_.Acquire();
+    std::vector<Endpoint *> endpoints(endpoints_);
+    lock_.Release();
+
+    uint64_t now = SysInfo::TickCount64();
+    size_t evicted = 0;
+    for(size_t index = 0; index < endpoints.size(); ++index)
+    {
+        Endpoint & entry = *endpoints[index];
+        size_t count = entry.idle.RemoveIf([this, now](PooledSocket * connection) {
+            return IsExpired(connection, now);
+        });
+        if(count == 0)
+            continue;
+
+        //连接在锁外取出，取连接的请求可能在这期间看到没有空闲连接而排队，
+        //让出的名额和Discard一样转交给等待的请求
+        std::vector<SocketPoolRequest *> waiters;
+        lock_.Acquire();
+        entry.connections -= count;
+        for(size_t granted = 0; granted < count; ++granted)
+        {
+            SocketPoolRequest * waiter = PopWaiter(entry);
+            if(waiter == 0)
+                break;
+            ++entry.connections;
+            waiters.push_back(waiter);
+        }
+        lock_.Release();
+
+        for(size_t granted = 0; granted < waiters.size(); ++granted)
+            Dial(entry, *waiters[granted]);
+        evicted += count;
+    }
+    return evicted;
+}
+
+size_t SocketPool::idle_count() const
+{
+    size_t count = 0;
+    lock_.Acquire();
+    for(size_t index = 0; index < endpoints_.size(); ++index)
+        count += endpoints_[index]->idle.size();
+    lock_.Release();
+    return count;
+}
+
+size_t SocketPool::connection_count() const
+{
+    size_t count = 0;
+    lock_.Acquire();
+    for(size_t index = 0; index < endpoints_.size(); ++index)
+        count += endpoints_[index]->connections;
+    lock_.Release();
+    return count;
+}
+
+SocketPool::Endpoint * SocketPool::FindEndpoint(const IPEndPoint & endpoint,
+                                                bool create)
+{
+    for(size_t index = 0; index < endpoints_.size(); ++index)
+    {
+        if(endpoints_[index]->endpoint == endpoint)
+            return endpoints_[index];
+    }
+
+    if(!create)
+        return 0;
+
+    Endpoint * entry = new Endpoint(endpoint, max_per_endpoint_);
+    endpoints_.push_back(entry);
+    return entry;
+}
+
+SocketPoolRequest * SocketPool::PopWaiter(Endpoint & entry)
+{
+    SocketPoolRequest * waiter = entry.waiters_head;
+    if(waiter)
+    {
+        entry.waiters_head = waiter->next_;
+        if(entry.waiters_head == 0)
+            entry.waiters_tail = 0;
+        waiter->next_ = 0;
+    }
+    return waiter;
+}
+
+PooledSocket * SocketPool::TakeIdle(Endpoint & entry)
+{
+    for(;;)
+    {
+        PooledSocket * connection = entry.idle.Get();
+        if(connection == 0)
+            return 0;
+
+        //空闲的连接上不应该有数据，可读说明对端已经关闭
+        if(IsExpired(connection, SysInfo::TickCount64()) ||
+           connection->socket_.CanRead())
+        {
+            Discard(entry, connection);
+            continue;
+        }
+        return connection;
+    }
+}
+
+void SocketPool::Dial(Endpoint & entry, SocketPoolRequest & request)
+{
+    PooledSocket * connection = new PooledSocket(request.endpoint_);
+    Socket & socket = connection->socket_;
+    request.connection_ = connection;
+    request.args_.set_remote_endpoint(request.endpoint_);
+
+    bool started = socket.init(request.endpoint_.AddressFamily(),
+                               SocketType::kStream,
+                               ProtocolType::kTCP) &&
+                   socket.Associate(*proactor_) &&
+                   socket.ConnectAsync(request.args_);
+    if(started)
+        return;
+
+    uint32_t error = GetSocketError();
+    Deliver(request, 0, error ? error : kCanceledError);
+    Discard(entry, connection);
+}
+
+void SocketPool::OnDialed(SocketPoolRequest & request)
+{
+    PooledSocket * connection = request.connection_;
+    request.error_ = request.args_.error();
+    if(request.error_)
+    {
+        request.connection_ = 0;
+        lock_.Acquire();
+        Endpoint * entry = FindEndpoint(connection->endpoint_, false);
+        lock_.Release();
+        Discard(*entry, connection);
+    }
+
+    //已经在前摄器线程上，直接回调
+    request.OnDelivered();
+}
+
+void SocketPool::Deliver(SocketPoolRequest & request, PooledSocket * connection,
+                         uint32_t error)
+{
+    request.connection_ = connection;
+    request.error_ = error;
+    if(!proactor_->Post(request.deliver_task_))
+        request.OnDelivered();
+}
+
+void SocketPool::Discard(Endpoint & entry, PooledSocket * connection)
+{
+    PooledSocketHandle::Free(connection);
+
+    lock_.Acquire();
+    --entry.connections;
+    SocketPoolRequest * waiter = PopWaiter(entry);
+    if(waiter)
+        ++entry.connections;
+    lock_.Release();
+
+    if(waiter)
+        Dial(entry, *waiter);
+}
+
+bool SocketPool::IsExpired(const PooledSocket * connection, uint64_t now) const
+{
+    if(idle_timeout_ == 0)
+        return false;
+
+    return now - connection->idle_since_ >= idle_timeout_;
+}
+
+void SocketPool::OnEvictTimer()
+{
+    Evict();
+
+    lock_.Acquire();
+    if(!stopping_)
+        proactor_->SetTimer(evict_timer_, idle_timeout_ / 2 + 1);
+    lock_.Release();
+}
+
+
+}
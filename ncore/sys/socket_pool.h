@@ -0,0 +1,208 @@
+﻿#ifndef NCORE_SYS_SOCKET_POOL_H_
+#define NCORE_SYS_SOCKET_POOL_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include <ncore/base/atomic.h>
+#include <ncore/utils/async_result_delegate.h>
+#include <ncore/utils/async_result_adapter.h>
+#include <ncore/utils/handle_pool.h>
+#include "async_task.h"
+#include "ip_endpoint.h"
+#include "socket.h"
+#include "socket_async_event_args.h"
+#include "spin_lock.h"
+#include "timing_wheel.h"
+
+namespace ncore
+{
+
+
+class Proactor;
+class SocketPool;
+
+//连接池中的一个连接，由SocketPool创建和销毁
+class PooledSocket : public NonCopyableObject
+{
+public:
+    //已连接并关联到连接池的前摄器
+    Socket & socket();
+
+    const IPEndPoint & endpoint() const;
+
+    //是否是复用的空闲连接，新建立的连接为false
+    bool reused() const;
+
+private:
+    PooledSocket(const IPEndPoint & endpoint);
+
+private:
+    Socket socket_;
+    IPEndPoint endpoint_;
+    uint64_t idle_since_;           //放回池中的时间，毫秒
+    bool reused_;
+
+    friend class SocketPool;
+    friend class PooledSocketHandle;
+};
+
+//HandlePool使用的句柄约定，释放时关闭并销毁连接
+class PooledSocketHandle
+{
+public:
+    typedef PooledSocket * Type;
+    static const Type kInvalidHandle;
+    static bool Free(Type handle);
+};
+
+/*! 从连接池取得连接的请求\n
+完成时在连接池的前摄器线程上回调，成功时通过connection()取得连接，用完后调用SocketPool::Release。\n
+同一个请求在回调之前不能再次提交。\n
+*/
+class SocketPoolRequest
+{
+public:
+    SocketPoolRequest();
+
+    //成功时为取得的连接，失败时为0
+    PooledSocket * connection() const;
+
+    uint32_t error() const;
+    const IPEndPoint & endpoint() const;
+
+    //新建连接的超时时间，毫秒，为0时不超时
+    void set_connect_timeout(uint32_t ms);
+
+    void set_completion_delegate(AsyncResultHandler<SocketPoolRequest> * handler);
+
+private:
+    void OnConnected(SocketAsyncContext & args);
+    void OnDelivered();
+
+private:
+    SocketPool * pool_;
+    IPEndPoint endpoint_;
+    PooledSocket * connection_;
+    uint32_t error_;
+    SocketPoolRequest * next_;      //等待队列
+    SocketAsyncContext args_;
+    SocketAsyncResultAdapter<SocketPoolRequest> connect_adapter_;
+    AsyncTaskAdapter<SocketPoolRequest> deliver_task_;
+    AsyncResultDelegate<SocketPoolRequest> completion_delegate_;
+
+    friend class SocketPool;
+};
+
+typedef AsyncResultDelegate<SocketPoolRequest> SocketPoolResultDelegate;
+typedef AsyncResultHandler<SocketPoolRequest>  SocketPoolResultHandler;
+
+template <typename Adaptee>
+using SocketPoolResultAdapter = AsyncResultAdapter<Adaptee, SocketPoolRequest>;
+
+/*! 客户端连接池\n
+按IPEndPoint缓存已建立的TCP连接，省去重复的连接握手。\n
+取连接时优先复用最近放回的空闲连接，复用前以CanRead检查：
+空闲连接可读意味着对端已经关闭或者发来了不属于任何请求的数据，这样的连接直接丢弃；
+没有空闲连接时，如果该地址的连接数未达到上限则以ConnectAsync新建连接，否则排队等待其他连接放回。\n
+空闲超过idle_timeout的连接由前摄器的定时器定期关闭。各方法可以在任意线程调用。\n
+*/
+class SocketPool : public NonCopyableObject
+{
+public:
+    static const size_t kDefaultMaxPerEndpoint = 8;
+    static const uint32_t kDefaultIdleTimeout = 60000;
+
+public:
+    SocketPool();
+    ~SocketPool();
+
+    /*! 初始化
+    @param[in] proactor         新建的连接关联到此前摄器，回调也在它的线程上执行。
+    @param[in] max_per_endpoint 每个地址最多的连接数，包括空闲、已取出和正在建立的连接。
+    @param[in] idle_timeout     空闲连接的超时时间，毫秒，为0时不因空闲而关闭。
+    @return 初始化成功后返回true；否则返回false。
+    */
+    bool init(Proactor & proactor,
+              size_t max_per_endpoint = kDefaultMaxPerEndpoint,
+              uint32_t idle_timeout = kDefaultIdleTimeout);
+
+    /*! 关闭连接池
+    @remark 等待中的请求以取消错误在调用线程上直接回调，等待正在建立的连接完成后关闭所有空闲连接。\n
+            等待期间调用线程也执行前摄器的Run，没有其他线程执行前摄器时也不会一直等待，
+            此时前摄器上其他对象的回调也可能在调用线程上执行。\n
+            取出的连接必须在此之前全部放回，不能在回调中调用。\n
+    */
+    void fini();
+
+    /*! 异步取得到endpoint的连接
+    @return 提交成功返回true，之后总会回调一次；未初始化或者已经关闭时返回false。
+    */
+    bool CheckoutAsync(SocketPoolRequest & request, const IPEndPoint & endpoint);
+
+    /*! 放回连接
+    @param[in] connection   取得的连接。
+    @param[in] reusable     连接是否还能继续使用，出错、协议状态未知时传入false，连接被关闭。
+    @remark 有等待的请求时连接直接交给它，否则放入空闲连接中。\n
+    */
+    void Release(PooledSocket * connection, bool reusable);
+
+    //立即关闭超时的空闲连接，返回关闭的个数
+    size_t Evict();
+
+    size_t idle_count() const;
+
+    //所有地址的连接数，包括空闲、已取出和正在建立的连接
+    size_t connection_count() const;
+
+private:
+    struct Endpoint
+    {
+        IPEndPoint endpoint;
+        HandlePool<PooledSocketHandle> idle;
+        size_t connections;
+        SocketPoolRequest * waiters_head;
+        SocketPoolRequest * waiters_tail;
+
+        Endpoint(const IPEndPoint & ep, size_t capacity);
+    };
+
+    //在锁内调用，不存在时创建
+    Endpoint * FindEndpoint(const IPEndPoint & endpoint, bool create);
+
+    //在锁内调用，取出最早等待的请求
+    SocketPoolRequest * PopWaiter(Endpoint & entry);
+
+    //从空闲连接中取出一个可以复用的，没有时返回0
+    PooledSocket * TakeIdle(Endpoint & entry);
+
+    //为请求新建连接，连接数已经在锁内计入
+    void Dial(Endpoint & entry, SocketPoolRequest & request);
+    void OnDialed(SocketPoolRequest & request);
+
+    //投递到前摄器线程上回调请求
+    void Deliver(SocketPoolRequest & request, PooledSocket * connection,
+                 uint32_t error);
+
+    //关闭一个连接并让出名额，有等待的请求时为它新建连接
+    void Discard(Endpoint & entry, PooledSocket * connection);
+
+    bool IsExpired(const PooledSocket * connection, uint64_t now) const;
+    void OnEvictTimer();
+
+private:
+    mutable SpinLock lock_;
+    Proactor * proactor_;
+    std::vector<Endpoint *> endpoints_;
+    size_t max_per_endpoint_;
+    uint32_t idle_timeout_;
+    bool stopping_;
+    Atomic pending_;                //已提交尚未回调的请求数
+    AsyncTimerAdapter<SocketPool> evict_timer_;
+
+    friend class SocketPoolRequest;
+};
+
+
+}
+
+#endif
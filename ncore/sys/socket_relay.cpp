@@ -0,0 +1,290 @@
+﻿#include "socket.h"
+#include "socket_relay.h"
+
+namespace ncore
+{
+
+
+/*
+每个方向依次经过：读入（filling） -> 写出（draining，可能分多次） -> 再次读入。
+读到结束后等缓冲区写空，对dst半关闭，该方向结束（finished）。
+任一请求失败时记录错误并取消两端，在途的请求以错误完成后该方向结束。
+两个方向都结束时调用完成回调。
+*/
+SocketRelay::Flow::Flow()
+    : relay(0), capacity(0), pending(0), consumed(0), forwarded(0),
+      filling(false), draining(false), eof(false), failed(false),
+      finished(false)
+{
+    src = Endpoint();
+    dst = Endpoint();
+    socket_fill_adapter.Register(this, &Flow::OnSocketFilled);
+    socket_drain_adapter.Register(this, &Flow::OnSocketDrained);
+    socket_fill_args.set_completion_delegate(&socket_fill_adapter);
+    socket_drain_args.set_completion_delegate(&socket_drain_adapter);
+#if defined NCORE_WINDOWS
+    pipe_fill_adapter.Register(this, &Flow::OnPipeFilled);
+    pipe_drain_adapter.Register(this, &Flow::OnPipeDrained);
+    pipe_fill_args.set_completion_delegate(&pipe_fill_adapter);
+    pipe_drain_args.set_completion_delegate(&pipe_drain_adapter);
+#elif defined NCORE_LINUX
+    pipe[0] = -1;
+    pipe[1] = -1;
+#endif
+}
+
+void SocketRelay::Flow::OnSocketFilled(SocketAsyncContext & args)
+{
+    OnFilled(args.error(), args.transfered());
+}
+
+void SocketRelay::Flow::OnSocketDrained(SocketAsyncContext & args)
+{
+    OnDrained(args.error(), args.transfered());
+}
+
+void SocketRelay::Flow::OnFilled(uint32_t error, uint32_t transfered)
+{
+    lock.Acquire();
+    filling = false;
+    if(error)
+        failed = true;
+    else if(transfered == 0)
+        eof = true;
+    else
+        pending += transfered;
+    lock.Release();
+
+    if(error)
+        relay->OnFlowFailed(error);
+    Pump();
+}
+
+void SocketRelay::Flow::OnDrained(uint32_t error, uint32_t transfered)
+{
+    lock.Acquire();
+    draining = false;
+    if(error || transfered == 0)
+    {
+        failed = true;
+    }
+    else
+    {
+        pending -= transfered;
+        consumed += transfered;
+        forwarded += transfered;
+        if(pending == 0)
+            consumed = 0;
+    }
+    lock.Release();
+
+    if(error)
+        relay->OnFlowFailed(error);
+    Pump();
+}
+
+uint32_t SocketRelay::Flow::Room() const
+{
+    return pending == 0 ? capacity : 0;
+}
+
+void SocketRelay::Flow::Pump()
+{
+    uint32_t fill_size = 0;
+    uint32_t drain_size = 0;
+    bool finish = false;
+
+    lock.Acquire();
+    if(!failed)
+    {
+        if(!filling && !eof)
+        {
+            fill_size = Room();
+            filling = fill_size != 0;
+        }
+        if(!draining && pending)
+        {
+            drain_size = pending;
+            draining = true;
+        }
+        finish = eof && !filling && !draining && pending == 0;
+    }
+    else
+    {
+        //等在途的请求全部完成
+        finish = !filling && !draining;
+    }
+    if(finish)
+    {
+        finish = !finished;
+        finished = true;
+    }
+    bool graceful = !failed;
+    lock.Release();
+
+    if(fill_size)
+    {
+        uint32_t error = relay->StartFill(*this, fill_size);
+        if(error)
+            OnFilled(error, 0);
+    }
+
+    if(drain_size)
+    {
+        uint32_t error = relay->StartDrain(*this, drain_size);
+        if(error)
+            OnDrained(error, 0);
+    }
+
+    if(finish)
+    {
+        //把结束传给对端，另一个方向继续转发
+        if(graceful)
+            relay->ShutdownSend(dst);
+        relay->OnFlowFinished();
+    }
+}
+
+
+SocketRelay::SocketRelay()
+    : error_(0), initialized_(false)
+{
+    active_ = 0;
+    flows_[0].relay = this;
+    flows_[1].relay = this;
+}
+
+SocketRelay::~SocketRelay()
+{
+    fini();
+}
+
+bool SocketRelay::init(Socket & first, Socket & second, uint32_t buffer_size)
+{
+    Endpoint first_end = Endpoint();
+    Endpoint second_end = Endpoint();
+    first_end.socket = &first;
+    second_end.socket = &second;
+    return Setup(first_end, second_end, buffer_size);
+}
+
+bool SocketRelay::Setup(const Endpoint & first, const Endpoint & second,
+                        uint32_t buffer_size)
+{
+    if(initialized_ || buffer_size == 0)
+        return false;
+
+    if(!InitFlow(flows_[0], buffer_size))
+        return false;
+
+    if(!InitFlow(flows_[1], buffer_size))
+    {
+        FiniFlow(flows_[0]);
+        return false;
+    }
+
+    flows_[0].src = first;
+    flows_[0].dst = second;
+    flows_[1].src = second;
+    flows_[1].dst = first;
+    initialized_ = true;
+    return true;
+}
+
+void SocketRelay::fini()
+{
+    if(!initialized_)
+        return;
+
+    assert(active_ == 0);
+    FiniFlow(flows_[0]);
+    FiniFlow(flows_[1]);
+    initialized_ = false;
+}
+
+bool SocketRelay::Start()
+{
+    if(!initialized_ || active_ != 0)
+        return false;
+
+    error_ = 0;
+    for(size_t index = 0; index < 2; ++index)
+    {
+        Flow & flow = flows_[index];
+        flow.pending = 0;
+        flow.consumed = 0;
+        flow.forwarded = 0;
+        flow.filling = false;
+        flow.draining = false;
+        flow.eof = false;
+        flow.failed = false;
+        flow.finished = false;
+    }
+
+    active_ = 2;
+    flows_[0].Pump();
+    flows_[1].Pump();
+    return true;
+}
+
+void SocketRelay::Stop()
+{
+    if(!initialized_)
+        return;
+
+    CancelEndpoint(flows_[0].src);
+    CancelEndpoint(flows_[0].dst);
+}
+
+uint64_t SocketRelay::first_to_second() const
+{
+    flows_[0].lock.Acquire();
+    uint64_t forwarded = flows_[0].forwarded;
+    flows_[0].lock.Release();
+    return forwarded;
+}
+
+uint64_t SocketRelay::second_to_first() const
+{
+    flows_[1].lock.Acquire();
+    uint64_t forwarded = flows_[1].forwarded;
+    flows_[1].lock.Release();
+    return forwarded;
+}
+
+uint32_t SocketRelay::error() const
+{
+    return error_;
+}
+
+bool SocketRelay::is_running() const
+{
+    return active_ != 0;
+}
+
+void SocketRelay::set_completion_delegate(SocketRelayResultHandler * handler)
+{
+    completion_delegate_ = handler;
+}
+
+void SocketRelay::OnFlowFailed(uint32_t error)
+{
+    error_lock_.Acquire();
+    bool first = error_ == 0;
+    if(first)
+        error_ = error;
+    error_lock_.Release();
+
+    //取消引起的错误不再重复取消
+    if(first)
+        Stop();
+}
+
+void SocketRelay::OnFlowFinished()
+{
+    if(--active_ == 0)
+        completion_delegate_(*this);
+}
+
+
+}
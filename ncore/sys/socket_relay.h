@@ -0,0 +1,174 @@
+﻿#ifndef NCORE_SYS_SOCKET_RELAY_H_
+#define NCORE_SYS_SOCKET_RELAY_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include <ncore/base/atomic.h>
+#include <ncore/utils/async_result_delegate.h>
+#include <ncore/utils/async_result_adapter.h>
+#include "spin_lock.h"
+#include "socket_async_event_args.h"
+#if defined NCORE_WINDOWS
+#include "named_pipe_async_event_args.h"
+#endif
+
+namespace ncore
+{
+
+
+class Socket;
+class NamedPipe;
+class SocketRelay;
+
+typedef AsyncResultDelegate<SocketRelay> SocketRelayResultDelegate;
+typedef AsyncResultHandler<SocketRelay>  SocketRelayResultHandler;
+
+/*! 套接字转发\n
+在两个端点之间双向转发数据，用于代理。每个方向上读入和写出交替进行，
+缓冲区中的数据全部写出之后才再次读入，写出慢时由TCP的窗口把压力传回发送方。\n
+Linux下以splice经内核管道转发，数据不经过用户态；Windows下收发共用一块缓冲区，不做复制。\n
+一个方向读到结束时，待缓冲的数据全部写出后对另一端Shutdown(kSend)，另一个方向继续转发。
+两个方向都结束、或者任一方向出错时转发结束，调用完成回调；出错时取消两端的请求。\n
+端点需要事先关联到前摄器，转发期间不能在端点上发起其他请求。\n
+*/
+class SocketRelay : public NonCopyableObject
+{
+public:
+    //每个方向的默认缓冲大小，Linux下为管道的容量
+    static const uint32_t kDefaultBufferSize = 65536;
+
+public:
+    SocketRelay();
+    ~SocketRelay();
+
+    /*! 初始化
+    @param[in] first        第一个端点。
+    @param[in] second       第二个端点。
+    @param[in] buffer_size  每个方向的缓冲大小。
+    @return 初始化成功后返回true；否则返回false。
+    */
+    bool init(Socket & first, Socket & second,
+              uint32_t buffer_size = kDefaultBufferSize);
+
+#if defined NCORE_WINDOWS
+    /*! 初始化，在套接字和命名管道之间转发
+    @remark 命名管道没有半关闭，套接字一方结束时管道一方不做处理。\n
+    */
+    bool init(Socket & first, NamedPipe & second,
+              uint32_t buffer_size = kDefaultBufferSize);
+#endif
+
+    //必须在转发结束之后调用
+    void fini();
+
+    /*! 开始转发
+    @return 未初始化或者正在转发时返回false；否则返回true，发起请求失败时通过完成回调报告。
+    */
+    bool Start();
+
+    //取消两端的请求，转发随之结束，完成回调仍然会调用
+    void Stop();
+
+    //从first转发到second的字节数
+    uint64_t first_to_second() const;
+
+    //从second转发到first的字节数
+    uint64_t second_to_first() const;
+
+    //第一个错误，正常结束时为0
+    uint32_t error() const;
+
+    bool is_running() const;
+
+    void set_completion_delegate(SocketRelayResultHandler * handler);
+
+private:
+    //转发的一端
+    struct Endpoint
+    {
+        Socket * socket;
+#if defined NCORE_WINDOWS
+        NamedPipe * pipe;
+#endif
+    };
+
+    //一个方向的转发：从src读入缓冲区，再从缓冲区写到dst
+    class Flow
+    {
+    public:
+        Flow();
+
+        void OnFilled(uint32_t error, uint32_t transfered);
+        void OnDrained(uint32_t error, uint32_t transfered);
+        void OnSocketFilled(SocketAsyncContext & args);
+        void OnSocketDrained(SocketAsyncContext & args);
+#if defined NCORE_WINDOWS
+        void OnPipeFilled(NamedPipeAsyncContext & args);
+        void OnPipeDrained(NamedPipeAsyncContext & args);
+#endif
+
+        //根据状态发起读入和写出，在锁外调用
+        void Pump();
+
+        //可以读入的字节数
+        uint32_t Room() const;
+
+    public:
+        SocketRelay * relay;
+        Endpoint src;
+        Endpoint dst;
+        mutable SpinLock lock;
+        uint32_t capacity;
+        uint32_t pending;           //缓冲区中尚未写出的字节数
+        uint32_t consumed;          //缓冲区中已经写出的字节数
+        uint64_t forwarded;
+        bool filling;
+        bool draining;
+        bool eof;
+        bool failed;
+        bool finished;
+        SocketAsyncContext socket_fill_args;
+        SocketAsyncContext socket_drain_args;
+        SocketAsyncResultAdapter<Flow> socket_fill_adapter;
+        SocketAsyncResultAdapter<Flow> socket_drain_adapter;
+#if defined NCORE_WINDOWS
+        NamedPipeAsyncContext pipe_fill_args;
+        NamedPipeAsyncContext pipe_drain_args;
+        NamedPipeAsyncResultAdapter<Flow> pipe_fill_adapter;
+        NamedPipeAsyncResultAdapter<Flow> pipe_drain_adapter;
+        std::vector<char> buffer;
+#elif defined NCORE_LINUX
+        int pipe[2];                //读入端写入pipe[1]，写出端从pipe[0]读取
+#endif
+    };
+
+    bool Setup(const Endpoint & first, const Endpoint & second,
+               uint32_t buffer_size);
+
+    void OnFlowFailed(uint32_t error);
+    void OnFlowFinished();
+
+    //平台相关的部分，Start*成功时返回0，否则返回错误码
+    bool InitFlow(Flow & flow, uint32_t buffer_size);
+    void FiniFlow(Flow & flow);
+    uint32_t StartFill(Flow & flow, uint32_t size);
+    uint32_t StartDrain(Flow & flow, uint32_t size);
+    void ShutdownSend(Endpoint & endpoint);
+    void CancelEndpoint(Endpoint & endpoint);
+
+private:
+    Flow flows_[2];
+    Atomic active_;
+    SpinLock error_lock_;
+    uint32_t error_;
+    bool initialized_;
+    SocketRelayResultDelegate completion_delegate_;
+};
+
+template <typename Adaptee>
+using SocketRelayResultAdapter = AsyncResultAdapter<Adaptee, SocketRelay>;
+
+
+}
+
+#endif
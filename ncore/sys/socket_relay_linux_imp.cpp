@@ -0,0 +1,72 @@
+﻿#include "socket.h"
+#include "socket_relay.h"
+
+namespace ncore
+{
+
+
+bool SocketRelay::InitFlow(Flow & flow, uint32_t buffer_size)
+{
+    if(pipe2(flow.pipe, O_NONBLOCK | O_CLOEXEC) != 0)
+        return false;
+
+    //管道的容量按页向上取整，超过上限时保留默认容量
+    int size = fcntl(flow.pipe[1], F_SETPIPE_SZ, static_cast<int>(buffer_size));
+    if(size < 0)
+        size = fcntl(flow.pipe[1], F_GETPIPE_SZ);
+
+    if(size <= 0)
+    {
+        FiniFlow(flow);
+        return false;
+    }
+
+    flow.capacity = static_cast<uint32_t>(size);
+    return true;
+}
+
+void SocketRelay::FiniFlow(Flow & flow)
+{
+    for(size_t index = 0; index < 2; ++index)
+    {
+        if(flow.pipe[index] >= 0)
+        {
+            close(flow.pipe[index]);
+            flow.pipe[index] = -1;
+        }
+    }
+    flow.capacity = 0;
+}
+
+uint32_t SocketRelay::StartFill(Flow & flow, uint32_t size)
+{
+    errno = 0;
+    if(flow.src.socket->SpliceRecvAsync(flow.socket_fill_args,
+                                        flow.pipe[1], size))
+        return 0;
+
+    return errno ? errno : EINVAL;
+}
+
+uint32_t SocketRelay::StartDrain(Flow & flow, uint32_t size)
+{
+    errno = 0;
+    if(flow.dst.socket->SpliceSendAsync(flow.socket_drain_args,
+                                        flow.pipe[0], size))
+        return 0;
+
+    return errno ? errno : EINVAL;
+}
+
+void SocketRelay::ShutdownSend(Endpoint & endpoint)
+{
+    endpoint.socket->Shutdown(SocketShutdown::kSend);
+}
+
+void SocketRelay::CancelEndpoint(Endpoint & endpoint)
+{
+    endpoint.socket->Cancel();
+}
+
+
+}
@@ -0,0 +1,106 @@
+﻿#include "named_pipe.h"
+#include "socket.h"
+#include "socket_relay.h"
+
+namespace ncore
+{
+
+
+bool SocketRelay::init(Socket & first, NamedPipe & second, uint32_t buffer_size)
+{
+    Endpoint first_end = Endpoint();
+    Endpoint second_end = Endpoint();
+    first_end.socket = &first;
+    second_end.pipe = &second;
+    return Setup(first_end, second_end, buffer_size);
+}
+
+void SocketRelay::Flow::OnPipeFilled(NamedPipeAsyncContext & args)
+{
+    //对端关闭管道视为读到结束
+    if(args.error() == ERROR_BROKEN_PIPE)
+        OnFilled(0, 0);
+    else
+        OnFilled(args.error(), args.transfered());
+}
+
+void SocketRelay::Flow::OnPipeDrained(NamedPipeAsyncContext & args)
+{
+    OnDrained(args.error(), args.transfered());
+}
+
+bool SocketRelay::InitFlow(Flow & flow, uint32_t buffer_size)
+{
+    flow.buffer.resize(buffer_size);
+    flow.capacity = buffer_size;
+    return true;
+}
+
+void SocketRelay::FiniFlow(Flow & flow)
+{
+    std::vector<char>().swap(flow.buffer);
+    flow.capacity = 0;
+}
+
+uint32_t SocketRelay::StartFill(Flow & flow, uint32_t size)
+{
+    //缓冲区写空之后才读入，总是从头开始
+    char * data = &flow.buffer[0];
+    bool result = false;
+    if(flow.src.socket)
+    {
+        flow.socket_fill_args.SetBuffer(data, size);
+        result = flow.src.socket->ReceiveAsync(flow.socket_fill_args);
+    }
+    else
+    {
+        flow.pipe_fill_args.SetBuffer(data, size);
+        result = flow.src.pipe->ReadAsync(flow.pipe_fill_args);
+    }
+
+    if(result)
+        return 0;
+
+    uint32_t error = ::GetLastError();
+    return error ? error : ERROR_INVALID_FUNCTION;
+}
+
+uint32_t SocketRelay::StartDrain(Flow & flow, uint32_t size)
+{
+    char * data = &flow.buffer[flow.consumed];
+    bool result = false;
+    if(flow.dst.socket)
+    {
+        flow.socket_drain_args.SetBuffer(data, size);
+        result = flow.dst.socket->SendAsync(flow.socket_drain_args);
+    }
+    else
+    {
+        flow.pipe_drain_args.SetBuffer(data, size);
+        result = flow.dst.pipe->WriteAsync(flow.pipe_drain_args);
+    }
+
+    if(result)
+        return 0;
+
+    uint32_t error = ::GetLastError();
+    return error ? error : ERROR_INVALID_FUNCTION;
+}
+
+void SocketRelay::ShutdownSend(Endpoint & endpoint)
+{
+    //命名管道没有半关闭
+    if(endpoint.socket)
+        endpoint.socket->Shutdown(SocketShutdown::kSend);
+}
+
+void SocketRelay::CancelEndpoint(Endpoint & endpoint)
+{
+    if(endpoint.socket)
+        endpoint.socket->Cancel();
+    else
+        endpoint.pipe->Cancel();
+}
+
+
+}
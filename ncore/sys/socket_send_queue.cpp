@@ -0,0 +1,441 @@
+﻿#include "proactor.h"
+#include "socket.h"
+#include "socket_send_queue.h"
+#include "sys_info.h"
+#include "thread.h"
+#include "token_bucket.h"
+
+namespace ncore
+{
+
+#if defined NCORE_WINDOWS
+static const uint32_t kInvalidError = WSAEINVAL;
+
+static uint32_t GetLastSocketError()
+{
+    return ::WSAGetLastError();
+}
+#elif defined NCORE_LINUX
+static const uint32_t kInvalidError = EINVAL;
+
+static uint32_t GetLastSocketError()
+{
+    return errno;
+}
+#endif
+
+//一次推迟的上限，避免极低的速率使定时器的毫秒数溢出
+static const uint64_t kMaxPaceDelay = 0x7FFFFFFF;
+
+
+SocketSendRequest::SocketSendRequest()
+    : buffer_(0), size_(0), error_(0), user_token_(0), next_(0),
+      queued_time_(0)
+{
+}
+
+void SocketSendRequest::SetBuffer(const void * buffer, uint32_t size)
+{
+    buffer_ = buffer;
+    size_ = size;
+}
+
+const void * SocketSendRequest::buffer() const
+{
+    return buffer_;
+}
+
+uint32_t SocketSendRequest::size() const
+{
+    return size_;
+}
+
+uint32_t SocketSendRequest::error() const
+{
+    return error_;
+}
+
+void * SocketSendRequest::user_token() const
+{
+    return user_token_;
+}
+
+void SocketSendRequest::set_user_token(void * token)
+{
+    user_token_ = token;
+}
+
+void SocketSendRequest::set_completion_delegate(SocketSendRequestHandler * handler)
+{
+    completion_delegate_ = handler;
+}
+
+void SocketSendRequest::OnCompleted(uint32_t error)
+{
+    error_ = error;
+    next_ = 0;
+    completion_delegate_(*this);
+}
+
+
+SocketSendQueue::SocketSendQueue()
+    : socket_(0), head_(0), tail_(0), head_sent_(0),
+      queued_size_(0), queued_count_(0),
+      high_water_mark_(0), low_water_mark_(0),
+      sending_(false), full_(false), error_(0),
+      bucket_(0), proactor_(0), throttled_count_(0), throttled_bytes_(0),
+      pace_firing_(false), pace_wait_(0)
+{
+    adapter_.Register(this, &SocketSendQueue::OnSent);
+    args_.set_completion_delegate(&adapter_);
+    pace_timer_.Register(this, &SocketSendQueue::OnPaceTimer);
+}
+
+SocketSendQueue::~SocketSendQueue()
+{
+    fini();
+}
+
+bool SocketSendQueue::init(Socket & socket, size_t high_water_mark)
+{
+    if(socket_ || high_water_mark == 0)
+        return false;
+
+    socket_ = &socket;
+    high_water_mark_ = high_water_mark;
+    low_water_mark_ = high_water_mark / 2;
+    error_ = 0;
+    full_ = false;
+    return true;
+}
+
+void SocketSendQueue::fini()
+{
+    if(socket_ == 0)
+        return;
+
+    assert(!sending_ && head_ == 0);
+    //最后一次提交可能由定时器发起，完成时定时器的回调还没有返回
+    while(pace_timer_.firing())
+        Thread::Sleep(0, false);
+
+    socket_ = 0;
+    bucket_ = 0;
+    proactor_ = 0;
+}
+
+bool SocketSendQueue::Send(SocketSendRequest & request)
+{
+    if(socket_ == 0 || request.size_ == 0)
+        return false;
+
+    //只在启用节奏控制时取时间
+    uint64_t now = bucket_ ? SysInfo::MicroTickCount() : 0;
+    lock_.Acquire();
+    if(error_ || full_)
+    {
+        lock_.Release();
+        return false;
+    }
+
+    request.queued_time_ = now;
+    request.error_ = 0;
+    request.next_ = 0;
+    if(tail_)
+        tail_->next_ = &request;
+    else
+        head_ = &request;
+    tail_ = &request;
+    queued_size_ += request.size_;
+    ++queued_count_;
+
+    bool notify = queued_size_ >= high_water_mark_;
+    if(notify)
+        full_ = true;
+
+    bool start = !sending_;
+    uint32_t wait = 0;
+    if(start)
+    {
+        sending_ = true;
+        wait = Pace();
+        if(DeferPace(wait))
+            start = false;
+    }
+    lock_.Release();
+
+    uint32_t submit_error = start ? Schedule(wait) : 0;
+    if(notify)
+        backpressure_delegate_(*this);
+    if(submit_error)
+        Finish(submit_error, 0);
+    return true;
+}
+
+size_t SocketSendQueue::queued_size() const
+{
+    lock_.Acquire();
+    size_t size = queued_size_;
+    lock_.Release();
+    return size;
+}
+
+size_t SocketSendQueue::queued_count() const
+{
+    lock_.Acquire();
+    size_t count = queued_count_;
+    lock_.Release();
+    return count;
+}
+
+bool SocketSendQueue::is_full() const
+{
+    return full_;
+}
+
+uint32_t SocketSendQueue::error() const
+{
+    return error_;
+}
+
+void SocketSendQueue::set_backpressure_delegate(SocketSendQueueHandler * handler)
+{
+    backpressure_delegate_ = handler;
+}
+
+bool SocketSendQueue::set_pacing(TokenBucket * bucket, Proactor * proactor)
+{
+    if(socket_ == 0 || (bucket && proactor == 0))
+        return false;
+
+    lock_.Acquire();
+    bool idle = !sending_ && head_ == 0;
+    if(idle)
+    {
+        bucket_ = bucket;
+        proactor_ = bucket ? proactor : 0;
+    }
+    lock_.Release();
+    return idle;
+}
+
+uint64_t SocketSendQueue::throttled_count() const
+{
+    lock_.Acquire();
+    uint64_t count = throttled_count_;
+    lock_.Release();
+    return count;
+}
+
+uint64_t SocketSendQueue::throttled_bytes() const
+{
+    lock_.Acquire();
+    uint64_t bytes = throttled_bytes_;
+    lock_.Release();
+    return bytes;
+}
+
+IOHistogram SocketSendQueue::queue_delay() const
+{
+    lock_.Acquire();
+    IOHistogram delay = queue_delay_;
+    lock_.Release();
+    return delay;
+}
+
+size_t SocketSendQueue::Prepare(size_t limit)
+{
+    SocketBuffer buffers[SocketAsyncContext::kMaxBuffers];
+    size_t count = 0;
+    size_t total = 0;
+    uint32_t offset = head_sent_;
+    for(SocketSendRequest * request = head_;
+        request && count < SocketAsyncContext::kMaxBuffers && total < limit;
+        request = request->next_)
+    {
+        size_t size = request->size_ - offset;
+        if(size > limit - total)
+            size = limit - total;
+
+        const char * data = static_cast<const char *>(request->buffer_);
+        buffers[count].data = const_cast<char *>(data + offset);
+        buffers[count].size = size;
+        total += size;
+        offset = 0;
+        ++count;
+    }
+    args_.SetBuffers(buffers, count);
+    return total;
+}
+
+uint32_t SocketSendQueue::Pace()
+{
+    size_t size = Prepare(static_cast<size_t>(-1));
+    if(bucket_ == 0)
+        return 0;
+
+    uint64_t delay = 0;
+    uint64_t granted = bucket_->Acquire(size, delay);
+    if(granted == 0)
+    {
+        ++throttled_count_;
+        throttled_bytes_ += size;
+        //定时器的精度为1毫秒，向上取整
+        uint64_t wait = (delay + 999) / 1000;
+        if(wait == 0)
+            wait = 1;
+        return static_cast<uint32_t>(wait < kMaxPaceDelay ? wait : kMaxPaceDelay);
+    }
+
+    if(granted < size)
+        Prepare(static_cast<size_t>(granted));
+    return 0;
+}
+
+bool SocketSendQueue::DeferPace(uint32_t wait)
+{
+    if(wait == 0 || !pace_firing_)
+        return false;
+
+    pace_wait_ = wait;
+    return true;
+}
+
+uint32_t SocketSendQueue::Schedule(uint32_t wait)
+{
+    if(wait == 0)
+        return Submit();
+
+    //pace_firing_已经清除，定时器的回调即使还没有返回也只剩最后几条指令
+    while(pace_timer_.firing())
+        Thread::Pause();
+    proactor_->SetTimer(pace_timer_, wait);
+    return 0;
+}
+
+void SocketSendQueue::OnPaceTimer()
+{
+    //回调返回之前定时器只能在回调中重新启动，
+    //提交的完成可能在其他线程上先于回调返回，需要的定时器由DeferPace交给这里启动
+    lock_.Acquire();
+    uint32_t wait = Pace();
+    if(wait)
+        proactor_->SetTimer(pace_timer_, wait);
+    else
+        pace_firing_ = true;
+    lock_.Release();
+    if(wait)
+        return;
+
+    uint32_t submit_error = Submit();
+    if(submit_error)
+        Finish(submit_error, 0);
+
+    lock_.Acquire();
+    pace_firing_ = false;
+    if(pace_wait_)
+        proactor_->SetTimer(pace_timer_, pace_wait_);
+    pace_wait_ = 0;
+    lock_.Release();
+}
+
+uint32_t SocketSendQueue::Submit()
+{
+    if(socket_->SendAsync(args_))
+        return 0;
+
+    uint32_t error = GetLastSocketError();
+    return error ? error : kInvalidError;
+}
+
+void SocketSendQueue::OnSent(SocketAsyncContext & args)
+{
+    Finish(args.error(), args.transfered());
+}
+
+void SocketSendQueue::Finish(uint32_t error, uint32_t transfered)
+{
+    lock_.Acquire();
+    if(error && error_ == 0)
+        error_ = error;
+
+    SocketSendRequest * done = Detach(error, transfered);
+    bool resume = !error && head_ != 0;
+    uint32_t wait = 0;
+    bool deferred = false;
+    if(resume)
+    {
+        wait = Pace();
+        deferred = DeferPace(wait);
+    }
+    else
+    {
+        sending_ = false;
+    }
+
+    bool notify = full_ && queued_size_ <= low_water_mark_;
+    if(notify)
+        full_ = false;
+    lock_.Release();
+
+    //先提交剩余的部分，回调与发送重叠
+    uint32_t submit_error = resume && !deferred ? Schedule(wait) : 0;
+    Complete(done, error);
+    if(notify)
+        backpressure_delegate_(*this);
+    if(submit_error)
+        Finish(submit_error, 0);
+}
+
+SocketSendRequest * SocketSendQueue::Detach(uint32_t error, uint32_t transfered)
+{
+    SocketSendRequest * done = head_;
+    if(error)
+    {
+        head_ = 0;
+        tail_ = 0;
+        head_sent_ = 0;
+        queued_size_ = 0;
+        queued_count_ = 0;
+        return done;
+    }
+
+    queued_size_ -= transfered;
+    uint64_t now = bucket_ ? SysInfo::MicroTickCount() : 0;
+    SocketSendRequest * last = 0;
+    SocketSendRequest * request = head_;
+    while(request && transfered >= request->size_ - head_sent_)
+    {
+        transfered -= request->size_ - head_sent_;
+        head_sent_ = 0;
+        --queued_count_;
+        if(bucket_)
+            queue_delay_.Add(now - request->queued_time_);
+        last = request;
+        request = request->next_;
+    }
+    head_sent_ += transfered;
+
+    if(last == 0)
+        return 0;
+
+    last->next_ = 0;
+    head_ = request;
+    if(head_ == 0)
+        tail_ = 0;
+    return done;
+}
+
+void SocketSendQueue::Complete(SocketSendRequest * requests, uint32_t error)
+{
+    //回调中可以再次发送同一条消息，先取出next_
+    while(requests)
+    {
+        SocketSendRequest * next = requests->next_;
+        requests->OnCompleted(error);
+        requests = next;
+    }
+}
+
+
+}
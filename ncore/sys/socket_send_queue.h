@@ -0,0 +1,195 @@
+﻿#ifndef NCORE_SYS_SOCKET_SEND_QUEUE_H_
+#define NCORE_SYS_SOCKET_SEND_QUEUE_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include <ncore/utils/async_result_delegate.h>
+#include <ncore/utils/async_result_adapter.h>
+#include "io_stats.h"
+#include "spin_lock.h"
+#include "socket_async_event_args.h"
+#include "timing_wheel.h"
+
+namespace ncore
+{
+
+
+class Socket;
+class Proactor;
+class TokenBucket;
+class SocketSendRequest;
+class SocketSendQueue;
+
+typedef AsyncResultDelegate<SocketSendRequest> SocketSendRequestDelegate;
+typedef AsyncResultHandler<SocketSendRequest>  SocketSendRequestHandler;
+typedef AsyncResultDelegate<SocketSendQueue> SocketSendQueueDelegate;
+typedef AsyncResultHandler<SocketSendQueue>  SocketSendQueueHandler;
+
+/*! 发送队列中的一条消息\n
+由调用者分配，从SocketSendQueue::Send到完成回调之间，消息对象和数据都必须保持有效。\n
+*/
+class SocketSendRequest
+{
+public:
+    SocketSendRequest();
+
+    void SetBuffer(const void * buffer, uint32_t size);
+
+    const void * buffer() const;
+    uint32_t size() const;
+
+    //成功时为0；套接字出错时，尚未发送完的消息都以该错误完成
+    uint32_t error() const;
+
+    void * user_token() const;
+    void set_user_token(void * token);
+
+    void set_completion_delegate(SocketSendRequestHandler * handler);
+
+private:
+    void OnCompleted(uint32_t error);
+
+private:
+    const void * buffer_;
+    uint32_t size_;
+    uint32_t error_;
+    void * user_token_;
+    SocketSendRequest * next_;
+    uint64_t queued_time_;          //启用节奏控制时加入队列的微秒数
+    SocketSendRequestDelegate completion_delegate_;
+
+    friend class SocketSendQueue;
+};
+
+/*! 套接字的发送队列\n
+接受任意多条消息，按顺序发送，同一时刻只有一个SendAsync在途。
+排队的消息一次最多SocketAsyncContext::kMaxBuffers条以聚集发送合并提交，
+部分完成时自动从断点继续，每条消息全部发出后单独回调。\n
+排队的字节数达到高水位时Send返回false，降到低水位以下才再次接受；
+两次状态变化都调用背压回调，回调中以is_full()区分。\n
+以set_pacing指定令牌桶后按令牌放行：每次提交只包含放行的字节，
+令牌不足时以前摄器的定时器推迟提交，消息仍然按顺序、不重叠地发出。\n
+套接字需要事先关联到前摄器，使用队列期间不能在套接字上直接发送。\n
+*/
+class SocketSendQueue : public NonCopyableObject
+{
+public:
+    static const size_t kDefaultHighWaterMark = 1024 * 1024;
+
+public:
+    SocketSendQueue();
+    ~SocketSendQueue();
+
+    /*! 初始化
+    @param[in] socket           已经连接并关联到前摄器的套接字。
+    @param[in] high_water_mark  高水位字节数，低水位为其一半。
+    @return 初始化成功后返回true；否则返回false。
+    */
+    bool init(Socket & socket, size_t high_water_mark = kDefaultHighWaterMark);
+
+    //必须在所有消息完成之后调用
+    void fini();
+
+    /*! 发送消息
+    @param[in] request 消息，大小不能为0。
+    @return 加入队列后返回true，之后一定会调用消息的完成回调；
+            队列已满、已经出错或者消息为空时返回false，不会回调。
+    */
+    bool Send(SocketSendRequest & request);
+
+    //尚未发送完的字节数
+    size_t queued_size() const;
+
+    //尚未完成的消息数
+    size_t queued_count() const;
+
+    bool is_full() const;
+
+    //第一个发送错误，出错后队列不再接受消息
+    uint32_t error() const;
+
+    void set_backpressure_delegate(SocketSendQueueHandler * handler);
+
+    /*! 启用发送节奏控制
+    @param[in] bucket   连接的令牌桶，可以有分组、全局的父桶，为0时取消节奏控制。
+    @param[in] proactor 令牌不足时在其上设置定时器，通常是套接字关联的前摄器。
+    @return 设置成功后返回true；没有初始化、有消息尚未完成或者缺少前摄器时返回false。
+    @remark 必须在没有未完成的消息时调用，令牌桶和前摄器在fini之前必须保持有效。\n
+            定时器精度为1毫秒，速率较低时每次放行的字节由令牌桶的burst决定。
+            Linux下还可以用Socket::SetPacingRate让内核在报文级别平滑发送。\n
+    */
+    bool set_pacing(TokenBucket * bucket, Proactor * proactor);
+
+    //被令牌桶推迟的提交次数和字节数，同一批数据每推迟一次计一次
+    uint64_t throttled_count() const;
+    uint64_t throttled_bytes() const;
+
+    //启用节奏控制期间，每条消息从Send到全部发出的微秒数
+    IOHistogram queue_delay() const;
+
+private:
+    //从队首准备一次提交，最多包含limit字节，返回准备的字节数，在锁内调用
+    size_t Prepare(size_t limit);
+
+    //向令牌桶申请并准备提交，在锁内调用；放行时返回0，否则返回需要等待的毫秒数
+    uint32_t Pace();
+
+    //定时器的回调正在执行时记下等待时间，由回调返回之前启动，在锁内调用；推迟时返回true
+    bool DeferPace(uint32_t wait);
+
+    //按Pace的结果提交或者启动定时器，在锁外调用，不能在定时器的回调中调用；
+    //成功时返回0，否则返回错误码
+    uint32_t Schedule(uint32_t wait);
+
+    void OnPaceTimer();
+
+    //在锁外调用，成功时返回0，否则返回错误码
+    uint32_t Submit();
+
+    void OnSent(SocketAsyncContext & args);
+
+    //一次提交结束，出错时以错误完成所有消息
+    void Finish(uint32_t error, uint32_t transfered);
+
+    //摘下已经发送完的消息，出错时摘下全部，在锁内调用
+    SocketSendRequest * Detach(uint32_t error, uint32_t transfered);
+
+    //依次回调摘下的消息，在锁外调用
+    static void Complete(SocketSendRequest * requests, uint32_t error);
+
+private:
+    Socket * socket_;
+    mutable SpinLock lock_;
+    SocketSendRequest * head_;
+    SocketSendRequest * tail_;
+    uint32_t head_sent_;            //队首消息已经发送的字节数
+    size_t queued_size_;
+    size_t queued_count_;
+    size_t high_water_mark_;
+    size_t low_water_mark_;
+    bool sending_;
+    bool full_;
+    uint32_t error_;
+    SocketAsyncContext args_;
+    SocketAsyncResultAdapter<SocketSendQueue> adapter_;
+    TokenBucket * bucket_;
+    Proactor * proactor_;
+    uint64_t throttled_count_;
+    uint64_t throttled_bytes_;
+    IOHistogram queue_delay_;
+    AsyncTimerAdapter<SocketSendQueue> pace_timer_;
+    bool pace_firing_;              //定时器的回调已经提交，尚未返回
+    uint32_t pace_wait_;            //回调返回之前需要再次启动定时器的毫秒数
+    SocketSendQueueDelegate backpressure_delegate_;
+};
+
+template <typename Adaptee>
+using SocketSendRequestAdapter = AsyncResultAdapter<Adaptee, SocketSendRequest>;
+
+template <typename Adaptee>
+using SocketSendQueueAdapter = AsyncResultAdapter<Adaptee, SocketSendQueue>;
+
+
+}
+
+#endif
@@ -1,736 +1,1168 @@
-﻿#include <ncore/base/buffer.h>
-#include "named_event.h"
-#include "proactor.h"
-#include "socket_async_event_args.h"
-#include "socket.h"
-
-namespace ncore
-{
-
-typedef BOOL (__stdcall * AcceptEx_t)(SOCKET sListenSocket, 
-                                      SOCKET sAcceptSocket,
-                                      PVOID lpOutputBuffer, 
-                                      DWORD dwReceiveDataLength,
-                                      DWORD dwLocalAddressLength,
-                                      DWORD dwRemoteAddressLength,
-                                      LPDWORD lpdwBytesReceived,
-                                      LPOVERLAPPED lpOverlapped);
-
-typedef BOOL (_stdcall * ConnectEx_t)(SOCKET s,
-                                      const struct sockaddr *name,
-                                      int namelen,
-                                      PVOID lpSendBuffer,
-                                      DWORD dwSendDataLength,
-                                      LPDWORD lpdwBytesSent,
-                                      LPOVERLAPPED lpOverlapped);
-
-typedef BOOL (__stdcall * DisconnectEx_t)(SOCKET hSocket,
-                                          LPOVERLAPPED lpOverlapped,
-                                          DWORD dwFlags,
-                                          DWORD reserved);
-
-static const size_t kAddressBufferSize  = sizeof(sockaddr_in) + 16;
-static const size_t kMinAcceptBufferSize = kAddressBufferSize * 2;
-
-
-class SocketRoutines
-{
-private:
-    friend class Socket;
-
-    static void __stdcall OnCompleted(DWORD dwError,
-                                      DWORD cbTransferred,
-                                      LPWSAOVERLAPPED lpOverlapped,
-                                      DWORD dwFlags)
-    {
-        auto & sae = *reinterpret_cast<SocketAsyncContext*>(lpOverlapped);
-        sae.socket_flags_ = dwFlags;
-        sae.OnCompleted(dwError, cbTransferred);
-    }
-
-    static AcceptEx_t GetAcceptExAddress(SOCKET socket)
-    {
-        static AcceptEx_t AcceptEx = 0;
-        static GUID GuidAcceptEx = WSAID_ACCEPTEX;
-
-        if(AcceptEx == 0)
-        {
-            DWORD byte_received = 0;
-            WSAIoctl(socket, SIO_GET_EXTENSION_FUNCTION_POINTER, 
-                &GuidAcceptEx, sizeof(GuidAcceptEx), 
-                &AcceptEx, sizeof(AcceptEx), 
-                &byte_received, 0, 0);
-        }
-        return AcceptEx;
-    }
-
-    static ConnectEx_t GetConnectExAddress(SOCKET socket)
-    {
-        static ConnectEx_t ConnectEx = 0;
-        static GUID GuidConnectEx = WSAID_CONNECTEX;
-
-        if(ConnectEx == 0)
-        {
-            DWORD byte_received = 0;
-            WSAIoctl(socket, SIO_GET_EXTENSION_FUNCTION_POINTER, 
-                &GuidConnectEx, sizeof(GuidConnectEx), 
-                &ConnectEx, sizeof(ConnectEx), 
-                &byte_received, 0, 0);
-        }
-        return ConnectEx;
-    }
-
-    static DisconnectEx_t GetDisconnectExAddress(SOCKET socket)
-    {
-        static DisconnectEx_t DisconnectEx = 0;
-        static GUID GuidDisconnectEx = WSAID_DISCONNECTEX;
-
-        if(DisconnectEx == 0)
-        {
-            DWORD byte_received = 0;
-            WSAIoctl(socket, SIO_GET_EXTENSION_FUNCTION_POINTER, 
-                &GuidDisconnectEx, sizeof(GuidDisconnectEx), 
-                &DisconnectEx, sizeof(DisconnectEx), 
-                &byte_received, 0, 0);
-        }
-        return DisconnectEx;
-    }
-
-    static bool GetProtocolInfo(SOCKET socket, 
-                                AddressFamily & af,
-                                SocketType & type,
-                                ProtocolType & protocol)
-    {
-        WSAPROTOCOL_INFO pi = {0};
-        char * ppi = reinterpret_cast<char *>(&pi);
-        int pi_size = sizeof(pi);
-        if(getsockopt(socket, SOL_SOCKET, SO_PROTOCOL_INFO, ppi, &pi_size))
-        {
-            return false;
-        }
-
-        af = static_cast<AddressFamily>(pi.iAddressFamily);
-        type = static_cast<SocketType>(pi.iSocketType);
-        protocol = static_cast<ProtocolType>(pi.iProtocol);
-        return true;
-    }   
-};
-
-
-Socket::Socket()
-    : s_(INVALID_SOCKET),
-      io_handler_(0)
-{
-
-}
-
-Socket::~Socket()
-{
-    Close();
-}
-
-Socket::Socket(Socket && obj)
-    : s_(INVALID_SOCKET),
-      io_handler_(0)
-{
-    std::swap(s_, obj.s_);
-    std::swap(io_handler_, obj.io_handler_);
-}
-
-Socket & Socket::operator = (Socket && obj)
-{
-    std::swap(s_, obj.s_);
-    std::swap(io_handler_, obj.io_handler_);
-    return *this;
-}
-
-bool Socket::init(AddressFamily af,
-                  SocketType type,
-                  ProtocolType protocol)
-{
-    if(s_ != INVALID_SOCKET)
-        return true;
-
-    s_= WSASocket(af, type, protocol, 0, 0, WSA_FLAG_OVERLAPPED);
-
-    return s_ != INVALID_SOCKET ? true : false;
-}
-
-void Socket::fini()
-{
-    Close();
-    return;
-}
-
-bool Socket::Close()
-{
-    auto ss = s_;
-    if(ss == INVALID_SOCKET)
-        return false;
-    s_ = INVALID_SOCKET;
-    if(closesocket(ss))
-        return false;
-    return true;
-}
-
-bool Socket::Bind(const IPEndPoint & endpoint)
-{
-    auto sa_ptr = reinterpret_cast<const sockaddr *>(&endpoint.ep_);
-    if(!bind(s_, sa_ptr, endpoint.ep_size_))
-        return true;
-    return false;
-}
-
-bool Socket::Listen(int backlog)
-{
-    return listen(s_, backlog) ? false : true;
-}
-
-bool Socket::Shutdown(SocketShutdown how)
-{
-    return shutdown(s_, how) ? false : true;
-}
-
-Socket Socket::Accept()
-{
-    return Accept(-1);
-}
-
-Socket Socket::Accept(uint32_t timeout)
-{
-    Socket invalid_socket;
-    Socket accept_socket;
-
-    if(s_ == INVALID_SOCKET)
-        return invalid_socket;
-
-    NamedEvent complete_event;
-    if(!complete_event.init(true, false))
-        return invalid_socket;
-
-    SocketAsyncContext args(complete_event);
-    args.SuppressIOCP();
-
-    AddressFamily af;
-    SocketType type;
-    ProtocolType protocol;
-
-    if(!SocketRoutines::GetProtocolInfo(s_, af, type, protocol))
-        return invalid_socket;
-
-    if(!accept_socket.init(af, type, protocol))
-        return invalid_socket;
-
-    args.set_accept_socket(accept_socket);
-
-    FixedBuffer<kMinAcceptBufferSize> output;
-    args.SetBuffer(output.data(), output.capacity());
-
-    if(!AcceptAsync(args))
-        return invalid_socket;
-
-    if(!complete_event.Wait(timeout))
-        Cancel();
-
-    if(!WaitSocketAsyncEvent(args))
-        return invalid_socket;
-
-    return std::move(accept_socket);
-}
-
-bool Socket::AcceptAsync(SocketAsyncContext & args)
-{
-    AcceptEx_t AcceptEx = SocketRoutines::GetAcceptExAddress(s_);
-
-    if(s_ == INVALID_SOCKET)
-        return false;
-
-    if(AcceptEx == 0)
-        return false;
-
-    if(args.count_ < kMinAcceptBufferSize) 
-        return false;
-
-    if(args.accept_socket_ == 0)
-        return false;
-
-    if(args.accept_socket_->IsValid() == false)
-        return false;
-
-    if(args.buffer() == 0)
-        return false;
-
-    size_t output_size = args.count() - kMinAcceptBufferSize;
-    auto byte_transed_ptr = reinterpret_cast<DWORD *>(&args.transfered_);
-    args.last_op_ = SocketAsyncOp::kAsyncAccept;
-    if(!AcceptEx(s_, args.accept_socket_->s_, args.buffer(), output_size,
-                 kAddressBufferSize, kAddressBufferSize, 
-                 byte_transed_ptr, &args.overlapped_))
-    {
-        DWORD last_err = WSAGetLastError();
-        if(last_err != ERROR_IO_PENDING)
-            return false;
-    }
-    return true;
-}
-
-bool Socket::Connect(const IPEndPoint & endpoint)
-{
-    return Connect(endpoint, -1);
-}
-
-bool Socket::Connect(const IPEndPoint & endpoint, uint32_t timeout)
-{
-    if(s_ == INVALID_SOCKET)
-        return false;
-
-    NamedEvent complete_event;
-    if(!complete_event.init(true, false))
-        return false;
-
-    SocketAsyncContext args(complete_event);
-    args.SuppressIOCP();
-    args.set_remote_endpoint(endpoint);
-
-    if(!ConnectAsync(args))
-        return false;
-
-    if(!complete_event.Wait(timeout))
-        Cancel();
-
-    if(!WaitSocketAsyncEvent(args))
-        return false;
-
-    return true;
-}
-
-bool Socket::ConnectAsync(SocketAsyncContext & args)
-{
-    ConnectEx_t ConnectEx = SocketRoutines::GetConnectExAddress(s_);
-
-    if(s_ == INVALID_SOCKET)
-        return false;
-
-    if(ConnectEx == 0)
-        return false;
-
-    if(!Bind(IPEndPoint::kAny))
-        if(WSAGetLastError() != WSAEINVAL)
-            return false;			//绑定失败
-
-    IPEndPoint & ep = args.remote_endpoint();
-    auto sa_ptr = reinterpret_cast<sockaddr *>(&ep.ep_);
-    auto byte_transed_ptr = reinterpret_cast<DWORD *>(&args.transfered_);
-    args.connect_socket_ = this;
-    args.last_op_ = SocketAsyncOp::kAsyncConnect;
-    if(!ConnectEx(s_, sa_ptr, ep.ep_size_, args.buffer(), args.count(),
-                  byte_transed_ptr, &args.overlapped_))
-    {
-        DWORD last_err = WSAGetLastError();
-        if(last_err != ERROR_IO_PENDING)
-            return false;
-    }
-    return true;
-}
-
-void Socket::Disconnect(bool reuse)
-{
-    if(s_ == INVALID_SOCKET)
-        return;
-
-    NamedEvent complete_event;
-    if(!complete_event.init(true, false))
-        return;
-
-    SocketAsyncContext args(complete_event);
-    args.SuppressIOCP();
-    args.set_reuse(reuse);
-    
-    if(!DisconnectAsync(args))
-        return;
-
-    if(!complete_event.Wait(-1))
-        return;
-
-    if(!WaitSocketAsyncEvent(args))
-        return;
-
-    return;
-}
-
-bool Socket::DisconnectAsync(SocketAsyncContext & args)
-{
-    DisconnectEx_t DisconnectEx = SocketRoutines::GetDisconnectExAddress(s_);
-
-    if(s_ == INVALID_SOCKET)
-        return false;
-    if(DisconnectEx == 0)
-        return false;
-
-    args.last_op_ = SocketAsyncOp::kAsyncDisconnect;
-    if(!DisconnectEx(s_, &args.overlapped_, 
-                     args.reuse()? TF_REUSE_SOCKET: 0, 0))
-    {
-        DWORD last_err = WSAGetLastError();
-        if(last_err != ERROR_IO_PENDING)
-            return false;
-    }
-
-    return true;
-}
-
-bool Socket::Receive(void * data, uint32_t size_to_recv, uint32_t & transfered)
-{
-    return Receive(data, size_to_recv, -1, transfered);
-}
-
-bool Socket::Receive(void * data, uint32_t size_to_recv, uint32_t timeout,
-                     uint32_t & transfered)
-{
-    if(s_ == INVALID_SOCKET)
-        return false;
-
-    if(data == 0)
-        return false;
-
-    NamedEvent complete_event;
-    if(!complete_event.init(true, false))
-        return false;
-
-    SocketAsyncContext args(complete_event);
-    args.SuppressIOCP();
-    args.SetBuffer(data, size_to_recv);
-    if(!ReceiveAsync(args))
-        return false;
-    
-    if(!complete_event.Wait(timeout))
-        Cancel();
-
-    if(!WaitSocketAsyncEvent(args))
-        return false;
-
-    transfered = args.transfered();
-    return true;
-}
-
-bool Socket::ReceiveAsync(SocketAsyncContext & args)
-{
-    if(s_ == INVALID_SOCKET)
-        return false;
-
-    char * buffer = reinterpret_cast<char *>(args.buffer());
-    if(buffer == 0)
-        return false;
-
-    WSABUF wsa_buf = {args.count(), buffer};
-    DWORD * byte_transed_ptr = 0;//reinterpret_cast<DWORD *>(&args.transfered_);
-    auto socket_flag_ptr = reinterpret_cast<DWORD *>(&args.socket_flags_);
-    auto iocr = SocketRoutines::OnCompleted;
-    if(args.completion_delegate_ == 0 || io_handler_ != 0)
-        iocr = 0;
-    args.last_op_ = SocketAsyncOp::kAsyncRecv;
-    if(WSARecv(s_, &wsa_buf, 1, byte_transed_ptr, socket_flag_ptr, 
-               &args.overlapped_, iocr))
-    {
-        DWORD last_err = WSAGetLastError();
-        if(last_err != ERROR_IO_PENDING)
-            return false;
-    }
-    return true;
-}
-
-bool Socket::Send(const void * data, uint32_t size_to_send, 
-                  uint32_t & transfered)
-{
-    return Send(data, size_to_send, -1, transfered);
-}
-
-bool Socket::Send(const void * data, uint32_t size_to_send, uint32_t timeout,
-                  uint32_t & transfered)
-{
-    if(s_ == INVALID_SOCKET)
-        return false;
-
-    if(data == 0)
-        return false;
-
-    NamedEvent complete_event;
-    if(!complete_event.init(true, false))
-        return false;
-
-    SocketAsyncContext args(complete_event);
-    args.SuppressIOCP();
-    args.SetBuffer(data, size_to_send);
-    if(!SendAsync(args))
-        return false;
-
-    if(!complete_event.Wait(timeout))
-        Cancel();
-
-    if(!WaitSocketAsyncEvent(args))
-        return false;
-
-    transfered = args.transfered();
-    return true;
-}
-
-bool Socket::SendAsync(SocketAsyncContext & args)
-{
-    if(s_ == INVALID_SOCKET)
-        return false;
-
-    char * buffer = reinterpret_cast<char *>(args.buffer());
-    if(buffer == 0)
-        return false;
-
-    WSABUF wsa_buf = {args.count(), buffer};
-    DWORD * byte_transed_ptr = 0;//reinterpret_cast<DWORD *>(&args.transfered_);
-    auto iocr = SocketRoutines::OnCompleted;
-    if(args.completion_delegate_ == 0 || io_handler_ != 0)
-        iocr = 0;
-    args.last_op_ = SocketAsyncOp::kAsyncSend;
-    if(WSASend(s_, &wsa_buf, 1, byte_transed_ptr, args.socket_flags_, 
-               &args.overlapped_, iocr))
-    {
-        DWORD last_err = WSAGetLastError();
-        if(last_err != ERROR_IO_PENDING)
-            return false;
-    }
-    return true;
-}
-
-bool Socket::ReceiveFrom(void * data, uint32_t size_to_recv, 
-                        uint32_t & transfered, IPEndPoint & endpoint)
-{
-    return ReceiveFrom(data, size_to_recv, -1, transfered, endpoint);
-}
-
-bool Socket::ReceiveFrom(void * data, uint32_t size_to_recv, uint32_t timeout,
-                        uint32_t & transfered, IPEndPoint & endpoint)
-{
-    if(s_ == INVALID_SOCKET)
-        return false;
-
-    if(data == 0)
-        return false;
-
-    NamedEvent complete_event;
-    if(!complete_event.init(true, false))
-        return false;
-
-    SocketAsyncContext args(complete_event);
-    args.SuppressIOCP();
-    args.SetBuffer(data, size_to_recv);
-    if(!ReceiveFromAsync(args))
-        return false;
-
-    if(!complete_event.Wait(timeout))
-        Cancel();
-
-    if(!WaitSocketAsyncEvent(args))
-        return false;
-
-    endpoint = args.remote_endpoint();
-    transfered = args.transfered();
-    return true;
-}
-
-bool Socket::ReceiveFromAsync(SocketAsyncContext & args)
-{
-    if(s_ == INVALID_SOCKET)
-        return false;
-
-    char * buffer = reinterpret_cast<char *>(args.buffer());
-    if(buffer == 0)
-        return false;
-
-    WSABUF wsa_buf = {args.count(), buffer};
-    DWORD * byte_transed_ptr = 0;//reinterpret_cast<DWORD *>(&args.transfered_);
-    auto socket_flag_ptr = reinterpret_cast<DWORD *>(&args.socket_flags_);
-    auto sa_ptr = reinterpret_cast<sockaddr *>(&args.remote_endpoint_.ep_);
-    auto sa_size_ptr = reinterpret_cast<int *>(&args.remote_endpoint_.ep_size_);
-    auto iocr = SocketRoutines::OnCompleted;
-    if(args.completion_delegate_ == 0 || io_handler_ != 0)
-        iocr = 0;
-    args.last_op_ = SocketAsyncOp::kAsyncRecvFrom;
-    if(WSARecvFrom(s_, &wsa_buf, 1, byte_transed_ptr, socket_flag_ptr, 
-                   sa_ptr, sa_size_ptr, &args.overlapped_, iocr))
-    {
-        DWORD last_err = WSAGetLastError();
-        if(last_err != ERROR_IO_PENDING)
-            return false;
-    }
-    return true;
-}
-
-bool Socket::SendTo(const void * data, uint32_t size_to_send, 
-                    const IPEndPoint & endpoint, uint32_t & transfered)
-{
-    return SendTo(data, size_to_send, endpoint, -1, transfered);
-}
-
-bool Socket::SendTo(const void * data, uint32_t size_to_send, 
-                    const IPEndPoint & endpoint, uint32_t timeout,
-                    uint32_t & transfered)
-{
-    if(s_ == INVALID_SOCKET)
-        return false;
-
-    if(data == 0)
-        return false;
-
-    NamedEvent complete_event;
-    if(!complete_event.init(true, false))
-        return false;
-
-    SocketAsyncContext args(complete_event);
-    args.SuppressIOCP();
-    args.SetBuffer(data, size_to_send);
-    args.set_remote_endpoint(endpoint);
-
-    if(!SendToAsync(args))
-        return false;
-
-    if(!complete_event.Wait(timeout))
-        Cancel();
-
-    if(!WaitSocketAsyncEvent(args))
-        return false;
-
-    transfered = args.transfered();
-
-    return true;
-}
-
-bool Socket::SendToAsync(SocketAsyncContext & args)
-{
-    if(s_ == INVALID_SOCKET)
-        return false;
-
-    char * buffer = reinterpret_cast<char *>(args.buffer());
-    if(buffer == 0)
-        return false;
-
-    WSABUF wsa_buf = {args.count(), buffer};
-    DWORD * byte_transed_ptr = 0;//reinterpret_cast<DWORD *>(&args.transfered_);
-    auto sa_ptr = reinterpret_cast<sockaddr *>(&args.remote_endpoint_.ep_);
-    auto iocr = SocketRoutines::OnCompleted;
-    if(args.completion_delegate_ == 0 || io_handler_ != 0)
-        iocr = 0;
-    args.last_op_ = SocketAsyncOp::kAsyncSendTo;
-    if(WSASendTo(s_, &wsa_buf, 1, byte_transed_ptr, args.socket_flags_, 
-                  sa_ptr, args.remote_endpoint_.ep_size_, &args.overlapped_, 
-                  iocr))
-    {
-        DWORD last_err = WSAGetLastError();
-        if(last_err != ERROR_IO_PENDING)
-            return false;
-    }
-    return true;
-}
-
-bool Socket::CanRead()
-{
-    if(s_ == INVALID_SOCKET)
-        return false;
-
-    fd_set read_fds;
-    FD_ZERO(&read_fds);
-    timeval timeout = {0, 0};
-    FD_SET(s_, &read_fds);
-    int result = select(1, &read_fds, NULL, NULL, &timeout);
-    if (result <= 0)
-        return false;
-
-    return FD_ISSET(s_, &read_fds) != 0;
-}
-
-bool Socket::CanWrite()
-{
-    if(s_ == INVALID_SOCKET)
-        return false;
-
-    fd_set write_fds;
-    FD_ZERO(&write_fds);
-    timeval timeout = {0, 0};
-    FD_SET(s_, &write_fds);
-    int result = select(1, NULL, &write_fds, NULL, &timeout);
-    if (result <= 0)
-        return false;
-
-    return FD_ISSET(s_, &write_fds) != 0;
-}
-
-bool Socket::IsValid()
-{
-    return s_ != INVALID_SOCKET;
-}
-
-bool Socket::Cancel()
-{
-    if(s_ == INVALID_SOCKET)
-        return false;
-
-    return ::CancelIo((HANDLE)s_) != FALSE;
-}
-
-bool Socket::Associate(Proactor & io)
-{
-    if(s_ == INVALID_SOCKET)
-        return false;
-
-    if(io.Associate(*this))
-    {
-        io_handler_ = &io;
-        return true;
-    }
-    return false;
-}
-
-void * Socket::GetPlatformHandle()
-{
-    return reinterpret_cast<void *>(s_);
-}
-
-void Socket::OnCompleted(AsyncContext & args,
-                         uint32_t error, 
-                         uint32_t transfered)
-{
-    auto & sock_args = static_cast<SocketAsyncContext&>(args);
-    switch(sock_args.last_op())
-    {
-    case SocketAsyncOp::kAsyncAccept:
-        {
-            setsockopt(sock_args.accept_socket_->s_, SOL_SOCKET, 
-                       SO_UPDATE_ACCEPT_CONTEXT, (char *)&s_, sizeof(s_));
-        }
-        break;
-    case SocketAsyncOp::kAsyncConnect:
-        {
-            setsockopt(sock_args.connect_socket_->s_, SOL_SOCKET, 
-                       SO_UPDATE_CONNECT_CONTEXT, 0, 0);
-        }
-        break;  
-    }
-    sock_args.OnCompleted(error, transfered);
-}
-
-bool Socket::WaitSocketAsyncEvent(SocketAsyncContext & args)
-{
-    bool succeed = true;
-    DWORD error = 0;
-    DWORD flag = 0;
-    DWORD transed = 0;
-
-    if(!WSAGetOverlappedResult(s_, &args.overlapped_, &transed, TRUE, &flag))
-    {
-        error = WSAGetLastError();
-        succeed = false;
-    }
-    args.socket_flags_ = flag;
-    OnCompleted(args, error, transed);
-    return succeed;
-}
-
-
+﻿#include <ncore/base/buffer.h>
+#include "file_stream.h"
+#include "named_event.h"
+#include "proactor.h"
+#include "socket_async_event_args.h"
+#include "socket.h"
+#include "socket_buffer_pool.h"
+
+namespace ncore
+{
+
+typedef BOOL (__stdcall * AcceptEx_t)(SOCKET sListenSocket, 
+                                      SOCKET sAcceptSocket,
+                                      PVOID lpOutputBuffer, 
+                                      DWORD dwReceiveDataLength,
+                                      DWORD dwLocalAddressLength,
+                                      DWORD dwRemoteAddressLength,
+                                      LPDWORD lpdwBytesReceived,
+                                      LPOVERLAPPED lpOverlapped);
+
+typedef BOOL (_stdcall * ConnectEx_t)(SOCKET s,
+                                      const struct sockaddr *name,
+                                      int namelen,
+                                      PVOID lpSendBuffer,
+                                      DWORD dwSendDataLength,
+                                      LPDWORD lpdwBytesSent,
+                                      LPOVERLAPPED lpOverlapped);
+
+typedef BOOL (__stdcall * DisconnectEx_t)(SOCKET hSocket,
+                                          LPOVERLAPPED lpOverlapped,
+                                          DWORD dwFlags,
+                                          DWORD reserved);
+
+typedef BOOL (__stdcall * TransmitFile_t)(SOCKET hSocket,
+                                          HANDLE hFile,
+                                          DWORD nNumberOfBytesToWrite,
+                                          DWORD nNumberOfBytesPerSend,
+                                          LPOVERLAPPED lpOverlapped,
+                                          LPTRANSMIT_FILE_BUFFERS lpTransmitBuffers,
+                                          DWORD dwReserved);
+
+static const size_t kAddressBufferSize  = sizeof(sockaddr_in) + 16;
+static const size_t kMinAcceptBufferSize = kAddressBufferSize * 2;
+
+
+class SocketRoutines
+{
+private:
+    friend class Socket;
+
+    static void __stdcall OnCompleted(DWORD dwError,
+                                      DWORD cbTransferred,
+                                      LPWSAOVERLAPPED lpOverlapped,
+                                      DWORD dwFlags)
+    {
+        auto & sae = *reinterpret_cast<SocketAsyncContext*>(lpOverlapped);
+        sae.socket_flags_ = dwFlags;
+        sae.OnCompleted(dwError, cbTransferred);
+    }
+
+    //把上下文中的缓冲区转换为WSABUF，返回段数，没有缓冲区时返回0
+    static DWORD GetWsaBuffers(const SocketAsyncContext & args, WSABUF * wsa_bufs)
+    {
+        if(args.buffer_count_ == 0)
+        {
+            if(args.buffer_ == 0)
+                return 0;
+            wsa_bufs[0].len = static_cast<ULONG>(args.count_);
+            wsa_bufs[0].buf = static_cast<char *>(args.buffer_);
+            return 1;
+        }
+
+        for(size_t index = 0; index < args.buffer_count_; ++index)
+        {
+            const SocketBuffer & segment = args.buffers_[index];
+            wsa_bufs[index].len = static_cast<ULONG>(segment.size);
+            wsa_bufs[index].buf = static_cast<char *>(segment.data);
+        }
+        return static_cast<DWORD>(args.buffer_count_);
+    }
+
+    //等待套接字就绪，超时时设置WSAETIMEDOUT
+    static bool WaitFor(SOCKET socket, SHORT events, uint32_t timeout)
+    {
+        WSAPOLLFD fd;
+        fd.fd = socket;
+        fd.events = events;
+        fd.revents = 0;
+
+        int result = WSAPoll(&fd, 1, static_cast<INT>(timeout));
+        if(result > 0)
+            return true;
+        if(result == 0)
+            WSASetLastError(WSAETIMEDOUT);
+        return false;
+    }
+
+    static bool IsInfinite(uint32_t timeout)
+    {
+        return timeout == static_cast<uint32_t>(-1);
+    }
+
+    static AcceptEx_t GetAcceptExAddress(SOCKET socket)
+    {
+        static AcceptEx_t AcceptEx = 0;
+        static GUID GuidAcceptEx = WSAID_ACCEPTEX;
+
+        if(AcceptEx == 0)
+        {
+            DWORD byte_received = 0;
+            WSAIoctl(socket, SIO_GET_EXTENSION_FUNCTION_POINTER, 
+                &GuidAcceptEx, sizeof(GuidAcceptEx), 
+                &AcceptEx, sizeof(AcceptEx), 
+                &byte_received, 0, 0);
+        }
+        return AcceptEx;
+    }
+
+    static ConnectEx_t GetConnectExAddress(SOCKET socket)
+    {
+        static ConnectEx_t ConnectEx = 0;
+        static GUID GuidConnectEx = WSAID_CONNECTEX;
+
+        if(ConnectEx == 0)
+        {
+            DWORD byte_received = 0;
+            WSAIoctl(socket, SIO_GET_EXTENSION_FUNCTION_POINTER, 
+                &GuidConnectEx, sizeof(GuidConnectEx), 
+                &ConnectEx, sizeof(ConnectEx), 
+                &byte_received, 0, 0);
+        }
+        return ConnectEx;
+    }
+
+    static DisconnectEx_t GetDisconnectExAddress(SOCKET socket)
+    {
+        static DisconnectEx_t DisconnectEx = 0;
+        static GUID GuidDisconnectEx = WSAID_DISCONNECTEX;
+
+        if(DisconnectEx == 0)
+        {
+            DWORD byte_received = 0;
+            WSAIoctl(socket, SIO_GET_EXTENSION_FUNCTION_POINTER, 
+                &GuidDisconnectEx, sizeof(GuidDisconnectEx), 
+                &DisconnectEx, sizeof(DisconnectEx), 
+                &byte_received, 0, 0);
+        }
+        return DisconnectEx;
+    }
+
+    static TransmitFile_t GetTransmitFileAddress(SOCKET socket)
+    {
+        static TransmitFile_t TransmitFile = 0;
+        static GUID GuidTransmitFile = WSAID_TRANSMITFILE;
+
+        if(TransmitFile == 0)
+        {
+            DWORD byte_received = 0;
+            WSAIoctl(socket, SIO_GET_EXTENSION_FUNCTION_POINTER, 
+                &GuidTransmitFile, sizeof(GuidTransmitFile), 
+                &TransmitFile, sizeof(TransmitFile), 
+                &byte_received, 0, 0);
+        }
+        return TransmitFile;
+    }
+
+    static bool GetProtocolInfo(SOCKET socket, 
+                                AddressFamily & af,
+                                SocketType & type,
+                                ProtocolType & protocol)
+    {
+        WSAPROTOCOL_INFO pi = {0};
+        char * ppi = reinterpret_cast<char *>(&pi);
+        int pi_size = sizeof(pi);
+        if(getsockopt(socket, SOL_SOCKET, SO_PROTOCOL_INFO, ppi, &pi_size))
+        {
+            return false;
+        }
+
+        af = static_cast<AddressFamily>(pi.iAddressFamily);
+        type = static_cast<SocketType>(pi.iSocketType);
+        protocol = static_cast<ProtocolType>(pi.iProtocol);
+        return true;
+    }   
+
+    //没有recvmmsg，逐个取出已经到达的数据报，不会阻塞
+    static size_t DrainDatagrams(SOCKET s, SocketDatagram * datagrams,
+                                 size_t count)
+    {
+        size_t received = 0;
+        while(received < count)
+        {
+            u_long pending = 0;
+            if(ioctlsocket(s, FIONREAD, &pending) || pending == 0)
+                break;
+
+            SocketDatagram & datagram = datagrams[received];
+            IPEndPoint & endpoint = datagram.endpoint;
+            int sa_size = sizeof(endpoint.ep_storage_);
+            int result = recvfrom(s, static_cast<char *>(datagram.data),
+                                  static_cast<int>(datagram.size), 0,
+                                  &endpoint.ep_, &sa_size);
+            if(result == SOCKET_ERROR)
+            {
+                //数据报被截断时仍然取出
+                if(WSAGetLastError() != WSAEMSGSIZE)
+                    break;
+                result = static_cast<int>(datagram.size);
+            }
+            endpoint.ep_size_ = sa_size;
+            datagram.transfered = static_cast<uint32_t>(result);
+            ++received;
+        }
+        return received;
+    }
+
+    //没有sendmmsg，逐个发送，UDP的sendto不会长时间阻塞
+    static size_t SendDatagrams(SOCKET s, SocketDatagram * datagrams,
+                                size_t count)
+    {
+        size_t sent = 0;
+        while(sent < count)
+        {
+            SocketDatagram & datagram = datagrams[sent];
+            const IPEndPoint & endpoint = datagram.endpoint;
+            const sockaddr * sa_ptr = endpoint.ep_size_ ? &endpoint.ep_ : 0;
+            int result = sendto(s, static_cast<const char *>(datagram.data),
+                                static_cast<int>(datagram.size), 0,
+                                sa_ptr, static_cast<int>(endpoint.ep_size_));
+            if(result == SOCKET_ERROR)
+                break;
+            datagram.transfered = static_cast<uint32_t>(result);
+            ++sent;
+        }
+        return sent;
+    }
+};
+
+
+Socket::Socket()
+    : s_(INVALID_SOCKET),
+      io_handler_(0)
+{
+
+}
+
+Socket::~Socket()
+{
+    Close();
+}
+
+Socket::Socket(Socket && obj)
+    : s_(INVALID_SOCKET),
+      io_handler_(0)
+{
+    std::swap(s_, obj.s_);
+    std::swap(io_handler_, obj.io_handler_);
+}
+
+Socket & Socket::operator = (Socket && obj)
+{
+    std::swap(s_, obj.s_);
+    std::swap(io_handler_, obj.io_handler_);
+    return *this;
+}
+
+bool Socket::init(AddressFamily af,
+                  SocketType type,
+                  ProtocolType protocol)
+{
+    if(s_ != INVALID_SOCKET)
+        return true;
+
+    s_= WSASocket(af, type, protocol, 0, 0, WSA_FLAG_OVERLAPPED);
+
+    return s_ != INVALID_SOCKET ? true : false;
+}
+
+void Socket::fini()
+{
+    Close();
+    return;
+}
+
+bool Socket::Close()
+{
+    auto ss = s_;
+    if(ss == INVALID_SOCKET)
+        return false;
+    s_ = INVALID_SOCKET;
+    if(closesocket(ss))
+        return false;
+    return true;
+}
+
+bool Socket::Bind(const IPEndPoint & endpoint)
+{
+    auto sa_ptr = reinterpret_cast<const sockaddr *>(&endpoint.ep_);
+    if(!bind(s_, sa_ptr, endpoint.ep_size_))
+        return true;
+    return false;
+}
+
+bool Socket::LocalEndPoint(IPEndPoint & endpoint) const
+{
+    sockaddr_storage storage;
+    int size = sizeof(storage);
+    auto sa_ptr = reinterpret_cast<sockaddr *>(&storage);
+    if(getsockname(s_, sa_ptr, &size))
+        return false;
+    if(sa_ptr->sa_family != AF_INET && sa_ptr->sa_family != AF_INET6)
+        return false;
+    endpoint = IPEndPoint::FromSockAddr(*sa_ptr);
+    return true;
+}
+
+bool Socket::Listen(int backlog)
+{
+    return listen(s_, backlog) ? false : true;
+}
+
+bool Socket::Shutdown(SocketShutdown how)
+{
+    return shutdown(s_, how) ? false : true;
+}
+
+Socket Socket::Accept()
+{
+    return Accept(-1);
+}
+
+Socket Socket::Accept(uint32_t timeout)
+{
+    Socket accept_socket;
+
+    if(s_ == INVALID_SOCKET)
+        return accept_socket;
+
+    //有连接到达之后再accept，不需要预先创建接受套接字和AcceptEx的上下文
+    if(!SocketRoutines::IsInfinite(timeout) &&
+       !SocketRoutines::WaitFor(s_, POLLRDNORM, timeout))
+        return accept_socket;
+
+    accept_socket.s_ = accept(s_, 0, 0);
+    return std::move(accept_socket);
+}
+
+bool Socket::AcceptAsync(SocketAsyncContext & args)
+{
+    AcceptEx_t AcceptEx = SocketRoutines::GetAcceptExAddress(s_);
+
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    if(AcceptEx == 0)
+        return false;
+
+    if(args.count_ < kMinAcceptBufferSize) 
+        return false;
+
+    if(args.accept_socket_ == 0)
+        return false;
+
+    if(args.accept_socket_->IsValid() == false)
+        return false;
+
+    if(args.buffer() == 0)
+        return false;
+
+    size_t output_size = args.count() - kMinAcceptBufferSize;
+    auto byte_transed_ptr = reinterpret_cast<DWORD *>(&args.transfered_);
+    args.last_op_ = SocketAsyncOp::kAsyncAccept;
+    StartDeadline(io_handler_, args);
+    if(!AcceptEx(s_, args.accept_socket_->s_, args.buffer(), output_size,
+                 kAddressBufferSize, kAddressBufferSize, 
+                 byte_transed_ptr, &args.overlapped_))
+    {
+        DWORD last_err = WSAGetLastError();
+        if(last_err != ERROR_IO_PENDING)
+        {
+            StopDeadline(args);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Socket::Connect(const IPEndPoint & endpoint)
+{
+    return Connect(endpoint, -1);
+}
+
+bool Socket::Connect(const IPEndPoint & endpoint, uint32_t timeout)
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    //不超时的连接直接阻塞在connect上
+    if(SocketRoutines::IsInfinite(timeout))
+    {
+        auto sa_ptr = reinterpret_cast<const sockaddr *>(&endpoint.ep_);
+        return connect(s_, sa_ptr, static_cast<int>(endpoint.ep_size_)) == 0;
+    }
+
+    NamedEvent * complete_event = GetCompleteEvent();
+    if(complete_event == 0)
+        return false;
+
+    SocketAsyncContext args(*complete_event);
+    args.SuppressIOCP();
+    args.set_remote_endpoint(endpoint);
+
+    if(!ConnectAsync(args))
+        return false;
+
+    if(!complete_event->Wait(timeout))
+        Cancel();
+
+    if(!WaitSocketAsyncEvent(args))
+        return false;
+
+    return true;
+}
+
+bool Socket::ConnectAsync(SocketAsyncContext & args)
+{
+    ConnectEx_t ConnectEx = SocketRoutines::GetConnectExAddress(s_);
+
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    if(ConnectEx == 0)
+        return false;
+
+    //ConnectEx要求先绑定，AF_UNIX的套接字不绑定到IP地址
+    IPEndPoint & ep = args.remote_endpoint();
+    if(ep.AddressFamily() != kUnix && !Bind(IPEndPoint::kAny))
+        if(WSAGetLastError() != WSAEINVAL)
+            return false;			//绑定失败
+
+    auto sa_ptr = reinterpret_cast<sockaddr *>(&ep.ep_);
+    auto byte_transed_ptr = reinterpret_cast<DWORD *>(&args.transfered_);
+    args.connect_socket_ = this;
+    args.last_op_ = SocketAsyncOp::kAsyncConnect;
+    StartDeadline(io_handler_, args);
+    if(!ConnectEx(s_, sa_ptr, ep.ep_size_, args.buffer(), args.count(),
+                  byte_transed_ptr, &args.overlapped_))
+    {
+        DWORD last_err = WSAGetLastError();
+        if(last_err != ERROR_IO_PENDING)
+        {
+            StopDeadline(args);
+            return false;
+        }
+    }
+    return true;
+}
+
+void Socket::Disconnect(bool reuse)
+{
+    if(s_ == INVALID_SOCKET)
+        return;
+
+    NamedEvent * complete_event = GetCompleteEvent();
+    if(complete_event == 0)
+        return;
+
+    SocketAsyncContext args(*complete_event);
+    args.SuppressIOCP();
+    args.set_reuse(reuse);
+    
+    if(!DisconnectAsync(args))
+        return;
+
+    if(!complete_event->Wait(-1))
+        return;
+
+    if(!WaitSocketAsyncEvent(args))
+        return;
+
+    return;
+}
+
+bool Socket::DisconnectAsync(SocketAsyncContext & args)
+{
+    DisconnectEx_t DisconnectEx = SocketRoutines::GetDisconnectExAddress(s_);
+
+    if(s_ == INVALID_SOCKET)
+        return false;
+    if(DisconnectEx == 0)
+        return false;
+
+    args.last_op_ = SocketAsyncOp::kAsyncDisconnect;
+    StartDeadline(io_handler_, args);
+    if(!DisconnectEx(s_, &args.overlapped_, 
+                     args.reuse()? TF_REUSE_SOCKET: 0, 0))
+    {
+        DWORD last_err = WSAGetLastError();
+        if(last_err != ERROR_IO_PENDING)
+        {
+            StopDeadline(args);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Socket::Receive(void * data, uint32_t size_to_recv, uint32_t & transfered)
+{
+    return Receive(data, size_to_recv, -1, transfered);
+}
+
+bool Socket::Receive(void * data, uint32_t size_to_recv, uint32_t timeout,
+                     uint32_t & transfered)
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    if(data == 0)
+        return false;
+
+    //可读之后的recv不会阻塞，超时时不需要取消重叠的请求
+    if(!SocketRoutines::IsInfinite(timeout) &&
+       !SocketRoutines::WaitFor(s_, POLLRDNORM, timeout))
+        return false;
+
+    int result = recv(s_, static_cast<char *>(data),
+                      static_cast<int>(size_to_recv), 0);
+    if(result == SOCKET_ERROR)
+        return false;
+
+    transfered = static_cast<uint32_t>(result);
+    return true;
+}
+
+bool Socket::ReceiveAsync(SocketAsyncContext & args)
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    WSABUF wsa_bufs[SocketAsyncContext::kMaxBuffers];
+    DWORD buf_count = SocketRoutines::GetWsaBuffers(args, wsa_bufs);
+    if(buf_count == 0)
+        return false;
+
+    DWORD * byte_transed_ptr = 0;//reinterpret_cast<DWORD *>(&args.transfered_);
+    auto socket_flag_ptr = reinterpret_cast<DWORD *>(&args.socket_flags_);
+    auto iocr = SocketRoutines::OnCompleted;
+    if(args.completion_delegate_ == 0 || io_handler_ != 0)
+        iocr = 0;
+    args.last_op_ = SocketAsyncOp::kAsyncRecv;
+    StartDeadline(io_handler_, args);
+    if(WSARecv(s_, wsa_bufs, buf_count, byte_transed_ptr, socket_flag_ptr, 
+               &args.overlapped_, iocr))
+    {
+        DWORD last_err = WSAGetLastError();
+        if(last_err != ERROR_IO_PENDING)
+        {
+            StopDeadline(args);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Socket::ReceivePooledAsync(SocketAsyncContext & args, SocketBufferPool & pool)
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    //零字节的接收只等待数据到达，不占用缓冲区
+    WSABUF wsa_buf;
+    wsa_buf.buf = 0;
+    wsa_buf.len = 0;
+
+    args.SetBuffer(static_cast<void *>(0), 0);
+    args.buffer_pool_ = &pool;
+    args.socket_flags_ = 0;
+    auto socket_flag_ptr = reinterpret_cast<DWORD *>(&args.socket_flags_);
+    auto iocr = SocketRoutines::OnCompleted;
+    if(args.completion_delegate_ == 0 || io_handler_ != 0)
+        iocr = 0;
+    args.last_op_ = SocketAsyncOp::kAsyncRecvPooled;
+    StartDeadline(io_handler_, args);
+    if(WSARecv(s_, &wsa_buf, 1, 0, socket_flag_ptr, &args.overlapped_, iocr))
+    {
+        DWORD last_err = WSAGetLastError();
+        if(last_err != ERROR_IO_PENDING)
+        {
+            StopDeadline(args);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Socket::Send(const void * data, uint32_t size_to_send, 
+                  uint32_t & transfered)
+{
+    return Send(data, size_to_send, -1, transfered);
+}
+
+bool Socket::Send(const void * data, uint32_t size_to_send, uint32_t timeout,
+                  uint32_t & transfered)
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    if(data == 0)
+        return false;
+
+    //阻塞的send在数据全部进入发送缓冲区之前不返回，只有不超时时可以直接调用
+    if(SocketRoutines::IsInfinite(timeout))
+    {
+        int result = send(s_, static_cast<const char *>(data),
+                          static_cast<int>(size_to_send), 0);
+        if(result == SOCKET_ERROR)
+            return false;
+
+        transfered = static_cast<uint32_t>(result);
+        return true;
+    }
+
+    NamedEvent * complete_event = GetCompleteEvent();
+    if(complete_event == 0)
+        return false;
+
+    SocketAsyncContext args(*complete_event);
+    args.SuppressIOCP();
+    args.SetBuffer(data, size_to_send);
+    if(!SendAsync(args))
+        return false;
+
+    if(!complete_event->Wait(timeout))
+        Cancel();
+
+    if(!WaitSocketAsyncEvent(args))
+        return false;
+
+    transfered = args.transfered();
+    return true;
+}
+
+bool Socket::SendAsync(SocketAsyncContext & args)
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    WSABUF wsa_bufs[SocketAsyncContext::kMaxBuffers];
+    DWORD buf_count = SocketRoutines::GetWsaBuffers(args, wsa_bufs);
+    if(buf_count == 0)
+        return false;
+
+    DWORD * byte_transed_ptr = 0;//reinterpret_cast<DWORD *>(&args.transfered_);
+    auto iocr = SocketRoutines::OnCompleted;
+    if(args.completion_delegate_ == 0 || io_handler_ != 0)
+        iocr = 0;
+    args.last_op_ = SocketAsyncOp::kAsyncSend;
+    StartDeadline(io_handler_, args);
+    if(WSASend(s_, wsa_bufs, buf_count, byte_transed_ptr, args.socket_flags_, 
+               &args.overlapped_, iocr))
+    {
+        DWORD last_err = WSAGetLastError();
+        if(last_err != ERROR_IO_PENDING)
+        {
+            StopDeadline(args);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Socket::SendFile(FileStream & file, uint64_t offset, uint32_t length,
+                      const SocketBuffer & header, const SocketBuffer & trailer,
+                      uint32_t & transfered)
+{
+    transfered = 0;
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    NamedEvent * complete_event = GetCompleteEvent();
+    if(complete_event == 0)
+        return false;
+
+    SocketFileAsyncContext args(*complete_event);
+    args.SuppressIOCP();
+    args.SetFile(file, offset, length);
+    args.SetHeader(header.data, header.size);
+    args.SetTrailer(trailer.data, trailer.size);
+    if(!SendFileAsync(args))
+    {
+        //TransmitFile不可用时改为读取后发送
+        DWORD last_err = WSAGetLastError();
+        if(last_err != WSAEOPNOTSUPP && last_err != WSAEINVAL &&
+           SocketRoutines::GetTransmitFileAddress(s_) != 0)
+            return false;
+        uint64_t total = 0;
+        bool succeed = SendFileByCopy(file, offset, length, header, trailer,
+                                      total);
+        transfered = ClampTransfered(total);
+        return succeed;
+    }
+
+    if(!WaitSocketAsyncEvent(args))
+        return false;
+
+    transfered = args.transfered();
+    return true;
+}
+
+bool Socket::SendFileAsync(SocketFileAsyncContext & args)
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    if(args.file_ == 0 || !args.file_->IsValid())
+        return false;
+
+    TransmitFile_t TransmitFile = SocketRoutines::GetTransmitFileAddress(s_);
+    if(TransmitFile == 0)
+        return false;
+
+    //TransmitFile从OVERLAPPED中的偏移处读取文件
+    args.overlapped_.Offset = static_cast<DWORD>(args.file_offset_);
+    args.overlapped_.OffsetHigh = static_cast<DWORD>(args.file_offset_ >> 32);
+
+    LPTRANSMIT_FILE_BUFFERS transmit_buffers = 0;
+    if(args.header_.size || args.trailer_.size)
+    {
+        args.transmit_buffers_.Head = args.header_.data;
+        args.transmit_buffers_.HeadLength = static_cast<DWORD>(args.header_.size);
+        args.transmit_buffers_.Tail = args.trailer_.data;
+        args.transmit_buffers_.TailLength = static_cast<DWORD>(args.trailer_.size);
+        transmit_buffers = &args.transmit_buffers_;
+    }
+
+    args.last_op_ = SocketAsyncOp::kAsyncSendFile;
+    StartDeadline(io_handler_, args);
+    if(!TransmitFile(s_, args.file_->handle_, args.file_length_, 0,
+                     &args.overlapped_, transmit_buffers, 0))
+    {
+        DWORD last_err = WSAGetLastError();
+        if(last_err != ERROR_IO_PENDING)
+        {
+            StopDeadline(args);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Socket::ReceiveFrom(void * data, uint32_t size_to_recv, 
+                        uint32_t & transfered, IPEndPoint & endpoint)
+{
+    return ReceiveFrom(data, size_to_recv, -1, transfered, endpoint);
+}
+
+bool Socket::ReceiveFrom(void * data, uint32_t size_to_recv, uint32_t timeout,
+                        uint32_t & transfered, IPEndPoint & endpoint)
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    if(data == 0)
+        return false;
+
+    if(!SocketRoutines::IsInfinite(timeout) &&
+       !SocketRoutines::WaitFor(s_, POLLRDNORM, timeout))
+        return false;
+
+    int sa_size = sizeof(endpoint.ep_storage_);
+    int result = recvfrom(s_, static_cast<char *>(data),
+                          static_cast<int>(size_to_recv), 0,
+                          &endpoint.ep_, &sa_size);
+    if(result == SOCKET_ERROR)
+        return false;
+
+    endpoint.ep_size_ = sa_size;
+    transfered = static_cast<uint32_t>(result);
+    return true;
+}
+
+bool Socket::ReceiveFromAsync(SocketAsyncContext & args)
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    WSABUF wsa_bufs[SocketAsyncContext::kMaxBuffers];
+    DWORD buf_count = SocketRoutines::GetWsaBuffers(args, wsa_bufs);
+    if(buf_count == 0)
+        return false;
+
+    DWORD * byte_transed_ptr = 0;//reinterpret_cast<DWORD *>(&args.transfered_);
+    auto socket_flag_ptr = reinterpret_cast<DWORD *>(&args.socket_flags_);
+    auto sa_ptr = reinterpret_cast<sockaddr *>(&args.remote_endpoint_.ep_);
+    auto sa_size_ptr = reinterpret_cast<int *>(&args.remote_endpoint_.ep_size_);
+    auto iocr = SocketRoutines::OnCompleted;
+    if(args.completion_delegate_ == 0 || io_handler_ != 0)
+        iocr = 0;
+    args.last_op_ = SocketAsyncOp::kAsyncRecvFrom;
+    StartDeadline(io_handler_, args);
+    if(WSARecvFrom(s_, wsa_bufs, buf_count, byte_transed_ptr, socket_flag_ptr, 
+                   sa_ptr, sa_size_ptr, &args.overlapped_, iocr))
+    {
+        DWORD last_err = WSAGetLastError();
+        if(last_err != ERROR_IO_PENDING)
+        {
+            StopDeadline(args);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Socket::SendTo(const void * data, uint32_t size_to_send, 
+                    const IPEndPoint & endpoint, uint32_t & transfered)
+{
+    return SendTo(data, size_to_send, endpoint, -1, transfered);
+}
+
+bool Socket::SendTo(const void * data, uint32_t size_to_send, 
+                    const IPEndPoint & endpoint, uint32_t timeout,
+                    uint32_t & transfered)
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    if(data == 0)
+        return false;
+
+    //数据报一次发出，不超时时直接调用
+    if(SocketRoutines::IsInfinite(timeout))
+    {
+        int result = sendto(s_, static_cast<const char *>(data),
+                            static_cast<int>(size_to_send), 0, &endpoint.ep_,
+                            static_cast<int>(endpoint.ep_size_));
+        if(result == SOCKET_ERROR)
+            return false;
+
+        transfered = static_cast<uint32_t>(result);
+        return true;
+    }
+
+    NamedEvent * complete_event = GetCompleteEvent();
+    if(complete_event == 0)
+        return false;
+
+    SocketAsyncContext args(*complete_event);
+    args.SuppressIOCP();
+    args.SetBuffer(data, size_to_send);
+    args.set_remote_endpoint(endpoint);
+
+    if(!SendToAsync(args))
+        return false;
+
+    if(!complete_event->Wait(timeout))
+        Cancel();
+
+    if(!WaitSocketAsyncEvent(args))
+        return false;
+
+    transfered = args.transfered();
+
+    return true;
+}
+
+bool Socket::SendToAsync(SocketAsyncContext & args)
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    WSABUF wsa_bufs[SocketAsyncContext::kMaxBuffers];
+    DWORD buf_count = SocketRoutines::GetWsaBuffers(args, wsa_bufs);
+    if(buf_count == 0)
+        return false;
+
+    DWORD * byte_transed_ptr = 0;//reinterpret_cast<DWORD *>(&args.transfered_);
+    auto sa_ptr = reinterpret_cast<sockaddr *>(&args.remote_endpoint_.ep_);
+    auto iocr = SocketRoutines::OnCompleted;
+    if(args.completion_delegate_ == 0 || io_handler_ != 0)
+        iocr = 0;
+    args.last_op_ = SocketAsyncOp::kAsyncSendTo;
+    StartDeadline(io_handler_, args);
+    if(WSASendTo(s_, wsa_bufs, buf_count, byte_transed_ptr, args.socket_flags_, 
+                  sa_ptr, args.remote_endpoint_.ep_size_, &args.overlapped_, 
+                  iocr))
+    {
+        DWORD last_err = WSAGetLastError();
+        if(last_err != ERROR_IO_PENDING)
+        {
+            StopDeadline(args);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Socket::ReceiveFromBatch(SocketDatagram * datagrams, size_t count,
+                              uint32_t timeout, size_t & received)
+{
+    received = 0;
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    if(datagrams == 0 || count == 0)
+        return false;
+
+    SocketDatagram & first = datagrams[0];
+    first.transfered = 0;
+    if(!ReceiveFrom(first.data, first.size, timeout,
+                    first.transfered, first.endpoint))
+        return false;
+
+    received = 1 + SocketRoutines::DrainDatagrams(s_, datagrams + 1, count - 1);
+    return true;
+}
+
+bool Socket::ReceiveFromBatchAsync(SocketBatchAsyncContext & args)
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    //其余的数据报在Socket::OnCompleted中取出，必须经过前摄器完成
+    if(io_handler_ == 0)
+        return false;
+
+    if(args.datagram_count_ == 0)
+        return false;
+
+    SocketDatagram & first = args.datagrams_[0];
+    first.transfered = 0;
+    first.endpoint.ep_size_ = sizeof(first.endpoint.ep_storage_);
+
+    WSABUF wsa_buf;
+    wsa_buf.len = static_cast<ULONG>(first.size);
+    wsa_buf.buf = static_cast<char *>(first.data);
+    auto socket_flag_ptr = reinterpret_cast<DWORD *>(&args.socket_flags_);
+    auto sa_ptr = reinterpret_cast<sockaddr *>(&first.endpoint.ep_);
+    auto sa_size_ptr = reinterpret_cast<int *>(&first.endpoint.ep_size_);
+    args.last_op_ = SocketAsyncOp::kAsyncRecvFromBatch;
+    StartDeadline(io_handler_, args);
+    if(WSARecvFrom(s_, &wsa_buf, 1, 0, socket_flag_ptr, 
+                   sa_ptr, sa_size_ptr, &args.overlapped_, 0))
+    {
+        DWORD last_err = WSAGetLastError();
+        if(last_err != ERROR_IO_PENDING)
+        {
+            StopDeadline(args);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Socket::SendToBatch(SocketDatagram * datagrams, size_t count,
+                         size_t & sent)
+{
+    sent = 0;
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    if(datagrams == 0 || count == 0)
+        return false;
+
+    sent = SocketRoutines::SendDatagrams(s_, datagrams, count);
+    return sent == count;
+}
+
+bool Socket::SendToBatchAsync(SocketBatchAsyncContext & args)
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    if(io_handler_ == 0)
+        return false;
+
+    if(args.datagram_count_ == 0)
+        return false;
+
+    SocketDatagram & first = args.datagrams_[0];
+    first.transfered = 0;
+
+    WSABUF wsa_buf;
+    wsa_buf.len = static_cast<ULONG>(first.size);
+    wsa_buf.buf = static_cast<char *>(first.data);
+    auto sa_ptr = first.endpoint.ep_size_ ? &first.endpoint.ep_ : 0;
+    args.last_op_ = SocketAsyncOp::kAsyncSendToBatch;
+    StartDeadline(io_handler_, args);
+    if(WSASendTo(s_, &wsa_buf, 1, 0, args.socket_flags_, 
+                 sa_ptr, static_cast<int>(first.endpoint.ep_size_),
+                 &args.overlapped_, 0))
+    {
+        DWORD last_err = WSAGetLastError();
+        if(last_err != ERROR_IO_PENDING)
+        {
+            StopDeadline(args);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Socket::CanRead()
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    fd_set read_fds;
+    FD_ZERO(&read_fds);
+    timeval timeout = {0, 0};
+    FD_SET(s_, &read_fds);
+    int result = select(1, &read_fds, NULL, NULL, &timeout);
+    if (result <= 0)
+        return false;
+
+    return FD_ISSET(s_, &read_fds) != 0;
+}
+
+bool Socket::CanWrite()
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    fd_set write_fds;
+    FD_ZERO(&write_fds);
+    timeval timeout = {0, 0};
+    FD_SET(s_, &write_fds);
+    int result = select(1, NULL, &write_fds, NULL, &timeout);
+    if (result <= 0)
+        return false;
+
+    return FD_ISSET(s_, &write_fds) != 0;
+}
+
+bool Socket::SetPacingRate(uint64_t rate)
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    ::WSASetLastError(WSAEOPNOTSUPP);
+    return false;
+}
+
+bool Socket::IsValid()
+{
+    return s_ != INVALID_SOCKET;
+}
+
+bool Socket::Cancel()
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    return ::CancelIo((HANDLE)s_) != FALSE;
+}
+
+bool Socket::Associate(Proactor & io)
+{
+    if(s_ == INVALID_SOCKET)
+        return false;
+
+    if(io.Associate(*this))
+    {
+        io_handler_ = &io;
+        return true;
+    }
+    return false;
+}
+
+void * Socket::GetPlatformHandle()
+{
+    return reinterpret_cast<void *>(s_);
+}
+
+void Socket::OnCompleted(AsyncContext & args,
+                         uint32_t error, 
+                         uint32_t transfered)
+{
+    auto & sock_args = static_cast<SocketAsyncContext&>(args);
+    switch(sock_args.last_op())
+    {
+    case SocketAsyncOp::kAsyncAccept:
+        {
+            setsockopt(sock_args.accept_socket_->s_, SOL_SOCKET, 
+                       SO_UPDATE_ACCEPT_CONTEXT, (char *)&s_, sizeof(s_));
+        }
+        break;
+    case SocketAsyncOp::kAsyncConnect:
+        {
+            setsockopt(sock_args.connect_socket_->s_, SOL_SOCKET, 
+                       SO_UPDATE_CONNECT_CONTEXT, 0, 0);
+        }
+        break;  
+    case SocketAsyncOp::kAsyncRecvPooled:
+        {
+            //零字节的接收完成表示数据已经到达，此时才从池中取出缓冲区
+            SocketBufferPool & pool = *sock_args.buffer_pool_;
+            void * buffer = error == 0 ? pool.Acquire() : 0;
+            if(error == 0 && buffer == 0)
+                error = WSAENOBUFS;
+            if(buffer)
+            {
+                int result = recv(s_, static_cast<char *>(buffer),
+                                  pool.buffer_size(), 0);
+                if(result > 0)
+                {
+                    sock_args.buffer_ = buffer;
+                    sock_args.count_ = pool.buffer_size();
+                    transfered = static_cast<uint32_t>(result);
+                }
+                else
+                {
+                    //对端关闭时照常以0字节完成
+                    if(result < 0)
+                        error = WSAGetLastError();
+                    transfered = 0;
+                    pool.Release(buffer);
+                }
+            }
+        }
+        break;
+    case SocketAsyncOp::kAsyncRecvFromBatch:
+    case SocketAsyncOp::kAsyncSendToBatch:
+        {
+            //第一个数据报以重叠I/O完成，其余的在此取出或者发送，transfered改为数据报个数
+            auto & batch = static_cast<SocketBatchAsyncContext&>(args);
+            if(error == 0)
+            {
+                SocketDatagram * rest = batch.datagrams_ + 1;
+                size_t rest_count = batch.datagram_count_ - 1;
+                batch.datagrams_[0].transfered = transfered;
+                if(batch.last_op() == SocketAsyncOp::kAsyncRecvFromBatch)
+                    rest_count = SocketRoutines::DrainDatagrams(s_, rest, rest_count);
+                else
+                    rest_count = SocketRoutines::SendDatagrams(s_, rest, rest_count);
+                transfered = static_cast<uint32_t>(1 + rest_count);
+            }
+        }
+        break;
+    }
+    sock_args.OnCompleted(error, transfered);
+}
+
+uint32_t Socket::GetStatsOp(AsyncContext & args)
+{
+    return static_cast<SocketAsyncContext&>(args).last_op();
+}
+
+bool Socket::WaitSocketAsyncEvent(SocketAsyncContext & args)
+{
+    bool succeed = true;
+    DWORD error = 0;
+    DWORD flag = 0;
+    DWORD transed = 0;
+
+    if(!WSAGetOverlappedResult(s_, &args.overlapped_, &transed, TRUE, &flag))
+    {
+        error = WSAGetLastError();
+        succeed = false;
+    }
+    args.socket_flags_ = flag;
+    OnCompleted(args, error, transed);
+    return succeed;
+}
+
+
 }
\ No newline at end of file
@@ -0,0 +1,237 @@
+﻿#include "proactor.h"
+#include "socket.h"
+#include "socket_writer.h"
+
+namespace ncore
+{
+
+#if defined NCORE_WINDOWS
+static const uint32_t kMoreFlag = 0;
+static const uint32_t kInvalidError = WSAEINVAL;
+
+static uint32_t GetLastSocketError()
+{
+    return ::WSAGetLastError();
+}
+#elif defined NCORE_LINUX
+static const uint32_t kMoreFlag = MSG_MORE;
+static const uint32_t kInvalidError = EINVAL;
+
+static uint32_t GetLastSocketError()
+{
+    return errno;
+}
+#endif
+
+//解除MSG_MORE时没有数据可发，以空的发送把内核中积压的报文段推出
+static const char kEmptyBuffer[1] = {0};
+
+
+SocketWriter::SocketWriter()
+    : socket_(0), proactor_(0), flush_size_(0),
+      in_flight_(false), deferred_(false), flush_requested_(false),
+      corked_(false), error_(0)
+{
+    memset(&stats_, 0, sizeof(stats_));
+    flush_task_.Register(this, &SocketWriter::OnFlushTask);
+    adapter_.Register(this, &SocketWriter::OnSent);
+    args_.set_completion_delegate(&adapter_);
+}
+
+SocketWriter::~SocketWriter()
+{
+    fini();
+}
+
+bool SocketWriter::init(Socket & socket, Proactor & proactor, size_t flush_size)
+{
+    if(socket_ || flush_size == 0)
+        return false;
+
+    socket_ = &socket;
+    proactor_ = &proactor;
+    flush_size_ = flush_size;
+    pending_.reserve(flush_size);
+    sending_.reserve(flush_size);
+    error_ = 0;
+    memset(&stats_, 0, sizeof(stats_));
+    return true;
+}
+
+void SocketWriter::fini()
+{
+    if(socket_ == 0)
+        return;
+
+    assert(!in_flight_ && !deferred_);
+    pending_.clear();
+    sending_.clear();
+    corked_ = false;
+    flush_requested_ = false;
+    socket_ = 0;
+    proactor_ = 0;
+}
+
+bool SocketWriter::Write(const void * data, size_t size)
+{
+    if(socket_ == 0)
+        return false;
+
+    lock_.Acquire();
+    if(error_)
+    {
+        lock_.Release();
+        return false;
+    }
+
+    const char * bytes = static_cast<const char *>(data);
+    pending_.insert(pending_.end(), bytes, bytes + size);
+    ++stats_.writes;
+
+    if(!deferred_)
+        deferred_ = proactor_->Defer(flush_task_);
+
+    //推迟的发送一定在之后进行，阈值触发的发送可以带MSG_MORE
+    bool start = pending_.size() >= flush_size_ && Prepare(deferred_);
+    lock_.Release();
+
+    return start ? Submit() : true;
+}
+
+bool SocketWriter::Flush()
+{
+    if(socket_ == 0)
+        return false;
+
+    lock_.Acquire();
+    if(error_)
+    {
+        lock_.Release();
+        return false;
+    }
+
+    bool start = Prepare(false);
+    lock_.Release();
+
+    return start ? Submit() : true;
+}
+
+size_t SocketWriter::buffered() const
+{
+    lock_.Acquire();
+    size_t size = pending_.size();
+    lock_.Release();
+    return size;
+}
+
+uint32_t SocketWriter::error() const
+{
+    return error_;
+}
+
+SocketWriterStats SocketWriter::stats() const
+{
+    lock_.Acquire();
+    SocketWriterStats stats = stats_;
+    lock_.Release();
+    return stats;
+}
+
+bool SocketWriter::Prepare(bool more)
+{
+    if(in_flight_)
+    {
+        if(!more)
+            flush_requested_ = true;
+        return false;
+    }
+
+    if(pending_.empty())
+    {
+        if(more || !corked_)
+            return false;
+
+        args_.SetBuffer(kEmptyBuffer, 0);
+    }
+    else
+    {
+        pending_.swap(sending_);
+        pending_.clear();
+        args_.SetBuffer(&sending_[0], sending_.size());
+    }
+
+    args_.set_socket_flags(more ? kMoreFlag : 0);
+    corked_ = more && kMoreFlag != 0;
+    in_flight_ = true;
+    ++stats_.sends;
+    return true;
+}
+
+bool SocketWriter::Submit()
+{
+    if(socket_->SendAsync(args_))
+        return true;
+
+    uint32_t error = GetLastSocketError();
+    lock_.Acquire();
+    error_ = error ? error : kInvalidError;
+    in_flight_ = false;
+    flush_requested_ = false;
+    pending_.clear();
+    lock_.Release();
+    return false;
+}
+
+void SocketWriter::OnFlushTask()
+{
+    lock_.Acquire();
+    deferred_ = false;
+    bool start = error_ == 0 && Prepare(false);
+    lock_.Release();
+
+    if(start)
+        Submit();
+}
+
+void SocketWriter::OnSent(SocketAsyncContext & args)
+{
+    lock_.Acquire();
+    if(args.error())
+    {
+        error_ = args.error();
+        in_flight_ = false;
+        flush_requested_ = false;
+        pending_.clear();
+        lock_.Release();
+        return;
+    }
+
+    stats_.bytes += args.transfered();
+    if(args.ConsumeBuffers(args.transfered()))
+    {
+        //部分完成，以同样的标志发送剩余的部分
+        ++stats_.sends;
+        lock_.Release();
+        Submit();
+        return;
+    }
+
+    in_flight_ = false;
+    bool start = false;
+    if(flush_requested_)
+    {
+        flush_requested_ = false;
+        start = Prepare(false);
+    }
+    else if(pending_.size() >= flush_size_)
+    {
+        start = Prepare(deferred_);
+    }
+    lock_.Release();
+
+    if(start)
+        Submit();
+}
+
+
+}
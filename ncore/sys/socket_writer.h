@@ -0,0 +1,105 @@
+﻿#ifndef NCORE_SYS_SOCKET_WRITER_H_
+#define NCORE_SYS_SOCKET_WRITER_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include "spin_lock.h"
+#include "async_task.h"
+#include "socket_async_event_args.h"
+
+namespace ncore
+{
+
+
+class Socket;
+class Proactor;
+
+struct SocketWriterStats
+{
+    uint64_t writes;    //Write的次数
+    uint64_t sends;     //提交的发送次数，writes - sends即省去的系统调用
+    uint64_t bytes;     //发送完成的字节数
+};
+
+/*! 合并小块写的套接字写入器\n
+Write把数据复制到缓冲区，以下三种情况把缓冲区一次SendAsync发出：
+缓冲的字节数达到阈值、调用Flush、前摄器本次分发结束（见Proactor::Defer）。\n
+在前摄器的回调之外调用Write时没有分发结束的时机，需要调用Flush。\n
+同一时刻只有一个发送在途，在途期间写入另一块缓冲区，部分完成时自动发送剩余的部分。
+Linux下分发结束之前因阈值发出的数据带MSG_MORE，由分发结束时的发送解除，
+使一批回调中的写尽量合并成完整的报文段。\n
+套接字需要事先关联到前摄器，使用期间不能在套接字上直接发送。\n
+*/
+class SocketWriter : public NonCopyableObject
+{
+public:
+    static const size_t kDefaultFlushSize = 16384;
+
+public:
+    SocketWriter();
+    ~SocketWriter();
+
+    /*! 初始化
+    @param[in] socket       已经连接并关联到proactor的套接字。
+    @param[in] proactor     套接字关联的前摄器，在其分发结束时发送。
+    @param[in] flush_size   缓冲的字节数达到该值时立即发送。
+    @return 初始化成功后返回true；否则返回false。
+    */
+    bool init(Socket & socket, Proactor & proactor,
+              size_t flush_size = kDefaultFlushSize);
+
+    //必须在发送全部完成之后调用
+    void fini();
+
+    /*! 写入数据
+    @return 写入缓冲区后返回true；已经出错时返回false。
+    */
+    bool Write(const void * data, size_t size);
+
+    /*! 立即发送缓冲的数据
+    @return 已经出错时返回false。
+    @remark 有发送在途时，在其完成之后发送。\n
+    */
+    bool Flush();
+
+    //缓冲中尚未提交的字节数
+    size_t buffered() const;
+
+    //第一个发送错误，出错后缓冲的数据被丢弃，Write不再接受数据
+    uint32_t error() const;
+
+    SocketWriterStats stats() const;
+
+private:
+    //准备发送缓冲的数据，more表示之后一定还有一次发送，在锁内调用
+    bool Prepare(bool more);
+
+    //在锁外调用
+    bool Submit();
+
+    void OnFlushTask();
+
+    void OnSent(SocketAsyncContext & args);
+
+private:
+    Socket * socket_;
+    Proactor * proactor_;
+    size_t flush_size_;
+    mutable SpinLock lock_;
+    std::vector<char> pending_;     //正在写入的缓冲区
+    std::vector<char> sending_;     //正在发送的缓冲区
+    bool in_flight_;
+    bool deferred_;                 //已经推迟到分发结束时发送
+    bool flush_requested_;          //在途的发送完成后需要发送
+    bool corked_;                   //最近的发送带MSG_MORE
+    uint32_t error_;
+    SocketWriterStats stats_;
+    AsyncTaskAdapter<SocketWriter> flush_task_;     //分发结束时发送
+    SocketAsyncContext args_;
+    SocketAsyncResultAdapter<SocketWriter> adapter_;
+};
+
+
+}
+
+#endif
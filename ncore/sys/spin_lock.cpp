@@ -1,29 +1,29 @@
-﻿#include "spin_lock.h"
-
-namespace ncore
-{
-
-SpinLock::SpinLock()
-{
-}
-
-SpinLock::~SpinLock()
-{
-}
-
-bool SpinLock::TryAcquire()
-{
-    return !locker_.CompareExchange(1, 0);
-}
-
-void SpinLock::Acquire()
-{
-    while(locker_.CompareExchange(1, 0));
-}
-
-void SpinLock::Release()
-{
-    locker_ = 0;
-}
-
+﻿#include "spin_lock.h"
+
+namespace ncore
+{
+
+SpinLock::SpinLock()
+{
+}
+
+SpinLock::~SpinLock()
+{
+}
+
+bool SpinLock::TryAcquire()
+{
+    return !locker_.CompareExchange(1, 0);
+}
+
+void SpinLock::Acquire()
+{
+    while(locker_.CompareExchange(1, 0));
+}
+
+void SpinLock::Release()
+{
+    locker_ = 0;
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,61 @@
+﻿#include "strand.h"
+#include "thread.h"
+
+namespace ncore
+{
+
+
+Strand::Strand()
+    : running_(false), owner_(0)
+{
+}
+
+Strand::~Strand()
+{
+    assert(queue_.empty());
+    assert(!running_);
+}
+
+void Strand::Post(AsyncTask & task)
+{
+    lock_.Acquire();
+    queue_.Push(task);
+    if(running_)
+    {
+        lock_.Release();
+        return;
+    }
+    running_ = true;
+    lock_.Release();
+
+    Drain();
+}
+
+bool Strand::RunningInThisThread() const
+{
+    return owner_ == Thread::GetCurrentThreadId();
+}
+
+void Strand::Drain()
+{
+    owner_ = Thread::GetCurrentThreadId();
+    while(true)
+    {
+        //一次取走整条队列，执行期间新投递的任务进入新的队列
+        lock_.Acquire();
+        AsyncTask * head = queue_.TakeAll();
+        if(head == 0)
+        {
+            owner_ = 0;
+            running_ = false;
+            lock_.Release();
+            return;
+        }
+        lock_.Release();
+
+        AsyncTaskQueue::Run(head);
+    }
+}
+
+
+}
@@ -0,0 +1,46 @@
+﻿#ifndef NCORE_SYS_STRAND_H_
+#define NCORE_SYS_STRAND_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include "spin_lock.h"
+#include "async_task.h"
+
+namespace ncore
+{
+
+
+/*! 串行执行器\n
+投递到同一个Strand的任务按投递顺序逐个执行，任意时刻最多只有一个在执行，不同Strand之间互不影响。\n
+Strand不拥有线程：空闲时由投递者所在的线程直接执行，忙碌时任务排队后立即返回，由正在执行的线程接着执行。\n
+IOPortal::set_strand之后，该对象的完成回调也经由Strand执行，回调中不再需要加锁。\n
+*/
+class Strand : public NonCopyableObject
+{
+public:
+    Strand();
+    ~Strand();
+
+    /*! 投递任务
+    @param[in] task 任务，执行完毕之前必须保持有效。
+    @remark 在本Strand的任务中投递时只排队，待当前任务返回后执行，不会重入。\n
+    */
+    void Post(AsyncTask & task);
+
+    //当前线程是否正在执行本Strand的任务
+    bool RunningInThisThread() const;
+
+private:
+    void Drain();
+
+private:
+    SpinLock lock_;
+    AsyncTaskQueue queue_;
+    bool running_;
+    volatile uint32_t owner_;
+};
+
+
+}
+
+#endif
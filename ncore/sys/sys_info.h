@@ -1,53 +1,59 @@
-﻿#ifndef NCORE_SYS_SYS_INFO_H_
-#define NCORE_SYS_SYS_INFO_H_
-
-#include <ncore/ncore.h>
-
-namespace ncore
-{
-
-class SysInfo
-{
-public:
-    static int GetLogicalProcessorNumber();
-
-    static bool DWMEnabled();
-
-    static bool IsWow64();
-
-    static bool QueryDiskFreeSpace(const char * dir, 
-                                   uint64_t & freebytes);
-
-    static uint32_t GetMaxFreeSpaceDisk();
-
-    static uint32_t TickCount();
-
-    static std::string CommonAppDataPath();
-
-    static std::string CommonAppDataPath(const char * name);
-
-    static std::string WindowsPath();
-
-    static std::string WindowsPath(const char * name);
-
-    static std::string GetPlatformName();
-
-    static bool IsElevated();
-
-    static bool IsUserAdmin();
-
-    static bool IsWinNT5();
-
-    static bool IsWinXP();
-
-    static bool IsWin2K3();
-
-    static bool IsWinNT6();
-
-    static bool IsX86();
-
-    static bool IsX64();
-};
-
-}
+﻿#ifndef NCORE_SYS_SYS_INFO_H_
+#define NCORE_SYS_SYS_INFO_H_
+
+#include <ncore/ncore.h>
+
+namespace ncore
+{
+
+class SysInfo
+{
+public:
+    static int GetLogicalProcessorNumber();
+
+    static bool DWMEnabled();
+
+    static bool IsWow64();
+
+    static bool QueryDiskFreeSpace(const char * dir, 
+                                   uint64_t & freebytes);
+
+    static uint32_t GetMaxFreeSpaceDisk();
+
+    static uint32_t TickCount();
+
+    //系统启动以来的毫秒数，单调递增，不会回绕
+    static uint64_t TickCount64();
+
+    //系统启动以来的微秒数，单调递增，用于测量短时间间隔
+    static uint64_t MicroTickCount();
+
+    static std::string CommonAppDataPath();
+
+    static std::string CommonAppDataPath(const char * name);
+
+    static std::string WindowsPath();
+
+    static std::string WindowsPath(const char * name);
+
+    static std::string GetPlatformName();
+
+    static bool IsElevated();
+
+    static bool IsUserAdmin();
+
+    static bool IsWinNT5();
+
+    static bool IsWinXP();
+
+    static bool IsWin2K3();
+
+    static bool IsWinNT6();
+
+    static bool IsX86();
+
+    static bool IsX64();
+};
+
+}
 #endif
\ No newline at end of file
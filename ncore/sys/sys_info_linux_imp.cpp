@@ -0,0 +1,75 @@
+﻿#include "sys_info.h"
+
+namespace ncore
+{
+
+
+/*
+只实现与平台无关的部分，Windows特有的接口(DWM、Windows路径、系统版本等)没有对应的实现
+*/
+int SysInfo::GetLogicalProcessorNumber()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? static_cast<int>(count) : 1;
+}
+
+bool SysInfo::QueryDiskFreeSpace(const char * path,
+                                 uint64_t & freebytes)
+{
+    struct statvfs info;
+    if(statvfs(path, &info))
+        return false;
+
+    freebytes = static_cast<uint64_t>(info.f_bavail) * info.f_frsize;
+    return true;
+}
+
+uint32_t SysInfo::TickCount()
+{
+    return static_cast<uint32_t>(TickCount64());
+}
+
+uint64_t SysInfo::TickCount64()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t tick = static_cast<uint64_t>(ts.tv_sec) * 1000;
+    tick += ts.tv_nsec / 1000000;
+    return tick;
+}
+
+uint64_t SysInfo::MicroTickCount()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t tick = static_cast<uint64_t>(ts.tv_sec) * 1000000;
+    tick += ts.tv_nsec / 1000;
+    return tick;
+}
+
+bool SysInfo::IsX86()
+{
+#if defined NCORE_X86
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool SysInfo::IsX64()
+{
+#if defined NCORE_X64
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::string SysInfo::GetPlatformName()
+{
+    std::string processor = IsX64() ? "@64" : (IsX86() ? "" : "@Unknown");
+    return "Linux" + processor;
+}
+
+
+}
@@ -1,109 +1,122 @@
-﻿#ifndef NCORE_SYS_THREAD_H_
-#define NCORE_SYS_THREAD_H_
-
-#include <ncore/ncore.h>
-#include <ncore/base/object.h>
-#include <ncore/base/exception.h>
-
-namespace ncore
-{
-
-//线程过程类
-class ThreadProc
-{
-protected:
-    ThreadProc(){}
-    virtual ~ThreadProc(){}
-public:
-    virtual void Run() = 0;
-};
-
-template<typename T>
-class ThreadProcAdapter : public ThreadProc
-{
-public:
-    typedef void (T::*TF)();
-public:
-    ThreadProcAdapter()
-        :obj_(0),
-        func_(0)
-    {
-    }
-
-    ~ThreadProcAdapter()
-    {
-    }
-
-    void Register(T * obj, TF func)
-    {
-        obj_ = obj;
-        func_ = func;
-    }
-
-    void Run()
-    {
-        (obj_->*func_)();
-    }
-
-private:
-    T * obj_;
-    TF func_;
-};
-
-//线程异常
-
-class ThreadExceptionAbort : public Exception
-{
-};
-
-//线程类
-class Thread : public NonCopyableObject
-{
-    friend class MainThread;
-private:
-    enum ThreadExitCode
-    {
-        kThreadAbort = -3,
-        kTheadTerminated = -2,
-        kThreadNotStarted = -1,
-        kThreadExited = 0,
-        kThreadRunning = 1,
-    };
-
-private:
-#if defined NCORE_WINDOWS
-    static uint32_t _stdcall Run(void *);
-    static void  _stdcall AbortProc(ULONG_PTR dwParam);
-#elif defined NCORE_MACOS
-
-#endif
-public:
-    static uint32_t GetCurrentThreadId();
-    static void Sleep(int ms, bool alertable);
-    static Thread * Current();
-    static Thread * Main();
-
-public:
-    Thread();
-    virtual ~Thread();
-    bool init(ThreadProc & thread_proc);
-    void fini();
-
-    bool Start();
-    bool Terminate();
-    bool Suspend();
-    bool Join();
-    bool IsAlive();
-    bool Abort();
-
-protected:
-    uintptr_t thread_handle_;
-    uint32_t thread_id_;
-    ThreadProc * thread_proc_;
-    bool started_;
-};
-
-
-}
-
+﻿#ifndef NCORE_SYS_THREAD_H_
+#define NCORE_SYS_THREAD_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include <ncore/base/exception.h>
+
+namespace ncore
+{
+
+//线程过程类
+class ThreadProc
+{
+protected:
+    ThreadProc(){}
+    virtual ~ThreadProc(){}
+public:
+    virtual void Run() = 0;
+};
+
+template<typename T>
+class ThreadProcAdapter : public ThreadProc
+{
+public:
+    typedef void (T::*TF)();
+public:
+    ThreadProcAdapter()
+        :obj_(0),
+        func_(0)
+    {
+    }
+
+    ~ThreadProcAdapter()
+    {
+    }
+
+    void Register(T * obj, TF func)
+    {
+        obj_ = obj;
+        func_ = func;
+    }
+
+    void Run()
+    {
+        (obj_->*func_)();
+    }
+
+private:
+    T * obj_;
+    TF func_;
+};
+
+//线程异常
+
+class ThreadExceptionAbort : public Exception
+{
+};
+
+//线程类
+class Thread : public NonCopyableObject
+{
+    friend class MainThread;
+private:
+    enum ThreadExitCode
+    {
+        kThreadAbort = -3,
+        kTheadTerminated = -2,
+        kThreadNotStarted = -1,
+        kThreadExited = 0,
+        kThreadRunning = 1,
+    };
+
+private:
+#if defined NCORE_WINDOWS
+    static uint32_t _stdcall Run(void *);
+    static void  _stdcall AbortProc(ULONG_PTR dwParam);
+#elif defined NCORE_LINUX
+    static void * Run(void *);
+#elif defined NCORE_MACOS
+
+#endif
+public:
+    static uint32_t GetCurrentThreadId();
+    static void Sleep(int ms, bool alertable);
+
+    //忙等待时提示处理器，不让出时间片
+    static void Pause();
+    static Thread * Current();
+    static Thread * Main();
+
+public:
+    Thread();
+    virtual ~Thread();
+    bool init(ThreadProc & thread_proc);
+    void fini();
+
+    bool Start();
+    bool Terminate();
+    bool Suspend();
+    bool Join();
+    bool IsAlive();
+    bool Abort();
+
+    /*! 绑定到指定的逻辑处理器
+    @param[in] cpu 逻辑处理器的序号。
+    @return 设置成功后返回true；否则返回false。
+    @remark 可以在Start之前调用。\n
+    */
+    bool SetAffinity(uint32_t cpu);
+
+protected:
+    uintptr_t thread_handle_;
+    uint32_t thread_id_;
+    ThreadProc * thread_proc_;
+    bool started_;
+    int affinity_;
+};
+
+
+}
+
 #endif
\ No newline at end of file
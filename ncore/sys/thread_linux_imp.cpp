@@ -0,0 +1,211 @@
+﻿#include "thread.h"
+
+
+namespace ncore
+{
+
+static __thread Thread * current = 0;
+
+class MainThread
+{
+public:
+    MainThread()
+    {
+        thread_.thread_id_ = Thread::GetCurrentThreadId();
+        thread_.started_ = true;
+        current = &thread_;
+    }
+
+    ~MainThread()
+    {
+    }
+
+    Thread thread_;
+};
+
+MainThread main_thread;
+
+
+
+void * Thread::Run(void * param)
+{
+    Thread * thread = (Thread *)param;
+    assert(thread != 0);
+    current = thread;
+    thread->thread_id_ = GetCurrentThreadId();
+    try
+    {
+        assert(thread->thread_proc_ != 0);
+        thread->thread_proc_->Run();
+    }
+    catch(const ThreadExceptionAbort &)
+    {
+    }
+    __atomic_store_n(&thread->started_, false, __ATOMIC_RELEASE);
+    return 0;
+}
+
+void Thread::Sleep(int ms, bool)
+{
+    //Linux上没有APC，alertable被忽略
+    if(ms <= 0)
+    {
+        sched_yield();
+        return;
+    }
+
+    timespec ts;
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (ms % 1000) * 1000000L;
+    while(nanosleep(&ts, &ts) < 0 && errno == EINTR);
+}
+
+void Thread::Pause()
+{
+#if defined NCORE_X86 || defined NCORE_X64
+    __builtin_ia32_pause();
+#elif defined __aarch64__
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+uint32_t Thread::GetCurrentThreadId()
+{
+    return static_cast<uint32_t>(syscall(SYS_gettid));
+}
+
+Thread * Thread::Current()
+{
+    return current;
+}
+
+Thread * Thread::Main()
+{
+    return &main_thread.thread_;
+}
+
+Thread::Thread()
+    : thread_handle_(0),
+      thread_id_(0),
+      thread_proc_(0),
+      started_(false),
+      affinity_(-1)
+{
+}
+
+Thread::~Thread()
+{
+    fini();
+}
+
+bool Thread::init(ThreadProc & thread_proc)
+{
+    //pthread不能以挂起方式创建，线程在Start时才创建
+    if(thread_handle_)
+        return true;
+
+    thread_proc_ = &thread_proc;
+    return true;
+}
+
+void Thread::fini()
+{
+    if(thread_handle_ != 0)
+        Join();
+    thread_id_ = 0;
+    thread_proc_ = 0;
+}
+
+bool Thread::Start()
+{
+    if(thread_handle_ || thread_proc_ == 0)
+        return false;
+
+    pthread_attr_t attr;
+    if(pthread_attr_init(&attr))
+        return false;
+
+    if(affinity_ >= 0 && affinity_ < CPU_SETSIZE)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(affinity_, &cpus);
+        pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+    }
+
+    //先置位，避免线程尚未运行时IsAlive返回false
+    started_ = true;
+    pthread_t handle;
+    int result = pthread_create(&handle, &attr, Run, this);
+    pthread_attr_destroy(&attr);
+    if(result)
+    {
+        started_ = false;
+        return false;
+    }
+
+    thread_handle_ = static_cast<uintptr_t>(handle);
+    return true;
+}
+
+bool Thread::Terminate()
+{
+    //不支持强制结束线程
+    return false;
+}
+
+bool Thread::Suspend()
+{
+    return false;
+}
+
+bool Thread::Join()
+{
+    if(thread_handle_ == 0)
+        return false;
+
+    pthread_t handle = static_cast<pthread_t>(thread_handle_);
+    if(pthread_equal(handle, pthread_self()))
+        return false;
+
+    if(pthread_join(handle, 0))
+        return false;
+
+    thread_handle_ = 0;
+    return true;
+}
+
+bool Thread::Abort()
+{
+    //没有APC，线程过程需要自行检查退出条件
+    return false;
+}
+
+bool Thread::IsAlive()
+{
+    if(thread_handle_ == 0)
+        return false;
+
+    return __atomic_load_n(&started_, __ATOMIC_ACQUIRE);
+}
+
+bool Thread::SetAffinity(uint32_t cpu)
+{
+    if(cpu >= CPU_SETSIZE)
+        return false;
+
+    affinity_ = static_cast<int>(cpu);
+    if(thread_handle_ == 0)
+        return true;
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    pthread_t handle = static_cast<pthread_t>(thread_handle_);
+    return pthread_setaffinity_np(handle, sizeof(cpus), &cpus) == 0;
+}
+
+
+}
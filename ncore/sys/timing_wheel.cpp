@@ -0,0 +1,201 @@
+﻿#include "timing_wheel.h"
+
+namespace ncore
+{
+
+
+AsyncTimer::AsyncTimer()
+    : timer_prev_(0), timer_next_(0), timer_slot_(0), expire_(0),
+      timer_state_(kTimerIdle)
+{
+}
+
+AsyncTimer::~AsyncTimer()
+{
+    assert(timer_slot_ == 0);
+}
+
+bool AsyncTimer::armed() const
+{
+    return timer_state_ == kTimerArmed;
+}
+
+bool AsyncTimer::firing() const
+{
+    return timer_state_ == kTimerFiring;
+}
+
+
+TimingWheel::TimingWheel()
+    : current_(0), size_(0)
+{
+    memset(slots_, 0, sizeof(slots_));
+}
+
+TimingWheel::~TimingWheel()
+{
+    assert(size_ == 0);
+}
+
+void TimingWheel::Reset(uint64_t now)
+{
+    if(size_ == 0)
+        current_ = now;
+}
+
+void TimingWheel::Add(AsyncTimer & timer, uint64_t expire)
+{
+    if(timer.timer_slot_)
+    {
+        Unlink(timer);
+        --size_;
+    }
+
+    timer.expire_ = expire;
+    Link(timer);
+    timer.timer_state_ = AsyncTimer::kTimerArmed;
+    ++size_;
+}
+
+bool TimingWheel::Remove(AsyncTimer & timer)
+{
+    if(timer.timer_slot_ == 0)
+        return false;
+
+    Unlink(timer);
+    --size_;
+    timer.timer_state_ = AsyncTimer::kTimerIdle;
+    return true;
+}
+
+size_t TimingWheel::Advance(uint64_t now, AsyncTaskQueue & expired)
+{
+    size_t count = 0;
+    while(current_ <= now)
+    {
+        //没有定时器时直接跳到当前时间
+        if(size_ == 0)
+        {
+            current_ = now + 1;
+            break;
+        }
+
+        size_t index = static_cast<size_t>(current_) & (kSlots - 1);
+        if(index == 0)
+        {
+            //到达边界，把上层对应槽中的定时器下移
+            for(size_t level = 1; level < kLevels; ++level)
+            {
+                Cascade(level);
+                size_t shift = level * kSlotBits;
+                if(((current_ >> shift) & (kSlots - 1)) != 0)
+                    break;
+            }
+        }
+
+        AsyncTimer * timer = slots_[0][index];
+        slots_[0][index] = 0;
+        while(timer)
+        {
+            AsyncTimer * next = timer->timer_next_;
+            timer->timer_prev_ = 0;
+            timer->timer_next_ = 0;
+            timer->timer_slot_ = 0;
+            timer->timer_state_ = AsyncTimer::kTimerFiring;
+            expired.Push(*timer);
+            --size_;
+            ++count;
+            timer = next;
+        }
+
+        ++current_;
+    }
+    return count;
+}
+
+uint64_t TimingWheel::NextExpire() const
+{
+    if(size_ == 0)
+        return static_cast<uint64_t>(-1);
+
+    //最底层覆盖当前的256个刻度，到达边界时需要推进以下移上层的定时器
+    uint64_t tick = current_;
+    while(true)
+    {
+        size_t index = static_cast<size_t>(tick) & (kSlots - 1);
+        if(index == 0 || slots_[0][index])
+            return tick;
+        ++tick;
+    }
+}
+
+size_t TimingWheel::size() const
+{
+    return size_;
+}
+
+void TimingWheel::Link(AsyncTimer & timer)
+{
+    const uint64_t kMaxDelta = (static_cast<uint64_t>(1) <<
+                                (kLevels * kSlotBits)) - 1;
+
+    if(timer.expire_ < current_)
+        timer.expire_ = current_;
+
+    uint64_t delta = timer.expire_ - current_;
+    if(delta > kMaxDelta)
+    {
+        timer.expire_ = current_ + kMaxDelta;
+        delta = kMaxDelta;
+    }
+
+    //第level层的一个槽覆盖256^level个刻度
+    size_t level = 0;
+    while(level + 1 < kLevels &&
+          delta >= (static_cast<uint64_t>(1) << ((level + 1) * kSlotBits)))
+        ++level;
+
+    size_t shift = level * kSlotBits;
+    size_t index = static_cast<size_t>(timer.expire_ >> shift) & (kSlots - 1);
+    AsyncTimer *& head = slots_[level][index];
+
+    timer.timer_prev_ = 0;
+    timer.timer_next_ = head;
+    if(head)
+        head->timer_prev_ = &timer;
+    head = &timer;
+    timer.timer_slot_ = &head;
+}
+
+void TimingWheel::Unlink(AsyncTimer & timer)
+{
+    if(timer.timer_prev_)
+        timer.timer_prev_->timer_next_ = timer.timer_next_;
+    else
+        *timer.timer_slot_ = timer.timer_next_;
+
+    if(timer.timer_next_)
+        timer.timer_next_->timer_prev_ = timer.timer_prev_;
+
+    timer.timer_prev_ = 0;
+    timer.timer_next_ = 0;
+    timer.timer_slot_ = 0;
+}
+
+void TimingWheel::Cascade(size_t level)
+{
+    size_t shift = level * kSlotBits;
+    size_t index = static_cast<size_t>(current_ >> shift) & (kSlots - 1);
+    AsyncTimer * timer = slots_[level][index];
+    slots_[level][index] = 0;
+
+    while(timer)
+    {
+        AsyncTimer * next = timer->timer_next_;
+        Link(*timer);
+        timer = next;
+    }
+}
+
+
+}
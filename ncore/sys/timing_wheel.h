@@ -0,0 +1,104 @@
+﻿#ifndef NCORE_SYS_TIMING_WHEEL_H_
+#define NCORE_SYS_TIMING_WHEEL_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include <ncore/base/atomic.h>
+#include "async_task.h"
+
+namespace ncore
+{
+
+
+/*! 定时器\n
+到期时执行Run。定时器由调用者持有，启动后直到停止或者Run返回之前必须保持有效。\n
+*/
+class AsyncTimer : public AsyncTask
+{
+protected:
+    AsyncTimer();
+    ~AsyncTimer();
+
+public:
+    //已启动且尚未到期
+    bool armed() const;
+
+    //已经到期，Run尚未返回
+    bool firing() const;
+
+private:
+    enum TimerState
+    {
+        kTimerIdle,
+        kTimerArmed,
+        kTimerFiring,
+    };
+
+    AsyncTimer * timer_prev_;
+    AsyncTimer * timer_next_;
+    AsyncTimer ** timer_slot_;
+    uint64_t expire_;
+    Atomic timer_state_;
+
+    friend class TimingWheel;
+    friend class Proactor;
+};
+
+template <typename T>
+using AsyncTimerAdapter = AsyncTaskAdapter<T, AsyncTimer>;
+
+/*! 分层时间轮\n
+以毫秒为刻度，4层，每层256个槽，最长约49天，更长的定时被截断。\n
+启动和停止都是O(1)；推进时逐刻度处理，到达上层槽的边界时把上层的定时器下移。\n
+不是线程安全的，由使用者加锁。\n
+*/
+class TimingWheel : public NonCopyableObject
+{
+public:
+    static const size_t kLevels = 4;
+    static const size_t kSlotBits = 8;
+    static const size_t kSlots = 1 << kSlotBits;
+
+public:
+    TimingWheel();
+    ~TimingWheel();
+
+    //设置当前时间，只在没有定时器时有效
+    void Reset(uint64_t now);
+
+    //加入定时器，expire早于当前时间时在下一次推进时到期
+    void Add(AsyncTimer & timer, uint64_t expire);
+
+    //移除尚未到期的定时器，定时器不在时间轮中时返回false
+    bool Remove(AsyncTimer & timer);
+
+    /*! 推进到指定时间
+    @param[in] now      当前时间。
+    @param[out] expired 到期的定时器依次追加到队尾。
+    @return 到期的定时器数量。
+    */
+    size_t Advance(uint64_t now, AsyncTaskQueue & expired);
+
+    /*! 下一次需要推进的时间
+    @return 没有定时器时返回uint64_t的最大值。
+    @remark 最近的定时器不在最底层时，返回下一个需要下移的边界，不超过256毫秒。\n
+    */
+    uint64_t NextExpire() const;
+
+    size_t size() const;
+
+private:
+    void Link(AsyncTimer & timer);
+    void Unlink(AsyncTimer & timer);
+    void Cascade(size_t level);
+
+private:
+    AsyncTimer * slots_[kLevels][kSlots];
+    uint64_t current_;              //下一个待处理的刻度
+    size_t size_;
+};
+
+
+}
+
+#endif
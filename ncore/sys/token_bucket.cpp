@@ -0,0 +1,189 @@
+﻿#include "token_bucket.h"
+#include "sys_info.h"
+
+namespace ncore
+{
+
+
+static const uint64_t kMicrosecondsPerSecond = 1000000;
+
+
+TokenBucketStats::TokenBucketStats()
+    : granted_bytes(0), throttled_bytes(0), throttled_count(0)
+{
+}
+
+
+TokenBucket::TokenBucket()
+    : parent_(0), rate_(0), burst_(0), tokens_(0),
+      last_(0), remainder_(0), initialized_(false)
+{
+}
+
+TokenBucket::~TokenBucket()
+{
+    fini();
+}
+
+bool TokenBucket::init(uint64_t rate, uint64_t burst, TokenBucket * parent)
+{
+    if(initialized_ || burst == 0 || burst > 0x7FFFFFFFFFFFULL)
+        return false;
+
+    parent_ = parent;
+    rate_ = rate;
+    burst_ = burst;
+    tokens_ = static_cast<int64_t>(burst);
+    last_ = SysInfo::MicroTickCount();
+    remainder_ = 0;
+    stats_ = TokenBucketStats();
+    initialized_ = true;
+    return true;
+}
+
+void TokenBucket::fini()
+{
+    if(!initialized_)
+        return;
+
+    parent_ = 0;
+    initialized_ = false;
+}
+
+void TokenBucket::SetRate(uint64_t rate, uint64_t burst)
+{
+    if(burst == 0 || burst > 0x7FFFFFFFFFFFULL)
+        return;
+
+    lock_.Acquire();
+    //按原来的速率补充到现在
+    Refill(SysInfo::MicroTickCount());
+    rate_ = rate;
+    burst_ = burst;
+    if(tokens_ > static_cast<int64_t>(burst))
+        tokens_ = static_cast<int64_t>(burst);
+    lock_.Release();
+}
+
+uint64_t TokenBucket::Acquire(uint64_t size, uint64_t & delay)
+{
+    delay = 0;
+    if(!initialized_ || size == 0)
+        return 0;
+
+    uint64_t now = SysInfo::MicroTickCount();
+    uint64_t granted = size;
+    for(TokenBucket * bucket = this; bucket; bucket = bucket->parent_)
+    {
+        granted = bucket->Check(granted, now, delay);
+        if(granted == 0)
+            return 0;
+    }
+
+    //检查和扣除之间其他连接可能已经取走令牌，扣成负数由以后的申请偿还
+    for(TokenBucket * bucket = this; bucket; bucket = bucket->parent_)
+        bucket->Consume(granted);
+    return granted;
+}
+
+uint64_t TokenBucket::rate() const
+{
+    return rate_;
+}
+
+uint64_t TokenBucket::burst() const
+{
+    return burst_;
+}
+
+TokenBucket * TokenBucket::parent() const
+{
+    return parent_;
+}
+
+int64_t TokenBucket::tokens() const
+{
+    lock_.Acquire();
+    int64_t tokens = tokens_;
+    lock_.Release();
+    return tokens;
+}
+
+void TokenBucket::Snapshot(TokenBucketStats & stats) const
+{
+    lock_.Acquire();
+    stats = stats_;
+    lock_.Release();
+}
+
+void TokenBucket::Refill(uint64_t now)
+{
+    //多个线程取得的时间可能略有先后
+    if(now <= last_)
+        return;
+
+    uint64_t elapsed = now - last_;
+    last_ = now;
+    if(rate_ == 0 || tokens_ >= static_cast<int64_t>(burst_))
+    {
+        remainder_ = 0;
+        return;
+    }
+
+    //长时间空闲后整秒的部分直接与空缺比较，避免乘法溢出
+    uint64_t room = static_cast<uint64_t>(static_cast<int64_t>(burst_) - tokens_);
+    uint64_t seconds = elapsed / kMicrosecondsPerSecond;
+    uint64_t scaled = (elapsed % kMicrosecondsPerSecond) * rate_ + remainder_;
+    uint64_t added = seconds > room / rate_ ? room :
+                     seconds * rate_ + scaled / kMicrosecondsPerSecond;
+    if(added >= room)
+    {
+        tokens_ = static_cast<int64_t>(burst_);
+        remainder_ = 0;
+        return;
+    }
+
+    tokens_ += static_cast<int64_t>(added);
+    remainder_ = scaled % kMicrosecondsPerSecond;
+}
+
+uint64_t TokenBucket::Check(uint64_t size, uint64_t now, uint64_t & delay)
+{
+    lock_.Acquire();
+    Refill(now);
+    if(rate_ == 0)
+    {
+        lock_.Release();
+        return size;
+    }
+
+    int64_t need = static_cast<int64_t>(size < burst_ ? size : burst_);
+    if(tokens_ >= need)
+    {
+        uint64_t granted = static_cast<uint64_t>(tokens_);
+        lock_.Release();
+        return granted < size ? granted : size;
+    }
+
+    //向上取整，已经积累的不足一个字节的部分也算进去
+    uint64_t deficit = static_cast<uint64_t>(need - tokens_);
+    uint64_t scaled = deficit * kMicrosecondsPerSecond - remainder_;
+    delay = (scaled + rate_ - 1) / rate_;
+    stats_.throttled_bytes += size;
+    ++stats_.throttled_count;
+    stats_.delay.Add(delay);
+    lock_.Release();
+    return 0;
+}
+
+void TokenBucket::Consume(uint64_t size)
+{
+    lock_.Acquire();
+    if(rate_)
+        tokens_ -= static_cast<int64_t>(size);
+    stats_.granted_bytes += size;
+    lock_.Release();
+}
+
+
+}
@@ -0,0 +1,100 @@
+﻿#ifndef NCORE_SYS_TOKEN_BUCKET_H_
+#define NCORE_SYS_TOKEN_BUCKET_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include "io_stats.h"
+#include "spin_lock.h"
+
+namespace ncore
+{
+
+
+//令牌桶的统计
+struct TokenBucketStats
+{
+    uint64_t granted_bytes;         //放行的字节数
+    uint64_t throttled_bytes;       //因本桶的令牌不足而推迟的字节数，同一批数据每推迟一次计一次
+    uint64_t throttled_count;       //推迟的次数
+    IOHistogram delay;              //每次推迟需要等待的微秒数
+
+    TokenBucketStats();
+};
+
+/*! 令牌桶\n
+令牌按rate字节每秒匀速补充，最多积累burst字节，发送前按字节数取走令牌。\n
+可以指定父桶组成层次，例如全局、分组、连接三层：申请时沿父桶逐级检查，
+每一级都放行才发送，放行的字节从每一级扣除，所以一个连接既受自身的速率限制，
+也与同组、同进程的其他连接分享上层的带宽。\n
+令牌允许被扣成负数（多个子桶同时放行时），之后的申请相应地等待更久，长期速率不受影响。\n
+线程安全，父桶必须比子桶先初始化、后销毁。\n
+*/
+class TokenBucket : public NonCopyableObject
+{
+public:
+    TokenBucket();
+    ~TokenBucket();
+
+    /*! 初始化
+    @param[in] rate     每秒补充的字节数，为0时不限速，只做统计并检查父桶。
+    @param[in] burst    最多积累的字节数，也是一次放行的上限，不能为0。
+    @param[in] parent   父桶，可以为0。
+    @return 初始化成功后返回true；否则返回false。
+    @remark 初始时桶是满的。\n
+    */
+    bool init(uint64_t rate, uint64_t burst, TokenBucket * parent = 0);
+
+    void fini();
+
+    //运行中修改速率，已经积累的令牌不超过新的burst
+    void SetRate(uint64_t rate, uint64_t burst);
+
+    /*! 申请发送
+    @param[in] size     希望发送的字节数。
+    @param[out] delay   不能放行时，到令牌足够还需要等待的微秒数。
+    @return 放行的字节数，不超过size，也不超过每一级的burst；不能放行时返回0。
+    @remark 每一级至少积累到min(size, burst)才放行，避免令牌刚补充时放出零碎的小块。\n
+    */
+    uint64_t Acquire(uint64_t size, uint64_t & delay);
+
+    uint64_t rate() const;
+    uint64_t burst() const;
+    TokenBucket * parent() const;
+
+    //当前可用的令牌，可能为负数
+    int64_t tokens() const;
+
+    //取得统计的副本
+    void Snapshot(TokenBucketStats & stats) const;
+
+private:
+    //补充到now为止的令牌，在锁内调用
+    void Refill(uint64_t now);
+
+    /*! 检查本级能放行的字节数
+    @param[in] size     希望发送的字节数。
+    @param[in] now      当前的微秒数，同一次申请的各级使用同一个时间。
+    @param[out] delay   不能放行时需要等待的微秒数。
+    @return 能放行时返回不超过size的字节数；否则返回0。
+    */
+    uint64_t Check(uint64_t size, uint64_t now, uint64_t & delay);
+
+    //扣除放行的字节
+    void Consume(uint64_t size);
+
+private:
+    mutable SpinLock lock_;
+    TokenBucket * parent_;
+    uint64_t rate_;
+    uint64_t burst_;
+    int64_t tokens_;
+    uint64_t last_;                 //上次补充的微秒数
+    uint64_t remainder_;            //补充时不足一个字节的部分，以字节乘微秒计
+    bool initialized_;
+    TokenBucketStats stats_;
+};
+
+
+}
+
+#endif
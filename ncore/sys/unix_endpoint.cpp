@@ -0,0 +1,124 @@
+﻿#include "unix_endpoint.h"
+
+#if defined NCORE_AF_UNIX
+
+namespace ncore
+{
+
+
+//sockaddr_un中sun_path之前的部分，只有地址族
+static const size_t kPathOffset = offsetof(sockaddr_un, sun_path);
+
+const size_t UnixEndPoint::kMaxPathLength = sizeof(sockaddr_un::sun_path) - 1;
+
+#if defined NCORE_LINUX
+UnixEndPoint UnixEndPoint::Abstract(const char * name)
+{
+    UnixEndPoint ep;
+    size_t length = name ? strlen(name) : 0;
+    if(length > kMaxPathLength)
+    {
+        ep.ep_size_ = 0;
+        return ep;
+    }
+
+    //长度由ep_size_决定，名字中不包括结尾的0
+    memcpy(ep.un().sun_path + 1, name, length);
+    ep.ep_size_ = kPathOffset + 1 + length;
+    return ep;
+}
+#endif
+
+UnixEndPoint::UnixEndPoint()
+{
+    Reset();
+}
+
+UnixEndPoint::UnixEndPoint(const char * path)
+{
+    SetPath(path);
+}
+
+UnixEndPoint::UnixEndPoint(const IPEndPoint & endpoint)
+    : IPEndPoint(endpoint)
+{
+    if(ep_.sa_family != AF_UNIX || ep_size_ < kPathOffset ||
+       ep_size_ > sizeof(sockaddr_un))
+        Reset();
+}
+
+UnixEndPoint::~UnixEndPoint()
+{
+}
+
+bool UnixEndPoint::SetPath(const char * path)
+{
+    Reset();
+
+    size_t length = path ? strlen(path) : 0;
+    if(length > kMaxPathLength)
+    {
+        ep_size_ = 0;
+        return false;
+    }
+
+    if(length == 0)
+        return true;
+
+    memcpy(un().sun_path, path, length);
+    ep_size_ = kPathOffset + length + 1;
+    return true;
+}
+
+std::string UnixEndPoint::Path() const
+{
+    if(IsUnnamed())
+        return std::string();
+
+    const char * path = un().sun_path;
+    size_t length = ep_size_ - kPathOffset;
+    if(IsAbstract())
+        return std::string(path + 1, length - 1);
+
+    //内核返回的长度可能包括结尾的0，也可能不包括
+    size_t end = 0;
+    while(end < length && path[end])
+        ++end;
+    return std::string(path, end);
+}
+
+bool UnixEndPoint::IsUnnamed() const
+{
+    return ep_size_ <= kPathOffset;
+}
+
+bool UnixEndPoint::IsAbstract() const
+{
+#if defined NCORE_LINUX
+    return !IsUnnamed() && un().sun_path[0] == 0;
+#else
+    return false;
+#endif
+}
+
+sockaddr_un & UnixEndPoint::un()
+{
+    return *reinterpret_cast<sockaddr_un *>(&ep_storage_);
+}
+
+const sockaddr_un & UnixEndPoint::un() const
+{
+    return *reinterpret_cast<const sockaddr_un *>(&ep_storage_);
+}
+
+void UnixEndPoint::Reset()
+{
+    memset(&ep_storage_, 0, sizeof(ep_storage_));
+    ep_.sa_family = AF_UNIX;
+    ep_size_ = kPathOffset;
+}
+
+
+}
+
+#endif
@@ -0,0 +1,70 @@
+﻿#ifndef NCORE_SYS_UNIX_ENDPOINT_H_
+#define NCORE_SYS_UNIX_ENDPOINT_H_
+
+#include "ip_endpoint.h"
+
+#if defined NCORE_AF_UNIX
+
+namespace ncore
+{
+
+
+/*! 本机进程间通信（AF_UNIX）的地址\n
+从IPEndPoint派生，不增加成员，可以直接用于Socket的Bind、Connect以及异步上下文的remote_endpoint。
+套接字以AddressFamily::kUnix、SocketType::kStream或kSeqPacket、ProtocolType::kUnspecificProtocol初始化。\n
+文件系统中的地址在Bind时创建对应的文件，关闭套接字后不会删除，再次Bind之前需要先删除；
+Linux下还可以使用抽象命名空间的地址，不创建文件，最后一个套接字关闭后自动释放。\n
+Windows下只支持kStream，不支持抽象命名空间，并且需要Windows 10 1803（RS4）及以上的SDK才提供此类。\n
+*/
+class UnixEndPoint : public IPEndPoint
+{
+public:
+    //路径的最大长度，不包括结尾的0
+    static const size_t kMaxPathLength;
+
+public:
+#if defined NCORE_LINUX
+    //抽象命名空间中的地址，name不需要以0开头
+    static UnixEndPoint Abstract(const char * name);
+#endif
+
+public:
+    //未命名的地址，可以用来接收Accept、ReceiveFrom的对端地址
+    UnixEndPoint();
+
+    /*! 文件系统中的地址
+    @param[in] path 套接字文件的路径。
+    @remark 路径超过kMaxPathLength时地址无效，Bind和Connect都会失败。\n
+    */
+    explicit UnixEndPoint(const char * path);
+
+    //取出Accept、ReceiveFrom等得到的对端地址，不是AF_UNIX的地址得到未命名的地址
+    explicit UnixEndPoint(const IPEndPoint & endpoint);
+
+    ~UnixEndPoint();
+
+    //设置文件系统中的地址，路径为空时得到未命名的地址；路径过长时返回false，地址变为无效
+    bool SetPath(const char * path);
+
+    //文件系统中的路径或者抽象命名空间中的名字（不包括开头的0）
+    std::string Path() const;
+
+    //未命名的地址，例如connect之前没有Bind的对端
+    bool IsUnnamed() const;
+
+    //抽象命名空间中的地址
+    bool IsAbstract() const;
+
+private:
+    sockaddr_un & un();
+    const sockaddr_un & un() const;
+
+    void Reset();
+};
+
+
+}
+
+#endif
+
+#endif
@@ -1,40 +1,125 @@
-#ifndef NCORE_UTILS_HANDLE_POOL_H_
-#define NCORE_UTILS_HANDLE_POOL_H_
-
-#include <ncore/ncore.h>
-
-namespace ncore
-{
-
-
-template<typename Handle>
-class HandlePool
-{
-public:
-    HandlePool()
-    {}
-
-    Handle::Type Get()
-    {
-        Handle::Type handle = Handle::kInvalidHandle;
-        if (pool_.size()) {
-            handle = pool_.top();
-            pool_.pop();
-        }
-        return handle;
-    }
-
-    void Put(Handle::Type handle)
-    {
-        if (handle != Handle::kInvalidHandle)
-            pool_.push(handle);
-    }
-
-private:
-    std::stack<HandleType> pool_;
-};
-
-
-}
-
-#endif
\ No newline at end of file
+#ifndef NCORE_UTILS_HANDLE_POOL_H_
+#define NCORE_UTILS_HANDLE_POOL_H_
+
+#include <ncore/ncore.h>
+#include <ncore/base/object.h>
+#include <ncore/sys/spin_lock.h>
+
+namespace ncore
+{
+
+
+/*! 句柄池\n
+缓存可以重复使用的句柄，Get/Put可以在多个线程上同时调用。\n
+Handle的约定与ScopeHandle相同：Type为句柄类型，kInvalidHandle为无效值，Free释放句柄。\n
+后放入的句柄先取出，尽量复用最近使用过的句柄。\n
+*/
+template<typename Handle>
+class HandlePool : public NonCopyableObject
+{
+public:
+    typedef typename Handle::Type HandleType;
+
+    //capacity为池中最多缓存的句柄数
+    explicit HandlePool(size_t capacity = static_cast<size_t>(-1))
+        : capacity_(capacity)
+    {}
+
+    ~HandlePool()
+    {
+        Clear();
+    }
+
+    //池为空时返回kInvalidHandle
+    HandleType Get()
+    {
+        HandleType handle = Handle::kInvalidHandle;
+        lock_.Acquire();
+        if(!pool_.empty())
+        {
+            handle = pool_.back();
+            pool_.pop_back();
+        }
+        lock_.Release();
+        return handle;
+    }
+
+    /*! 放回句柄
+    @return 放入池中返回true；句柄无效或者池已满时返回false，此时句柄已被释放。
+    */
+    bool Put(HandleType handle)
+    {
+        if(handle == Handle::kInvalidHandle)
+            return false;
+
+        lock_.Acquire();
+        bool cached = pool_.size() < capacity_;
+        if(cached)
+            pool_.push_back(handle);
+        lock_.Release();
+
+        if(!cached)
+            Handle::Free(handle);
+        return cached;
+    }
+
+    /*! 释放满足条件的句柄
+    @param[in] pred 以句柄为参数，返回true的句柄被移出并释放。在锁内调用，不能再访问本池。
+    @return 释放的句柄数。
+    */
+    template<typename Predicate>
+    size_t RemoveIf(Predicate pred)
+    {
+        std::vector<HandleType> removed;
+        lock_.Acquire();
+        size_t kept = 0;
+        for(size_t index = 0; index < pool_.size(); ++index)
+        {
+            if(pred(pool_[index]))
+                removed.push_back(pool_[index]);
+            else
+                pool_[kept++] = pool_[index];
+        }
+        pool_.resize(kept);
+        lock_.Release();
+
+        for(size_t index = 0; index < removed.size(); ++index)
+            Handle::Free(removed[index]);
+        return removed.size();
+    }
+
+    //释放池中所有的句柄
+    void Clear()
+    {
+        std::vector<HandleType> removed;
+        lock_.Acquire();
+        removed.swap(pool_);
+        lock_.Release();
+
+        for(size_t index = 0; index < removed.size(); ++index)
+            Handle::Free(removed[index]);
+    }
+
+    size_t size() const
+    {
+        lock_.Acquire();
+        size_t size = pool_.size();
+        lock_.Release();
+        return size;
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+private:
+    mutable SpinLock lock_;
+    std::vector<HandleType> pool_;
+    size_t capacity_;
+};
+
+
+}
+
+#endif